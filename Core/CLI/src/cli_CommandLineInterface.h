@@ -212,7 +212,7 @@ namespace cli
             bool DoPWatch(bool query = true, const std::string* pProduction = 0, bool setting = false);
             bool DoRemoveWME(uint64_t timetag);
             bool DoReplayInput(eReplayInputMode mode, std::string* pathname);
-            bool DoReteNet(bool save, std::string filename);
+            bool DoReteNet(bool save, std::string filename, bool add = false);
             bool DoSelect(const std::string* pOp = 0);
             bool DoSource(std::string filename, SourceBitset* pOptions = 0);
             bool DoTime(std::vector<std::string>& argv);
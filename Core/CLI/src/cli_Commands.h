@@ -258,7 +258,9 @@ namespace cli
                     {'d', "off",          OPTARG_NONE},
                     {'e', "enable",       OPTARG_NONE},
                     {'e', "on",           OPTARG_NONE},
+                    {'E', "export",       OPTARG_NONE},
                     {'i', "init",         OPTARG_NONE},
+                    {'I', "import",       OPTARG_NONE},
                     {'g', "get",          OPTARG_NONE},
                     {'p', "print",        OPTARG_NONE},
                     {'s', "set",          OPTARG_NONE},
@@ -311,7 +313,9 @@ namespace cli
                     }
 
                     case 'b':
-                        // case: backup requires one non-option argument
+                    case 'E':
+                    case 'I':
+                        // case: backup, export and import require one non-option argument
                         if (!opt.CheckNumNonOptArgs(1, 1))
                         {
                             return cli.SetError(opt.GetError().c_str());
@@ -1018,6 +1022,8 @@ namespace cli
                     {'s', "set",    OPTARG_NONE},
                     {'t', "trace",    OPTARG_NONE},
                     {'S', "stats",    OPTARG_NONE},
+                    {'w', "save-weights",    OPTARG_NONE},
+                    {'l', "load-weights",    OPTARG_NONE},
                     {0, 0, OPTARG_NONE} // null
                 };
 
@@ -1106,6 +1112,18 @@ namespace cli
 
                         return cli.DoRL(option, &(argv[2]));
                     }
+
+                    case 'w':
+                    case 'l':
+                        // case: save-weights and load-weights require one non-option argument
+                    {
+                        if (!opt.CheckNumNonOptArgs(1, 1))
+                        {
+                            return cli.SetError(opt.GetError().c_str());
+                        }
+
+                        return cli.DoRL(option, &(argv[2]));
+                    }
                 }
 
                 // bad: no option, but more than one argument
@@ -1293,6 +1311,7 @@ namespace cli
                     {'g', "get",        OPTARG_NONE},
                     {'h', "history",    OPTARG_NONE},//Testing/unstable - 23-7-2014
                     {'i', "init",       OPTARG_NONE},
+                    {'I', "import",     OPTARG_NONE},
                     {'P', "precalculate", OPTARG_NONE},
                     {'q', "query",      OPTARG_NONE},//Testing/unstable - 23-7-2014
                     {'r', "remove",     OPTARG_NONE},//Testing/unstable - 23-7-2014
@@ -1343,7 +1362,8 @@ namespace cli
                         return cli.DoSMem(option, &(argv[2]));
 
                     case 'b':
-                        // case: backup requires one non-option argument
+                    case 'I':
+                        // case: backup and import require one non-option argument
                         if (!opt.CheckNumNonOptArgs(1, 1))
                         {
                             return cli.SetError(opt.GetError().c_str());
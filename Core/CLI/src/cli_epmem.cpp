@@ -41,14 +41,19 @@ bool CommandLineInterface::DoEpMem(const char pOp, const std::string* pAttr, con
         PrintCLIMessage_Item("append:", thisAgent->EpMem->epmem_params->append_db, 40);
         PrintCLIMessage_Item("path:", thisAgent->EpMem->epmem_params->path, 40);
         PrintCLIMessage_Item("lazy-commit:", thisAgent->EpMem->epmem_params->lazy_commit, 40);
+        PrintCLIMessage_Item("commit-episodes:", thisAgent->EpMem->epmem_params->commit_episodes, 40);
+        PrintCLIMessage_Item("commit-ms:", thisAgent->EpMem->epmem_params->commit_ms, 40);
+        PrintCLIMessage_Item("async-storage:", thisAgent->EpMem->epmem_params->async_storage, 40);
         PrintCLIMessage_Section("Retrieval", 40);
         PrintCLIMessage_Item("balance:", thisAgent->EpMem->epmem_params->balance, 40);
         PrintCLIMessage_Item("graph-match:", thisAgent->EpMem->epmem_params->graph_match, 40);
         PrintCLIMessage_Item("graph-match-ordering:", thisAgent->EpMem->epmem_params->gm_ordering, 40);
+        PrintCLIMessage_Item("interval-index:", thisAgent->EpMem->epmem_params->interval_index, 40);
         PrintCLIMessage_Section("Performance", 40);
         PrintCLIMessage_Item("page-size:", thisAgent->EpMem->epmem_params->page_size, 40);
         PrintCLIMessage_Item("cache-size:", thisAgent->EpMem->epmem_params->cache_size, 40);
         PrintCLIMessage_Item("optimization:", thisAgent->EpMem->epmem_params->opt, 40);
+        PrintCLIMessage_Item("query-threads:", thisAgent->EpMem->epmem_params->query_threads, 40);
         PrintCLIMessage_Item("timers:", thisAgent->EpMem->epmem_params->timers, 40);
         PrintCLIMessage_Section("Experimental", 40);
         PrintCLIMessage_Item("merge:", thisAgent->EpMem->epmem_params->merge, 40);
@@ -79,6 +84,42 @@ bool CommandLineInterface::DoEpMem(const char pOp, const std::string* pAttr, con
         
         return result;
     }
+    else if (pOp == 'E')
+    {
+        std::string err;
+
+        bool result = epmem_export_db(thisAgent, pAttr->c_str(), &(err));
+
+        if (!result)
+        {
+            SetError("Error while exporting database: " + err);
+        }
+        else
+        {
+            tempString << "Episodic memory database exported to " << pAttr->c_str();
+            PrintCLIMessage(&tempString);
+        }
+
+        return result;
+    }
+    else if (pOp == 'I')
+    {
+        std::string err;
+
+        bool result = epmem_import_db(thisAgent, pAttr->c_str(), &(err));
+
+        if (!result)
+        {
+            SetError("Error while importing database: " + err);
+        }
+        else
+        {
+            tempString << "Episodic memory database imported from " << pAttr->c_str();
+            PrintCLIMessage(&tempString);
+        }
+
+        return result;
+    }
     else if (pOp == 'c')
     {
         const char* msg = "Episodic memory database closed.";
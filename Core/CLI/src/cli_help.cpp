@@ -744,6 +744,8 @@ void initdocstrings()
 		"  epmem -v|--viz <episode id>\n"
 		"  epmem -p|--print <episode id>\n"
 		"  epmem -b|--backup <file name>\n"
+		"  epmem -E|--export <file name>\n"
+		"  epmem -I|--import <file name>\n"
 		"\n"
 		"Options:\n"
 		"\n"
@@ -759,6 +761,8 @@ void initdocstrings()
 		"-v, --viz            Print episode in graphviz format\n"
 		"-p, --print          Print episode in user-readable format\n"
 		"-b, --backup         Creates a backup of the episodic database on disk\n"
+		"-E, --export         Writes the episodic store to a compact snapshot file\n"
+		"-I, --import         Replaces the episodic store with a snapshot file\n"
 		"\n"
 		"Description\n"
 		"\n"
@@ -801,11 +805,19 @@ void initdocstrings()
 		"Performance Parameters:\n"
 		"\n"
 		"Parameter            Description              Possible values      Default\n"
+		"async-storage        Write new episodes on a  on, off              on\n"
+		"                     background thread\n"
 		"cache-size           Number of memory pages   1, 2, ...            10000\n"
 		"                     used in the SQLite cache\n"
+		"commit-episodes      With lazy-commit, commit 0, 1, 2, ...         0\n"
+		"                     after this many episodes\n"
+		"commit-ms            With lazy-commit, commit 0, 1, 2, ...         0\n"
+		"                     after this many msecs\n"
 		"graph-match          Graph matching enabled   on, off              on\n"
 		"graph-match-ordering Ordering of identifiers  undefined, dfs, mcv  undefined\n"
 		"                     during graph match\n"
+		"interval-index       Walk episode intervals   on, off              on\n"
+		"                     from memory in queries\n"
 		"                     Delay writing semantic\n"
 		"lazy-commit          store changes to file    on, off              on\n"
 		"                     until agent exits\n"
@@ -813,6 +825,8 @@ void initdocstrings()
 		"                     data to disk\n"
 		"page-size            Size of each memory page 1k, 2k, 4k, 8k, 16k, 8k\n"
 		"                     used in the SQLite cache 32k, 64k\n"
+		"query-threads        Threads used to graph    1, 2, ...            1\n"
+		"                     match query candidates\n"
 		"timers               Timer granularity        off, one, two, three off\n"
 		"\n"
 		"The learning parameter turns the episodic memory module on or off. When\n"
@@ -855,6 +869,15 @@ void initdocstrings()
 		"The epmem --backup command can be used to make a copy of the current state of\n"
 		"the database, whether in memory or on disk. This command will commit all\n"
 		"outstanding changes before initiating the copy.\n"
+		"The epmem --export command writes the episodes, along with the symbols and\n"
+		"working memory structures they refer to, to a snapshot file, which is usually a\n"
+		"small fraction of the size of the database. Episode ids are delta-encoded,\n"
+		"symbols are stored once, and indices are left out. epmem --import replaces the\n"
+		"contents of the current episodic memory database, in memory or on disk, with\n"
+		"those of a snapshot, so that a pre-built episodic memory can be given to a new\n"
+		"agent. The snapshot is read through a read-only memory map and checked before\n"
+		"anything is replaced. Snapshots can only be imported by a Soar with the same\n"
+		"epmem schema version.\n"
 		"When the database is stored to disk, the lazy-commit and optimization\n"
 		"parameters control how often cached database changes are written to disk. These\n"
 		"parameters trade off safety in the case of a program crash with database\n"
@@ -863,6 +886,19 @@ void initdocstrings()
 		"another SQLite process such as SQLiteMan. The lock can be relinquished by\n"
 		"setting the database to memory or another database and issuing init-soar/epmem\n"
 		"--init or by shutting down the Soar kernel.\n"
+		"Setting commit-episodes or commit-ms to a number greater than 0 turns on group\n"
+		"commit: with lazy-commit on, episodic memory commits whenever that many\n"
+		"episodes have been stored or that many milliseconds have passed since the last\n"
+		"commit, whichever comes first. A database on disk is then kept in write-ahead\n"
+		"log mode and is written back to the database file by a background thread, so a\n"
+		"crash loses at most the episodes since the last commit and the agent does not\n"
+		"wait for the disk on each commit. Group commit takes the place of the\n"
+		"optimization setting and does not lock the database.\n"
+		"With async-storage on, episodic memory works out what changed in each new\n"
+		"episode during the decision cycle, but the database updates for it are made by\n"
+		"a background thread while the agent goes on running. Retrievals, queries and\n"
+		"commands that read the database first wait for those updates to finish, and so\n"
+		"does the agent at each group commit, so committed episodes are never lost.\n"
 		"The balance parameter sets the linear weight of match cardinality vs. cue\n"
 		"activation. As a performance optimization, when the value is 1 (default),\n"
 		"activation is not computed. If this value is not 1 (even close, such as 0.99),\n"
@@ -878,6 +914,15 @@ void initdocstrings()
 		"is advised that you attempt these heuristics to improve performance if the\n"
 		"query_graph_match timer reveals that graph matching is dominating retrieval\n"
 		"time.\n"
+		"With interval-index on, a query reads the episode intervals of each working\n"
+		"memory element it considers from the database once and keeps them in memory,\n"
+		"updating them as new episodes are stored, instead of querying the database for\n"
+		"them on every retrieval.\n"
+		"With query-threads set above 1, a query does not stop to graph match each\n"
+		"episode that matches every leaf of the cue. It hands such episodes to that\n"
+		"many threads and carries on walking back through the store while they are\n"
+		"matched, returning the most recent one that matches. The threads are kept\n"
+		"between queries. The result is the same as with a single thread.\n"
 		"The merge parameter controls how the augmentations of retrieved long-term\n"
 		"identifiers (LTIs) interact with an existing LTI in working memory. If the LTI\n"
 		"is not in working memory or has no augmentations in working memory, this\n"
@@ -1532,7 +1577,7 @@ void initdocstrings()
 		"  ------------------------------------------------------------\n"
 		"  load library                    <filename> <args...>\n"
 		"  ------------------------------------------------------------\n"
-		"  load rete-network               --load <filename>\n"
+		"  load rete-network               --load <filename> [--add]\n"
 		"  ------------------------------------------------------------\n"
 		"  load percepts                   --open <filename>\n"
 		"  load percepts                   --close\n"
@@ -1627,6 +1672,14 @@ void initdocstrings()
 		"productions. This command provides a fast method of saving and loading\n"
 		"productions since a special format is used and no parsing is necessary. Rete-\n"
 		"net files are portable across platforms that support Soar.\n"
+		"Loading normally replaces all productions and reinitializes working memory.\n"
+		"With -A or --add, the saved productions are added to the running agent:\n"
+		"working memory is kept, and a loaded production replaces any production of\n"
+		"the same name. Added productions do not share Rete nodes with the ones\n"
+		"already loaded.\n"
+		"Files saved by this version keep each rule's RL values (update count,\n"
+		"delta-bar-delta state, ecr, efr and gql), its original rule name and exact\n"
+		"float constants, so learned chunks and RL rules reload as they were saved.\n"
 		"If the filename contains a suffix of .Z, then the file is compressed\n"
 		"automatically when it is saved and uncompressed when it is loaded. Compressed\n"
 		"files may not be portable to another platform if that platform does not support\n"
@@ -1635,6 +1688,7 @@ void initdocstrings()
 		"Usage:\n"
 		"\n"
 		"  load rete-network -l <filename>\n"
+		"  load rete-network -l <filename> -A\n"
 		"\n"
 		"load percepts\n"
 		"\n"
@@ -2662,14 +2716,18 @@ void initdocstrings()
 		"  rl -s|--set <parameter> <value>\n"
 		"  rl -t|--trace <parameter> <value>\n"
 		"  rl -S|--stats <statistic>\n"
+		"  rl -w|--save-weights <file name>\n"
+		"  rl -l|--load-weights <file name>\n"
 		"\n"
 		"Options:\n"
 		"\n"
-		"Option      Description\n"
-		"-g, --get   Print current parameter setting\n"
-		"-s, --set   Set parameter value\n"
-		"-t, --trace Print, clear, or init traces\n"
-		"-S, --stats Print statistic summary or specific statistic\n"
+		"Option              Description\n"
+		"-g, --get           Print current parameter setting\n"
+		"-s, --set           Set parameter value\n"
+		"-t, --trace         Print, clear, or init traces\n"
+		"-S, --stats         Print statistic summary or specific statistic\n"
+		"-w, --save-weights  Write the learned values of all RL rules to a file\n"
+		"-l, --load-weights  Give loaded RL rules the values saved in a file\n"
 		"\n"
 		"Description\n"
 		"\n"
@@ -2845,6 +2903,19 @@ void initdocstrings()
 		"\n"
 		"The .svg format works better for large traces.\n"
 		"\n"
+		"RL Weights\n"
+		"\n"
+		"rl --save-weights writes what has been learned about each RL rule -- its\n"
+		"value, expected current and future reward, GQ weight, update count and\n"
+		"delta-bar-delta state -- to a compact binary file. rl --load-weights reads such\n"
+		"a file and gives those values to the loaded rules with the same names, without\n"
+		"re-sourcing them, so that a training run can be checkpointed and a trained\n"
+		"agent warm-started from its rule base. Rules in the file that are not loaded\n"
+		"are counted and skipped. Rules made from RL templates are named in the order\n"
+		"they are made, so they are matched by their template and the constants in their\n"
+		"conditions instead of by name, and only need to have been made again, in any\n"
+		"order. The file is checked before any rule is changed.\n"
+		"\n"
 		"See Also\n"
 		"\n"
 		"excise print trace\n"
@@ -2994,8 +3065,8 @@ void initdocstrings()
 		"productions. This command provides a fast method of saving and loading\n"
 		"productions since a special format is used and no parsing is necessary. Rete-\n"
 		"net files are portable across platforms that support Soar.\n"
-		"Note that justifications cannot be present when saving the Rete net. Issuing a\n"
-		"production_excise_-j before saving a Rete net will remove all justifications.\n"
+		"Justifications are not saved; productions learned as chunks and RL rules are\n"
+		"saved along with their RL values.\n"
 		"If the filename contains a suffix of .Z, then the file is compressed\n"
 		"automatically when it is saved and uncompressed when it is loaded. Compressed\n"
 		"files may not be portable to another platform if that platform does not support\n"
@@ -3052,6 +3123,7 @@ void initdocstrings()
 		"  smem --backup                                <filename>   Save copy of database\n"
 		"  smem --clear                                              Delete contents of smem\n"
 		"  smem --export                        <filename> [<LTI>]   Save database to file\n"
+		"  smem --import                                <filename>   Bulk load knowledge file\n"
 		"  smem --init                                               Reinit smem store\n"
 		"  smem --query                           {(cue)* [<num>]}   Query smem via given cue\n"
 		"  smem --remove                 { (id [^attr [value]])* }   Remove smem structures\n"
@@ -3089,6 +3161,7 @@ void initdocstrings()
 		"  optimization                   [ safety | PERFORMANCE ]\n"
 		"  cache-size                                        10000   Number of memory pages for SQLite cache\n"
 		"  page-size                                            8k   Size of each memory page\n"
+		"  native-store                               [ ON | off ]   Answer queries from an in-memory copy\n"
 		"  ----------------- Timers and Statistics ---------------\n"
 		"  timers                      [ OFF | one | two | three ]   How detailed timers should be\n"
 		"  smem --timers                                 [<timer>]   Print summary or specifics\n"
@@ -3131,6 +3204,7 @@ void initdocstrings()
 		"-S, --stats          Print statistic summary or specific statistic\n"
 		"-t, --timers         Print timer summary or specific statistic\n"
 		"-a, --add            Add concepts to semantic memory\n"
+		"-I, --import         Bulk load concepts from a file into semantic memory\n"
 		"-r, --remove         Remove concepts from semantic memory\n"
 		"-q, --query          Print concepts in semantic store matching some cue\n"
 		"-h, --history        Print activation history for some LTI\n"
@@ -3225,6 +3299,9 @@ void initdocstrings()
 		"             Delay writing semantic store\n"
 		"lazy-commit  changes to file until agent  on, off                   on\n"
 		"             exits\n"
+		"             Answer cue-based retrievals\n"
+		"native-store from an in-memory copy of    on, off                   on\n"
+		"             the augmentations\n"
 		"optimization Policy for committing data   safety, performance       performance\n"
 		"             to disk\n"
 		"page-size    Size of each memory page     1k, 2k, 4k, 8k, 16k, 32k, 8k\n"
@@ -3240,6 +3317,16 @@ void initdocstrings()
 		"setting the database to memory or another database and issuing init-soar/smem -\n"
 		"-init or by shutting down the Soar kernel.\n"
 		"\n"
+		"With native-store on, semantic memory also keeps a copy of every LTI's\n"
+		"augmentations in memory, indexed by cue element and sorted by activation, and\n"
+		"answers the candidate walk of cue-based retrievals from it instead of SQLite.\n"
+		"The database remains the store of record and every change is written through\n"
+		"to it. Numeric values are also kept ordered per attribute, so that a query\n"
+		"with a single math-query element walks values from the max/min down, or only\n"
+		"the values in range, rather than every memory with the attribute. Retrievals\n"
+		"with spreading activation on still walk their candidates in SQLite. The\n"
+		"setting can only be changed while the database is closed.\n"
+		"\n"
 		"Statistics\n"
 		"\n"
 		"Semantic memory tracks statistics over the lifetime of the agent. These can be\n"
@@ -3313,6 +3400,26 @@ void initdocstrings()
 		"children. Each child will be its own concept with two constant attribute/value\n"
 		"pairs.\n"
 		"\n"
+		"smem --import\n"
+		"\n"
+		"Large knowledge bases can be loaded with smem --import <filename>, which is\n"
+		"much faster than smem --add. A file ending in .csv or .tsv holds one\n"
+		"augmentation per line, as comma- or tab-separated fields:\n"
+		"\n"
+		"  <id>,<attribute>,<value>[,<edge weight>]\n"
+		"\n"
+		"Ids, and values that are LTIs, are written either @<number>, for a specific\n"
+		"LTI, or <name>, for a new LTI that every line using that name shares. Other\n"
+		"values are integers, floats or strings; |quoted| strings are never read as\n"
+		"numbers. Blank lines and lines starting with # are skipped. Any other file is\n"
+		"read as the clauses of an smem --add command, without the braces.\n"
+		"\n"
+		"The whole file is parsed before anything is stored, so a malformed line or\n"
+		"clause leaves semantic memory unchanged. Augmentations are appended as with\n"
+		"smem --add, in one transaction, with the indices of the augmentation table\n"
+		"built once after all of the rows are inserted and the attribute/value\n"
+		"frequencies recounted in one pass.\n"
+		"\n"
 		"smem --remove\n"
 		"\n"
 		"Part or all of the information in the semantic store of some LTI can be\n"
@@ -340,6 +340,7 @@ bool CommandLineInterface::ParseReteLoad(std::vector< std::string >& argv)
     cli::Options opt;
     OptionsData optionsData[] =
     {
+        {'A', "add",         OPTARG_NONE},
         {'l', "load",        OPTARG_REQUIRED},
         {'r', "restore",    OPTARG_REQUIRED},
         {'s', "save",        OPTARG_REQUIRED},
@@ -348,6 +349,7 @@ bool CommandLineInterface::ParseReteLoad(std::vector< std::string >& argv)
 
     bool save = false;
     bool load = false;
+    bool add = false;
     std::string filename;
 
     for (;;)
@@ -364,6 +366,9 @@ bool CommandLineInterface::ParseReteLoad(std::vector< std::string >& argv)
 
         switch (opt.GetOption())
         {
+            case 'A':
+                add = true;
+                break;
             case 'l':
             case 'r':
                 load = true;
@@ -387,8 +392,12 @@ bool CommandLineInterface::ParseReteLoad(std::vector< std::string >& argv)
     {
         return SetError("Please specify a file name.");
     }
+    if (add && !load)
+    {
+        return SetError("The --add option only applies when loading a Rete net.");
+    }
 
-    return DoReteNet(save, filename);
+    return DoReteNet(save, filename, add);
 
 
 }
@@ -583,7 +592,7 @@ bool CommandLineInterface::DoCaptureInput(eCaptureInputMode mode, bool autoflush
                 return SetError("File name required.");
             }
 
-            uint32_t seed = SoarRandInt();
+            uint32_t seed = m_pAgentSML->GetSoarAgent()->rng->randInt();
 
             if (!m_pAgentSML->StartCaptureInput(*pathname, autoflush, seed))
             {
@@ -602,7 +611,7 @@ bool CommandLineInterface::DoCaptureInput(eCaptureInputMode mode, bool autoflush
     return true;
 }
 
-bool CommandLineInterface::DoReteNet(bool save, std::string filename)
+bool CommandLineInterface::DoReteNet(bool save, std::string filename, bool add)
 {
     if (!filename.size())
     {
@@ -637,7 +646,7 @@ bool CommandLineInterface::DoReteNet(bool save, std::string filename)
             return SetError("Open file failed.");
         }
 
-        if (! load_rete_net(thisAgent, file))
+        if (! load_rete_net(thisAgent, file, add))
         {
             // TODO: additional error information
             return SetError("Rete load operation failed.");
@@ -43,6 +43,7 @@ namespace cli
                     {'r', "restore",    OPTARG_REQUIRED},
                     {'s', "save",        OPTARG_REQUIRED},
                     {'a', "all",            OPTARG_NONE},
+                    {'A', "add",            OPTARG_NONE},
                     {'d', "disable",        OPTARG_NONE},
                     {'v', "verbose",        OPTARG_NONE},
                     {0, 0, OPTARG_NONE}
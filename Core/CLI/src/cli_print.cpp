@@ -47,11 +47,11 @@ bool print_gds(agent* thisAgent)
     thisAgent->outputManager->printa_sf(thisAgent,  "stepping thru all wmes in rete, looking for any that are in a gds...\n");
     for (w = thisAgent->all_wmes_in_rete; w != NIL; w = w->rete_next)
     {
-        if (w->gds)
+        if (wme_gds(w))
         {
-            if (w->gds->goal)
+            if (w->cold->gds->goal)
             {
-                thisAgent->outputManager->printa_sf(thisAgent, "  For Goal  %y  ", w->gds->goal);
+                thisAgent->outputManager->printa_sf(thisAgent, "  For Goal  %y  ", w->cold->gds->goal);
             }
             else
             {
@@ -75,7 +75,7 @@ bool print_gds(agent* thisAgent)
         {
             /* Loop over all the WMEs in the GDS */
             thisAgent->outputManager->printa_sf(thisAgent,  "\n");
-            for (w = goal->id->gds->wmes_in_gds; w != NIL; w = w->gds_next)
+            for (w = goal->id->gds->wmes_in_gds; w != NIL; w = w->cold->gds_next)
             {
                 thisAgent->outputManager->printa_sf(thisAgent,  "                (%u: ", w->timetag);
                 thisAgent->outputManager->printa_sf(thisAgent, "%y ^%y %y", w->id, w->attr, w->value);
@@ -176,6 +176,7 @@ void do_print_for_production(agent* thisAgent, production* prod, bool intern, bo
                 thisAgent->outputManager->printa_sf(thisAgent, " %y", thisAgent->symbolManager->make_float_constant(prod->rl_delta_bar_delta_h));
             }
             thisAgent->outputManager->printa_sf(thisAgent, " %y", thisAgent->symbolManager->make_float_constant(prod->rl_update_count));
+            rl_write_back_value(thisAgent, prod);
             thisAgent->outputManager->printa_sf(thisAgent, " %y", rhs_value_to_symbol(prod->action_list->referent));
         }
     }
@@ -371,6 +371,42 @@ bool CommandLineInterface::DoRL(const char pOp, const std::string* pAttr, const
         
         return true;
     }
+    else if (pOp == 'w')
+    {
+        std::string err;
+        uint64_t count;
+
+        if (!rl_save_weights(thisAgent, pAttr->c_str(), &count, &err))
+        {
+            return SetError("Error while saving RL weights: " + err);
+        }
+
+        std::ostringstream tempString;
+        tempString << "Saved weights of " << count << " RL rules to " << *pAttr;
+        PrintCLIMessage(&tempString);
+
+        return true;
+    }
+    else if (pOp == 'l')
+    {
+        std::string err;
+        uint64_t count, unmatched;
+
+        if (!rl_load_weights(thisAgent, pAttr->c_str(), &count, &unmatched, &err))
+        {
+            return SetError("Error while loading RL weights: " + err);
+        }
+
+        std::ostringstream tempString;
+        tempString << "Loaded weights of " << count << " RL rules from " << *pAttr;
+        if (unmatched)
+        {
+            tempString << " (" << unmatched << " not found)";
+        }
+        PrintCLIMessage(&tempString);
+
+        return true;
+    }
     
     return SetError("Unknown option.");
 }
@@ -60,6 +60,24 @@ bool CommandLineInterface::DoSMem(const char pOp, const std::string* pArg1, cons
         delete err;
         return result;
     }
+    else if (pOp == 'I')
+    {
+        std::string* err = new std::string("");
+        std::string* imported = new std::string("");
+        bool result = thisAgent->SMem->CLI_import(pArg1->c_str(), &(err), &(imported));
+
+        if (!result)
+        {
+            SetError("Error while importing into semantic memory: " + *err);
+        }
+        else
+        {
+            PrintCLIMessage(imported);
+        }
+        delete err;
+        delete imported;
+        return result;
+    }
     else if (pOp == 'b')
     {
         std::string err;
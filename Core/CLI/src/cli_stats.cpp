@@ -554,6 +554,7 @@ void CommandLineInterface::GetMemoryStats()
     m_Result << std::setw(8) << thisAgent->memoryManager->memory_for_usage[HASH_TABLE_MEM_USAGE] << " bytes for hash tables\n";
     m_Result << std::setw(8) << thisAgent->memoryManager->memory_for_usage[POOL_MEM_USAGE] << " bytes for various memory pools\n";
     m_Result << std::setw(8) << thisAgent->memoryManager->memory_for_usage[MISCELLANEOUS_MEM_USAGE] << " bytes for miscellaneous other things\n";
+    m_Result << "Memory pools " << (thisAgent->memoryManager->is_shared() ? "shared by all agents" : "owned by this agent") << "\n";
 
     GetMemoryPoolStatistics();
 }
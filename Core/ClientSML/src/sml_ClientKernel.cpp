@@ -62,6 +62,9 @@ Kernel::Kernel(Connection* pConnection)
     // Power users are free to turn it off and use explicit commit calls.
     m_bAutoCommit   = true ;
 
+    m_bKernelReadsInputBatches = false ;
+    m_bAllowInputBatches = true ;
+
     ClearError() ;
 
     if (pConnection)
@@ -322,6 +325,29 @@ bool Kernel::IsTracingCommunications()
     return m_bTracingCommunications ;
 }
 
+void Kernel::SetAllowBinaryMessages(bool state)
+{
+    if (m_Connection)
+    {
+        m_Connection->SetAllowBinaryMessages(state) ;
+    }
+}
+
+bool Kernel::IsAllowingBinaryMessages()
+{
+    return m_Connection && m_Connection->IsAllowingBinaryMessages() ;
+}
+
+void Kernel::SetAllowInputBatches(bool state)
+{
+    m_bAllowInputBatches = state ;
+}
+
+bool Kernel::IsUsingInputBatches()
+{
+    return m_bAllowInputBatches && m_bKernelReadsInputBatches ;
+}
+
 /*************************************************************
 * @brief This function is called when we receive a "call" SML
 *        message from the kernel.
@@ -772,6 +798,8 @@ Kernel* Kernel::CreateEmbeddedConnection(bool clientThread, bool optimized, int
 
         pKernel->InitializeTimeTagCounter() ;
 
+        pKernel->InitializeInputBatchSupport() ;
+
         pKernel->InitEvents() ;
     }
 
@@ -831,6 +859,9 @@ Kernel* Kernel::CreateRemoteConnection(bool sharedFileSystem, char const* pIPadd
     // Initialize our time tags
     pKernel->InitializeTimeTagCounter();
 
+    // Find out how the kernel wants to receive input
+    pKernel->InitializeInputBatchSupport();
+
     // Get the current list of active agents
     pKernel->UpdateAgentList();
 
@@ -877,6 +908,19 @@ void Kernel::InitializeTimeTagCounter()
     }
 }
 
+/*************************************************************
+* @brief Input-link changes are committed as a single <wmes> batch
+*        (see sml_InputBatch.h), but kernels from before batches
+*        only read <wme> tags and would silently drop a batch.
+*        So we ask the kernel once, when we connect; an older kernel
+*        doesn't recognize the command and we fall back to <wme> tags.
+*************************************************************/
+void Kernel::InitializeInputBatchSupport()
+{
+    AnalyzeXML response ;
+    m_bKernelReadsInputBatches = GetConnection()->SendAgentCommand(&response, sml_Names::kCommand_GetInputBatchSupport) && response.GetResultBool(false) ;
+}
+
 /*************************************************************
 * @brief Get the list of agents currently active in the kernel
 *        and create local Agent objects for each one (if we
@@ -2410,6 +2454,50 @@ bool Kernel::SetInterruptCheckRate(int newRate)
     return ok ;
 }
 
+/*************************************************************
+* @brief Controls who owns the memory pools of agents created
+*        after this call.  By default all agents in a kernel
+*        share one set of pools.  When agent owned, each new
+*        agent gets its own pools and pool statistics.
+*
+* @param agentOwned true to give each new agent its own pools
+*************************************************************/
+bool Kernel::SetAgentMemoryPools(bool agentOwned)
+{
+    AnalyzeXML response ;
+
+    bool ok = GetConnection()->SendAgentCommand(&response, sml_Names::kCommand_SetAgentMemoryPools, NULL, sml_Names::kParamValue, agentOwned ? sml_Names::kTrue : sml_Names::kFalse) ;
+
+    return ok ;
+}
+
+/*************************************************************
+* @brief Sets how many threads are used to step agents when
+*        several agents run together.  Agents that own their
+*        memory pools are stepped concurrently, synchronizing
+*        after every interleave step.
+*
+* @param threads >= 1, 1 runs agents round-robin on one thread
+*************************************************************/
+bool Kernel::SetParallelRunThreads(int threads)
+{
+    // Reject invalid thread counts
+    if (threads <= 0)
+    {
+        return false ;
+    }
+
+    AnalyzeXML response ;
+
+    // Convert int to a string
+    std::ostringstream ostr ;
+    ostr << threads ;
+
+    bool ok = GetConnection()->SendAgentCommand(&response, sml_Names::kCommand_SetParallelRunThreads, NULL, sml_Names::kParamValue, ostr.str().c_str()) ;
+
+    return ok ;
+}
+
 /*************************************************************
 * @brief The Soar kernel version is based on sending a request
 *        to the kernel asking for its version and returning the
@@ -232,6 +232,12 @@ namespace sml
             // (that is send them over to kernelSML immediately, rather than collecting them up for a single commit)
             bool m_bAutoCommit ;
 
+            // True if the kernel said (when we connected) that it can read input as <wmes> batches
+            bool m_bKernelReadsInputBatches ;
+
+            // If false, input is always sent as one <wme> tag per change
+            bool m_bAllowInputBatches ;
+
             // This thread is used to check for incoming events when the client goes to sleep
             // It ensures the client stays "alive" and is optional (there are other ways for clients to keep themselves
             // responsive).
@@ -307,6 +313,8 @@ namespace sml
 
             void InitializeTimeTagCounter() ;
 
+            void InitializeInputBatchSupport() ;
+
         public:
             /*************************************************************
             * @brief Creates a connection to the Soar kernel that is embedded
@@ -430,6 +438,24 @@ namespace sml
             void SetTraceCommunications(bool state) ;
             bool IsTracingCommunications() ;
 
+            /*************************************************************
+            * @brief Controls whether messages to a remote kernel may be sent in a
+            *        compact binary format rather than as XML text.  Binary is only
+            *        used once the kernel has said it can read it, so older kernels
+            *        keep getting XML.  On by default.  Has no effect on embedded connections.
+            *************************************************************/
+            void SetAllowBinaryMessages(bool state) ;
+            bool IsAllowingBinaryMessages() ;
+
+            /*************************************************************
+            * @brief Controls whether input-link changes are committed as a single
+            *        <wmes> batch rather than one <wme> tag per change.  Batches are
+            *        only sent to kernels that said they can read them when we
+            *        connected, so older kernels keep getting <wme> tags.  On by default.
+            *************************************************************/
+            void SetAllowInputBatches(bool state) ;
+            bool IsUsingInputBatches() ;
+
             /*************************************************************
             * @brief Creates a new Soar agent with the given name.
             *
@@ -754,6 +780,38 @@ namespace sml
             *************************************************************/
             bool SetInterruptCheckRate(int newRate) ;
 
+            /*************************************************************
+            * @brief Controls who owns the memory pools of agents created
+            *        after this call.  By default all agents in a kernel
+            *        share one set of pools.  When agent owned, each new
+            *        agent gets its own pools and pool statistics, which
+            *        keeps the agents' allocations from mixing and is
+            *        required for running agents in parallel.
+            *
+            *        Agents that already exist keep the pools they have.
+            *
+            * @param agentOwned true to give each new agent its own pools
+            *************************************************************/
+            bool SetAgentMemoryPools(bool agentOwned) ;
+
+            /*************************************************************
+            * @brief Sets how many threads are used to step agents when
+            *        several agents run together.  With more than one
+            *        thread the agents scheduled to run are stepped
+            *        concurrently, one interleave step at a time, and
+            *        the kernel waits for all of them before firing
+            *        events such as smlEVENT_AFTER_ALL_OUTPUT_PHASES,
+            *        so those still fire once per round.
+            *
+            *        Agents are only stepped in parallel if they own their
+            *        memory pools (see SetAgentMemoryPools).  Event and rhs
+            *        function handlers may be called from the worker threads
+            *        but never from two threads at once.
+            *
+            * @param threads 1 (the default) runs agents round-robin on one thread
+            *************************************************************/
+            bool SetParallelRunThreads(int threads) ;
+
             /*************************************************************
             * @brief Register a handler for a RHS (right hand side) function.
             *        This function can be called in the RHS of a production firing
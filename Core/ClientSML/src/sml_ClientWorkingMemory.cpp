@@ -1343,26 +1343,32 @@ bool WorkingMemory::Commit()
     ElementXML_Handle hCommand = GetConnection()->AddParameterToSMLCommand(pMsg, sml_Names::kParamAgent, GetAgentName()) ;
     ElementXML command(hCommand) ;
     
-    // Build the list of WME changes
-    for (int i = 0 ; i < deltas ; i++)
+    if (GetAgent()->GetKernel()->IsUsingInputBatches())
     {
-        // Get the next change
-        TagWme* pDelta = m_DeltaList.GetDelta(i) ;
+        // The whole list of changes goes over as one block of binary data
+        std::string buffer ;
+        m_DeltaList.GetBatch()->Serialize(&buffer) ;
+        
+        ElementXML* pBatch = new ElementXML() ;
+        pBatch->SetTagName(sml_Names::kTagWMEBatch) ;
+        pBatch->SetBinaryCharacterData(buffer.data(), static_cast<int>(buffer.size())) ;
         
         // Add it as a child of the command tag
-        // (the command takes ownership of the delta)
-        command.AddChild(pDelta) ;
+        // (the command takes ownership of the batch)
+        command.AddChild(pBatch) ;
     }
+    else
+    {
+        // The kernel can't read batches, so send a <wme> tag per change
+        m_DeltaList.GetBatch()->AddWmeTags(&command) ;
+    }
+    m_DeltaList.Clear() ;
     
     // This is important.  We are working with a subpart of pMsg.
     // If we retain ownership of the handle and delete the object
     // it will release the handle...deleting part of our message.
     command.Detach() ;
     
-    // We have transfered the list of deltas over to pMsg
-    // so we need to clear the list, but not delete the tags that it contains.
-    m_DeltaList.Clear(false) ;
-    
 #ifdef _DEBUG
     // Generate a text form of the XML so we can look at it in the debugger.
     char* pStr = pMsg->GenerateXMLString(true) ;
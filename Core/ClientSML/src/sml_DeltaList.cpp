@@ -15,61 +15,47 @@
 #include "sml_DeltaList.h"
 #include "sml_ClientWMElement.h"
 #include "sml_ClientIdentifier.h"
-#include "sml_Connection.h"
-#include "sml_TagWme.h"
+#include "sml_ClientIntElement.h"
+#include "sml_ClientFloatElement.h"
+#include "sml_ClientStringElement.h"
 
 using namespace sml ;
 
 void DeltaList::RemoveWME(long long timeTag)
 {
-// BADBAD: We should scan the existing list of tags and if we are adding this value
-// just delete that tag and don't add anything to the delta list.
+// BADBAD: We should scan the existing list of changes and if we are adding this value
+// just drop that add and don't add anything to the delta list.
 // (This will happen if we change a value twice within a commit cycle).
 // We probably shouldn't do this if the object being removed is an identifier
 // as we might leave pending adds that are children of the object.
 // (Then again, that might be ok as presumably those adds would fail when we
 //  got to the kernel, possibly saving a bunch of time in the matcher).
 
-    // Create the wme tag
-    TagWme* pTag = new TagWme() ;
-    
     // For removes, we just use the time tag
-    pTag->SetTimeTag(timeTag) ;
-    pTag->SetActionRemove() ;
-    
-    m_DeltaList.push_back(pTag) ;
+    m_Batch.RemoveWME(timeTag) ;
 }
 
 void DeltaList::AddWME(WMElement* pWME)
 {
-    // Create the wme tag
-    TagWme* pTag = new TagWme() ;
-    
     // For adds we send everything
-    pTag->SetIdentifier(pWME->GetIdentifier()->GetIdentifierSymbol()) ;
-    pTag->SetAttribute(pWME->GetAttribute()) ;
-    std::string temp;
-    pTag->SetValue(pWME->GetValueAsString(temp), pWME->GetValueType()) ;
-    pTag->SetTimeTag(pWME->GetTimeTag()) ;
-    pTag->SetActionAdd() ;
+    char const* pID = pWME->GetIdentifier()->GetIdentifierSymbol() ;
+    char const* pAttribute = pWME->GetAttribute() ;
+    long long timeTag = pWME->GetTimeTag() ;
     
-    m_DeltaList.push_back(pTag) ;
-}
-
-// We make deleting the contents optional as
-// we may just be moving the tags out of here
-// and into a message for sending, in which case
-// we won't delete them.
-void DeltaList::Clear(bool deleteContents)
-{
-    if (deleteContents)
+    if (IntElement* pInt = pWME->ConvertToIntElement())
     {
-        for (size_t i = 0 ; i < m_DeltaList.size() ; i++)
-        {
-            TagWme* pDelta = m_DeltaList[i] ;
-            delete pDelta ;
-        }
+        m_Batch.AddIntWME(pID, pAttribute, pInt->GetValue(), timeTag) ;
+    }
+    else if (FloatElement* pFloat = pWME->ConvertToFloatElement())
+    {
+        m_Batch.AddDoubleWME(pID, pAttribute, pFloat->GetValue(), timeTag) ;
+    }
+    else if (Identifier* pIdentifier = pWME->ConvertToIdentifier())
+    {
+        m_Batch.AddIdWME(pID, pAttribute, pIdentifier->GetValueAsString(), timeTag) ;
+    }
+    else
+    {
+        m_Batch.AddStringWME(pID, pAttribute, pWME->GetValueAsString(), timeTag) ;
     }
-    
-    m_DeltaList.clear() ;
 }
@@ -13,34 +13,28 @@
 #ifndef SML_DELTA_LIST_H
 #define SML_DELTA_LIST_H
 
-#include <vector>
 #include "Export.h"
+#include "sml_InputBatch.h"
 
 namespace sml
 {
 
     class WMElement ;
-    class TagWme ;
     
     class EXPORT DeltaList
     {
         protected:
-            std::vector<TagWme*>        m_DeltaList ;
+            // The changes are kept in columnar form, ready to be sent as one block
+            InputBatch  m_Batch ;
             
         public:
             DeltaList() { }
             
-            ~DeltaList()
+            void Clear()
             {
-                Clear(true) ;
+                m_Batch.Clear() ;
             }
             
-            // We make deleting the contents optional as
-            // we may just be moving the tags out of here
-            // and into a message for sending, in which case
-            // we won't delete them.
-            void Clear(bool deleteContents) ;
-            
             void RemoveWME(long long timeTag) ;
             
             void AddWME(WMElement* pWME) ;
@@ -55,11 +49,11 @@ namespace sml
             
             int GetSize()
             {
-                return (int)m_DeltaList.size() ;
+                return (int)m_Batch.GetSize() ;
             }
-            TagWme* GetDelta(int i)
+            InputBatch* GetBatch()
             {
-                return m_DeltaList[i] ;
+                return &m_Batch ;
             }
     };
     
@@ -6,6 +6,7 @@
 #include "src/sml_EmbeddedConnectionSynch.cpp"
 #include "src/sml_Events.cpp"
 #include "src/sml_EventThread.cpp"
+#include "src/sml_InputBatch.cpp"
 #include "src/sml_MessageSML.cpp"
 #include "src/sml_Names.cpp"
 #include "src/sml_RemoteConnection.cpp"
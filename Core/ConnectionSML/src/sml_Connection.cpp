@@ -64,6 +64,7 @@ Connection::Connection()
     m_bIsDirectConnection = false ;
     m_bTraceCommunications = false ;
     m_bIsKernelSide = false ;
+    m_bAllowBinaryMessages = true ;
     
     m_Timer.reset();
     m_IncomingTime.reset();
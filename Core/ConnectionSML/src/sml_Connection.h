@@ -172,6 +172,9 @@ namespace sml
             // This has no effect on the logic, but can be helpful for debugging
             bool m_bIsKernelSide ;
             
+            // True if we may send messages in the binary wire format once the other side says it can read it
+            bool m_bAllowBinaryMessages ;
+            
             // A client needs to get this mutex before sending and receiving messages.
             // This allows us to use a separate thread in the client to keep connections
             // alive even when the client itself goes to sleep.
@@ -300,6 +303,22 @@ namespace sml
                 return m_bIsKernelSide ;
             }
             
+            /*************************************************************
+            * @brief Controls whether messages can be sent in the compact binary format
+            *        (see soarxml::BinaryXML) rather than as XML text.
+            *        Binary is only used once the other side has said that it can read it,
+            *        so this is safe to leave on when talking to older clients and kernels.
+            *        Currently only affects remote connections.  On by default.
+            *************************************************************/
+            virtual void        SetAllowBinaryMessages(bool state)
+            {
+                m_bAllowBinaryMessages = state ;
+            }
+            virtual bool        IsAllowingBinaryMessages()
+            {
+                return m_bAllowBinaryMessages ;
+            }
+            
             /*************************************************************
             * @brief Send a message to the SML receiver (e.g. from the environment to the Soar kernel).
             *        The error code that is returned indicates whether the command was successfully sent,
@@ -0,0 +1,311 @@
+#include "portability.h"
+
+/////////////////////////////////////////////////////////////////
+// InputBatch class
+//
+// Date  : October 2026
+//
+// Holds a list of changes to an agent's input link in columnar form.
+//
+// Layout of a serialized batch (numbers are unsigned LEB128 varints,
+// signed numbers are zigzag encoded first):
+//
+//   batch     : version #changes op* #strings strings change*
+//   op        : one byte per change (an InputBatch::InputOp)
+//   strings   : the string buffer, every string null terminated
+//   change    : timetag                                (remove)
+//             | timetag id attribute value             (add)
+//   id, attribute, string and id values are offsets into the string buffer.
+//   int values are signed numbers and double values are their 8 bytes,
+//   least significant first.
+//
+/////////////////////////////////////////////////////////////////
+
+#include "sml_InputBatch.h"
+#include "sml_TagWme.h"
+
+#include <string.h>
+
+using namespace sml ;
+
+#define kInputBatchVersion  1
+
+uint32_t InputBatch::AddString(char const* pString)
+{
+    uint32_t offset = static_cast<uint32_t>(m_Strings.size()) ;
+    m_Strings.append(pString ? pString : "") ;
+    m_Strings.push_back('\0') ;
+    return offset ;
+}
+
+void InputBatch::AddWME(InputOp op, char const* pID, char const* pAttribute, int64_t value, int64_t timeTag)
+{
+    m_Ops.push_back(static_cast<unsigned char>(op)) ;
+    m_TimeTags.push_back(timeTag) ;
+    m_Ids.push_back(AddString(pID)) ;
+    m_Attributes.push_back(AddString(pAttribute)) ;
+    m_Values.push_back(value) ;
+}
+
+void InputBatch::AddDoubleWME(char const* pID, char const* pAttribute, double value, int64_t timeTag)
+{
+    int64_t bits ;
+    memcpy(&bits, &value, sizeof(bits)) ;
+    AddWME(kAddDouble, pID, pAttribute, bits, timeTag) ;
+}
+
+void InputBatch::RemoveWME(int64_t timeTag)
+{
+    m_Ops.push_back(static_cast<unsigned char>(kRemove)) ;
+    m_TimeTags.push_back(timeTag) ;
+    m_Ids.push_back(0) ;
+    m_Attributes.push_back(0) ;
+    m_Values.push_back(0) ;
+}
+
+double InputBatch::GetDoubleValue(size_t i) const
+{
+    double value ;
+    memcpy(&value, &m_Values[i], sizeof(value)) ;
+    return value ;
+}
+
+void InputBatch::Clear()
+{
+    m_Ops.clear() ;
+    m_TimeTags.clear() ;
+    m_Ids.clear() ;
+    m_Attributes.clear() ;
+    m_Values.clear() ;
+    m_Strings.clear() ;
+}
+
+////////////////////////////////////////////////////////////////
+//
+// Serialization
+//
+////////////////////////////////////////////////////////////////
+
+static void WriteNumber(std::string* pBuffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        pBuffer->push_back(static_cast<char>((value & 0x7F) | 0x80)) ;
+        value >>= 7 ;
+    }
+    pBuffer->push_back(static_cast<char>(value)) ;
+}
+
+static void WriteSignedNumber(std::string* pBuffer, int64_t value)
+{
+    WriteNumber(pBuffer, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)) ;
+}
+
+static bool ReadNumber(char const*& pInput, char const* pEnd, uint64_t* pValue)
+{
+    uint64_t value = 0 ;
+    for (int shift = 0 ; shift < 64 && pInput < pEnd ; shift += 7)
+    {
+        unsigned char byte = static_cast<unsigned char>(*pInput++) ;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift ;
+
+        if ((byte & 0x80) == 0)
+        {
+            *pValue = value ;
+            return true ;
+        }
+    }
+    return false ;
+}
+
+static bool ReadSignedNumber(char const*& pInput, char const* pEnd, int64_t* pValue)
+{
+    uint64_t value = 0 ;
+    if (!ReadNumber(pInput, pEnd, &value))
+    {
+        return false ;
+    }
+    *pValue = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1) ;
+    return true ;
+}
+
+void InputBatch::Serialize(std::string* pBuffer) const
+{
+    size_t count = m_Ops.size() ;
+
+    pBuffer->push_back(static_cast<char>(kInputBatchVersion)) ;
+    WriteNumber(pBuffer, count) ;
+    pBuffer->append(reinterpret_cast<char const*>(m_Ops.data()), count) ;
+    WriteNumber(pBuffer, m_Strings.size()) ;
+    pBuffer->append(m_Strings) ;
+
+    for (size_t i = 0 ; i < count ; i++)
+    {
+        WriteSignedNumber(pBuffer, m_TimeTags[i]) ;
+
+        if (m_Ops[i] == kRemove)
+        {
+            continue ;
+        }
+
+        WriteNumber(pBuffer, m_Ids[i]) ;
+        WriteNumber(pBuffer, m_Attributes[i]) ;
+
+        if (m_Ops[i] == kAddInt)
+        {
+            WriteSignedNumber(pBuffer, m_Values[i]) ;
+        }
+        else if (m_Ops[i] == kAddDouble)
+        {
+            uint64_t bits = static_cast<uint64_t>(m_Values[i]) ;
+            for (int b = 0 ; b < 8 ; b++)
+            {
+                pBuffer->push_back(static_cast<char>(bits >> (b * 8))) ;
+            }
+        }
+        else
+        {
+            WriteNumber(pBuffer, static_cast<uint64_t>(m_Values[i])) ;
+        }
+    }
+}
+
+bool InputBatch::Deserialize(char const* pBuffer, size_t length)
+{
+    Clear() ;
+
+    if (!pBuffer || length < 1 || pBuffer[0] != kInputBatchVersion)
+    {
+        return false ;
+    }
+
+    char const* pInput = pBuffer + 1 ;
+    char const* pEnd = pBuffer + length ;
+
+    // Every change takes at least one byte for its op and one for its timetag,
+    // so a larger count than that is a bad buffer (and we shouldn't reserve for it).
+    uint64_t count = 0 ;
+    if (!ReadNumber(pInput, pEnd, &count) || count > static_cast<uint64_t>(pEnd - pInput) / 2)
+    {
+        return false ;
+    }
+
+    m_Ops.assign(reinterpret_cast<unsigned char const*>(pInput), reinterpret_cast<unsigned char const*>(pInput) + count) ;
+    pInput += count ;
+
+    uint64_t stringsLength = 0 ;
+    if (!ReadNumber(pInput, pEnd, &stringsLength) || stringsLength > static_cast<uint64_t>(pEnd - pInput))
+    {
+        Clear() ;
+        return false ;
+    }
+
+    // The last string must be terminated, so that every offset into the buffer is a valid string
+    if (stringsLength > 0 && pInput[stringsLength - 1] != '\0')
+    {
+        Clear() ;
+        return false ;
+    }
+    m_Strings.assign(pInput, static_cast<size_t>(stringsLength)) ;
+    pInput += stringsLength ;
+
+    m_TimeTags.reserve(count) ;
+    m_Ids.reserve(count) ;
+    m_Attributes.reserve(count) ;
+    m_Values.reserve(count) ;
+
+    bool ok = true ;
+    for (size_t i = 0 ; ok && i < count ; i++)
+    {
+        unsigned char op = m_Ops[i] ;
+        int64_t timeTag = 0 ;
+        uint64_t id = 0, attribute = 0 ;
+        int64_t value = 0 ;
+
+        ok = op < kNumberOps && ReadSignedNumber(pInput, pEnd, &timeTag) ;
+
+        if (ok && op != kRemove)
+        {
+            ok = ReadNumber(pInput, pEnd, &id) && id < stringsLength &&
+                 ReadNumber(pInput, pEnd, &attribute) && attribute < stringsLength ;
+
+            if (!ok)
+            {
+                break ;
+            }
+
+            if (op == kAddInt)
+            {
+                ok = ReadSignedNumber(pInput, pEnd, &value) ;
+            }
+            else if (op == kAddDouble)
+            {
+                ok = (pEnd - pInput) >= 8 ;
+                uint64_t bits = 0 ;
+                for (int b = 0 ; ok && b < 8 ; b++)
+                {
+                    bits |= static_cast<uint64_t>(static_cast<unsigned char>(*pInput++)) << (b * 8) ;
+                }
+                value = static_cast<int64_t>(bits) ;
+            }
+            else
+            {
+                uint64_t offset = 0 ;
+                ok = ReadNumber(pInput, pEnd, &offset) && offset < stringsLength ;
+                value = static_cast<int64_t>(offset) ;
+            }
+        }
+
+        m_TimeTags.push_back(timeTag) ;
+        m_Ids.push_back(static_cast<uint32_t>(id)) ;
+        m_Attributes.push_back(static_cast<uint32_t>(attribute)) ;
+        m_Values.push_back(value) ;
+    }
+
+    if (!ok || pInput != pEnd)
+    {
+        Clear() ;
+        return false ;
+    }
+
+    return true ;
+}
+
+void InputBatch::AddWmeTags(soarxml::ElementXML* pParent) const
+{
+    std::string value ;
+
+    for (size_t i = 0 ; i < GetSize() ; i++)
+    {
+        TagWme* pTag = new TagWme() ;
+        pTag->SetTimeTag(GetTimeTag(i)) ;
+
+        if (GetOp(i) == kRemove)
+        {
+            pTag->SetActionRemove() ;
+            pParent->AddChild(pTag) ;
+            continue ;
+        }
+
+        pTag->SetIdentifier(GetId(i)) ;
+        pTag->SetAttribute(GetAttribute(i)) ;
+
+        switch (GetOp(i))
+        {
+            case kAddInt:
+                pTag->SetValue(to_string(GetIntValue(i), value).c_str(), sml_Names::kTypeInt) ;
+                break ;
+            case kAddDouble:
+                pTag->SetValue(to_string(GetDoubleValue(i), value).c_str(), sml_Names::kTypeDouble) ;
+                break ;
+            case kAddId:
+                pTag->SetValue(GetStringValue(i), sml_Names::kTypeID) ;
+                break ;
+            default:
+                pTag->SetValue(GetStringValue(i), sml_Names::kTypeString) ;
+                break ;
+        }
+        pTag->SetActionAdd() ;
+        pParent->AddChild(pTag) ;
+    }
+}
@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////
+// InputBatch class
+//
+// Date  : October 2026
+//
+// Holds a list of changes to an agent's input link (adds and
+// removes of wmes) in columnar form: one array per field rather
+// than one object (or XML tag) per wme.  All strings share a single
+// buffer, so adding a change never allocates once the arrays have
+// grown to the size of a typical cycle's input.
+//
+// The client fills a batch between commits, and the kernel applies
+// a whole batch in one pass at the next input phase.  When the
+// batch has to cross a remote connection it is serialized into a
+// single binary block (see Serialize()) and carried as the
+// character data of one <wmes> tag.
+//
+/////////////////////////////////////////////////////////////////
+
+#ifndef SML_INPUT_BATCH_H
+#define SML_INPUT_BATCH_H
+
+#include "Export.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace soarxml
+{
+    class ElementXML ;
+}
+
+namespace sml
+{
+
+    class EXPORT InputBatch
+    {
+        public:
+            enum InputOp { kRemove = 0, kAddString, kAddInt, kAddDouble, kAddId, kNumberOps };
+
+        protected:
+            // The columns.  For removes the id, attribute and value entries are unused.
+            std::vector<unsigned char>  m_Ops ;
+            std::vector<int64_t>        m_TimeTags ;
+            std::vector<uint32_t>       m_Ids ;         // Offsets into m_Strings
+            std::vector<uint32_t>       m_Attributes ;  // Offsets into m_Strings
+            std::vector<int64_t>        m_Values ;      // An int, the bits of a double or an offset into m_Strings
+
+            // Every string in the batch, each one null terminated
+            std::string                 m_Strings ;
+
+            uint32_t AddString(char const* pString) ;
+            void AddWME(InputOp op, char const* pID, char const* pAttribute, int64_t value, int64_t timeTag) ;
+
+        public:
+            InputBatch() { }
+
+            void AddStringWME(char const* pID, char const* pAttribute, char const* pValue, int64_t timeTag)
+            {
+                AddWME(kAddString, pID, pAttribute, AddString(pValue), timeTag) ;
+            }
+            void AddIntWME(char const* pID, char const* pAttribute, int64_t value, int64_t timeTag)
+            {
+                AddWME(kAddInt, pID, pAttribute, value, timeTag) ;
+            }
+            void AddDoubleWME(char const* pID, char const* pAttribute, double value, int64_t timeTag) ;
+            void AddIdWME(char const* pID, char const* pAttribute, char const* pValueID, int64_t timeTag)
+            {
+                AddWME(kAddId, pID, pAttribute, AddString(pValueID), timeTag) ;
+            }
+            void RemoveWME(int64_t timeTag) ;
+
+            size_t GetSize() const
+            {
+                return m_Ops.size() ;
+            }
+            bool IsEmpty() const
+            {
+                return m_Ops.empty() ;
+            }
+
+            // Empties the batch but keeps the memory for reuse
+            void Clear() ;
+
+            InputOp GetOp(size_t i) const
+            {
+                return static_cast<InputOp>(m_Ops[i]) ;
+            }
+            int64_t GetTimeTag(size_t i) const
+            {
+                return m_TimeTags[i] ;
+            }
+            char const* GetId(size_t i) const
+            {
+                return m_Strings.c_str() + m_Ids[i] ;
+            }
+            char const* GetAttribute(size_t i) const
+            {
+                return m_Strings.c_str() + m_Attributes[i] ;
+            }
+
+            // The value of a kAddString or kAddId change
+            char const* GetStringValue(size_t i) const
+            {
+                return m_Strings.c_str() + m_Values[i] ;
+            }
+            int64_t GetIntValue(size_t i) const
+            {
+                return m_Values[i] ;
+            }
+            double GetDoubleValue(size_t i) const ;
+
+            /*************************************************************
+            * @brief Appends the batch to pBuffer in a compact binary form
+            *        (see sml_InputBatch.cpp for the layout).
+            *************************************************************/
+            void Serialize(std::string* pBuffer) const ;
+
+            /*************************************************************
+            * @brief Replaces the contents of this batch with a buffer
+            *        created by Serialize().
+            *
+            * @returns false (and leaves the batch empty) if the buffer
+            *          is not a valid batch.
+            *************************************************************/
+            bool Deserialize(char const* pBuffer, size_t length) ;
+
+            /*************************************************************
+            * @brief Adds one <wme> tag per change to pParent, the form
+            *        input took before batches.  Used for kernels that
+            *        can't read a batch and for xml-input-received listeners.
+            *************************************************************/
+            void AddWmeTags(soarxml::ElementXML* pParent) const ;
+    } ;
+
+} // End of namespace
+
+#endif // SML_INPUT_BATCH_H
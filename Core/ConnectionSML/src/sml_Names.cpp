@@ -27,6 +27,8 @@ char const* const sml_Names::kDocType_Response  = "response" ;
 char const* const sml_Names::kDocType_Notify    = "notify" ;
 char const* const sml_Names::kSMLVersion        = "smlversion" ;
 char const* const sml_Names::kOutputLinkName    = "output-link" ;
+char const* const sml_Names::kWireFormat        = "wireformat" ;
+char const* const sml_Names::kWireFormatBinary  = "binary" ;
 
 // Version strings
 char const* const sml_Names::kSoarVersionValue = VERSION_STRING();
@@ -138,6 +140,7 @@ char const* const sml_Names::kValueAdd      = "add" ;
 char const* const sml_Names::kValueRemove   = "remove" ;
 char const* const sml_Names::kTagWMERemove  = "removing_wme" ;
 char const* const sml_Names::kTagWMEAdd     = "adding_wme" ;
+char const* const sml_Names::kTagWMEBatch   = "wmes" ;
 
 // <preference> tag identifiers, also Watch level 5
 char const* const sml_Names::kTagPreference     = "preference" ;
@@ -426,6 +429,8 @@ char const* const sml_Names::kCommand_SuppressEvent         = "suppress_event" ;
 char const* const sml_Names::kCommand_CheckForIncomingCommands = "check_for_incoming_commands" ;
 char const* const sml_Names::kCommand_SetInterruptCheckRate = "set_interrupt_check_rate" ;
 char const* const sml_Names::kCommand_Shutdown              = "shutdown" ;
+char const* const sml_Names::kCommand_SetAgentMemoryPools   = "set_agent_memory_pools" ;
+char const* const sml_Names::kCommand_SetParallelRunThreads = "set_parallel_run_threads" ;
 char const* const sml_Names::kCommand_GetVersion            = "version" ;
 char const* const sml_Names::kCommand_IsSoarRunning         = "is_running" ;
 char const* const sml_Names::kCommand_GetConnections        = "get_connections" ;
@@ -441,6 +446,7 @@ char const* const sml_Names::kCommand_GetInitialTimeTag     = "initial_time_tag"
 char const* const sml_Names::kCommand_OutputInit            = "output_init" ;
 char const* const sml_Names::kCommand_ConvertIdentifier     = "convert_identifier";
 char const* const sml_Names::kCommand_GetListenerPort       = "get_listener_port";
+char const* const sml_Names::kCommand_GetInputBatchSupport  = "input_batch_support";
 
 // command line interface
 char const* const sml_Names::kCommand_CommandLine        = "cmdline" ;
@@ -29,6 +29,8 @@ namespace sml
             static char const* const kDocType_Notify ;
             static char const* const kSMLVersion ;
             static char const* const kOutputLinkName ;
+            static char const* const kWireFormat ;
+            static char const* const kWireFormatBinary ;
 
             static const char* const kSoarVersionValue;
             static const char* const kSMLVersionValue;
@@ -136,6 +138,7 @@ namespace sml
             static char const* const kValueRemove ;
             static char const* const kTagWMERemove ;
             static char const* const kTagWMEAdd ;
+            static char const* const kTagWMEBatch ;   // <wmes>, a batch of input changes (see sml_InputBatch.h)
 
             // <preference> tag identifiers, also Watch level 5
             static char const* const kTagPreference ;
@@ -416,6 +419,8 @@ namespace sml
             static char const* const kCommand_CheckForIncomingCommands ;
             static char const* const kCommand_SetInterruptCheckRate ;
             static char const* const kCommand_Shutdown ;
+            static char const* const kCommand_SetAgentMemoryPools ;
+            static char const* const kCommand_SetParallelRunThreads ;
             static char const* const kCommand_GetVersion ;
             static char const* const kCommand_IsSoarRunning ;
             static char const* const kCommand_GetConnections ;
@@ -431,6 +436,7 @@ namespace sml
             static char const* const kCommand_OutputInit ;
             static char const* const kCommand_ConvertIdentifier ;
             static char const* const kCommand_GetListenerPort ;
+            static char const* const kCommand_GetInputBatchSupport ;
 
             // Command line interface
             static char const* const kCommand_CommandLine ;
@@ -30,6 +30,7 @@ RemoteConnection::RemoteConnection(bool sharedFileSystem, sock::DataSender* pDat
     m_SharedFileSystem = sharedFileSystem ;
     m_DataSender = pDataSender ;
     m_pLastResponse = NULL ;
+    m_PeerAcceptsBinary = false ;
 }
 
 RemoteConnection::~RemoteConnection()
@@ -169,7 +170,8 @@ bool RemoteConnection::DoesResponseMatch(ElementXML* pResponse, char const* pID)
 * @brief Send a message to the other side of this connection.
 *
 * For an remote connection this is done by sending the command
-* over a socket as an actual XML string.
+* over a socket as an actual XML string, or as a binary buffer
+* once both sides have agreed to use the binary format.
 *
 * There is no immediate response because we have to wait for
 * the other side to read from the socket and execute the command.
@@ -180,28 +182,58 @@ void RemoteConnection::SendMsg(ElementXML* pMsg)
 {
     ClearError() ;
     
-    // Convert the message to an XML string
-    char* pXMLString = pMsg->GenerateXMLString(true) ;
+    bool ok ;
     
-    // Send it
-    bool ok = m_DataSender->SendString(pXMLString) ;
-    
-    // Dump the message if we're tracing
-    if (m_bTraceCommunications)
+    if (m_bAllowBinaryMessages && m_PeerAcceptsBinary)
     {
-        if (IsKernelSide())
+        // Convert the message to a binary buffer and send it
+        int length = 0 ;
+        char* pBuffer = pMsg->GenerateBinaryBuffer(&length) ;
+        
+        ok = m_DataSender->SendString(pBuffer, static_cast<uint32_t>(length)) ;
+        
+        pMsg->DeleteString(pBuffer) ;
+        
+        // Dump the message if we're tracing (the binary form isn't readable, so show the XML)
+        if (m_bTraceCommunications)
         {
-            sml::PrintDebugFormat("Kernel remote send: %s\n", pXMLString) ;
+            char* pXMLString = pMsg->GenerateXMLString(true) ;
+            sml::PrintDebugFormat("%s remote send (binary, %d bytes): %s\n", IsKernelSide() ? "Kernel" : "Client", length, pXMLString) ;
+            pMsg->DeleteString(pXMLString) ;
         }
-        else
+    }
+    else
+    {
+        // Let the other side know we can read binary messages.
+        // An older reader will just ignore the extra attribute.
+        if (m_bAllowBinaryMessages)
+        {
+            pMsg->AddAttribute(sml_Names::kWireFormat, sml_Names::kWireFormatBinary) ;
+        }
+        
+        // Convert the message to an XML string
+        char* pXMLString = pMsg->GenerateXMLString(true) ;
+        
+        // Send it
+        ok = m_DataSender->SendString(pXMLString) ;
+        
+        // Dump the message if we're tracing
+        if (m_bTraceCommunications)
         {
-            sml::PrintDebugFormat("Client remote send: %s\n", pXMLString) ;
+            if (IsKernelSide())
+            {
+                sml::PrintDebugFormat("Kernel remote send: %s\n", pXMLString) ;
+            }
+            else
+            {
+                sml::PrintDebugFormat("Client remote send: %s\n", pXMLString) ;
+            }
         }
+        
+        // Release the XML string
+        pMsg->DeleteString(pXMLString) ;
     }
     
-    // Release the XML string
-    pMsg->DeleteString(pXMLString) ;
-    
     // If we had an error close the connection
     if (!ok)
     {
@@ -353,22 +385,50 @@ bool RemoteConnection::ReceiveMessages(bool allMessages, int secondsWait, int mi
             return receivedMessage ;
         }
         
-        // Dump the message if we're tracing
-        if (m_bTraceCommunications)
+        ElementXML* pIncomingMsg = NULL ;
+        
+        if (ElementXML::IsBinaryBuffer(xmlString.data(), static_cast<int>(xmlString.size())))
         {
-            if (IsKernelSide())
+            // Get an XML message from the incoming binary buffer
+            pIncomingMsg = ElementXML::ParseBinaryBuffer(xmlString.data(), static_cast<int>(xmlString.size())) ;
+            
+            // Only a reader of binary messages would send us one
+            m_PeerAcceptsBinary = true ;
+            
+            // Dump the message if we're tracing (the binary form isn't readable, so show the XML)
+            if (m_bTraceCommunications && pIncomingMsg)
             {
-                sml::PrintDebugFormat("Kernel remote receive: %s\n", xmlString.c_str()) ;
+                char* pXMLString = pIncomingMsg->GenerateXMLString(true) ;
+                sml::PrintDebugFormat("%s remote receive (binary, %d bytes): %s\n", IsKernelSide() ? "Kernel" : "Client", static_cast<int>(xmlString.size()), pXMLString) ;
+                pIncomingMsg->DeleteString(pXMLString) ;
             }
-            else
+        }
+        else
+        {
+            // Dump the message if we're tracing
+            if (m_bTraceCommunications)
             {
-                sml::PrintDebugFormat("Client remote receive: %s\n", xmlString.c_str()) ;
+                if (IsKernelSide())
+                {
+                    sml::PrintDebugFormat("Kernel remote receive: %s\n", xmlString.c_str()) ;
+                }
+                else
+                {
+                    sml::PrintDebugFormat("Client remote receive: %s\n", xmlString.c_str()) ;
+                }
+            }
+            
+            // Get an XML message from the incoming string
+            pIncomingMsg = ElementXML::ParseXMLFromString(xmlString.c_str()) ;
+            
+            // See if the other side has said it can read binary messages
+            if (pIncomingMsg && !m_PeerAcceptsBinary)
+            {
+                char const* pWireFormat = pIncomingMsg->GetAttribute(sml_Names::kWireFormat) ;
+                m_PeerAcceptsBinary = (pWireFormat && strcmp(pWireFormat, sml_Names::kWireFormatBinary) == 0) ;
             }
         }
         
-        // Get an XML message from the incoming string
-        ElementXML* pIncomingMsg = ElementXML::ParseXMLFromString(xmlString.c_str()) ;
-        
         if (!pIncomingMsg)
         {
             this->SetError(Error::kParsingXMLError) ;
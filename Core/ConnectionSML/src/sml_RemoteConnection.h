@@ -44,6 +44,10 @@ namespace sml
             // breaking of existing code.
             bool m_SharedFileSystem ;
             
+            // True once the other side has told us it can read binary messages
+            // (either by sending us one or by adding the wire format attribute to an XML message).
+            bool m_PeerAcceptsBinary ;
+            
             /** We need to cache the responses to calls **/
             soarxml::ElementXML* m_pLastResponse ;
             
@@ -5,7 +5,7 @@
 using namespace sock ;
 
 /////////////////////////////////////////////////////////////////////
-// Function name  : DataSender::SendBuffer
+// Function name  : DataSender::SendString
 //
 // Return type    : bool
 // Argument       : char* String
@@ -17,8 +17,24 @@ using namespace sock ;
 /////////////////////////////////////////////////////////////////////
 bool DataSender::SendString(char const* pString)
 {
-    uint32_t len = static_cast<uint32_t>(strlen(pString));
-    
+    return SendString(pString, static_cast<uint32_t>(strlen(pString))) ;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Function name  : DataSender::SendString
+//
+// Return type    : bool
+// Argument       : char* pData
+// Argument       : uint32_t len
+//
+// Description    : Send a block of data to a socket.
+//                  The outgoing format on the socket will be
+//                  a 4-byte length followed by the data, so
+//                  the data may contain embedded nulls.
+//
+/////////////////////////////////////////////////////////////////////
+bool DataSender::SendString(char const* pData, uint32_t len)
+{
     // Convert the value into network byte ordering (so it's compatible if we send it
     // from a big-endian machine to a little endian one or vice-versa).
     uint32_t netLen = htonl(len) ;
@@ -27,20 +43,21 @@ bool DataSender::SendString(char const* pString)
     bool ok = SendBuffer(reinterpret_cast<const char*>(&netLen), sizeof(netLen)) ;
     
     // Now send the string of characters
-    ok = ok && SendBuffer(pString, len) ;
+    ok = ok && SendBuffer(pData, len) ;
     
     return ok ;
 }
 
 /////////////////////////////////////////////////////////////////////
-// Function name  : DataSender::SendBuffer
+// Function name  : DataSender::ReceiveString
 //
 // Return type    : bool
-// Argument       : char* String
+// Argument       : std::string* pString
 //
-// Description    : Send a string of data to a socket.
-//                  The outgoing format on the socket will be
+// Description    : Receive a string of data from a socket.
+//                  The incoming format on the socket will be
 //                  a 4-byte length followed by the string of characters.
+//                  The whole block is returned, even if it contains nulls.
 //
 /////////////////////////////////////////////////////////////////////
 bool DataSender::ReceiveString(std::string* pString)
@@ -57,29 +74,20 @@ bool DataSender::ReceiveString(std::string* pString)
     uint32_t len = ntohl(netLen) ;
     
     // If we got a zero length string.
-    if (len == 0)
+    if (len == 0 || !ok)
     {
         return ok ;
     }
     
-    // Create the buffer into which we'll receive data
-    char* buffer = new char[len + 1] ;
-    
-    // Receive the string
-    ok = ok && ReceiveBuffer(buffer, len) ;
+    // Receive straight into the string (which keeps its own trailing null)
+    pString->resize(len) ;
+    ok = ReceiveBuffer(&(*pString)[0], len) ;
     
-    // Make it null terminated
-    buffer[len] = 0 ;
-    
-    // Return the result in the string
-    if (ok)
+    if (!ok)
     {
-        pString->assign(buffer) ;
+        pString->clear() ;
     }
     
-    // Release our temp buffer
-    delete [] buffer ;
-    
     return ok ;
 }
 
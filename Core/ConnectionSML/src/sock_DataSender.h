@@ -80,7 +80,11 @@ namespace sock
             // Send a string of characters.  Outgoing format will be "<4-byte length>"+string data
             bool        SendString(char const* pString) ;
             
+            // Send a block of data, which may contain nulls.  Outgoing format is the same as SendString.
+            bool        SendString(char const* pData, uint32_t length) ;
+            
             // Receive a string of characters.  Incoming format on socket should be "<4-byte length>"+string data
+            // The string holds all of the data that was sent, including any embedded nulls.
             bool        ReceiveString(std::string* pString) ;
             
         protected:
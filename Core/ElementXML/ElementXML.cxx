@@ -1,3 +1,4 @@
+#include "src/BinaryXML.cpp"
 #include "src/ElementXMLInterface.cpp"
 #include "src/ElementXMLImpl.cpp"
 #include "src/ParseXML.cpp"
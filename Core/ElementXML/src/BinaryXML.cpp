@@ -0,0 +1,399 @@
+#include "portability.h"
+
+/////////////////////////////////////////////////////////////////
+// BinaryXML class
+//
+// Date  : October 2026
+//
+// This class converts an ElementXMLImpl tree to and from a compact
+// binary buffer.  See BinaryXML.h for the layout of the buffer.
+//
+/////////////////////////////////////////////////////////////////
+
+#include "BinaryXML.h"
+
+using namespace soarxml ;
+
+BinaryXML::BinaryXML()
+{
+    m_pInput    = NULL ;
+    m_pInputEnd = NULL ;
+    m_Error     = false ;
+}
+
+void BinaryXML::SetError(char const* pMsg)
+{
+    // Only record the first error
+    if (!m_Error)
+    {
+        m_Error = true ;
+        m_ErrorMsg = pMsg ;
+    }
+}
+
+////////////////////////////////////////////////////////////////
+//
+// Generator
+//
+////////////////////////////////////////////////////////////////
+
+void BinaryXML::WriteNumber(unsigned int value)
+{
+    while (value >= 0x80)
+    {
+        m_Buffer.push_back(static_cast<char>((value & 0x7F) | 0x80)) ;
+        value >>= 7 ;
+    }
+    m_Buffer.push_back(static_cast<char>(value)) ;
+}
+
+void BinaryXML::WriteBytes(char const* pBytes, unsigned int length)
+{
+    WriteNumber(length) ;
+    m_Buffer.append(pBytes, length) ;
+}
+
+void BinaryXML::WriteName(xmlStringConst pName)
+{
+    if (!pName)
+    {
+        WriteNumber(kNameNone) ;
+        return ;
+    }
+
+    NameIndexMap::iterator iter = m_NameIndex.find(pName) ;
+    if (iter != m_NameIndex.end())
+    {
+        WriteNumber(kNameFirstIndex + iter->second) ;
+        return ;
+    }
+
+    // The map only stores the pointer, which stays valid until we're done generating.
+    unsigned int index = static_cast<unsigned int>(m_NameIndex.size()) ;
+    m_NameIndex[pName] = index ;
+
+    WriteNumber(kNameNew) ;
+    WriteBytes(pName, static_cast<unsigned int>(strlen(pName))) ;
+}
+
+void BinaryXML::WriteElement(ElementXMLImpl const* pXML)
+{
+    WriteName(pXML->m_TagName) ;
+
+    unsigned char flags = 0 ;
+    if (pXML->m_UseCData)
+    {
+        flags |= kFlagUseCData ;
+    }
+    if (pXML->m_DataIsBinary)
+    {
+        flags |= kFlagBinaryData ;
+    }
+    if (pXML->m_CharacterData)
+    {
+        flags |= kFlagHasData ;
+    }
+    if (pXML->m_Comment)
+    {
+        flags |= kFlagHasComment ;
+    }
+    m_Buffer.push_back(static_cast<char>(flags)) ;
+
+    if (pXML->m_Comment)
+    {
+        WriteBytes(pXML->m_Comment, static_cast<unsigned int>(strlen(pXML->m_Comment))) ;
+    }
+
+    if (pXML->m_CharacterData)
+    {
+        unsigned int length = pXML->m_DataIsBinary ? pXML->m_BinaryDataLength : static_cast<unsigned int>(strlen(pXML->m_CharacterData)) ;
+        WriteBytes(pXML->m_CharacterData, length) ;
+    }
+
+    WriteNumber(static_cast<unsigned int>(pXML->m_AttributeMap.size())) ;
+    for (xmlAttributeMapConstIter mapIter = pXML->m_AttributeMap.begin() ; mapIter != pXML->m_AttributeMap.end() ; mapIter++)
+    {
+        WriteName(mapIter->first) ;
+        WriteBytes(mapIter->second, static_cast<unsigned int>(strlen(mapIter->second))) ;
+    }
+
+    WriteNumber(static_cast<unsigned int>(pXML->m_Children.size())) ;
+    for (xmlListConstIter iterChildren = pXML->m_Children.begin() ; iterChildren != pXML->m_Children.end() ; iterChildren++)
+    {
+        WriteElement(*iterChildren) ;
+    }
+}
+
+char* BinaryXML::Generate(ElementXMLImpl const* pXML, int* pLength)
+{
+    m_Buffer.clear() ;
+    m_NameIndex.clear() ;
+
+    m_Buffer.push_back(static_cast<char>(kBinaryXMLMarker)) ;
+    m_Buffer.push_back(static_cast<char>(kBinaryXMLVersion)) ;
+
+    WriteElement(pXML) ;
+
+    int length = static_cast<int>(m_Buffer.size()) ;
+    char* pBuffer = ElementXMLImpl::AllocateString(length) ;
+    memcpy(pBuffer, m_Buffer.data(), length) ;
+    pBuffer[length] = NUL ;
+
+    *pLength = length ;
+    return pBuffer ;
+}
+
+////////////////////////////////////////////////////////////////
+//
+// Parser
+//
+////////////////////////////////////////////////////////////////
+
+bool BinaryXML::ReadNumber(unsigned int* pValue)
+{
+    unsigned int value = 0 ;
+    for (int shift = 0 ; shift < 35 ; shift += 7)
+    {
+        if (m_pInput >= m_pInputEnd)
+        {
+            SetError("Binary XML buffer ended in the middle of a number") ;
+            return false ;
+        }
+
+        unsigned char byte = static_cast<unsigned char>(*m_pInput++) ;
+        value |= static_cast<unsigned int>(byte & 0x7F) << shift ;
+
+        if ((byte & 0x80) == 0)
+        {
+            *pValue = value ;
+            return true ;
+        }
+    }
+
+    SetError("Binary XML buffer contains a number that is too large") ;
+    return false ;
+}
+
+bool BinaryXML::ReadBytes(unsigned int length, char const** pBytes)
+{
+    if (static_cast<size_t>(m_pInputEnd - m_pInput) < length)
+    {
+        SetError("Binary XML buffer ended in the middle of a string") ;
+        return false ;
+    }
+
+    *pBytes = m_pInput ;
+    m_pInput += length ;
+    return true ;
+}
+
+/*************************************************************
+* @brief Reads a length prefixed string and returns a copy of it
+*        allocated with AllocateString(), or NULL on error.
+*
+*        Character strings are null terminated.  Binary data is
+*        copied exactly, and pLength is set to its length.
+*************************************************************/
+char* BinaryXML::ReadString(bool binary, int* pLength)
+{
+    unsigned int length = 0 ;
+    char const* pBytes = NULL ;
+
+    if (!ReadNumber(&length) || !ReadBytes(length, &pBytes))
+    {
+        return NULL ;
+    }
+
+    char* pString = ElementXMLImpl::AllocateString(length) ;
+    memcpy(pString, pBytes, length) ;
+    pString[length] = NUL ;
+
+    if (binary && pLength)
+    {
+        *pLength = static_cast<int>(length) ;
+    }
+    return pString ;
+}
+
+/*************************************************************
+* @brief Reads a tag or attribute name.
+*
+*        The name returned is owned by this parser and is only
+*        valid until the next call, so callers copy it right away.
+*************************************************************/
+bool BinaryXML::ReadName(char const** pName)
+{
+    unsigned int code = 0 ;
+    if (!ReadNumber(&code))
+    {
+        return false ;
+    }
+
+    if (code == kNameNone)
+    {
+        *pName = NULL ;
+        return true ;
+    }
+
+    if (code == kNameNew)
+    {
+        unsigned int length = 0 ;
+        char const* pBytes = NULL ;
+        if (!ReadNumber(&length) || !ReadBytes(length, &pBytes))
+        {
+            return false ;
+        }
+        m_Names.push_back(std::string(pBytes, length)) ;
+        *pName = m_Names.back().c_str() ;
+        return true ;
+    }
+
+    unsigned int index = code - kNameFirstIndex ;
+    if (index >= m_Names.size())
+    {
+        SetError("Binary XML buffer refers to a name that has not been sent") ;
+        return false ;
+    }
+
+    *pName = m_Names[index].c_str() ;
+    return true ;
+}
+
+ElementXMLImpl* BinaryXML::ReadElement()
+{
+    ElementXMLImpl* pXML = new ElementXMLImpl() ;
+
+    char const* pTagName = NULL ;
+    if (!ReadName(&pTagName))
+    {
+        pXML->ReleaseRef() ;
+        return NULL ;
+    }
+    if (pTagName)
+    {
+        pXML->SetTagName(pTagName) ;
+    }
+
+    if (m_pInput >= m_pInputEnd)
+    {
+        SetError("Binary XML buffer ended before an element's flags") ;
+        pXML->ReleaseRef() ;
+        return NULL ;
+    }
+    unsigned char flags = static_cast<unsigned char>(*m_pInput++) ;
+
+    pXML->SetUseCData((flags & kFlagUseCData) != 0) ;
+
+    if (flags & kFlagHasComment)
+    {
+        char* pComment = ReadString(false, NULL) ;
+        if (!pComment)
+        {
+            pXML->ReleaseRef() ;
+            return NULL ;
+        }
+        // SetComment() makes its own copy
+        pXML->SetComment(pComment) ;
+        ElementXMLImpl::DeleteString(pComment) ;
+    }
+
+    if (flags & kFlagHasData)
+    {
+        bool binary = (flags & kFlagBinaryData) != 0 ;
+        int length = 0 ;
+        char* pData = ReadString(binary, &length) ;
+        if (!pData)
+        {
+            pXML->ReleaseRef() ;
+            return NULL ;
+        }
+
+        if (binary)
+        {
+            pXML->SetBinaryCharacterData(pData, length, false) ;
+        }
+        else
+        {
+            pXML->SetCharacterData(pData, false) ;
+        }
+    }
+
+    unsigned int numberAttributes = 0 ;
+    if (!ReadNumber(&numberAttributes))
+    {
+        pXML->ReleaseRef() ;
+        return NULL ;
+    }
+    for (unsigned int i = 0 ; i < numberAttributes ; i++)
+    {
+        char const* pName = NULL ;
+        if (!ReadName(&pName) || !pName)
+        {
+            SetError("Binary XML buffer contains an attribute without a name") ;
+            pXML->ReleaseRef() ;
+            return NULL ;
+        }
+
+        char* pValue = ReadString(false, NULL) ;
+        if (!pValue)
+        {
+            pXML->ReleaseRef() ;
+            return NULL ;
+        }
+
+        // We take ownership of the value and make a copy of the (interned) name.
+        pXML->AddAttribute(ElementXMLImpl::CopyString(pName), pValue, false, false) ;
+    }
+
+    unsigned int numberChildren = 0 ;
+    if (!ReadNumber(&numberChildren))
+    {
+        pXML->ReleaseRef() ;
+        return NULL ;
+    }
+    for (unsigned int i = 0 ; i < numberChildren ; i++)
+    {
+        ElementXMLImpl* pChild = ReadElement() ;
+        if (!pChild)
+        {
+            pXML->ReleaseRef() ;
+            return NULL ;
+        }
+        pXML->AddChild(pChild) ;
+    }
+
+    return pXML ;
+}
+
+ElementXMLImpl* BinaryXML::Parse(char const* pBuffer, int length)
+{
+    m_Names.clear() ;
+    m_Error = false ;
+    m_ErrorMsg.clear() ;
+
+    if (!IsBinaryBuffer(pBuffer, length))
+    {
+        SetError("Buffer does not contain binary XML") ;
+        return NULL ;
+    }
+
+    if (pBuffer[1] != kBinaryXMLVersion)
+    {
+        SetError("Binary XML buffer has an unknown version") ;
+        return NULL ;
+    }
+
+    m_pInput    = pBuffer + 2 ;
+    m_pInputEnd = pBuffer + length ;
+
+    ElementXMLImpl* pXML = ReadElement() ;
+
+    if (pXML && m_pInput != m_pInputEnd)
+    {
+        SetError("Binary XML buffer has extra data after the root element") ;
+        pXML->ReleaseRef() ;
+        pXML = NULL ;
+    }
+
+    return pXML ;
+}
@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////////
+// BinaryXML class
+//
+// Date  : October 2026
+//
+// This class converts an ElementXMLImpl tree to and from a compact
+// binary buffer.  It is an alternative to generating and parsing
+// XML text when both ends of a connection are ElementXML libraries,
+// so there is no escaping, no tokenizing and no searching for end tags.
+//
+// Layout of a buffer (all counts and lengths are unsigned LEB128 varints):
+//
+//   header    : kBinaryXMLMarker kBinaryXMLVersion
+//   element   : name flags [comment] [data] #attributes (name string)* #children element*
+//   string    : length bytes               (no trailing null)
+//   data      : length bytes               (binary data may contain nulls)
+//   name      : 0                          (no name)
+//             | 1 string                   (a name we haven't seen yet in this buffer)
+//             | 2 + index                  (the index-th name sent earlier in this buffer)
+//   flags     : kFlagUseCData | kFlagBinaryData | kFlagHasData | kFlagHasComment
+//
+// Tag and attribute names are interned per buffer, so the repeated
+// names in an SML message (e.g. "wme", "id", "attr", "value") are only
+// sent once.
+//
+// The buffer always starts with a null byte, which can never start an
+// XML document, so a receiver can tell the two formats apart.
+//
+/////////////////////////////////////////////////////////////////
+
+#ifndef BINARY_XML_H
+#define BINARY_XML_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "ElementXMLImpl.h"
+
+namespace soarxml
+{
+
+#define kBinaryXMLMarker    0
+#define kBinaryXMLVersion   1
+
+    class BinaryXML
+    {
+        protected:
+            enum { kFlagUseCData = 1, kFlagBinaryData = 2, kFlagHasData = 4, kFlagHasComment = 8 } ;
+            enum { kNameNone = 0, kNameNew = 1, kNameFirstIndex = 2 } ;
+
+            typedef std::map<xmlStringConst, unsigned int, strCompareElementXMLImpl> NameIndexMap ;
+
+            // Used while generating a buffer
+            std::string         m_Buffer ;
+            NameIndexMap        m_NameIndex ;
+
+            // Used while parsing a buffer
+            char const*         m_pInput ;
+            char const*         m_pInputEnd ;
+            std::vector<std::string> m_Names ;
+
+            bool                m_Error ;
+            std::string         m_ErrorMsg ;
+
+            void WriteNumber(unsigned int value) ;
+            void WriteBytes(char const* pBytes, unsigned int length) ;
+            void WriteName(xmlStringConst pName) ;
+            void WriteElement(ElementXMLImpl const* pXML) ;
+
+            bool ReadNumber(unsigned int* pValue) ;
+            bool ReadBytes(unsigned int length, char const** pBytes) ;
+            char* ReadString(bool binary, int* pLength) ;
+            bool ReadName(char const** pName) ;
+            ElementXMLImpl* ReadElement() ;
+
+            void SetError(char const* pMsg) ;
+
+        public:
+            BinaryXML() ;
+
+            /*************************************************************
+            * @brief Converts the XML object (and all of its children) to a binary buffer.
+            *
+            * @param pXML       The root of the tree to convert.
+            * @param pLength    Set to the length of the buffer that is returned.
+            * @returns The buffer.  Caller must delete it with ElementXMLImpl::DeleteString().
+            *************************************************************/
+            char* Generate(ElementXMLImpl const* pXML, int* pLength) ;
+
+            /*************************************************************
+            * @brief Builds an XML object from a buffer created by Generate().
+            *
+            * @returns NULL if the buffer is not valid (see GetErrorMessage()).
+            *************************************************************/
+            ElementXMLImpl* Parse(char const* pBuffer, int length) ;
+
+            std::string GetErrorMessage()
+            {
+                return m_ErrorMsg ;
+            }
+
+            /*************************************************************
+            * @brief Returns true if the buffer holds a binary XML object
+            *        rather than XML text.
+            *************************************************************/
+            static bool IsBinaryBuffer(char const* pBuffer, int length)
+            {
+                return pBuffer && length >= 2 && pBuffer[0] == kBinaryXMLMarker ;
+            }
+    };
+
+}   // namespace
+
+#endif // BINARY_XML_H
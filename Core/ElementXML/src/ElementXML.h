@@ -667,6 +667,20 @@ namespace soarxml
                 return ::soarxml_DetermineXMLStringLength(m_hXML, includeChildren, insertNewLines) ;
             }
             
+            /*************************************************************
+            * @brief Converts the XML object (and all of its children) to a compact binary buffer.
+            *        This is faster to generate and parse than XML text, but can only be read
+            *        back by ParseBinaryBuffer().
+            *
+            * @param pLength    Set to the length of the buffer (which can contain embedded nulls).
+            *
+            * @returns The buffer.  Caller must delete with DeleteString().
+            *************************************************************/
+            char* GenerateBinaryBuffer(int* pLength) const
+            {
+                return ::soarxml_GenerateBinaryBuffer(m_hXML, pLength) ;
+            }
+            
             ////////////////////////////////////////////////////////////////
             //
             // String and memory functions
@@ -788,6 +802,35 @@ namespace soarxml
                 return new ElementXML(hXML) ;
             }
             
+            /*************************************************************
+            * @brief Builds an ElementXML object from a buffer created by
+            *        GenerateBinaryBuffer().
+            *
+            * @param  pBuffer   The buffer.
+            * @param  length    The length of the buffer.
+            * @returns NULL if parsing failed, otherwise the ElementXML representing XML doc
+            *************************************************************/
+            static ElementXML* ParseBinaryBuffer(char const* pBuffer, int length)
+            {
+                ElementXML_Handle hXML = ::soarxml_ParseBinaryBuffer(pBuffer, length) ;
+                
+                if (!hXML)
+                {
+                    return NULL ;
+                }
+                
+                return new ElementXML(hXML) ;
+            }
+            
+            /*************************************************************
+            * @brief Returns true if the buffer was created by GenerateBinaryBuffer()
+            *        (rather than being XML text).
+            *************************************************************/
+            static bool IsBinaryBuffer(char const* pBuffer, int length)
+            {
+                return ::soarxml_IsBinaryBuffer(pBuffer, length) ;
+            }
+            
             /*************************************************************
             * @brief Returns an error message describing reason for error in last parse.
             *
@@ -48,6 +48,7 @@ namespace soarxml
 // Forward declarations
     class ElementXMLImpl ;
     class MessageGenerator ;
+    class BinaryXML ;
     
 // Used to store a list of ElementXMLImpl nodes (use a vector for rapid index access)
     typedef std::vector<ElementXMLImpl*>    xmlList ;
@@ -87,6 +88,9 @@ namespace soarxml
             // Let MessageGenerator have access to Fast methods (which are protected because they take care to use correctly).
             friend class MessageGenerator ;
             
+            // BinaryXML reads and writes the fields directly when converting to and from binary buffers.
+            friend class BinaryXML ;
+            
         protected:
             int             m_ErrorCode ;       // Used to report any errors.
             bool            m_UseCData ;        // If true, should store character data in a CDATA section when encoding as XML.
@@ -22,6 +22,7 @@
 
 #include "ElementXMLInterface.h"
 #include "ElementXMLImpl.h"
+#include "BinaryXML.h"
 #include "ParseXMLFile.h"
 #include "ParseXMLString.h"
 
@@ -423,6 +424,19 @@ int soarxml_DetermineXMLStringLength(ElementXML_Handle const hXML, bool includeC
     return GetElementFromHandle(hXML)->DetermineXMLStringLength(0, includeChildren, insertNewLines);
 }
 
+/*************************************************************
+* @brief Converts the XML object (and all of its children) to a compact binary buffer.
+*
+* @param pLength    Set to the length of the buffer (which can contain embedded nulls).
+*
+* @returns The buffer.  Caller must delete with DeleteString().
+*************************************************************/
+char* soarxml_GenerateBinaryBuffer(ElementXML_Handle const hXML, int* pLength)
+{
+    BinaryXML generator ;
+    return generator.Generate(GetElementFromHandle(hXML), pLength) ;
+}
+
 ////////////////////////////////////////////////////////////////
 //
 // String and memory functions
@@ -630,6 +644,36 @@ ElementXML_Handle soarxml_ParseXMLFromFile(char const* pFilename)
     return reinterpret_cast<ElementXML_Handle>(pXML) ;
 }
 
+/*************************************************************
+* @brief Builds an ElementXML object from a buffer created by
+*        soarxml_GenerateBinaryBuffer().
+*
+* @param  pBuffer   The buffer.
+* @param  length    The length of the buffer.
+* @returns NULL if parsing failed, otherwise the ElementXML representing XML doc
+*************************************************************/
+ElementXML_Handle soarxml_ParseBinaryBuffer(char const* pBuffer, int length)
+{
+    BinaryXML parser ;
+    ElementXMLImpl* pXML = parser.Parse(pBuffer, length) ;
+    
+    if (!pXML)
+    {
+        s_LastParseErrorMessage = parser.GetErrorMessage() ;
+    }
+    
+    return reinterpret_cast<ElementXML_Handle>(pXML) ;
+}
+
+/*************************************************************
+* @brief Returns true if the buffer was created by soarxml_GenerateBinaryBuffer()
+*        (rather than being XML text).
+*************************************************************/
+bool soarxml_IsBinaryBuffer(char const* pBuffer, int length)
+{
+    return BinaryXML::IsBinaryBuffer(pBuffer, length) ;
+}
+
 /*************************************************************
 * @brief Returns an error message describing reason for error in last parse.
 *
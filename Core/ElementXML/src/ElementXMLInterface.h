@@ -343,6 +343,17 @@ EXPORT char* soarxml_GenerateXMLString(ElementXML_Handle const hXML, bool includ
 *************************************************************/
 EXPORT int soarxml_DetermineXMLStringLength(ElementXML_Handle const hXML, bool includeChildren, bool insertNewLines) ;
 
+/*************************************************************
+* @brief Converts the XML object (and all of its children) to a compact binary buffer.
+*        This is faster to generate and parse than XML text, but can only be read
+*        back by soarxml_ParseBinaryBuffer().
+*
+* @param pLength    Set to the length of the buffer (which can contain embedded nulls).
+*
+* @returns The buffer.  Caller must delete with DeleteString().
+*************************************************************/
+EXPORT char* soarxml_GenerateBinaryBuffer(ElementXML_Handle const hXML, int* pLength) ;
+
 ////////////////////////////////////////////////////////////////
 //
 // String and memory functions
@@ -468,6 +479,22 @@ EXPORT ElementXML_Handle soarxml_ParseXMLFromStringSequence(char const* pString,
 *************************************************************/
 EXPORT ElementXML_Handle soarxml_ParseXMLFromFile(char const* pFilename) ;
 
+/*************************************************************
+* @brief Builds an ElementXML object from a buffer created by
+*        soarxml_GenerateBinaryBuffer().
+*
+* @param  pBuffer   The buffer.
+* @param  length    The length of the buffer.
+* @returns NULL if parsing failed, otherwise the ElementXML representing XML doc
+*************************************************************/
+EXPORT ElementXML_Handle soarxml_ParseBinaryBuffer(char const* pBuffer, int length) ;
+
+/*************************************************************
+* @brief Returns true if the buffer was created by soarxml_GenerateBinaryBuffer()
+*        (rather than being XML text).
+*************************************************************/
+EXPORT bool soarxml_IsBinaryBuffer(char const* pBuffer, int length) ;
+
 /*************************************************************
 * @brief Returns an error message describing reason for error in last parse.
 *
@@ -17,6 +17,7 @@
 #include "src/sml_RhsListener.cpp"
 #include "src/sml_RunListener.cpp"
 #include "src/sml_RunScheduler.cpp"
+#include "src/sml_RunWorker.cpp"
 #include "src/sml_StringListener.cpp"
 #include "src/sml_SystemListener.cpp"
 #include "src/sml_UpdateListener.cpp"
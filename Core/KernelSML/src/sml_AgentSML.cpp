@@ -23,6 +23,7 @@
 #include "decide.h"
 #include "decider.h"
 #include "io_link.h"
+#include "memory_manager.h"
 #include "output_manager.h"
 #include "rhs_functions.h"
 #include "soar_rand.h"
@@ -78,6 +79,8 @@ void AgentSML::InitListeners()
 // Can't call this until after the Soar agent has been initialized
 void AgentSML::Init()
 {
+    Agent_MPM_Scope lMPMScope(m_agent->memoryManager);
+
     // Temporary HACK.  This should be fixed in the kernel.
     m_agent->stop_soar = false;
 
@@ -204,10 +207,9 @@ void AgentSML::ReleaseAllWmes(bool flushPendingRemoves)
     }
 
     m_PendingInput.clear() ;
-    m_DirectInputDeltaList.clear() ;
+    m_DirectInputBatch.Clear() ;
     m_ToClientIdentifierMap.clear() ;
     m_IdentifierMap.clear() ;
-    m_IdentifierRefMap.clear() ;
 
 #ifdef DEBUG_UPDATE
     sml::PrintDebugFormat("****************************************************") ;
@@ -256,6 +258,8 @@ void AgentSML::ResetCaptureReplay()
 
 bool AgentSML::Reinitialize()
 {
+    Agent_MPM_Scope lMPMScope(m_agent->memoryManager);
+
     m_pKernelSML->FireAgentEvent(this, smlEVENT_BEFORE_AGENT_REINITIALIZED) ;
 
     reinitialize_soar(m_agent);
@@ -494,6 +498,9 @@ static bool maxStepsReached(uint64_t steps, uint64_t maxSteps)
 
 smlRunResult AgentSML::Step(smlRunStepSize stepSize)
 {
+    // Anything the agent allocates while stepping comes from its own pools when it owns them
+    Agent_MPM_Scope lMPMScope(m_agent->memoryManager);
+
     // This method runs a single agent
     uint64_t count = 1 ;
     uint64_t startCount        = GetRunCounter(stepSize) ; // getReleventCounter(stepSize);
@@ -662,112 +669,143 @@ void AgentSML::ScheduleAgentToRun(bool state)
     }
 }
 
+bool AgentSML::EncodeIdentifier(char const* pID, IdentifierKey* pKey)
+{
+    if (pID == NULL || !isalpha(static_cast<unsigned char>(pID[0])) || pID[1] == 0)
+    {
+        return false ;
+    }
+
+    uint64_t number = 0 ;
+    for (char const* p = pID + 1 ; *p ; p++)
+    {
+        if (!isdigit(static_cast<unsigned char>(*p)))
+        {
+            return false ;
+        }
+
+        number = number * 10 + static_cast<uint64_t>(*p - '0') ;
+
+        // The number has to fit below the letter
+        if (number > GetIdentifierNumber(~static_cast<IdentifierKey>(0)))
+        {
+            return false ;
+        }
+    }
+
+    *pKey = EncodeIdentifier(pID[0], number) ;
+    return true ;
+}
+
 /*************************************************************
 * @brief    Converts an id from a client side value to a kernel side value.
 *           We need to be able to do this because the client is adding a collection
 *           of wmes at once, so it makes up the ids for those objects.
 *           But the kernel will assign them a different value when the
 *           wme is actually added in the kernel.
+*
+*           If there is no mapping we return false and set pKernelID to
+*           the id we were passed (or 0 if it isn't a valid identifier).
 *************************************************************/
-bool AgentSML::ConvertID(char const* pClientID, std::string* pKernelID)
+bool AgentSML::ConvertID(char const* pClientID, IdentifierKey* pKernelID)
 {
-    if (pClientID == NULL)
+    IdentifierKey clientKey = 0 ;
+    if (!EncodeIdentifier(pClientID, &clientKey))
     {
+        *pKernelID = 0 ;
         return false ;
     }
 
-    IdentifierMapIter iter = m_IdentifierMap.find(pClientID) ;
+    IdentifierMapIter iter = m_IdentifierMap.find(clientKey) ;
 
     if (iter == m_IdentifierMap.end())
     {
         // If the client id is not in the map, then we may have been
         // passed a kernel id (this will happen at times).
         // So return the value we were passed
-        *pKernelID = pClientID ;
+        *pKernelID = clientKey ;
         return false ;
     }
-    else
+
+    // If we found a mapping, return the mapped value
+    *pKernelID = iter->second.kernelID ;
+    return true ;
+}
+
+bool AgentSML::ConvertID(char const* pClientID, std::string* pKernelID)
+{
+    if (pClientID == NULL)
     {
-        // If we found a mapping, return the mapped value
-        *pKernelID = iter->second ;
-        return true ;
+        return false ;
+    }
+
+    IdentifierKey kernelKey = 0 ;
+    if (!ConvertID(pClientID, &kernelKey))
+    {
+        *pKernelID = pClientID ;
+        return false ;
     }
+
+    std::ostringstream buffer ;
+    buffer << GetIdentifierLetter(kernelKey) << GetIdentifierNumber(kernelKey) ;
+    *pKernelID = buffer.str() ;
+    return true ;
 }
 
-void AgentSML::RecordIDMapping(char const* pClientID, char const* pKernelID)
+void AgentSML::RecordIDMapping(char const* pClientID, char kernelLetter, uint64_t kernelNumber)
 {
+    IdentifierKey clientKey = 0 ;
+    if (!EncodeIdentifier(pClientID, &clientKey))
+    {
+        return ;
+    }
+
     // Do we already have a mapping?
-    IdentifierMapIter iter = m_IdentifierMap.find(pClientID);
+    IdentifierMapIter iter = m_IdentifierMap.find(clientKey);
 
     if (iter == m_IdentifierMap.end())
     {
-        // We don't, create a mapping, this indicates a reference count of 1
-        m_IdentifierMap[pClientID] = pKernelID ;
+        // We don't, create a mapping with a reference count of 1
+        IdentifierKey kernelKey = EncodeIdentifier(kernelLetter, kernelNumber) ;
+        IdentifierMapping& mapping = m_IdentifierMap[clientKey] ;
+        mapping.kernelID = kernelKey ;
+        mapping.refCount = 1 ;
 
         // Record in both directions, so we can clean up (at which time we only know the kernel side ID).
-        m_ToClientIdentifierMap[pKernelID] = pClientID ;
-
-        // Note that we leave the entry out of m_IdentifierRefMap, we only use
-        // that for counts of two or greater
+        m_ToClientIdentifierMap[kernelKey] = clientKey ;
     }
     else
     {
-        // The mapping already exists, so we need to check and see if we have a reference
-        // count for it yet
-        IdentifierRefMapIter iter = m_IdentifierRefMap.find(pClientID);
-        if (iter == m_IdentifierRefMap.end())
-        {
-            // there is no reference count and this is the second reference, so set it to two
-            m_IdentifierRefMap[pClientID] = 2 ;
-        }
-        else
-        {
-            // there is a reference count, increment it
-            iter->second += 1;
-        }
+        // The mapping already exists, so this is a shared id
+        iter->second.refCount += 1 ;
     }
 }
 
-void AgentSML::RemoveID(char const* pKernelID)
+void AgentSML::RemoveID(char kernelLetter, uint64_t kernelNumber)
 {
     // first, find the identifer
-    IdentifierMapIter iter = m_ToClientIdentifierMap.find(pKernelID) ;
+    ToClientIdentifierMapIter iter = m_ToClientIdentifierMap.find(EncodeIdentifier(kernelLetter, kernelNumber)) ;
 
-    // This identifier should have been in the table
-    // Note: sometimes this is called by gSKI when it is removing wmes. gSKI doesn't know if
-    // we're a direct connection and therefore aren't using this map, so in that case we need to not
-    // update this. Therefore, we can't assert here.
-    //assert (iter != m_ToClientIdentifierMap.end()) ;
+    // Note: sometimes this is called when removing wmes that weren't added through
+    // this map (e.g. on a direct connection), so we can't assert here.
     if (iter == m_ToClientIdentifierMap.end())
     {
         return ;
     }
 
-    // cache the identifer value
-    std::string& clientID = iter->second ;
-
-    // decrement the reference count and remove the identifier from the maps if it is there
-    IdentifierRefMapIter refIter = m_IdentifierRefMap.find(clientID);
-    if (refIter == m_IdentifierRefMap.end())
+    IdentifierMapIter clientIter = m_IdentifierMap.find(iter->second) ;
+    if (clientIter == m_IdentifierMap.end() || clientIter->second.refCount <= 1)
     {
-        // when we have an entry in the m_IdentifierMap but not m_IdentifierRefMap, this
-        // means our ref count is one, so we're decrementing to zero, so we remove it
-        m_IdentifierMap.erase(clientID) ;
-        m_ToClientIdentifierMap.erase(pKernelID) ;
-        return;
-    }
-    else
-    {
-        // if we have an entry, decrement it
-        refIter->second -= 1;
-
-        // if the count falls to 1, remove it from this map since presence in the map requires
-        // at least a ref count of two
-        if (refIter->second < 2)
+        // The last reference is going away, so remove the identifier from both maps
+        if (clientIter != m_IdentifierMap.end())
         {
-            m_IdentifierRefMap.erase(refIter);
+            m_IdentifierMap.erase(clientIter) ;
         }
+        m_ToClientIdentifierMap.erase(iter) ;
+        return ;
     }
+
+    clientIter->second.refCount -= 1 ;
 }
 
 uint64_t AgentSML::ConvertTime(int64_t clientTimeTag)
@@ -929,15 +967,12 @@ std::string AgentSML::ExecuteCommandLine(std::string const& commandLine)
 
 bool AgentSML::AddInputWME(char const* pID, char const* pAttribute, Symbol* pValueSymbol, int64_t clientTimeTag)
 {
-    std::string idKernel ;
+    IdentifierKey idKernel = 0 ;
     ConvertID(pID, &idKernel) ;
-
-    char idLetter = idKernel[0] ;
-    uint64_t idNumber = 0;
-    from_c_string(idNumber, idKernel.substr(1).c_str());
+    CHECK_RET_FALSE(idKernel) ;
 
     // Now create the wme
-    Symbol* pIDSymbol   = get_io_identifier(m_agent, idLetter, idNumber) ;
+    Symbol* pIDSymbol   = get_io_identifier(m_agent, GetIdentifierLetter(idKernel), GetIdentifierNumber(idKernel)) ;
     Symbol* pAttrSymbol = get_io_str_constant(m_agent, pAttribute) ;
 
     CHECK_RET_FALSE(pIDSymbol) ;
@@ -1043,7 +1078,7 @@ bool AgentSML::AddIdInputWME(char const* pID, char const* pAttribute, char const
     // If that identifier is found when we try to convert it, it already exists in the kernel, we make a shared id.
     // If that identifier is not found when we try to convert it, we make a new identifier.
 
-    std::string idValue ;
+    IdentifierKey idValue = 0 ;
     uint64_t idValueNumber = 0 ;
     char idValueLetter = 0;
     bool didntFindId = true;
@@ -1052,8 +1087,8 @@ bool AgentSML::AddIdInputWME(char const* pID, char const* pAttribute, char const
     {
         // we found a kernel side mapping, shared id
         didntFindId = false;    // for sanity check below
-        idValueLetter = idValue[0];
-        from_c_string(idValueNumber, idValue.substr(1).c_str());
+        idValueLetter = GetIdentifierLetter(idValue);
+        idValueNumber = GetIdentifierNumber(idValue);
     }
     else
     {
@@ -1076,10 +1111,7 @@ bool AgentSML::AddIdInputWME(char const* pID, char const* pAttribute, char const
 
     // If pValueSymbol is a new id, then RecordIDMapping will create a map between the client and kernel id names.
     // Otherwise, RecordIDMapping will add a ref count to client id name.
-    std::ostringstream buffer;
-    buffer << pValueSymbol->id->name_letter ;
-    buffer << pValueSymbol->id->name_number ;
-    this->RecordIDMapping(pValue, buffer.str().c_str()) ;
+    this->RecordIDMapping(pValue, pValueSymbol->id->name_letter, pValueSymbol->id->name_number) ;
     //if (kDebugInput)
     //{
     //  PrintDebugFormat("Recording id mapping of %s to %s", pValue, newid.c_str()) ;
@@ -1200,7 +1232,7 @@ bool AgentSML::RemoveInputWME(int64_t clientTimeTag)
 
     if (pWME->value->is_sti())
     {
-        this->RemoveID(pWME->value->to_string(true)) ;
+        this->RemoveID(pWME->value->id->name_letter, pWME->value->id->name_number) ;
     }
 
     RemoveWmeFromWmeMap(pWME);
@@ -1227,6 +1259,41 @@ bool AgentSML::RemoveInputWME(char const* pClientTimeTag)
     return RemoveInputWME(clientTimeTag);
 }
 
+bool AgentSML::ApplyInputBatch(InputBatch const& batch)
+{
+    bool ok = true ;
+
+    for (size_t i = 0, count = batch.GetSize() ; i < count ; i++)
+    {
+        int64_t clientTimeTag = batch.GetTimeTag(i) ;
+
+        switch (batch.GetOp(i))
+        {
+            case InputBatch::kRemove:
+                ok = RemoveInputWME(clientTimeTag) && ok ;
+                break;
+            case InputBatch::kAddString:
+                ok = AddStringInputWME(batch.GetId(i), batch.GetAttribute(i), batch.GetStringValue(i), clientTimeTag) && ok ;
+                break;
+            case InputBatch::kAddInt:
+                ok = AddIntInputWME(batch.GetId(i), batch.GetAttribute(i), batch.GetIntValue(i), clientTimeTag) && ok ;
+                break;
+            case InputBatch::kAddDouble:
+                ok = AddDoubleInputWME(batch.GetId(i), batch.GetAttribute(i), batch.GetDoubleValue(i), clientTimeTag) && ok ;
+                break;
+            case InputBatch::kAddId:
+                ok = AddIdInputWME(batch.GetId(i), batch.GetAttribute(i), batch.GetStringValue(i), clientTimeTag) && ok ;
+                break;
+            default:
+                assert(false);
+                ok = false ;
+                break;
+        }
+    }
+
+    return ok ;
+}
+
 void AgentSML::AddWmeToWmeMap(int64_t clientTimeTag, wme* w)
 {
     uint64_t timetag = w->timetag ;
@@ -1282,7 +1349,7 @@ bool AgentSML::StartCaptureInput(const std::string& pathname, bool autoflush, ui
     m_pCaptureFile = new std::fstream(pathname.c_str(), std::fstream::out | std::fstream::trunc);
     if (m_pCaptureFile && m_pCaptureFile->good())
     {
-        SoarSeedRNG(seed);
+        m_agent->rng->seed(seed);
         *m_pCaptureFile << seed << std::endl;
         return true;
     }
@@ -1362,7 +1429,7 @@ bool AgentSML::StartReplayInput(const std::string& pathname)
     {
         return false;
     }
-    SoarSeedRNG(seed);
+    m_agent->rng->seed(seed);
 
     // load replay file
     while (getline(replayFile, line))
@@ -1600,25 +1667,25 @@ void AgentSML::ReplayInputWMEs()
 
 void AgentSML::BufferedAddStringInputWME(char const* pID, char const* pAttribute, char const* pValue, int64_t clientTimeTag)
 {
-    m_DirectInputDeltaList.push_back(DirectInputDelta(DirectInputDelta::kAddString, pID, pAttribute, pValue, clientTimeTag));
+    m_DirectInputBatch.AddStringWME(pID, pAttribute, pValue, clientTimeTag);
 }
 
 void AgentSML::BufferedAddIntInputWME(char const* pID, char const* pAttribute, int64_t value, int64_t clientTimeTag)
 {
-    m_DirectInputDeltaList.push_back(DirectInputDelta(pID, pAttribute, value, clientTimeTag));
+    m_DirectInputBatch.AddIntWME(pID, pAttribute, value, clientTimeTag);
 }
 
 void AgentSML::BufferedAddDoubleInputWME(char const* pID, char const* pAttribute, double value, int64_t clientTimeTag)
 {
-    m_DirectInputDeltaList.push_back(DirectInputDelta(pID, pAttribute, value, clientTimeTag));
+    m_DirectInputBatch.AddDoubleWME(pID, pAttribute, value, clientTimeTag);
 }
 
 void AgentSML::BufferedAddIdInputWME(char const* pID, char const* pAttribute, char const* pValue, int64_t clientTimeTag)
 {
-    m_DirectInputDeltaList.push_back(DirectInputDelta(DirectInputDelta::kAddId, pID, pAttribute, pValue, clientTimeTag));
+    m_DirectInputBatch.AddIdWME(pID, pAttribute, pValue, clientTimeTag);
 }
 
 void AgentSML::BufferedRemoveInputWME(int64_t clientTimeTag)
 {
-    m_DirectInputDeltaList.push_back(DirectInputDelta(clientTimeTag));
+    m_DirectInputBatch.RemoveWME(clientTimeTag);
 }
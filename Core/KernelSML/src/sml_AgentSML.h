@@ -18,6 +18,7 @@
 #include "sml_XMLListener.h"
 #include "sml_OutputListener.h"
 #include "sml_InputListener.h"
+#include "sml_InputBatch.h"
 
 #include "callback.h"
 
@@ -28,6 +29,7 @@ typedef struct cons_struct cons;
 typedef struct wme_struct wme;
 
 #include <map>
+#include <unordered_map>
 #include <list>
 #include <string>
 #include <fstream>
@@ -41,28 +43,38 @@ namespace sml
     class RhsFunction ;
     class AgentRunCallback ;
     
-// badbad: shouldn't we be using hash_maps for these?
-
+// Identifiers are looked up on every input wme, so rather than keying the maps below
+// by strings we pack an identifier's letter and number into a single integer.
+// The letter goes in the top byte and the number in the remaining 56 bits, so
+// "o3" and "O3" are different keys.  See AgentSML::EncodeIdentifier().
+    typedef uint64_t                            IdentifierKey ;
+    
+// A kernel side identifier plus the number of client side wmes that refer to it.
+    struct IdentifierMapping
+    {
+        IdentifierKey   kernelID ;
+        int             refCount ;
+    };
+    
 // Map from a client side identifier to a kernel side one (e.g. "o3" => "O5")
-    typedef std::map< std::string, std::string >    IdentifierMap ;
+    typedef std::unordered_map< IdentifierKey, IdentifierMapping >  IdentifierMap ;
     typedef IdentifierMap::iterator             IdentifierMapIter ;
     typedef IdentifierMap::const_iterator       IdentifierMapConstIter ;
     
-// Keep track of instances of client side ids
-    typedef std::map< std::string, int >        IdentifierRefMap ;
-    typedef IdentifierRefMap::iterator          IdentifierRefMapIter ;
-    typedef IdentifierRefMap::const_iterator    IdentifierRefMapConstIter ;
+// Map from a kernel side identifier back to the client side one (for cleanup)
+    typedef std::unordered_map< IdentifierKey, IdentifierKey >      ToClientIdentifierMap ;
+    typedef ToClientIdentifierMap::iterator     ToClientIdentifierMapIter ;
     
 // Map from client side time tag to a kernel time tag
-    typedef std::map< int64_t, uint64_t >       CKTimeMap ;
+    typedef std::unordered_map< int64_t, uint64_t > CKTimeMap ;
     typedef CKTimeMap::iterator                 CKTimeMapIter ;
     
 // Map from kernel side time tag to client time tag
-    typedef std::map< uint64_t, int64_t >       KCTimeMap ;
+    typedef std::unordered_map< uint64_t, int64_t > KCTimeMap ;
     typedef KCTimeMap::iterator                 KCTimeMapIter ;
     
 // Map from client side time tag to client time tag, for replay
-    typedef std::map< int64_t, int64_t >        CCTimeMap ;
+    typedef std::unordered_map< int64_t, int64_t >  CCTimeMap ;
     typedef CCTimeMap::iterator                 CCTimeMapIter ;
     
 // List of input messages waiting for the next input phase callback from the kernel
@@ -70,34 +82,9 @@ namespace sml
     typedef PendingInputList::iterator          PendingInputListIter ;
     
 // Map of kernel time tags to kernel wmes for input
-    typedef std::map< uint64_t, wme* >          WmeMap;
+    typedef std::unordered_map< uint64_t, wme* >    WmeMap;
     typedef WmeMap::iterator                    WmeMapIter;
     
-// This struct supports the buffered direct input calls
-    struct DirectInputDelta
-    {
-        enum DirectInputType { kRemove, kAddString, kAddInt, kAddDouble, kAddId };
-        std::string id;
-        std::string attribute;
-        int64_t clientTimeTag;
-        DirectInputType type;
-        std::string svalue;
-        int64_t ivalue;
-        double dvalue;
-        
-        DirectInputDelta(DirectInputType type, char const* pID, char const* pAttribute, char const* pValue, int64_t clientTimeTag)
-            : id(pID), attribute(pAttribute), clientTimeTag(clientTimeTag), type(type), svalue(pValue) {}
-            
-        DirectInputDelta(char const* pID, char const* pAttribute, int64_t value, int64_t clientTimeTag)
-            : id(pID), attribute(pAttribute), clientTimeTag(clientTimeTag), type(kAddInt), ivalue(value) {}
-            
-        DirectInputDelta(char const* pID, char const* pAttribute, double value, int64_t clientTimeTag)
-            : id(pID), attribute(pAttribute), clientTimeTag(clientTimeTag), type(kAddDouble), dvalue(value) {}
-            
-        DirectInputDelta(int64_t clientTimeTag)
-            : clientTimeTag(clientTimeTag), type(kRemove) {}
-    };
-    
     class EXPORT AgentSML
     {
             friend class KernelSML ;
@@ -121,8 +108,11 @@ namespace sml
             bool RemoveInputWME(int64_t timeTag) ;
             bool RemoveInputWME(char const* pTimeTag) ;
             
+            // Applies every change in the batch, in order.  Returns false if any of them fail.
+            bool ApplyInputBatch(InputBatch const& batch) ;
+            
         protected:
-            std::list<DirectInputDelta> m_DirectInputDeltaList;
+            InputBatch  m_DirectInputBatch ;
             
         public:
             // These functions are for direct, fast IO, called by the sml_Direct family
@@ -131,9 +121,9 @@ namespace sml
             void BufferedAddDoubleInputWME(char const* pID, char const* pAttribute, double value, int64_t clientTimeTag);
             void BufferedAddIdInputWME(char const* pID, char const* pAttribute, char const* pValue, int64_t clientTimeTag);
             void BufferedRemoveInputWME(int64_t timeTag) ;
-            std::list<DirectInputDelta>*    GetBufferedDirectList()
+            InputBatch* GetBufferedDirectBatch()
             {
-                return &m_DirectInputDeltaList ;
+                return &m_DirectInputBatch ;
             }
             
         protected:
@@ -147,11 +137,8 @@ namespace sml
             // Map from client side identifiers to kernel side ones
             IdentifierMap   m_IdentifierMap ;
             
-            // For cleanup we also need a map from kernel side identifiers to client side ones (for cleanup)
-            IdentifierMap   m_ToClientIdentifierMap ;
-            
-            // Keep track of number of instances of client side identifiers
-            IdentifierRefMap m_IdentifierRefMap;
+            // For cleanup we also need a map from kernel side identifiers to client side ones
+            ToClientIdentifierMap   m_ToClientIdentifierMap ;
             
             // Map from client side time tags to kernel side timetags, and back (for cleanup
             CKTimeMap       m_CKTimeMap ;
@@ -476,8 +463,28 @@ namespace sml
             *           to that id so that shared ids work correctly
             *************************************************************/
             bool ConvertID(char const* pClientID, std::string* pKernelID) ;
-            void RecordIDMapping(char const* pClientID, char const* pKernelID) ;
-            void RemoveID(char const* pKernelID) ;  // BADBAD: this function only referenced in commented out code
+            bool ConvertID(char const* pClientID, IdentifierKey* pKernelID) ;
+            void RecordIDMapping(char const* pClientID, char kernelLetter, uint64_t kernelNumber) ;
+            void RemoveID(char kernelLetter, uint64_t kernelNumber) ;
+            
+            /*************************************************************
+            * @brief    Packs an identifier string (a letter followed by digits,
+            *           e.g. "O5") into an IdentifierKey.  Returns false if the
+            *           string isn't in that form.
+            *************************************************************/
+            static bool EncodeIdentifier(char const* pID, IdentifierKey* pKey) ;
+            static IdentifierKey EncodeIdentifier(char letter, uint64_t number)
+            {
+                return (static_cast<IdentifierKey>(static_cast<unsigned char>(letter)) << 56) | number ;
+            }
+            static char GetIdentifierLetter(IdentifierKey key)
+            {
+                return static_cast<char>(key >> 56) ;
+            }
+            static uint64_t GetIdentifierNumber(IdentifierKey key)
+            {
+                return key & ((static_cast<IdentifierKey>(1) << 56) - 1) ;
+            }
             
             /*************************************************************
             * @brief    Converts a time tag from a client side value to
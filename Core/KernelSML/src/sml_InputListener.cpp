@@ -66,6 +66,7 @@ void InputListener::ProcessPendingInput(AgentSML* pAgentSML, int)
     PendingInputList* pPending = pAgentSML->GetPendingInputList() ;
     
     bool ok = true ;
+    InputBatch batch ;
     
     for (PendingInputListIter iter = pPending->begin() ; iter != pPending->end() ; iter = pPending->erase(iter))
     {
@@ -98,6 +99,27 @@ void InputListener::ProcessPendingInput(AgentSML* pAgentSML, int)
         {
             pCommand->GetChild(&wmeXML, i) ;
             
+            // A batch of changes sent as a single block
+            if (pWmeXML->IsTag(sml_Names::kTagWMEBatch))
+            {
+                // Binary data arrives hex encoded if the message was sent as XML text
+                pWmeXML->ConvertCharacterDataToBinary() ;
+                
+                if (!batch.Deserialize(pWmeXML->GetCharacterData(), static_cast<size_t>(pWmeXML->GetCharacterDataLength())))
+                {
+                    ok = false ;
+                    continue ;
+                }
+                
+                if (kDebugInput)
+                {
+                    PrintDebugFormat("%s Batch of %d changes", pAgentSML->GetName(), static_cast<int>(batch.GetSize())) ;
+                }
+                
+                ok = pAgentSML->ApplyInputBatch(batch) && ok ;
+                continue ;
+            }
+            
             // Ignore tags that aren't wmes.
             if (!pWmeXML->IsTag(sml_Names::kTagWME))
             {
@@ -160,31 +182,11 @@ void InputListener::ProcessPendingInput(AgentSML* pAgentSML, int)
         delete pInputMsg ;
     }
     
-    std::list<DirectInputDelta>* pBufferedDirect = pAgentSML->GetBufferedDirectList();
-    for (std::list<DirectInputDelta>::iterator iter = pBufferedDirect->begin() ; iter != pBufferedDirect->end() ; iter = pBufferedDirect->erase(iter))
+    InputBatch* pBufferedDirect = pAgentSML->GetBufferedDirectBatch() ;
+    if (!pBufferedDirect->IsEmpty())
     {
-        DirectInputDelta& delta = *iter;
-        switch (delta.type)
-        {
-            case DirectInputDelta::kRemove:
-                pAgentSML->RemoveInputWME(delta.clientTimeTag);
-                break;
-            case DirectInputDelta::kAddString:
-                pAgentSML->AddStringInputWME(delta.id.c_str(), delta.attribute.c_str(), delta.svalue.c_str(), delta.clientTimeTag);
-                break;
-            case DirectInputDelta::kAddInt:
-                pAgentSML->AddIntInputWME(delta.id.c_str(), delta.attribute.c_str(), delta.ivalue, delta.clientTimeTag);
-                break;
-            case DirectInputDelta::kAddDouble:
-                pAgentSML->AddDoubleInputWME(delta.id.c_str(), delta.attribute.c_str(), delta.dvalue, delta.clientTimeTag);
-                break;
-            case DirectInputDelta::kAddId:
-                pAgentSML->AddIdInputWME(delta.id.c_str(), delta.attribute.c_str(), delta.svalue.c_str(), delta.clientTimeTag);
-                break;
-            default:
-                assert(false);
-                break;
-        }
+        pAgentSML->ApplyInputBatch(*pBufferedDirect) ;
+        pBufferedDirect->Clear() ;
     }
 }
 
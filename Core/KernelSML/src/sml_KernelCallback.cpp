@@ -33,7 +33,23 @@ void KernelCallback::KernelCallbackStatic(agent* pAgent, int eventID, void* pDat
     assert(pThis->m_pCallbackAgentSML->GetSoarAgent() == pAgent) ;
     
     // Make the callback to the non-static method
-    pThis->OnKernelEvent(eventID, pThis->m_pCallbackAgentSML, pCallData) ;
+    if (s_SerializeCallbacks)
+    {
+        soar_thread::Lock lock(GetCallbackMutex()) ;
+        pThis->OnKernelEvent(eventID, pThis->m_pCallbackAgentSML, pCallData) ;
+    }
+    else
+    {
+        pThis->OnKernelEvent(eventID, pThis->m_pCallbackAgentSML, pCallData) ;
+    }
+}
+
+bool KernelCallback::s_SerializeCallbacks = false ;
+
+soar_thread::Mutex* KernelCallback::GetCallbackMutex()
+{
+    static soar_thread::Mutex callbackMutex ;
+    return &callbackMutex ;
 }
 
 // Not returning this as SOAR_CALLBACK_TYPE as that would expose the kernel headers through our headers.
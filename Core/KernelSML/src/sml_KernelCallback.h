@@ -24,6 +24,8 @@
 #include <assert.h>
 #include <map>
 
+#include "thread_Lock.h"
+
 // Forward definitions for kernel
 typedef struct agent_struct agent;
 typedef struct symbol_struct Symbol;
@@ -41,11 +43,24 @@ namespace sml
             std::map<int, bool> m_Registered ;
             static int  InternalGetCallbackFromEventID(int eventID) ;
             
+            // When agents are stepped on several threads at once their events are delivered one at a time
+            static bool s_SerializeCallbacks ;
+            
         public:
             static void KernelCallbackStatic(agent* pAgent, int eventID, void* pData, void* pCallData) ;
             static int  GetCallbackFromEventID(int eventID) ;
             static bool IsCallbackImplementedInKernel(int eventID) ;
             
+            static void SetSerializeCallbacks(bool state)
+            {
+                s_SerializeCallbacks = state ;
+            }
+            static bool IsSerializingCallbacks()
+            {
+                return s_SerializeCallbacks ;
+            }
+            static soar_thread::Mutex* GetCallbackMutex() ;
+            
             KernelCallback()
             {
                 m_pCallbackAgentSML = 0 ;
@@ -31,6 +31,7 @@
 #include "agent.h"
 #include "debug.h"
 #include "io_link.h"
+#include "memory_manager.h"
 #include "output_manager.h"
 #include "symbol.h"
 #include "symbol_manager.h"
@@ -81,6 +82,8 @@ void KernelSML::BuildCommandMap()
     m_CommandMap[sml_Names::kCommand_SetInterruptCheckRate] = &sml::KernelSML::HandleSetInterruptCheckRate ;
     m_CommandMap[sml_Names::kCommand_GetVersion]        = &sml::KernelSML::HandleGetVersion ;
     m_CommandMap[sml_Names::kCommand_Shutdown]          = &sml::KernelSML::HandleShutdown ;
+    m_CommandMap[sml_Names::kCommand_SetAgentMemoryPools] = &sml::KernelSML::HandleSetAgentMemoryPools ;
+    m_CommandMap[sml_Names::kCommand_SetParallelRunThreads] = &sml::KernelSML::HandleSetParallelRunThreads ;
     m_CommandMap[sml_Names::kCommand_IsSoarRunning]     = &sml::KernelSML::HandleIsSoarRunning ;
     m_CommandMap[sml_Names::kCommand_GetConnections]    = &sml::KernelSML::HandleGetConnections ;
     m_CommandMap[sml_Names::kCommand_SetConnectionInfo] = &sml::KernelSML::HandleSetConnectionInfo ;
@@ -94,6 +97,7 @@ void KernelSML::BuildCommandMap()
     m_CommandMap[sml_Names::kCommand_GetInitialTimeTag] = &sml::KernelSML::HandleGetInitialTimeTag ;
     m_CommandMap[sml_Names::kCommand_ConvertIdentifier] = &sml::KernelSML::HandleConvertIdentifier;
     m_CommandMap[sml_Names::kCommand_GetListenerPort]   = &sml::KernelSML::HandleGetListenerPort;
+    m_CommandMap[sml_Names::kCommand_GetInputBatchSupport] = &sml::KernelSML::HandleGetInputBatchSupport;
     m_CommandMap[sml_Names::kCommand_SVSInput] = &sml::KernelSML::HandleSVSInput;
     m_CommandMap[sml_Names::kCommand_SVSOutput] = &sml::KernelSML::HandleSVSOutput;
     m_CommandMap[sml_Names::kCommand_SVSQuery] = &sml::KernelSML::HandleSVSQuery;
@@ -663,6 +667,14 @@ bool KernelSML::HandleGetInitialTimeTag(AgentSML* /*pAgentSML*/, char const* /*p
     return this->ReturnIntResult(pConnection, pResponse, timeTagStart) ;
 }
 
+// Clients ask this when they connect.  Kernels from before <wmes> batches
+// don't know the command and report an error, so the client knows to send
+// one <wme> tag per change instead.
+bool KernelSML::HandleGetInputBatchSupport(AgentSML* /*pAgentSML*/, char const* /*pCommandName*/, Connection* pConnection, AnalyzeXML* /*pIncoming*/, soarxml::ElementXML* pResponse)
+{
+    return this->ReturnBoolResult(pConnection, pResponse, true) ;
+}
+
 bool KernelSML::HandleConvertIdentifier(AgentSML* pAgentSML, char const* pCommandName, Connection* pConnection, AnalyzeXML* pIncoming, soarxml::ElementXML* pResponse)
 {
     // Get the identifier to convert
@@ -752,6 +764,31 @@ bool KernelSML::HandleSetInterruptCheckRate(AgentSML* /*pAgentSML*/, char const*
     return true ;
 }
 
+// Chooses whether agents created from now on share the kernel's memory pools or own their own
+bool KernelSML::HandleSetAgentMemoryPools(AgentSML* /*pAgentSML*/, char const* /*pCommandName*/, Connection* /*pConnection*/, AnalyzeXML* pIncoming, soarxml::ElementXML* /*pResponse*/)
+{
+    bool agentOwned = pIncoming->GetArgBool(sml_Names::kParamValue, false) ;
+
+    Memory_Manager::set_pool_ownership(agentOwned ? MPO_agent : MPO_shared) ;
+
+    return true ;
+}
+
+// Sets how many threads the run scheduler may use to step agents
+bool KernelSML::HandleSetParallelRunThreads(AgentSML* /*pAgentSML*/, char const* pCommandName, Connection* pConnection, AnalyzeXML* pIncoming, soarxml::ElementXML* pResponse)
+{
+    int threads = pIncoming->GetArgInt(sml_Names::kParamValue, 1) ;
+
+    if (m_pRunScheduler->IsRunning())
+    {
+        return InvalidArg(pConnection, pResponse, pCommandName, "Can't change the number of run threads while agents are running") ;
+    }
+
+    m_pRunScheduler->SetParallelThreads(threads) ;
+
+    return true ;
+}
+
 // Fire a particular event at the request of the client.
 bool KernelSML::HandleFireEvent(AgentSML* /*pAgentSML*/, char const* pCommandName, Connection* pConnection, AnalyzeXML* pIncoming, soarxml::ElementXML* pResponse)
 {
@@ -14,6 +14,7 @@
 #include "sml_Utils.h"
 #include "sml_AgentSML.h"
 #include "sml_KernelSML.h"
+#include "sml_KernelCallback.h"
 
 #include "agent.h"
 #include "mem.h"
@@ -47,7 +48,17 @@ Symbol* RhsFunction::RhsFunctionCallback(agent* thisAgent, cons* args, void* use
     {
         // Actually make the call.  We can do the dynamic cast because we passed in the
         //  symbol factory and thus know how the symbol was created.
-        Symbol* pReturn = rhsFunction->Execute(&symVector);
+        // Client rhs functions may be called from several threads when agents run in parallel
+        Symbol* pReturn ;
+        if (KernelCallback::IsSerializingCallbacks())
+        {
+            soar_thread::Lock lock(KernelCallback::GetCallbackMutex()) ;
+            pReturn = rhsFunction->Execute(&symVector);
+        }
+        else
+        {
+            pReturn = rhsFunction->Execute(&symVector);
+        }
         
         // Return the result, assuming it is not NIL
         if (rhsFunction->IsValueReturned() == true)
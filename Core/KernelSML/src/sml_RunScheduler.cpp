@@ -18,6 +18,10 @@
 #include "sml_KernelSML.h"
 #include "sml_AgentSML.h"
 #include "sml_Events.h"
+#include "sml_KernelCallback.h"
+
+#include "agent.h"
+#include "memory_manager.h"
 
 #include <assert.h>
 
@@ -29,6 +33,12 @@ RunScheduler::RunScheduler(KernelSML* pKernelSML)
     m_RunFlags = sml_NONE ;
     m_IsRunning = false ;
     m_StopBeforePhase = sml_APPLY_PHASE ;
+    m_ParallelThreads = 1 ;
+}
+
+RunScheduler::~RunScheduler()
+{
+    StopWorkers() ;
 }
 
 /*************************************************************
@@ -685,6 +695,160 @@ bool RunScheduler::IsRunning()
     return m_IsRunning ;
 }
 
+/********************************************************************
+* @brief    Does the bookkeeping after an agent has been stepped one
+*           interleaveStepSize: counts completed run types and takes
+*           the agent off the run list once it is done running.
+*           Returns false if the agent still has more of the run to do.
+*********************************************************************/
+bool RunScheduler::CompleteAgentStep(AgentSML* pAgentSML, smlRunResult runResult, bool forever, smlRunStepSize runStepSize, uint64_t count)
+{
+    bool finished = true ;
+    
+    // if agent finished one runType, incr counter and remove from stepList
+    if (pAgentSML->CompletedRunType(pAgentSML->GetRunCounter(runStepSize)) /* || pAgent->MaxNilOutputCyclesReached */)
+    {
+        pAgentSML->IncrementLocalRunCounter();
+        pAgentSML->PutAgentOnStepList(false);
+    }
+    else
+    {
+        finished = false;
+    }
+    
+    // if agent finished count runTypes, remove from RunList, else runFinished = false;
+    // can also return true if a gSKI_STOP_AFTER_DECISION_CYCLE interrupt occurred
+    // or is pending on agents with RunType DECISION or FOREVER.
+    bool agentFinishedRun = IsAgentFinished(pAgentSML, forever, runStepSize, count) ;
+    
+    // Have to test the run state to find out if we are still ok to keep running
+    // (not sure if runResult provides this as well, but they're from different enums).
+    smlRunState runState = pAgentSML->GetRunState() ;
+    
+    // An agent should return "stopped" if it's just pausing in the middle of a run
+    // before we run it for the next phase.  Anything else means this agent is done running.
+    if (runState != sml_RUNSTATE_STOPPED || agentFinishedRun)
+    {
+        pAgentSML->RemoveAgentFromRunList() ;
+        pAgentSML->SetResultOfRun(runResult) ;
+        // If we know we won't have to step to StopBefore phase
+        // notify listeners that this agent is finished running
+        if ((runStepSize != sml_DECISION) && !forever)
+        {
+            pAgentSML->FireRunEvent(smlEVENT_AFTER_RUN_ENDS) ;
+        }
+    }
+    else
+    {
+        // If at least one agent wants to keep running, we keep running.
+        finished = false ;
+    }
+    
+    return finished ;
+}
+
+/********************************************************************
+* @brief    Sets the number of threads used to step agents.
+*           Workers are started lazily by the next parallel round.
+*********************************************************************/
+void RunScheduler::SetParallelThreads(int threads)
+{
+    if (threads < 1)
+    {
+        threads = 1 ;
+    }
+    
+    // Can't change the pool while the workers may be stepping agents
+    if (m_IsRunning || threads == m_ParallelThreads)
+    {
+        return ;
+    }
+    
+    StopWorkers() ;
+    m_ParallelThreads = threads ;
+}
+
+void RunScheduler::StopWorkers()
+{
+    for (std::vector<RunWorker*>::iterator iter = m_Workers.begin() ; iter != m_Workers.end() ; iter++)
+    {
+        (*iter)->Shutdown() ;
+        delete *iter ;
+    }
+    m_Workers.clear() ;
+}
+
+/********************************************************************
+* @brief    Steps every agent on the step list one interleaveStepSize,
+*           spreading them over the worker threads, and returns once
+*           all of them are done.  The agents are recorded in
+*           m_StepAgents in agent map order with their results in
+*           m_StepResults.
+*
+*           Returns false without stepping anyone if the agents can't
+*           safely run concurrently, i.e. when parallel runs are off,
+*           when there is only one agent to step or when an agent still
+*           allocates from the memory pools shared by the whole kernel.
+*********************************************************************/
+bool RunScheduler::StepAgentsInParallel(smlRunStepSize interleaveStepSize)
+{
+    if (m_ParallelThreads < 2)
+    {
+        return false ;
+    }
+    
+    m_StepAgents.clear() ;
+    for (AgentMapIter iter = m_pKernelSML->m_AgentMap.begin() ; iter != m_pKernelSML->m_AgentMap.end() ; iter++)
+    {
+        AgentSML* pAgentSML = iter->second ;
+        
+        if (pAgentSML->IsAgentOnStepList())
+        {
+            if (pAgentSML->GetSoarAgent()->memoryManager->is_shared())
+            {
+                return false ;
+            }
+            m_StepAgents.push_back(pAgentSML) ;
+        }
+    }
+    
+    if (m_StepAgents.size() < 2)
+    {
+        return false ;
+    }
+    
+    size_t threads = m_StepAgents.size() < static_cast<size_t>(m_ParallelThreads) ? m_StepAgents.size() : static_cast<size_t>(m_ParallelThreads) ;
+    
+    while (m_Workers.size() < threads - 1)
+    {
+        RunWorker* pWorker = new RunWorker() ;
+        pWorker->Start() ;
+        m_Workers.push_back(pWorker) ;
+    }
+    
+    m_StepResults.assign(m_StepAgents.size(), sml_RUN_COMPLETED) ;
+    
+    // Events raised by the agents while they step may now arrive on any thread
+    KernelCallback::SetSerializeCallbacks(true) ;
+    
+    // The calling thread takes the first share of the agents itself
+    for (size_t i = 1 ; i < threads ; i++)
+    {
+        m_Workers[i - 1]->StepAgents(&m_StepAgents, &m_StepResults, i, threads, interleaveStepSize) ;
+    }
+    
+    RunWorker::StepAgentShare(&m_StepAgents, &m_StepResults, 0, threads, interleaveStepSize) ;
+    
+    for (size_t i = 1 ; i < threads ; i++)
+    {
+        m_Workers[i - 1]->WaitUntilDone() ;
+    }
+    
+    KernelCallback::SetSerializeCallbacks(false) ;
+    
+    return true ;
+}
+
 /*************************************************************
 * @brief    Run all agents previously marked as being scheduled to run.
 *
@@ -833,6 +997,20 @@ smlRunResult RunScheduler::RunScheduledAgents(bool forever, smlRunStepSize runSt
             //    note that there is not a corresponding AFTER_AGENTS_RUN_STEP event...
             m_pKernelSML->FireSystemEvent(smlEVENT_BEFORE_AGENTS_RUN_STEP) ;
             
+            // When stepping in parallel every agent on the step list has already run one "interleaveStepSize"
+            // and we just complete their steps here, in the same order we would have stepped them.
+            if (StepAgentsInParallel(interleaveStepSize))
+            {
+                for (size_t i = 0 ; i < m_StepAgents.size() ; i++)
+                {
+                    if (!CompleteAgentStep(m_StepAgents[i], m_StepResults[i], forever, runStepSize, count))
+                    {
+                        runFinished = false ;
+                    }
+                }
+                continue ;
+            }
+            
             for (AgentMapIter iter = m_pKernelSML->m_AgentMap.begin() ; iter != m_pKernelSML->m_AgentMap.end() ; iter++)
             {
                 AgentSML* pAgentSML = iter->second ;
@@ -846,42 +1024,8 @@ smlRunResult RunScheduler::RunScheduledAgents(bool forever, smlRunStepSize runSt
                     // halted and running agents will return an error from StepInClientThread
                     //
                     
-                    // if agent finished one runType, incr counter and remove from stepList
-                    if (pAgentSML->CompletedRunType(pAgentSML->GetRunCounter(runStepSize)) /* || pAgent->MaxNilOutputCyclesReached */)
-                    {
-                        pAgentSML->IncrementLocalRunCounter();
-                        pAgentSML->PutAgentOnStepList(false);
-                    }
-                    else
-                    {
-                        runFinished = false;
-                    }
-                    
-                    // if agent finished count runTypes, remove from RunList, else runFinished = false;
-                    // can also return true if a gSKI_STOP_AFTER_DECISION_CYCLE interrupt occurred
-                    // or is pending on agents with RunType DECISION or FOREVER.
-                    bool agentFinishedRun = IsAgentFinished(pAgentSML, forever, runStepSize, count) ;
-                    
-                    // Have to test the run state to find out if we are still ok to keep running
-                    // (not sure if runResult provides this as well, but they're from different enums).
-                    smlRunState runState = pAgentSML->GetRunState() ;
-                    
-                    // An agent should return "stopped" if it's just pausing in the middle of a run
-                    // before we run it for the next phase.  Anything else means this agent is done running.
-                    if (runState != sml_RUNSTATE_STOPPED || agentFinishedRun)
-                    {
-                        pAgentSML->RemoveAgentFromRunList() ;
-                        pAgentSML->SetResultOfRun(runResult) ;
-                        // If we know we won't have to step to StopBefore phase
-                        // notify listeners that this agent is finished running
-                        if ((runStepSize != sml_DECISION) && !forever)
-                        {
-                            pAgentSML->FireRunEvent(smlEVENT_AFTER_RUN_ENDS) ;
-                        }
-                    }
-                    else
+                    if (!CompleteAgentStep(pAgentSML, runResult, forever, runStepSize, count))
                     {
-                        // If at least one agent wants to keep running, we keep running.
                         runFinished = false ;
                     }
                 }
@@ -12,6 +12,9 @@
 #define SML_RUN_SCHEDULER_H
 
 #include "sml_Events.h"
+#include "sml_RunWorker.h"
+
+#include <vector>
 
 namespace sml
 {
@@ -34,8 +37,18 @@ namespace sml
             // When running multiple agents, we synchronize them to this agent (same phase) before starting the real run.
             AgentSML*   m_pSynchAgentSML ;
             
+            // Number of threads used to step agents (1 means step them round-robin on the calling thread).
+            // The calling thread is always one of them, so we own m_ParallelThreads - 1 workers.
+            int         m_ParallelThreads ;
+            std::vector<RunWorker*> m_Workers ;
+            
+            // The agents stepped in the current parallel round and the result of each step
+            StepAgentList   m_StepAgents ;
+            StepResultList  m_StepResults ;
+            
         public:
             RunScheduler(KernelSML* pKernelSML) ;
+            ~RunScheduler() ;
             
             /********************************************************************
             * @brief    This is a method for getting the default value
@@ -114,6 +127,21 @@ namespace sml
                 return m_StopBeforePhase ;
             }
             
+            /*********************************************************************
+            * @brief    Sets how many threads are used to step agents during a run.
+            *           With more than one thread, agents on the step list are stepped
+            *           concurrently one interleaveStepSize at a time and the scheduler
+            *           waits for all of them before firing events and deciding who
+            *           keeps running, so kernel level events still fire once per round.
+            *           Agents are only stepped in parallel when every one of them owns
+            *           its memory pools; otherwise the run falls back to round-robin.
+            **********************************************************************/
+            void SetParallelThreads(int threads) ;
+            int GetParallelThreads()
+            {
+                return m_ParallelThreads ;
+            }
+            
         protected:
             bool            AgentsStillStepping() ;
             bool            AreAgentsSynchronized(AgentSML* pSynchAgent) ;
@@ -127,6 +155,9 @@ namespace sml
             void            InitializeStepList() ;
             void            InitializeUpdateWorldEvents(bool addListeners) ;
             bool            IsAgentFinished(AgentSML* pAgentSML, bool forever,  smlRunStepSize runStepSize, uint64_t count) ;
+            bool            CompleteAgentStep(AgentSML* pAgentSML, smlRunResult runResult, bool forever, smlRunStepSize runStepSize, uint64_t count) ;
+            bool            StepAgentsInParallel(smlRunStepSize interleaveStepSize) ;
+            void            StopWorkers() ;
             void            ResetRunCounters(smlRunStepSize runStepSize) ;
             void            TerminateUpdateWorldEvents(bool removeListeners) ;
             void            TestForFiringUpdateWorldEvents();
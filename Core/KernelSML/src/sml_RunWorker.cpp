@@ -0,0 +1,75 @@
+#include "portability.h"
+
+/////////////////////////////////////////////////////////////////
+// RunWorker class
+//
+// A thread owned by the RunScheduler which steps a share of the
+// scheduled agents when the kernel runs agents in parallel.
+//
+/////////////////////////////////////////////////////////////////
+
+#include "sml_RunWorker.h"
+
+#include "sml_AgentSML.h"
+
+using namespace sml ;
+
+RunWorker::RunWorker()
+{
+    m_pAgents  = 0 ;
+    m_pResults = 0 ;
+    m_First    = 0 ;
+    m_Stride   = 1 ;
+    m_StepSize = sml_PHASE ;
+}
+
+void RunWorker::StepAgentShare(StepAgentList* pAgents, StepResultList* pResults, size_t first, size_t stride, smlRunStepSize stepSize)
+{
+    for (size_t i = first ; i < pAgents->size() ; i += stride)
+    {
+        (*pResults)[i] = (*pAgents)[i]->StepInClientThread(stepSize) ;
+    }
+}
+
+void RunWorker::StepAgents(StepAgentList* pAgents, StepResultList* pResults, size_t first, size_t stride, smlRunStepSize stepSize)
+{
+    m_pAgents  = pAgents ;
+    m_pResults = pResults ;
+    m_First    = first ;
+    m_Stride   = stride ;
+    m_StepSize = stepSize ;
+
+    m_StartWork.TriggerEvent() ;
+}
+
+void RunWorker::WaitUntilDone()
+{
+    m_WorkDone.WaitForEventForever() ;
+}
+
+void RunWorker::Shutdown()
+{
+    m_QuitNow = true ;
+
+    // Wake the thread up so it notices it has been asked to quit
+    m_StartWork.TriggerEvent() ;
+
+    Stop(true) ;
+}
+
+void RunWorker::Run()
+{
+    while (!m_QuitNow)
+    {
+        m_StartWork.WaitForEventForever() ;
+
+        if (m_QuitNow)
+        {
+            break ;
+        }
+
+        StepAgentShare(m_pAgents, m_pResults, m_First, m_Stride, m_StepSize) ;
+
+        m_WorkDone.TriggerEvent() ;
+    }
+}
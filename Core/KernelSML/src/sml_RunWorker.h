@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////
+// RunWorker class
+//
+// A thread owned by the RunScheduler which steps a share of the
+// scheduled agents when the kernel runs agents in parallel.
+//
+// The scheduler hands every worker the same list of agents and
+// each worker steps every n-th agent starting at its own offset.
+// The scheduler then waits for all workers to finish before it
+// does any of the per-agent bookkeeping or fires kernel events,
+// so a round of parallel stepping looks just like a round of
+// round-robin stepping to the rest of the system.
+//
+/////////////////////////////////////////////////////////////////
+
+#ifndef SML_RUN_WORKER_H
+#define SML_RUN_WORKER_H
+
+#include "thread_Thread.h"
+#include "thread_Event.h"
+#include "sml_Events.h"
+
+#include <vector>
+
+namespace sml
+{
+
+// Forward declarations
+    class AgentSML ;
+
+    typedef std::vector<AgentSML*>      StepAgentList ;
+    typedef std::vector<smlRunResult>   StepResultList ;
+
+    class RunWorker : public soar_thread::Thread
+    {
+        protected:
+            soar_thread::Event  m_StartWork ;
+            soar_thread::Event  m_WorkDone ;
+
+            StepAgentList*      m_pAgents ;
+            StepResultList*     m_pResults ;
+            size_t              m_First ;
+            size_t              m_Stride ;
+            smlRunStepSize      m_StepSize ;
+
+            // This method is executed in the worker thread
+            void Run() ;
+
+        public:
+            RunWorker() ;
+
+            /*************************************************************
+            * @brief    Steps agents first, first + stride, ... in pAgents
+            *           on the worker thread, storing each result at the
+            *           same index in pResults.  Returns immediately.
+            *************************************************************/
+            void StepAgents(StepAgentList* pAgents, StepResultList* pResults, size_t first, size_t stride, smlRunStepSize stepSize) ;
+
+            /*************************************************************
+            * @brief    Blocks until the work given to StepAgents is done.
+            *************************************************************/
+            void WaitUntilDone() ;
+
+            /*************************************************************
+            * @brief    Asks the thread to exit and waits for it to do so.
+            *************************************************************/
+            void Shutdown() ;
+
+            /*************************************************************
+            * @brief    Steps agents first, first + stride, ... in pAgents
+            *           on the calling thread.
+            *************************************************************/
+            static void StepAgentShare(StepAgentList* pAgents, StepResultList* pResults, size_t first, size_t stride, smlRunStepSize stepSize) ;
+    } ;
+
+} // Namespace
+
+#endif  // SML_RUN_WORKER_H
@@ -20,6 +20,7 @@
 #include "sml_Connection.h"
 #include "sml_KernelSML.h"
 #include "sml_AgentSML.h"
+#include "sml_InputBatch.h"
 
 #include <assert.h>
 
@@ -114,6 +115,18 @@ void XMLListener::OnKernelEvent(int eventIDIn, AgentSML* pAgentSML, void* pCallD
     delete pMsg ;
 }
 
+// Converts a <wmes> batch into the equivalent list of <wme> tags
+static void AddBatchAsWmeTags(soarxml::ElementXML* pCommand, soarxml::ElementXML* pBatchXML)
+{
+    pBatchXML->ConvertCharacterDataToBinary() ;
+
+    InputBatch batch ;
+    if (batch.Deserialize(pBatchXML->GetCharacterData(), static_cast<size_t>(pBatchXML->GetCharacterDataLength())))
+    {
+        batch.AddWmeTags(pCommand) ;
+    }
+}
+
 // Echo the list of wmes received back to any listeners
 void XMLListener::FireInputReceivedEvent(soarxml::ElementXML const* pCommands)
 {
@@ -155,6 +168,11 @@ void XMLListener::FireInputReceivedEvent(soarxml::ElementXML const* pCommands)
             soarxml::ElementXML* pCopy = wme.MakeCopy() ;
             command.AddChild(pCopy) ;
         }
+        else if (wme.IsTag(sml_Names::kTagWMEBatch))
+        {
+            // Listeners expect one <wme> tag per change, so expand batches
+            AddBatchAsWmeTags(&command, &wme) ;
+        }
     }
     
     // This is important.  We are working with a subpart of pMsg.
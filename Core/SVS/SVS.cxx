@@ -21,6 +21,7 @@
 #include "src/filters/tag_select.cpp"
 #include "src/filters/volume.cpp"
 
+#include "src/bvh.cpp"
 #include "src/cliproxy.cpp"
 #include "src/command.cpp"
 #include "src/command_table.cpp"
@@ -0,0 +1,303 @@
+#include <algorithm>
+#include "bvh.h"
+#include "sgnode.h"
+
+using namespace std;
+
+/*
+ Leaf boxes are grown by this fraction of their size on each side, plus
+ a small absolute amount so that points and flat shapes get some slack.
+*/
+const double BVH_FAT_FRACTION = 0.1;
+const double BVH_FAT_MIN = 1e-3;
+
+/*
+ Half the surface area of a box, the cost measure used to decide where
+ to insert new leaves.
+*/
+static double half_area(const bbox& b)
+{
+    vec3 d = b.get_max() - b.get_min();
+    return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+}
+
+static bbox merge(const bbox& a, const bbox& b)
+{
+    bbox m = a;
+    m.include(b);
+    return m;
+}
+
+static bbox fatten(const bbox& b)
+{
+    vec3 margin = (b.get_max() - b.get_min()) * BVH_FAT_FRACTION;
+    for (int d = 0; d < 3; ++d)
+    {
+        margin[d] += BVH_FAT_MIN;
+    }
+    return bbox(b.get_min() - margin, b.get_max() + margin);
+}
+
+bvh::bvh()
+    : root(-1)
+{}
+
+void bvh::clear()
+{
+    tree.clear();
+    free_nodes.clear();
+    leaves.clear();
+    dirty.clear();
+    root = -1;
+}
+
+void bvh::insert(const sgnode* n)
+{
+    leaf_map::iterator i = leaves.find(n);
+    if (i != leaves.end())
+    {
+        mark_dirty(n);
+        return;
+    }
+    leaf_info& info = leaves[n];
+    info.leaf = -1;
+    info.dirty = true;
+    dirty.push_back(n);
+}
+
+void bvh::remove(const sgnode* n)
+{
+    leaf_map::iterator i = leaves.find(n);
+    if (i == leaves.end())
+    {
+        return;
+    }
+    if (i->second.leaf >= 0)
+    {
+        remove_leaf(i->second.leaf);
+        free_node(i->second.leaf);
+    }
+    leaves.erase(i);
+}
+
+void bvh::mark_dirty(const sgnode* n)
+{
+    leaf_map::iterator i = leaves.find(n);
+    if (i == leaves.end() || i->second.dirty)
+    {
+        return;
+    }
+    i->second.dirty = true;
+    dirty.push_back(n);
+}
+
+void bvh::query(const bbox& b, vector<const sgnode*>& result)
+{
+    refresh();
+    if (root < 0)
+    {
+        return;
+    }
+
+    vector<int> stack;
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+        const tree_node& t = tree[stack.back()];
+        stack.pop_back();
+        if (!t.box.intersects(b))
+        {
+            continue;
+        }
+        if (t.is_leaf())
+        {
+            if (t.obj->get_bounds().intersects(b))
+            {
+                result.push_back(t.obj);
+            }
+        }
+        else
+        {
+            stack.push_back(t.left);
+            stack.push_back(t.right);
+        }
+    }
+}
+
+int bvh::alloc_node()
+{
+    int i;
+    if (!free_nodes.empty())
+    {
+        i = free_nodes.back();
+        free_nodes.pop_back();
+    }
+    else
+    {
+        i = static_cast<int>(tree.size());
+        tree.resize(tree.size() + 1);
+    }
+    tree[i].parent = -1;
+    tree[i].left = -1;
+    tree[i].right = -1;
+    tree[i].obj = NULL;
+    return i;
+}
+
+void bvh::free_node(int i)
+{
+    tree[i].obj = NULL;
+    free_nodes.push_back(i);
+}
+
+/*
+ Walk down from the root toward the subtree whose box grows the least
+ when the new leaf is added, and pair the leaf with the node we stop at.
+*/
+void bvh::insert_leaf(int leaf)
+{
+    if (root < 0)
+    {
+        root = leaf;
+        tree[leaf].parent = -1;
+        return;
+    }
+
+    bbox leaf_box = tree[leaf].box;
+    int i = root;
+    while (!tree[i].is_leaf())
+    {
+        int left = tree[i].left, right = tree[i].right;
+        double area = half_area(tree[i].box);
+        double combined = half_area(merge(tree[i].box, leaf_box));
+
+        /* cost of making a new parent for this node and the leaf */
+        double cost = 2.0 * combined;
+
+        /* minimum cost of pushing the leaf further down */
+        double inherited = 2.0 * (combined - area);
+        double cost_left = half_area(merge(tree[left].box, leaf_box)) + inherited;
+        double cost_right = half_area(merge(tree[right].box, leaf_box)) + inherited;
+        if (!tree[left].is_leaf())
+        {
+            cost_left -= half_area(tree[left].box);
+        }
+        if (!tree[right].is_leaf())
+        {
+            cost_right -= half_area(tree[right].box);
+        }
+
+        if (cost < cost_left && cost < cost_right)
+        {
+            break;
+        }
+        i = (cost_left < cost_right) ? left : right;
+    }
+
+    int sibling = i;
+    int old_parent = tree[sibling].parent;
+    int new_parent = alloc_node();
+
+    tree[new_parent].parent = old_parent;
+    tree[new_parent].box = merge(tree[sibling].box, leaf_box);
+    tree[new_parent].left = sibling;
+    tree[new_parent].right = leaf;
+    tree[sibling].parent = new_parent;
+    tree[leaf].parent = new_parent;
+
+    if (old_parent < 0)
+    {
+        root = new_parent;
+    }
+    else if (tree[old_parent].left == sibling)
+    {
+        tree[old_parent].left = new_parent;
+    }
+    else
+    {
+        tree[old_parent].right = new_parent;
+    }
+    refit(old_parent);
+}
+
+/*
+ Unlinks a leaf from the tree by replacing its parent with its sibling.
+ The leaf itself is left allocated.
+*/
+void bvh::remove_leaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = -1;
+        return;
+    }
+
+    int parent = tree[leaf].parent;
+    int grandparent = tree[parent].parent;
+    int sibling = (tree[parent].left == leaf) ? tree[parent].right : tree[parent].left;
+
+    if (grandparent < 0)
+    {
+        root = sibling;
+        tree[sibling].parent = -1;
+    }
+    else
+    {
+        if (tree[grandparent].left == parent)
+        {
+            tree[grandparent].left = sibling;
+        }
+        else
+        {
+            tree[grandparent].right = sibling;
+        }
+        tree[sibling].parent = grandparent;
+        refit(grandparent);
+    }
+    free_node(parent);
+}
+
+void bvh::refit(int i)
+{
+    for (; i >= 0; i = tree[i].parent)
+    {
+        tree[i].box = merge(tree[tree[i].left].box, tree[tree[i].right].box);
+    }
+}
+
+/*
+ Reads the current bounds of every dirty node.  Nodes that are new, or
+ that have moved outside their fat box, are (re)inserted.
+*/
+void bvh::refresh()
+{
+    for (size_t d = 0, dend = dirty.size(); d < dend; ++d)
+    {
+        leaf_map::iterator i = leaves.find(dirty[d]);
+        if (i == leaves.end() || !i->second.dirty)
+        {
+            continue;
+        }
+        i->second.dirty = false;
+
+        const bbox& b = i->first->get_bounds();
+        int leaf = i->second.leaf;
+        if (leaf >= 0)
+        {
+            if (tree[leaf].box.contains(b))
+            {
+                continue;
+            }
+            remove_leaf(leaf);
+        }
+        else
+        {
+            leaf = alloc_node();
+            tree[leaf].obj = i->first;
+            i->second.leaf = leaf;
+        }
+        tree[leaf].box = fatten(b);
+        insert_leaf(leaf);
+    }
+    dirty.clear();
+}
@@ -0,0 +1,89 @@
+/*****************************************************************
+ *
+ * File SVS/src/bvh.h
+ *
+ * Contains:
+ *   class bvh
+ *
+ * A dynamic bounding volume hierarchy over the world bounds of
+ *   scene graph nodes.  Each node is a leaf of a binary tree of
+ *   axis-aligned boxes, and each inner box encloses its children,
+ *   so a spatial query only visits the subtrees whose boxes it
+ *   overlaps.
+ *
+ * Leaves store a slightly enlarged ("fat") copy of the node's
+ *   bounds.  A node that moves only has to be reinserted once it
+ *   leaves its fat box, so small movements do not touch the tree.
+ *
+ * Changes are applied lazily.  insert() and mark_dirty() only
+ *   record the node, and the bounds are read and the tree updated
+ *   the next time it is queried.  A parent transform change marks
+ *   every descendant dirty, and this keeps that O(1) per node.
+ *
+ *****************************************************************/
+#ifndef BVH_H
+#define BVH_H
+
+#include <vector>
+#include <unordered_map>
+#include "mat.h"
+
+class sgnode;
+
+class bvh
+{
+    public:
+        bvh();
+
+        void insert(const sgnode* n);
+        void remove(const sgnode* n);
+        void mark_dirty(const sgnode* n);
+        void clear();
+
+        /* Appends every node whose world bounds intersect b */
+        void query(const bbox& b, std::vector<const sgnode*>& result);
+
+        size_t size() const
+        {
+            return leaves.size();
+        }
+
+    private:
+        struct tree_node
+        {
+            bbox           box;
+            int            parent;
+            int            left;
+            int            right;
+            const sgnode*  obj;
+
+            bool is_leaf() const
+            {
+                return left < 0;
+            }
+        };
+
+        int  alloc_node();
+        void free_node(int i);
+        void insert_leaf(int leaf);
+        void remove_leaf(int leaf);
+        void refit(int i);
+        void refresh();
+
+        std::vector<tree_node>     tree;
+        std::vector<int>           free_nodes;
+        int                        root;
+
+        struct leaf_info
+        {
+            int   leaf;     // -1 if the node hasn't been placed in the tree yet
+            bool  dirty;
+        };
+
+        typedef std::unordered_map<const sgnode*, leaf_info> leaf_map;
+
+        leaf_map                    leaves;
+        std::vector<const sgnode*>  dirty;
+};
+
+#endif
@@ -30,6 +30,10 @@ void node_select_range_filter::set_range_from_params(const filter_params* p){
 		}
 }
 
+bool node_select_range_filter::above_range(double val){
+	return include_max ? (val > range_max) : (val >= range_max);
+}
+
 bool node_select_range_filter::falls_in_range(double val){
 	if(include_min && val < range_min)
 		return false;
@@ -108,9 +112,16 @@ bool node_comparison_select_filter::compute(const filter_params* p, sgnode*& out
     }
 
 		set_range_from_params(p);
+		out = b;
+		
+		// Broad phase, skip the comparison if even its lower bound is out of range
+		if (lower_bound && above_range(lower_bound(a, b, p)))
+		{
+			select = false;
+			return true;
+		}
 		
 		double res = comp(a, b, p);
-		out = b;
 		select = falls_in_range(res);
     return true;
 }
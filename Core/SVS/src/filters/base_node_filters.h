@@ -33,6 +33,8 @@
  *      bool falls_in_range(double v)
  *        returns true if the given value falls within the range 
  *        (satisfies min and max constraints)
+ *      bool above_range(double v)
+ *        returns true if the given value fails the max constraint
  *    Settings:
  *      set_min(double) - change the default min value
  *      set_max(double) - change the default max value
@@ -59,6 +61,9 @@
  *      max [Optional - defaults to +INF]
  *    Returns:
  *      sgnode b - if min <= node_comparison(a, b) <= max
+ *    Settings:
+ *      set_lower_bound(node_comparison*) - a cheap lower bound on the comparison,
+ *        pairs whose bound is already above max are rejected without calling it
  *
  *  node_comparison_rank_filter
  *    Parameters:
@@ -141,6 +146,7 @@ class node_select_range_filter : public select_filter<sgnode*>
 				}
 				void set_range_from_params(const filter_params* p);
 				bool falls_in_range(double val);
+				bool above_range(double val);
 
     private:
         double range_min;
@@ -204,13 +210,19 @@ class node_comparison_select_filter : public node_select_range_filter
     public:
         node_comparison_select_filter(Symbol* root, soar_interface* si,
                                       filter_input* input, node_comparison* comp)
-            : node_select_range_filter(root, si, input), comp(comp)
+            : node_select_range_filter(root, si, input), comp(comp), lower_bound(NULL)
         {}
         
         bool compute(const filter_params* p, sgnode*& out, bool& select);
         
+        void set_lower_bound(node_comparison* lb)
+        {
+            lower_bound = lb;
+        }
+        
     private:
         node_comparison* comp;
+        node_comparison* lower_bound;
 };
 
 class node_comparison_rank_filter : public rank_filter
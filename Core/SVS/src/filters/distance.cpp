@@ -23,6 +23,8 @@
  *    double max [optional - default = +INF]
  *   Returns:
  *    sgnode b if min <= dist(a, b) <= max
+ *   Hull distances are only computed for pairs whose bounding boxes
+ *    are within max of each other
  *
  *  Filter closest : node_comparison_rank_filter
  *    Parameters:
@@ -66,6 +68,21 @@ double compare_distance(sgnode* a, sgnode* b, const filter_params* p)
     }
 }
 
+/*
+ Lower bound on compare_distance used to reject pairs in distance_select
+ before running GJK.  Centroid distances are cheap, so they aren't bounded.
+*/
+double distance_lower_bound(sgnode* a, sgnode* b, const filter_params* p)
+{
+    string dist_type = "centroid";
+    get_filter_param(0, p, "distance_type", dist_type);
+    if (dist_type == "hull")
+    {
+        return bbox_distance(a, b);
+    }
+    return 0.0;
+}
+
 ///// filter distance //////
 filter* make_distance_filter(Symbol* root, soar_interface* si, scene* scn, filter_input* input)
 {
@@ -87,7 +104,9 @@ filter_table_entry* distance_filter_entry()
 ///// filter distance_select //////
 filter* make_distance_select_filter(Symbol* root, soar_interface* si, scene* scn, filter_input* input)
 {
-    return new node_comparison_select_filter(root, si, input, &compare_distance);
+    node_comparison_select_filter* f = new node_comparison_select_filter(root, si, input, &compare_distance);
+    f->set_lower_bound(&distance_lower_bound);
+    return f;
 }
 
 filter_table_entry* distance_select_filter_entry()
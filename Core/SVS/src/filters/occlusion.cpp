@@ -24,6 +24,9 @@
  *    (designed for extract_once)
  *    It may work for moving occluders, but will not recalculate the view lines
  *    if object a moves
+ *  Only occluders that were added or changed are tested against the view
+ *    lines on an update, and only view lines whose bounding boxes touch an
+ *    occluder's are tested with GJK
  ****************************************************************/
 
 #include <iostream>
@@ -39,6 +42,7 @@
 using namespace std;
 
 typedef map<const filter_params*, sgnode*> element_map;
+typedef map<const filter_params*, vector<bool> > occlusion_map;
 
 
 class occlusion_filter : public typed_filter<double> {
@@ -67,7 +71,9 @@ private:
 				return false;
 			}
 		}
-		calc_view_lines(a, eye, view_lines);
+		if(view_lines.empty()){
+			calc_view_lines(a, eye, view_lines);
+		}
 		return true;
 	}
 
@@ -91,6 +97,7 @@ private:
 				return false;
 			}
 			nodes[params] = b;
+			calc_occluded_view_lines(view_lines, b, occluded[params]);
 			changed = true;
 		}
 
@@ -104,6 +111,7 @@ private:
 				return false;
 			}
 			nodes[params] = b;
+			calc_occluded_view_lines(view_lines, b, occluded[params]);
 			changed = true;
 		}
 
@@ -112,15 +120,25 @@ private:
 		{
 			params = input->get_removed(i);
 			nodes.erase(params);
+			occluded.erase(params);
 			changed = true;
 		}
 
 		if(changed){
-			vector<const sgnode*> occluders;
-			for(element_map::const_iterator i = nodes.begin(); i != nodes.end(); i++){
-				occluders.push_back(i->second);
+			// Only the occluders that were added or changed above were tested
+			// against the view lines, the rest reuse their earlier results
+			int num_occluded = 0;
+			for(size_t j = 0, jend = view_lines.size(); j < jend; j++){
+				view_lines[j].second = false;
+				for(occlusion_map::const_iterator i = occluded.begin(); i != occluded.end(); i++){
+					if(i->second[j]){
+						view_lines[j].second = true;
+						num_occluded++;
+						break;
+					}
+				}
 			}
-			double res = convex_occlusion(view_lines, occluders);
+			double res = view_lines.empty() ? 0 : ((double)num_occluded)/view_lines.size();
 			set_output(NULL, res);
 		}
 
@@ -133,6 +151,7 @@ private:
 	sgnode* eye;
 	vector<view_line> view_lines; // Set of lines from eye to vertices of a
 	element_map nodes;  // Set of nodes to check as occluders
+	occlusion_map occluded;  // Which view lines each of those nodes occludes
 };
 
 filter *make_occlusion_filter(Symbol *root, soar_interface *si, scene *scn, filter_input *input) {
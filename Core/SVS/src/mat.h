@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <vector>
+#include <cmath>
+#include <algorithm>
 #include "serializable.h"
 
 #ifdef __clang__
@@ -335,6 +337,21 @@ class bbox
             return true;
         }
         
+        /* distance between the closest points of the two boxes, 0 if they intersect */
+        double distance(const bbox& b) const
+        {
+            double sum = 0.0;
+            for (int d = 0; d < 3; ++d)
+            {
+                double gap = std::max(b.min_pt[d] - max_pt[d], min_pt[d] - b.max_pt[d]);
+                if (gap > 0.0)
+                {
+                    sum += gap * gap;
+                }
+            }
+            return sqrt(sum);
+        }
+        
         bool contains(const bbox& b) const
         {
             int d;
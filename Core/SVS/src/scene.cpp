@@ -81,6 +81,7 @@ scene::scene(const string& name, svs* owner)
 {
     root = new group_node(root_id);
     nodes.push_back(root);
+    nodes_by_id[root_id] = root;
     root->listen(this);
 }
 
@@ -100,6 +101,7 @@ scene* scene::clone(const string& cname) const
     // Remove empty root
     c->root->unlisten(c);
     c->nodes.clear();
+    c->nodes_by_id.clear();
     delete c->root;
     
     // Replace with copy of root
@@ -108,32 +110,27 @@ scene* scene::clone(const string& cname) const
     for (size_t i = 0, iend = c->nodes.size(); i < iend; ++i)
     {
         c->nodes[i]->listen(c);
+        c->index_node(c->nodes[i]);
     }
     return c;
 }
 
 sgnode* scene::get_node(const string& id)
 {
-    node_table::iterator i, iend;
-    for (i = nodes.begin(), iend = nodes.end(); i != iend; ++i)
+    node_index::iterator i = nodes_by_id.find(id);
+    if (i != nodes_by_id.end())
     {
-        if ((*i)->get_id() == id)
-        {
-            return *i;
-        }
+        return i->second;
     }
     return NULL;
 }
 
 const sgnode* scene::get_node(const string& id) const
 {
-    node_table::const_iterator i, iend;
-    for (i = nodes.begin(), iend = nodes.end(); i != iend; ++i)
+    node_index::const_iterator i = nodes_by_id.find(id);
+    if (i != nodes_by_id.end())
     {
-        if ((*i)->get_id() == id)
-        {
-            return *i;
-        }
+        return i->second;
     }
     return NULL;
 }
@@ -166,6 +163,25 @@ void scene::get_all_nodes(vector<const sgnode*>& n) const
     }
 }
 
+void scene::get_nodes_in_bounds(const bbox& b, vector<const sgnode*>& n) const
+{
+    bounds_tree.query(b, n);
+}
+
+/*
+ Adds a node that was just added to the node table to the id index and
+ the bounding volume hierarchy.  The root isn't put in the hierarchy since
+ its bounds always enclose everything else.
+*/
+void scene::index_node(sgnode* n)
+{
+    nodes_by_id[n->get_id()] = n;
+    if (n != root)
+    {
+        bounds_tree.insert(n);
+    }
+}
+
 bool scene::add_node(const string& parent_id, sgnode* n)
 {
     group_node* par = get_group(parent_id);
@@ -555,6 +571,7 @@ void scene::node_update(sgnode* n, sgnode::change_type t, const std::string& upd
         child->listen(this);
         sgnode*& node = grow_vec(nodes);
         node = child;
+        index_node(child);
         
         if (draw)
         {
@@ -563,11 +580,7 @@ void scene::node_update(sgnode* n, sgnode::change_type t, const std::string& upd
         return;
     }
     
-    size_t i, iend;
-    for (i = 0, iend = nodes.size(); i < iend && nodes[i] != n; ++i)
-        ;
-    assert(i != nodes.size());
-    if (i == 0)
+    if (n == root)
     {
         return;
     }
@@ -579,20 +592,31 @@ void scene::node_update(sgnode* n, sgnode::change_type t, const std::string& upd
         case sgnode::TAG_CHANGED:
             break;
         case sgnode::DELETED:
-            nodes.erase(nodes.begin() + i);
+        {
+            node_table::iterator i = std::find(nodes.begin(), nodes.end(), n);
+            assert(i != nodes.end());
+            nodes.erase(i);
+            if (get_node(n->get_id()) == n)
+            {
+                nodes_by_id.erase(n->get_id());
+            }
+            bounds_tree.remove(n);
             
-            if (draw && i != 0)
+            if (draw)
             {
                 d->del(name, n);
             }
             break;
+        }
         case sgnode::SHAPE_CHANGED:
+            bounds_tree.mark_dirty(n);
             if (!n->is_group() && draw)
             {
                 d->change(name, n, drawer::SHAPE);
             }
             break;
         case sgnode::TRANSFORM_CHANGED:
+            bounds_tree.mark_dirty(n);
             if (draw)
             {
                 d->change(name, n, drawer::POS | drawer::ROT | drawer::SCALE);
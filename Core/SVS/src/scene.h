@@ -3,8 +3,10 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <cassert>
 #include "sgnode.h"
+#include "bvh.h"
 #include "common.h"
 #include "cliproxy.h"
 
@@ -39,6 +41,9 @@ class scene : public sgnode_listener, public cliproxy
         void get_all_nodes(std::vector<sgnode*>& nodes);
         void get_all_nodes(std::vector<const sgnode*>& nodes) const;
         
+        /* Appends every node other than the root whose world bounds intersect b */
+        void get_nodes_in_bounds(const bbox& b, std::vector<const sgnode*>& nodes) const;
+        
         bool add_node(const std::string& parent_id, sgnode* n);
         bool del_node(const std::string& id);
         void clear();
@@ -65,13 +70,18 @@ class scene : public sgnode_listener, public cliproxy
         void verify_listeners() const;
     private:
         typedef std::vector<sgnode*> node_table;
+        typedef std::unordered_map<std::string, sgnode*> node_index;
         
         std::string  name;
         group_node*  root;
         svs*         owner;
         node_table   nodes;
+        node_index   nodes_by_id;
+        mutable bvh  bounds_tree;
         bool         draw;
         
+        void index_node(sgnode* n);
+        
         
         int parse_add(std::vector<std::string>& f, std::string& error);
         int parse_del(std::vector<std::string>& f, std::string& error);
@@ -77,12 +77,72 @@ double point_geom_convex_dist(const vec3& p, const geometry_node* g)
     return dist > 0.0 ? dist : 0.0;
 }
 
+/*
+ Broad phase for the convex distance functions below.  The distance
+ between two bounding boxes is a lower bound on the distance between the
+ shapes inside them, so candidate pairs are visited in order of their box
+ distance and the search stops as soon as no remaining pair can beat the
+ closest one found so far.
+*/
+typedef std::pair<double, std::pair<size_t, size_t> > geom_pair;
+
+// Gets the convex distance between a point and the closest of a set of geometry nodes //
+double point_geoms_convex_dist(const vec3& p, const c_geom_node_list& g)
+{
+    vector<geom_pair> pairs;
+    bbox pbox(p);
+    double best = INF;
+    
+    pairs.reserve(g.size());
+    for (size_t i = 0, iend = g.size(); i < iend; ++i)
+    {
+        pairs.push_back(make_pair(pbox.distance(g[i]->get_bounds()), make_pair(i, i)));
+    }
+    sort(pairs.begin(), pairs.end());
+    
+    for (size_t i = 0, iend = pairs.size(); i < iend && pairs[i].first < best; ++i)
+    {
+        best = min(best, point_geom_convex_dist(p, g[pairs[i].second.first]));
+        if (best <= 0.0)
+        {
+            break;
+        }
+    }
+    return best;
+}
+
+// Gets the convex distance between the closest pair from two sets of geometry nodes //
+double geoms_convex_dist(const c_geom_node_list& g1, const c_geom_node_list& g2)
+{
+    vector<geom_pair> pairs;
+    double best = INF;
+    
+    pairs.reserve(g1.size() * g2.size());
+    for (size_t i = 0, iend = g1.size(); i < iend; ++i)
+    {
+        const bbox& b1 = g1[i]->get_bounds();
+        for (size_t j = 0, jend = g2.size(); j < jend; ++j)
+        {
+            pairs.push_back(make_pair(b1.distance(g2[j]->get_bounds()), make_pair(i, j)));
+        }
+    }
+    sort(pairs.begin(), pairs.end());
+    
+    for (size_t i = 0, iend = pairs.size(); i < iend && pairs[i].first < best; ++i)
+    {
+        best = min(best, geom_convex_dist(g1[pairs[i].second.first], g2[pairs[i].second.second]));
+        if (best <= 0.0)
+        {
+            break;
+        }
+    }
+    return best;
+}
+
 // Gets the convex distance between two sgnodes //
 double convex_distance(const sgnode* a, const sgnode* b)
 {
-    vector<const geometry_node*> g1, g2;
-    vector<double> dists;
-    vec3 c;
+    c_geom_node_list g1, g2;
     
     if (a == b || a->has_descendent(b) || b->has_descendent(a))
     {
@@ -99,34 +159,13 @@ double convex_distance(const sgnode* a, const sgnode* b)
     
     if (g1.empty())
     {
-        dists.reserve(g2.size());
-        c = a->get_centroid();
-        for (size_t i = 0, iend = g2.size(); i < iend; ++i)
-        {
-            dists.push_back(point_geom_convex_dist(c, g2[i]));
-        }
+        return point_geoms_convex_dist(a->get_centroid(), g2);
     }
     else if (g2.empty())
     {
-        dists.reserve(g1.size());
-        c = b->get_centroid();
-        for (size_t i = 0, iend = g1.size(); i < iend; ++i)
-        {
-            dists.push_back(point_geom_convex_dist(c, g1[i]));
-        }
+        return point_geoms_convex_dist(b->get_centroid(), g1);
     }
-    else
-    {
-        dists.reserve(g1.size() * g2.size());
-        for (size_t i = 0, iend = g1.size(); i < iend; ++i)
-        {
-            for (size_t j = 0, jend = g2.size(); j < jend; ++j)
-            {
-                dists.push_back(geom_convex_dist(g1[i], g2[j]));
-            }
-        }
-    }
-    return *min_element(dists.begin(), dists.end());
+    return geoms_convex_dist(g1, g2);
 }
 
 // Returns the euclidean distance between the centroids of two nodes //
@@ -262,6 +301,13 @@ bool bbox_intersects(const sgnode* a, const sgnode* b)
     return boxa.intersects(boxb);
 }
 
+// Returns the distance between the bounding boxes of nodes a and b,
+//   a lower bound on their convex distance
+double bbox_distance(const sgnode* a, const sgnode* b)
+{
+    return a->get_bounds().distance(b->get_bounds());
+}
+
 // Returns true if the bounding box of node a 
 //   contains the bounding box of node b
 bool bbox_contains(const sgnode* a, const sgnode* b)
@@ -285,6 +331,11 @@ double convex_overlap(const sgnode* n1, const sgnode* n2, int nsamples){
 		return 0;
 	}
 
+	if(!n1->get_bounds().intersects(n2->get_bounds())){
+		// Broad phase, the nodes can't overlap if their bounding boxes don't
+		return 0;
+	}
+
 	vector<const geometry_node*> g1, g2;
 	n1->walk_geoms(g1);
 	n2->walk_geoms(g2);
@@ -417,6 +468,23 @@ void calc_view_lines(const sgnode* target, const sgnode* eye, view_line_list& vi
 }
 
 
+// Marks which of the given view lines are intersected by the occluder
+//   Only lines whose bounding boxes touch the occluder's are tested with GJK
+void calc_occluded_view_lines(const view_line_list& view_lines, const sgnode* occluder, std::vector<bool>& occluded){
+	occluded.assign(view_lines.size(), false);
+
+	const bbox& occluder_box = occluder->get_bounds();
+	for(size_t i = 0, iend = view_lines.size(); i < iend; i++){
+		const sgnode* line = view_lines[i].first;
+		if(!occluder_box.intersects(line->get_bounds())){
+			continue;
+		}
+		if(convex_distance(occluder, line) <= 0){
+			occluded[i] = true;
+		}
+	}
+}
+
 // Returns the percentage of given view lines are intersected by an object in occludingNodes
 double convex_occlusion(view_line_list& view_lines, const c_sgnode_list& occluders){
 	if(view_lines.size() == 0){
@@ -433,25 +501,12 @@ double convex_occlusion(view_line_list& view_lines, const c_sgnode_list& occlude
 		i->second = false;
 	}
 
+	std::vector<bool> occluded;
 	for(c_sgnode_list::const_iterator i = occluders.begin(); i != occluders.end(); i++){
-		const sgnode* n = *i;
-		//std::cout << "Testing Object " << n->get_id() << std::endl;
-		for(view_line_list::iterator j = view_lines.begin(); j != view_lines.end(); j++){
-			view_line& view_line = *j;
-			if(view_line.second){
-				// Already occluded, don't bother checking again
-				continue;
-			}
-			double dist = convex_distance(n, view_line.first);
-			if(dist <= 0){
-				if(n->get_id() == "arm"){
-					//std::cout << "ARM OCCLUSION!" << std::endl;
-				}
-				//std::cout << "Occlusion detected" << std::endl;
-				//std::cout << "  " << j->first->get_id() << std::endl;
-				//std::cout << "  " << n->get_id() << std::endl; 
-
-				view_line.second = true;
+		calc_occluded_view_lines(view_lines, *i, occluded);
+		for(size_t j = 0, jend = view_lines.size(); j < jend; j++){
+			if(occluded[j] && !view_lines[j].second){
+				view_lines[j].second = true;
 				num_occluded++;
 			}
 		}
@@ -612,7 +667,9 @@ void adjust_sgnode_size(sgnode* n, std::vector<const sgnode*> targets){
 void adjust_sgnode_size(sgnode* n, scene* scn){
 	std::vector<const sgnode*> targets;
 	std::vector<const sgnode*> all;
-	scn->get_all_nodes(all);
+	// Only nodes whose bounds overlap n can intersect it, so let the scene's
+	// bounding volume hierarchy prune the rest before the convex tests
+	scn->get_nodes_in_bounds(n->get_bounds(), all);
 	for(std::vector<const sgnode*>::const_iterator i = all.begin(); i != all.end(); i++){
 		if(*i == n){
 			continue;
@@ -24,6 +24,8 @@ bool convex_intersects(const sgnode* a, const sgnode* b);
 
 bool bbox_intersects(const sgnode* a, const sgnode* b);
 
+double bbox_distance(const sgnode* a, const sgnode* b);
+
 bool bbox_contains(const sgnode* a, const sgnode* b);
 
 double convex_overlap(const sgnode* a, const sgnode* b, int nsamples);
@@ -32,6 +34,8 @@ typedef std::pair<convex_node*, bool> view_line;
 
 void calc_view_lines(const sgnode* target, const sgnode* eye, std::vector<view_line> &view_lines);
 
+void calc_occluded_view_lines(const std::vector<view_line> &view_lines, const sgnode* occluder, std::vector<bool> &occluded);
+
 double convex_occlusion(const sgnode* target, const sgnode* eye, const std::vector<const sgnode*>  &occluders);
 
 double convex_occlusion(std::vector<view_line> &view_lines, const std::vector<const sgnode*> &occluders);
@@ -1,5 +1,6 @@
 #include <action_record.cpp>
 #include <agent.cpp>
+#include <alpha_table.cpp>
 #include <callback.cpp>
 #include <chunk_record.cpp>
 #include <cmd_settings.cpp>
@@ -28,6 +29,7 @@
 #include <ebc_variablize.cpp>
 #include <ebc.cpp>
 #include <episodic_memory.cpp>
+#include <epmem_snapshot.cpp>
 #include <explain_print.cpp>
 #include <explanation_memory.cpp>
 #include <explanation_settings.cpp>
@@ -62,7 +64,9 @@
 #include <smem_activation.cpp>
 #include <smem_cli_commands.cpp>
 #include <smem_db.cpp>
+#include <smem_import.cpp>
 #include <smem_instance.cpp>
+#include <smem_native_store.cpp>
 #include <smem_print.cpp>
 #include <smem_query.cpp>
 #include <smem_settings.cpp>
@@ -75,6 +79,7 @@
 #include <soar_to_string.cpp>
 #include <stats.cpp>
 #include <symbol_manager.cpp>
+#include <symbol_table.cpp>
 #include <symbol.cpp>
 #include <test.cpp>
 #include <trace.cpp>
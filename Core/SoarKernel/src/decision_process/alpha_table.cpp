@@ -0,0 +1,175 @@
+/*
+ * alpha_table.cpp
+ *
+ *  Open-addressing hash table that the rete uses to find alpha
+ *  memories.  See alpha_table.h for an overview.
+ */
+
+#include "alpha_table.h"
+
+#include "agent.h"
+#include "memory_manager.h"
+#include "rete.h"
+
+#include <assert.h>
+
+/* Smallest number of slots a table ever has.  Must be a power of two. */
+#define ALPHA_TABLE_MINIMUM_SIZE 16
+#define ALPHA_TABLE_MINIMUM_LOG2SIZE 4
+
+Alpha_Table::Alpha_Table()
+{
+    thisAgent = NULL;
+    slots = NULL;
+    size = 0;
+    shift = 0;
+    count = 0;
+}
+
+void Alpha_Table::init(agent* pAgent)
+{
+    thisAgent = pAgent;
+    count = 0;
+    allocate_slots(ALPHA_TABLE_MINIMUM_SIZE);
+}
+
+void Alpha_Table::clean_up()
+{
+    if (slots)
+    {
+        thisAgent->memoryManager->free_memory(slots, HASH_TABLE_MEM_USAGE);
+        slots = NULL;
+    }
+    size = 0;
+    count = 0;
+}
+
+void Alpha_Table::allocate_slots(uint32_t pSize)
+{
+    uint32_t log2size = ALPHA_TABLE_MINIMUM_LOG2SIZE;
+
+    while ((static_cast<uint32_t>(1) << log2size) < pSize)
+    {
+        log2size++;
+    }
+    slots = static_cast<alpha_table_slot*>(thisAgent->memoryManager->allocate_memory(pSize * sizeof(alpha_table_slot), HASH_TABLE_MEM_USAGE));
+    for (uint32_t i = 0; i < pSize; i++)
+    {
+        slots[i].hash = 0;
+        slots[i].am = NIL;
+    }
+    size = pSize;
+    shift = 32 - log2size;
+}
+
+alpha_mem* Alpha_Table::find(uint32_t hash, Symbol* id, Symbol* attr, Symbol* value)
+{
+    uint32_t mask = size - 1;
+    uint32_t i;
+    alpha_mem* am;
+
+    for (i = home_slot(hash); (am = slots[i].am) != NIL; i = (i + 1) & mask)
+    {
+        if ((slots[i].hash == hash) && (am->id == id) && (am->attr == attr) && (am->value == value))
+        {
+            return am;
+        }
+    }
+    return NIL;
+}
+
+void Alpha_Table::insert_slot(uint32_t hash, alpha_mem* am)
+{
+    uint32_t mask = size - 1;
+    uint32_t i = home_slot(hash);
+
+    while (slots[i].am)
+    {
+        i = (i + 1) & mask;
+    }
+    slots[i].hash = hash;
+    slots[i].am = am;
+}
+
+void Alpha_Table::delete_slot(uint32_t index)
+{
+    uint32_t mask = size - 1;
+    uint32_t hole = index;
+    uint32_t i = index;
+    uint32_t home;
+
+    /* --- pull back any later entry in the run whose probe sequence
+     *     passes through the hole --- */
+    for (i = (i + 1) & mask; slots[i].am; i = (i + 1) & mask)
+    {
+        home = home_slot(slots[i].hash);
+        if ((hole < i) ? ((home <= hole) || (home > i)) : ((home <= hole) && (home > i)))
+        {
+            slots[hole] = slots[i];
+            hole = i;
+        }
+    }
+    slots[hole].hash = 0;
+    slots[hole].am = NIL;
+}
+
+void Alpha_Table::add(alpha_mem* am, uint32_t hash)
+{
+    count++;
+    if (count > (size / 2))
+    {
+        resize(size * 2);
+    }
+    insert_slot(hash, am);
+}
+
+void Alpha_Table::remove(alpha_mem* am, uint32_t hash)
+{
+    uint32_t mask = size - 1;
+    uint32_t i;
+
+    for (i = home_slot(hash); slots[i].am; i = (i + 1) & mask)
+    {
+        if (slots[i].am == am)
+        {
+            delete_slot(i);
+            count--;
+            if ((size > ALPHA_TABLE_MINIMUM_SIZE) && (count < (size / 8)))
+            {
+                resize(size / 2);
+            }
+            return;
+        }
+    }
+    assert(false && "Couldn't find alpha memory to remove from alpha table!");
+}
+
+void Alpha_Table::resize(uint32_t new_size)
+{
+    alpha_table_slot* old_slots = slots;
+    uint32_t old_size = size;
+    uint32_t i;
+
+    allocate_slots(new_size);
+    for (i = 0; i < old_size; i++)
+    {
+        if (old_slots[i].am)
+        {
+            insert_slot(old_slots[i].hash, old_slots[i].am);
+        }
+    }
+    thisAgent->memoryManager->free_memory(old_slots, HASH_TABLE_MEM_USAGE);
+}
+
+void Alpha_Table::do_for_all_items(hash_table_callback_fn2 f, void* userdata)
+{
+    uint32_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        if (slots[i].am && (*f)(thisAgent, slots[i].am, userdata))
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * alpha_table.h
+ *
+ *  Open-addressing hash table that the rete uses to find alpha
+ *  memories.  See the comment at the end of the file.
+ */
+
+#ifndef CORE_SOARKERNEL_SRC_DECISION_PROCESS_ALPHA_TABLE_H_
+#define CORE_SOARKERNEL_SRC_DECISION_PROCESS_ALPHA_TABLE_H_
+
+#include "kernel.h"
+#include "mem.h"
+
+typedef struct alpha_mem_struct alpha_mem;
+
+typedef struct alpha_table_slot_struct
+{
+    uint32_t    hash;
+    alpha_mem*  am;
+} alpha_table_slot;
+
+class Alpha_Table
+{
+    public:
+
+        Alpha_Table();
+        ~Alpha_Table() {};
+
+        void        init(agent* pAgent);
+        void        clean_up();
+
+        uint64_t    get_count() { return count; }
+
+        /* --- index of the first slot a probe for this hash looks at --- */
+        uint32_t    home_slot(uint32_t hash) { return (hash * 0x9E3779B1u) >> shift; }
+        void        prefetch(uint32_t hash)
+        {
+#if defined(__GNUC__)
+            __builtin_prefetch(&slots[home_slot(hash)]);
+#endif
+        }
+
+        alpha_mem*  find(uint32_t hash, Symbol* id, Symbol* attr, Symbol* value);
+        void        add(alpha_mem* am, uint32_t hash);
+        void        remove(alpha_mem* am, uint32_t hash);
+
+        void        do_for_all_items(hash_table_callback_fn2 f, void* userdata);
+
+    private:
+
+        agent*              thisAgent;
+
+        alpha_table_slot*   slots;
+        uint32_t            size;
+        uint32_t            shift;
+        uint64_t            count;
+
+        void                allocate_slots(uint32_t pSize);
+        void                insert_slot(uint32_t hash, alpha_mem* am);
+        void                delete_slot(uint32_t index);
+        void                resize(uint32_t new_size);
+};
+
+#endif /* CORE_SOARKERNEL_SRC_DECISION_PROCESS_ALPHA_TABLE_H_ */
+
+/* ======================================================================
+                              alpha_table.h
+
+   Every wme added to the rete is looked up in eight of the sixteen alpha
+   tables, one for each combination of id/attr/value that an alpha memory
+   can test.  An Alpha_Table keeps an array of (hash, alpha memory) slots
+   and uses linear probing, so each of those lookups touches one or two
+   adjacent slots instead of walking a bucket chain, and the slot can be
+   prefetched as soon as the hash is known.
+
+   The hash stored in a slot is the xor of the hash_ids of the symbols the
+   memory tests.  Symbol hash_ids are handed out in fixed steps, so xors
+   of them cluster badly in the low bits; home_slot() multiplies by a
+   large odd constant and takes the high bits instead (Fibonacci hashing).
+
+   Since a table only belongs to one combination of tests, two memories in
+   the same table are equal exactly when their id, attr and value are, and
+   find() doesn't need to know which combination the table is for.
+
+   Alpha memories are only created and freed when productions are added
+   and excised, so unlike the Symbol_Table there is no incremental
+   resize: the table simply rehashes when it is half full or less than
+   an eighth full.  Deletion uses backward shift, so no tombstones build
+   up.
+====================================================================== */
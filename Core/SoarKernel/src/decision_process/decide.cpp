@@ -1891,8 +1891,9 @@ Symbol* create_new_impasse(agent* thisAgent, bool isa_goal, Symbol* object, Symb
             }
             if (level > TOP_GOAL_LEVEL)
             {
-                lSSWME->local_singleton_id_identity_set = thisAgent->explanationBasedChunker->get_floating_identity(impasseID);
-                lSSWME->local_singleton_value_identity_set = thisAgent->explanationBasedChunker->get_floating_identity(impasseID);
+                wme_cold* lSSCold = wme_cold_data(thisAgent, lSSWME);
+                lSSCold->local_singleton_id_identity_set = thisAgent->explanationBasedChunker->get_floating_identity(impasseID);
+                lSSCold->local_singleton_value_identity_set = thisAgent->explanationBasedChunker->get_floating_identity(impasseID);
             }
         }
         Symbol* lreward_header = thisAgent->symbolManager->make_new_identifier('R', level);
@@ -2159,9 +2160,9 @@ void decide_non_context_slot(agent* thisAgent, slot* s)
         else
         {
             remove_from_dll(s->wmes, w, next, prev);
-            if (w->gds)
+            if (wme_gds(w))
             {
-                if (w->gds->goal != NIL)
+                if (w->cold->gds->goal != NIL)
                 {
                     /* If the goal pointer is non-NIL, then goal is in the stack */
                     gds_invalid_so_remove_goal(thisAgent, w);
@@ -2484,7 +2485,7 @@ void remove_existing_context_and_descendents(agent* thisAgent, Symbol* goal)
         }
     }
 
-    goal->id->rl_info->eligibility_traces->~rl_et_map();
+    goal->id->rl_info->eligibility_traces->~rl_et_store();
     thisAgent->memoryManager->free_with_pool(MP_rl_et, goal->id->rl_info->eligibility_traces);
     goal->id->rl_info->prev_op_rl_rules->~production_list();
     thisAgent->memoryManager->free_with_pool(MP_rl_rule, goal->id->rl_info->prev_op_rl_rules);
@@ -2595,7 +2596,7 @@ void create_new_context(agent* thisAgent, Symbol* attr_of_impasse, byte impasse_
     id->id->rl_info->gap_age = 0;
     id->id->rl_info->hrl_age = 0;
     thisAgent->memoryManager->allocate_with_pool(MP_rl_et, &(id->id->rl_info->eligibility_traces));
-    id->id->rl_info->eligibility_traces = new(id->id->rl_info->eligibility_traces) rl_et_map();
+    id->id->rl_info->eligibility_traces = new(id->id->rl_info->eligibility_traces) rl_et_store();
     thisAgent->memoryManager->allocate_with_pool(MP_rl_rule, &(id->id->rl_info->prev_op_rl_rules));
     id->id->rl_info->prev_op_rl_rules = new(id->id->rl_info->prev_op_rl_rules) production_list();
 
@@ -2994,6 +2995,7 @@ void init_decider(agent* thisAgent)
 {
     thisAgent->memoryManager->init_memory_pool(MP_slot, sizeof(slot), "slot");
     thisAgent->memoryManager->init_memory_pool(MP_wme, sizeof(wme), "wme");
+    thisAgent->memoryManager->init_memory_pool(MP_wme_cold, sizeof(wme_cold), "wme cold");
     thisAgent->memoryManager->init_memory_pool(MP_preference, sizeof(preference), "preference");
 }
 
@@ -3541,15 +3543,15 @@ void uniquely_add_to_head_of_dll(agent* thisAgent, instantiation* inst)
 void add_wme_to_gds(agent* thisAgent, goal_dependency_set* gds, wme* wme_to_add)
 {
     /* Set the correct GDS for this wme (wme's point to their gds) */
-    wme_to_add->gds = gds;
-    insert_at_head_of_dll(gds->wmes_in_gds, wme_to_add, gds_next, gds_prev);
+    wme_cold_data(thisAgent, wme_to_add)->gds = gds;
+    insert_at_head_of_dll(gds->wmes_in_gds, wme_to_add, cold->gds_next, cold->gds_prev);
 
     if (thisAgent->trace_settings[TRACE_GDS_WMES_SYSPARAM])
     {
         // BADBAD: the XML code makes this all very ugly
         char msgbuf[256];
         memset(msgbuf, 0, 256);
-        thisAgent->outputManager->sprinta_sf_cstr(thisAgent, msgbuf, 255, "Adding to GDS for %y: ", wme_to_add->gds->goal);
+        thisAgent->outputManager->sprinta_sf_cstr(thisAgent, msgbuf, 255, "Adding to GDS for %y: ", wme_to_add->cold->gds->goal);
         thisAgent->outputManager->printa(thisAgent,  msgbuf);
 
         xml_begin_tag(thisAgent, kTagVerbose);
@@ -3616,29 +3618,29 @@ void elaborate_gds(agent* thisAgent)
 
             if ((pref_for_this_wme == NIL) || (wme_goal_level < inst->match_goal_level))
             {
-                if (wme_matching_this_cond->gds != NIL)
+                if (wme_gds(wme_matching_this_cond) != NIL)
                 {
                     /* Then we want to check and see if the old GDS value should be changed */
-                    if (wme_matching_this_cond->gds->goal == NIL)
+                    if (wme_matching_this_cond->cold->gds->goal == NIL)
                     {
                         /* The goal is NIL: meaning that the goal for the GDS is no longer around */
-                        fast_remove_from_dll(wme_matching_this_cond->gds->wmes_in_gds,  wme_matching_this_cond, wme, gds_next, gds_prev);
+                        fast_remove_from_dll(wme_matching_this_cond->cold->gds->wmes_in_gds,  wme_matching_this_cond, wme, cold->gds_next, cold->gds_prev);
 
                         /* Must check for GDS removal every time we take a WME off the GDS wme list */
-                        if (!wme_matching_this_cond->gds->wmes_in_gds)
+                        if (!wme_matching_this_cond->cold->gds->wmes_in_gds)
                         {
-                            if (wme_matching_this_cond->gds->goal)
+                            if (wme_matching_this_cond->cold->gds->goal)
                             {
-                                wme_matching_this_cond->gds->goal->id->gds = NIL;
+                                wme_matching_this_cond->cold->gds->goal->id->gds = NIL;
                             }
 
-                            thisAgent->memoryManager->free_with_pool(MP_gds, wme_matching_this_cond->gds);
+                            thisAgent->memoryManager->free_with_pool(MP_gds, wme_matching_this_cond->cold->gds);
 
                         }
 
                         add_wme_to_gds(thisAgent, inst->match_goal->id->gds, wme_matching_this_cond);
                     }
-                    else if (wme_matching_this_cond->gds->goal->id->level > inst->match_goal_level)
+                    else if (wme_matching_this_cond->cold->gds->goal->id->level > inst->match_goal_level)
                     {
                         /* This WME currently belongs to the GDS of a goal below the current one */
                         /* 1. Take WME off old (current) GDS list
@@ -3646,19 +3648,19 @@ void elaborate_gds(agent* thisAgent)
                          * 3. Add WME to new GDS list
                          * 4. Update WME pointer to new GDS list
                          */
-                        fast_remove_from_dll(wme_matching_this_cond->gds->wmes_in_gds,  wme_matching_this_cond, wme, gds_next, gds_prev);
-                        if (!wme_matching_this_cond->gds->wmes_in_gds)
+                        fast_remove_from_dll(wme_matching_this_cond->cold->gds->wmes_in_gds,  wme_matching_this_cond, wme, cold->gds_next, cold->gds_prev);
+                        if (!wme_matching_this_cond->cold->gds->wmes_in_gds)
                         {
-                            if (wme_matching_this_cond->gds->goal)
+                            if (wme_matching_this_cond->cold->gds->goal)
                             {
-                                wme_matching_this_cond->gds->goal->id->gds = NIL;
+                                wme_matching_this_cond->cold->gds->goal->id->gds = NIL;
                             }
 
-                            thisAgent->memoryManager->free_with_pool(MP_gds, wme_matching_this_cond->gds);
+                            thisAgent->memoryManager->free_with_pool(MP_gds, wme_matching_this_cond->cold->gds);
 
                         }
                         add_wme_to_gds(thisAgent, inst->match_goal->id->gds, wme_matching_this_cond);
-                        wme_matching_this_cond->gds = inst->match_goal->id->gds;
+                        wme_matching_this_cond->cold->gds = inst->match_goal->id->gds;
                     }
                 }
                 else
@@ -3666,11 +3668,11 @@ void elaborate_gds(agent* thisAgent)
                     /* WME should be in the GDS of the current goal if the WME's GDS does not already exist. (i.e., if NIL GDS) */
                     add_wme_to_gds(thisAgent, inst->match_goal->id->gds, wme_matching_this_cond);
 
-                    if (wme_matching_this_cond->gds->wmes_in_gds->gds_prev)
+                    if (wme_matching_this_cond->cold->gds->wmes_in_gds->cold->gds_prev)
                     {
                         thisAgent->outputManager->printa_sf(thisAgent, "\nDEBUG DEBUG : The new header should never have a prev value.\n");
                     }
-                } /* end else clause for "if wme_matching_this_cond->gds != NIL" */
+                } /* end else clause for "if wme_matching_this_cond->cold->gds != NIL" */
             } /* end "wme in supergoal or arch-supported" */
             else
             {
@@ -3702,48 +3704,48 @@ void elaborate_gds(agent* thisAgent)
                                 wme* fake_inst_wme_cond;
 
                                 fake_inst_wme_cond = pref_for_this_wme->inst->top_of_instantiated_conditions->bt.wme_;
-                                if (fake_inst_wme_cond->gds != NIL)
+                                if (wme_gds(fake_inst_wme_cond) != NIL)
                                 {
                                     /* Then we want to check and see if the old GDS value should be changed */
-                                    if (fake_inst_wme_cond->gds->goal == NIL)
+                                    if (fake_inst_wme_cond->cold->gds->goal == NIL)
                                     {
                                         /* The goal is NIL: meaning that the goal for the GDS is no longer around */
 
-                                        fast_remove_from_dll(fake_inst_wme_cond->gds->wmes_in_gds, fake_inst_wme_cond, wme, gds_next, gds_prev);
+                                        fast_remove_from_dll(fake_inst_wme_cond->cold->gds->wmes_in_gds, fake_inst_wme_cond, wme, cold->gds_next, cold->gds_prev);
 
                                         /* We have to check for GDS removal anytime we take a WME off the GDS wme list, not just when a WME
                                          * is removed from memory. */
-                                        if (!fake_inst_wme_cond->gds->wmes_in_gds)
+                                        if (!fake_inst_wme_cond->cold->gds->wmes_in_gds)
                                         {
-                                            if (fake_inst_wme_cond->gds->goal)
+                                            if (fake_inst_wme_cond->cold->gds->goal)
                                             {
-                                                fake_inst_wme_cond->gds->goal->id->gds = NIL;
+                                                fake_inst_wme_cond->cold->gds->goal->id->gds = NIL;
                                             }
-                                            thisAgent->memoryManager->free_with_pool(MP_gds, fake_inst_wme_cond->gds);
+                                            thisAgent->memoryManager->free_with_pool(MP_gds, fake_inst_wme_cond->cold->gds);
                                         }
 
                                         add_wme_to_gds(thisAgent, inst->match_goal->id->gds, fake_inst_wme_cond);
                                     }
-                                    else if (fake_inst_wme_cond->gds->goal->id->level > inst->match_goal_level)
+                                    else if (fake_inst_wme_cond->cold->gds->goal->id->level > inst->match_goal_level)
                                     {
                                         /* If the WME currently belongs to the GDS of a goal below the current one:
                                          * 1. Take WME off old (current) GDS list
                                          * 2. Check to see if old GDS WME list is empty. If so, remove(free) it.
                                          * 3. Add WME to new GDS list
                                          * 4. Update WME pointer to new GDS list */
-                                        fast_remove_from_dll(fake_inst_wme_cond->gds->wmes_in_gds, fake_inst_wme_cond, wme, gds_next, gds_prev);
-                                        if (!fake_inst_wme_cond->gds->wmes_in_gds)
+                                        fast_remove_from_dll(fake_inst_wme_cond->cold->gds->wmes_in_gds, fake_inst_wme_cond, wme, cold->gds_next, cold->gds_prev);
+                                        if (!fake_inst_wme_cond->cold->gds->wmes_in_gds)
                                         {
-                                            if (fake_inst_wme_cond->gds->goal)
+                                            if (fake_inst_wme_cond->cold->gds->goal)
                                             {
-                                                fake_inst_wme_cond->gds->goal->id->gds = NIL;
+                                                fake_inst_wme_cond->cold->gds->goal->id->gds = NIL;
                                             }
 
-                                            thisAgent->memoryManager->free_with_pool(MP_gds, fake_inst_wme_cond->gds);
+                                            thisAgent->memoryManager->free_with_pool(MP_gds, fake_inst_wme_cond->cold->gds);
                                         }
 
                                         add_wme_to_gds(thisAgent, inst->match_goal->id->gds, fake_inst_wme_cond);
-                                        fake_inst_wme_cond->gds = inst->match_goal->id->gds;
+                                        fake_inst_wme_cond->cold->gds = inst->match_goal->id->gds;
                                     }
                                 }
                                 else
@@ -3752,7 +3754,7 @@ void elaborate_gds(agent* thisAgent)
 
                                     add_wme_to_gds(thisAgent, inst->match_goal->id->gds, fake_inst_wme_cond);
 
-                                    if (fake_inst_wme_cond->gds->wmes_in_gds->gds_prev)
+                                    if (fake_inst_wme_cond->cold->gds->wmes_in_gds->cold->gds_prev)
                                     {
                                         thisAgent->outputManager->printa_sf(thisAgent, "\nDEBUG DEBUG : The new header should never have a prev value.\n");
                                     }
@@ -3853,7 +3855,7 @@ void gds_invalid_so_remove_goal(agent* thisAgent, wme* w)
         // BADBAD: the XML code makes this all very ugly
         char msgbuf[256];
         memset(msgbuf, 0, 256);
-        thisAgent->outputManager->sprinta_sf_cstr(thisAgent, msgbuf, 255, "Removing state %y because element in GDS changed. WME: ", w->gds->goal);
+        thisAgent->outputManager->sprinta_sf_cstr(thisAgent, msgbuf, 255, "Removing state %y because element in GDS changed. WME: ", w->cold->gds->goal);
         thisAgent->outputManager->printa(thisAgent, msgbuf);
 
         xml_begin_tag(thisAgent, soar_TraceNames::kTagVerbose);
@@ -3890,15 +3892,15 @@ void gds_invalid_so_remove_goal(agent* thisAgent, wme* w)
 
     if (thisAgent->highest_goal_whose_context_changed)
     {
-        if (thisAgent->highest_goal_whose_context_changed->id->level >= w->gds->goal->id->level)
+        if (thisAgent->highest_goal_whose_context_changed->id->level >= w->cold->gds->goal->id->level)
         {
-            thisAgent->highest_goal_whose_context_changed = w->gds->goal->id->higher_goal;
+            thisAgent->highest_goal_whose_context_changed = w->cold->gds->goal->id->higher_goal;
         }
     }
     else
     {
         /* If nothing has yet changed (highest_ ... = NIL) then set the goal automatically */
-        thisAgent->highest_goal_whose_context_changed = w->gds->goal->id->higher_goal;
+        thisAgent->highest_goal_whose_context_changed = w->cold->gds->goal->id->higher_goal;
 
         // Tell those slots they are changed so that the impasses can be regenerated bug 1011
         for (slot* s = thisAgent->highest_goal_whose_context_changed->id->slots; s != 0; s = s->next)
@@ -3912,11 +3914,11 @@ void gds_invalid_so_remove_goal(agent* thisAgent, wme* w)
 
     if (thisAgent->trace_settings[TRACE_GDS_STATE_REMOVAL_SYSPARAM])
     {
-        thisAgent->outputManager->printa_sf(thisAgent, "\n    REMOVING GOAL [%y] due to change in GDS WME ", w->gds->goal);
+        thisAgent->outputManager->printa_sf(thisAgent, "\n    REMOVING GOAL [%y] due to change in GDS WME ", w->cold->gds->goal);
         print_wme(thisAgent, w);
     }
 
-    remove_existing_context_and_descendents(thisAgent, w->gds->goal);
+    remove_existing_context_and_descendents(thisAgent, w->cold->gds->goal);
 
     /* BUG: Need to reset highest_goal here ???*/
 
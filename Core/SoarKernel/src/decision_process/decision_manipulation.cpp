@@ -119,7 +119,7 @@ void predict_srand_store_snapshot(agent* thisAgent)
 
     while (!storage_val)
     {
-        storage_val = SoarRandInt();
+        storage_val = thisAgent->rng->randInt();
     }
 
     thisAgent->predict_seed = storage_val;
@@ -132,7 +132,7 @@ void predict_srand_restore_snapshot(agent* thisAgent, bool clear_snapshot)
 {
     if (thisAgent->predict_seed)
     {
-        SoarSeedRNG(thisAgent->predict_seed);
+        thisAgent->rng->seed(thisAgent->predict_seed);
     }
 
     if (clear_snapshot)
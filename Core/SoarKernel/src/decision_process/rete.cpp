@@ -29,6 +29,9 @@
 #include <assert.h>
 #include <sstream>
 #include <stdlib.h>
+#include <string.h>
+#include <unordered_set>
+#include <vector>
 
 /*************************************************************************
  *
@@ -1199,41 +1202,19 @@ inline bool wme_matches_alpha_mem(wme* w, alpha_mem* am)
 }
 
 /* --- Returns hash value for the given id/attr/value symbols --- */
-/*#define alpha_hash_value(i,a,v,num_bits) \
- ( ( ((i) ? ((Symbol *)(i))->hash_id : 0) ^ \
-     ((a) ? ((Symbol *)(a))->hash_id : 0) ^ \
-     ((v) ? ((Symbol *)(v))->hash_id : 0) ) & \
-   masks_for_n_low_order_bits[(num_bits)] )*/
-inline uint32_t alpha_hash_value(Symbol* i, Symbol* a, Symbol* v, short num_bits)
+inline uint32_t alpha_hash_value(Symbol* i, Symbol* a, Symbol* v)
 {
     return
-        (((i ? i->hash_id : 0) ^
-          (a ? a->hash_id : 0) ^
-          (v ? v->hash_id : 0)) &
-         masks_for_n_low_order_bits[(num_bits)]);
-}
-
-/* --- rehash funciton for resizable hash table routines --- */
-uint32_t hash_alpha_mem(void* item, short num_bits)
-{
-    alpha_mem* am;
-
-    am = static_cast<alpha_mem_struct*>(item);
-    return alpha_hash_value(am->id, am->attr, am->value, num_bits);
+        ((i ? i->hash_id : 0) ^
+         (a ? a->hash_id : 0) ^
+         (v ? v->hash_id : 0));
 }
 
 /* --- Which of the 16 hash tables to use? --- */
-/*#define table_for_tests(id,attr,value,acceptable) \
-  thisAgent->alpha_hash_tables [ ((id) ? 1 : 0) + ((attr) ? 2 : 0) + \
-                                     ((value) ? 4 : 0) + \
-                                     ((acceptable) ? 8 : 0) ]*/
-inline hash_table* table_for_tests(agent* thisAgent,
-                                   Symbol* id, Symbol* attr, Symbol* value,
-                                   bool acceptable)
+inline uint32_t table_index_for_tests(Symbol* id, Symbol* attr, Symbol* value,
+                                      bool acceptable)
 {
-    return thisAgent->alpha_hash_tables [(id ? 1 : 0) + (attr ? 2 : 0) +
-                                         (value ? 4 : 0) +
-                                         (acceptable ? 8 : 0) ];
+    return (id ? 1 : 0) + (attr ? 2 : 0) + (value ? 4 : 0) + (acceptable ? 8 : 0);
 }
 
 //#define get_next_alpha_mem_id() (thisAgent->alpha_mem_id_counter++)
@@ -1289,21 +1270,10 @@ void remove_wme_from_alpha_mem(agent* thisAgent, right_mem* rm)
 alpha_mem* find_alpha_mem(agent* thisAgent, Symbol* id, Symbol* attr,
                           Symbol* value, bool acceptable)
 {
-    hash_table* ht;
-    alpha_mem* am;
-    uint32_t hash_value;
+    uint32_t table_index;
 
-    ht = table_for_tests(thisAgent, id, attr, value, acceptable);
-    hash_value = alpha_hash_value(id, attr, value, ht->log2size);
-
-    for (am = reinterpret_cast<alpha_mem*>(*(ht->buckets + hash_value)); am != NIL;
-            am = am->next_in_hash_table)
-        if ((am->id == id) && (am->attr == attr) &&
-                (am->value == value) && (am->acceptable == acceptable))
-        {
-            return am;
-        }
-    return NIL;
+    table_index = table_index_for_tests(id, attr, value, acceptable);
+    return thisAgent->alpha_tables[table_index].find(alpha_hash_value(id, attr, value), id, attr, value);
 }
 
 /* --- Find and share existing alpha memory, or create new one.  Adjusts
@@ -1311,8 +1281,8 @@ alpha_mem* find_alpha_mem(agent* thisAgent, Symbol* id, Symbol* attr,
 alpha_mem* find_or_make_alpha_mem(agent* thisAgent, Symbol* id, Symbol* attr,
                                   Symbol* value, bool acceptable)
 {
-    hash_table* ht;
     alpha_mem* am, *more_general_am;
+    uint32_t table_index;
     wme* w;
     right_mem* rm;
 
@@ -1326,7 +1296,6 @@ alpha_mem* find_or_make_alpha_mem(agent* thisAgent, Symbol* id, Symbol* attr,
 
     /* --- no existing alpha_mem found, so create a new one --- */
     thisAgent->memoryManager->allocate_with_pool(MP_alpha_mem, &am);
-    am->next_in_hash_table = NIL;
     am->right_mems = NIL;
     am->beta_nodes = NIL;
     am->last_beta_node = NIL;
@@ -1348,8 +1317,9 @@ alpha_mem* find_or_make_alpha_mem(agent* thisAgent, Symbol* id, Symbol* attr,
     }
     am->acceptable = acceptable;
     am->am_id = get_next_alpha_mem_id(thisAgent);
-    ht = table_for_tests(thisAgent, id, attr, value, acceptable);
-    add_to_hash_table(thisAgent, ht, am);
+    table_index = table_index_for_tests(id, attr, value, acceptable);
+    thisAgent->alpha_tables[table_index].add(am, alpha_hash_value(id, attr, value));
+    thisAgent->alpha_tables_in_use |= (1 << table_index);
 
     /* --- fill new mem with any existing matching WME's --- */
     more_general_am = NIL;
@@ -1383,46 +1353,76 @@ alpha_mem* find_or_make_alpha_mem(agent* thisAgent, Symbol* id, Symbol* attr,
     return am;
 }
 
-/* --- Using the given hash table and hash value, try to find a
-   matching alpha memory in the indicated hash bucket.  If we find one,
-   we add the wme to it and inform successor nodes. --- */
-void add_wme_to_aht(agent* thisAgent, hash_table* ht, uint32_t hash_value, wme* w)
+/* --- The probes one wme makes into the alpha tables: the hash value
+   for each of the eight tables it could match in, and which of those
+   tables have any alpha memories at all. --- */
+typedef struct alpha_probes_struct
 {
-    alpha_mem* am;
-    rete_node* node, *next;
+    uint32_t hash_values[8];
+    uint32_t first_table;       /* 0, or 8 for acceptable preference wmes */
+    uint32_t tables_to_probe;   /* bit k set if table first_table+k is in use */
+} alpha_probes;
+
+/* --- Computes all eight hash values for a wme at once and starts fetching
+   the alpha table slots they point at.  Table first_table+k tests the id
+   if bit 0 of k is set, the attr if bit 1 is, and the value if bit 2 is.
+   The hashes are computed with masks instead of branches so that the
+   compiler can do all eight together in vector registers. --- */
+inline void compute_alpha_probes(agent* thisAgent, wme* w, alpha_probes* probes)
+{
+    uint32_t hi, ha, hv, k;
+
+    hi = w->id->hash_id;
+    ha = w->attr->hash_id;
+    hv = w->value->hash_id;
+    for (k = 0; k < 8; k++)
+    {
+        probes->hash_values[k] = (hi & (0u - (k & 1))) ^
+                                 (ha & (0u - ((k >> 1) & 1))) ^
+                                 (hv & (0u - ((k >> 2) & 1)));
+    }
 
-    hash_value = hash_value & masks_for_n_low_order_bits[ht->log2size];
-    am = reinterpret_cast<alpha_mem*>(*(ht->buckets + hash_value));
-    while (am != NIL)
+    probes->first_table = w->acceptable ? 8 : 0;
+    probes->tables_to_probe = (thisAgent->alpha_tables_in_use >> probes->first_table) & 0xFF;
+    for (k = 0; k < 8; k++)
     {
-        if (wme_matches_alpha_mem(w, am))
+        if (probes->tables_to_probe & (1 << k))
         {
-            /* --- found the right alpha memory, first add the wme --- */
-            add_wme_to_alpha_mem(thisAgent, w, am);
-
-            /* --- now call the beta nodes --- */
-            for (node = am->beta_nodes; node != NIL; node = next)
-            {
-                next = node->b.posneg.next_from_alpha_mem;
-                (*(right_addition_routines[node->node_type]))(thisAgent, node, w);
-            }
-            return; /* only one possible alpha memory per table could match */
+            thisAgent->alpha_tables[probes->first_table + k].prefetch(probes->hash_values[k]);
         }
-        am = am->next_in_hash_table;
     }
 }
 
-/* We cannot use 'xor' as the name of a function because it is defined in UNIX. */
-//#define xor_op(i,a,v) ((i) ^ (a) ^ (v))
-inline uint32_t xor_op(uint32_t i, uint32_t a, uint32_t v)
+/* --- Using table first_table+k and its hash value, try to find the
+   matching alpha memory.  If we find one, we add the wme to it and
+   inform successor nodes. --- */
+inline void add_wme_to_aht(agent* thisAgent, alpha_probes* probes, uint32_t k, wme* w)
 {
-    return ((i) ^ (a) ^ (v));
+    alpha_mem* am;
+    rete_node* node, *next;
+
+    am = thisAgent->alpha_tables[probes->first_table + k].find(probes->hash_values[k],
+            (k & 1) ? w->id : NIL, (k & 2) ? w->attr : NIL, (k & 4) ? w->value : NIL);
+    if (!am)
+    {
+        return;
+    }
+
+    /* --- found the right alpha memory, first add the wme --- */
+    add_wme_to_alpha_mem(thisAgent, w, am);
+
+    /* --- now call the beta nodes --- */
+    for (node = am->beta_nodes; node != NIL; node = next)
+    {
+        next = node->b.posneg.next_from_alpha_mem;
+        (*(right_addition_routines[node->node_type]))(thisAgent, node, w);
+    }
 }
 
-/* --- Adds a WME to the Rete. --- */
-void add_wme_to_rete(agent* thisAgent, wme* w)
+/* --- Adds a WME to the Rete, given the probes computed for it. --- */
+void add_wme_to_rete(agent* thisAgent, wme* w, alpha_probes* probes)
 {
-    uint32_t hi, ha, hv;
+    uint32_t k;
 
     /* --- add w to all_wmes_in_rete --- */
     insert_at_head_of_dll(thisAgent->all_wmes_in_rete, w, rete_next, rete_prev);
@@ -1432,35 +1432,20 @@ void add_wme_to_rete(agent* thisAgent, wme* w)
     w->right_mems = NIL;
     w->tokens = NIL;
 
-    /* --- add w to the appropriate alpha_mem in each of 8 possible tables --- */
-    hi = w->id->hash_id;
-    ha = w->attr->hash_id;
-    hv = w->value->hash_id;
-
-    if (w->acceptable)
+    /* --- add w to the appropriate alpha_mem in each of 8 possible tables,
+       in table order (the order successors get right activations in) --- */
+    for (k = 0; k < 8; k++)
     {
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[8],  xor_op(0, 0, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[9],  xor_op(hi, 0, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[10], xor_op(0, ha, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[11], xor_op(hi, ha, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[12], xor_op(0, 0, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[13], xor_op(hi, 0, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[14], xor_op(0, ha, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[15], xor_op(hi, ha, hv), w);
+        if (probes->tables_to_probe & (1 << k))
+        {
+            add_wme_to_aht(thisAgent, probes, k, w);
+        }
     }
-    else
+    if (w->cold)
     {
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[0],  xor_op(0, 0, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[1],  xor_op(hi, 0, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[2],  xor_op(0, ha, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[3],  xor_op(hi, ha, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[4],  xor_op(0, 0, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[5],  xor_op(hi, 0, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[6],  xor_op(0, ha, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[7],  xor_op(hi, ha, hv), w);
+        w->cold->epmem_id = EPMEM_NODEID_BAD;
+        w->cold->epmem_valid = NIL;
     }
-    w->epmem_id = EPMEM_NODEID_BAD;
-    w->epmem_valid = NIL;
     {
         if (thisAgent->EpMem->epmem_db->get_status() == soar_module::connected)
         {
@@ -1487,19 +1472,54 @@ void add_wme_to_rete(agent* thisAgent, wme* w)
     }
 }
 
+/* --- Adds a WME to the Rete. --- */
+void add_wme_to_rete(agent* thisAgent, wme* w)
+{
+    alpha_probes probes;
+
+    compute_alpha_probes(thisAgent, w, &probes);
+    add_wme_to_rete(thisAgent, w, &probes);
+}
+
+/* --- Adds a list of WMEs to the Rete, in order.  The probes for each wme
+   are computed, and its alpha table slots fetched, while the one before
+   it is still working its way through the beta network. --- */
+void add_wmes_to_rete(agent* thisAgent, cons* wmes)
+{
+    alpha_probes probes[2];
+    uint32_t current = 0;
+    cons* c;
+
+    if (!wmes)
+    {
+        return;
+    }
+    compute_alpha_probes(thisAgent, static_cast<wme*>(wmes->first), &probes[current]);
+    for (c = wmes; c != NIL; c = c->rest)
+    {
+        if (c->rest)
+        {
+            compute_alpha_probes(thisAgent, static_cast<wme*>(c->rest->first), &probes[1 - current]);
+        }
+        add_wme_to_rete(thisAgent, static_cast<wme*>(c->first), &probes[current]);
+        current = 1 - current;
+    }
+}
+
 inline void _epmem_remove_wme(agent* thisAgent, wme* w)
 {
     bool was_encoded = false;
+    bool is_encoded = w->cold && (w->cold->epmem_id != EPMEM_NODEID_BAD) && (w->cold->epmem_valid == thisAgent->EpMem->epmem_validation);
 
     if (w->value->symbol_type == IDENTIFIER_SYMBOL_TYPE)
     {
         bool lti = (w->value->id->LTI_ID != NIL);
 
-        if ((w->epmem_id != EPMEM_NODEID_BAD) && (w->epmem_valid == thisAgent->EpMem->epmem_validation))
+        if (is_encoded)
         {
             was_encoded = true;
 
-            (*thisAgent->EpMem->epmem_edge_removals)[ std::make_pair(w->epmem_id,static_cast<int64_t>((lti ? w->value->id->LTI_ID : 0))) ] = true;
+            (*thisAgent->EpMem->epmem_edge_removals)[ std::make_pair(w->cold->epmem_id,static_cast<int64_t>((lti ? w->value->id->LTI_ID : 0))) ] = true;
 
 #ifdef DEBUG_EPMEM_WME_ADD
             fprintf(stderr, "   wme destroyed: %d %d %d\n",
@@ -1513,8 +1533,8 @@ inline void _epmem_remove_wme(agent* thisAgent, wme* w)
                 fprintf(stderr, "   returning WME to pool: %d %d %d\n",
                         (unsigned int) w->id->id->epmem_id, (unsigned int) epmem_temporal_hash(thisAgent, w->attr), (unsigned int) w->value->id->epmem_id);
 #endif
-                epmem_return_id_pool::iterator p = thisAgent->EpMem->epmem_id_replacement->find(w->epmem_id);
-                (*p->second).push_front(std::make_pair(w->value->id->epmem_id, w->epmem_id));
+                epmem_return_id_pool::iterator p = thisAgent->EpMem->epmem_id_replacement->find(w->cold->epmem_id);
+                (*p->second).push_front(std::make_pair(w->value->id->epmem_id, w->cold->epmem_id));
                 thisAgent->EpMem->epmem_id_replacement->erase(p);
             }
         }
@@ -1545,17 +1565,17 @@ inline void _epmem_remove_wme(agent* thisAgent, wme* w)
             }
         }
     }
-    else if ((w->epmem_id != EPMEM_NODEID_BAD) && (w->epmem_valid == thisAgent->EpMem->epmem_validation))
+    else if (is_encoded)
     {
         was_encoded = true;
 
-        (*thisAgent->EpMem->epmem_node_removals)[ w->epmem_id ] = true;
+        (*thisAgent->EpMem->epmem_node_removals)[ w->cold->epmem_id ] = true;
     }
 
     if (was_encoded)
     {
-        w->epmem_id = EPMEM_NODEID_BAD;
-        w->epmem_valid = NIL;
+        w->cold->epmem_id = EPMEM_NODEID_BAD;
+        w->cold->epmem_valid = NIL;
     }
 }
 
@@ -1706,7 +1726,7 @@ void remove_wme_from_rete(agent* thisAgent, wme* w)
 /* --- Decrements reference count, deallocates alpha memory if unused. --- */
 void remove_ref_to_alpha_mem(agent* thisAgent, alpha_mem* am)
 {
-    hash_table* ht;
+    uint32_t table_index;
 
     am->reference_count--;
     if (am->reference_count != 0)
@@ -1714,8 +1734,12 @@ void remove_ref_to_alpha_mem(agent* thisAgent, alpha_mem* am)
         return;
     }
     /* --- remove from hash table, and deallocate the alpha_mem --- */
-    ht = table_for_tests(thisAgent, am->id, am->attr, am->value, am->acceptable);
-    remove_from_hash_table(thisAgent, ht, am);
+    table_index = table_index_for_tests(am->id, am->attr, am->value, am->acceptable);
+    thisAgent->alpha_tables[table_index].remove(am, alpha_hash_value(am->id, am->attr, am->value));
+    if (thisAgent->alpha_tables[table_index].get_count() == 0)
+    {
+        thisAgent->alpha_tables_in_use &= ~(1 << table_index);
+    }
     if (am->id)
     {
         thisAgent->symbolManager->symbol_remove_ref(&am->id);
@@ -3779,6 +3803,7 @@ byte add_production_to_rete(agent* thisAgent, production* p, condition* lhs_top,
         {
             continue;
         }
+        rl_write_back_value(thisAgent, p_node->b.p.prod);
         if (!ignore_rhs && !same_rhs(p_node->b.p.prod->action_list, p->action_list, thisAgent->RL->rl_params->chunk_stop->get_value() == on))
         {
             continue;
@@ -4307,6 +4332,9 @@ void p_node_to_conditions_and_rhs(agent* thisAgent,
 
     if (dest_rhs)
     {
+        /* a Soar-RL rule's RHS may not hold its latest value yet */
+        rl_write_back_value(thisAgent, prod);
+
         thisAgent->highest_rhs_unboundvar_index = -1;
         if (prod->rhs_unbound_variables)
         {
@@ -6559,6 +6587,9 @@ void remove_token_and_subtree(agent* thisAgent, token* root)
 
    File format (version 3):
      [Note: all 16-bit or 32-bit words are written LSB first]
+     [Version 4 is version 3 with every 4-byte count and index widened to
+      8 bytes.  Version 5 is version 4 plus the exact float constants and
+      the per-production learning state noted below.]
 
      magic number sequence: "SoarCompactReteNet\n"
      1 byte: 0 (null termination for the above string)
@@ -6571,7 +6602,8 @@ void remove_token_and_subtree(agent* thisAgent, token* root)
        names of all str_constants (each a null-terminated string)
        names of all variables (each a null-terminated string)
        values of all int_constants (each as a null-terminated ASCII string)
-       values of all float_constants (each as a null-terminated ASCII string)
+       values of all float_constants (each as a null-terminated ASCII string;
+         version 5: 8 bytes, the IEEE bits of the value)
 
      4 bytes: number of alpha memories
        definitions of all alpha memories, each of the form:
@@ -6603,11 +6635,19 @@ void remove_token_and_subtree(agent* thisAgent, token* root)
                record for the list of RHS actions
                4 bytes: number of RHS unbound variables
                  RHS unbound variables (symindices for each one)
+               version 5: original rule name (null-terminated string)
+                          8 bytes: naming depth
+                          6 x 8 bytes: RL update count, delta-bar-delta
+                            beta and h, ecr, efr and gql (IEEE doubles)
                1 byte (0 or 1): flag -- is there node_varnames info?
                  if yes:  node_varnames records for this production
     4 bytes: number of children
     node records for each child
 
+  Justifications are not saved.  From version 5 on, nodes that lead only
+  to justifications are left out, so saving no longer requires excising
+  them first; earlier versions refuse to save while justifications exist.
+
   EXTERNAL INTERFACE:
   Save_rete_net() and load_rete_net() save and load everything to and
   from the given (already open) files.  They return true if successful,
@@ -6616,6 +6656,11 @@ void remove_token_and_subtree(agent* thisAgent, token* root)
 
 FILE* rete_fs_file;  /* File handle we're using -- "fs" for "fast-save" */
 bool rete_net_64; // used by reteload_eight_bytes, retesave_eight_bytes, BADBAD global, fix with rete_fs_file above
+uint8_t rete_net_version; // format version of the file being saved or loaded, same caveat as above
+
+/* --- while loading, the whole file is read into memory and consumed from there --- */
+std::vector<uint8_t> reteload_buf;
+size_t reteload_pos;
 
 /* ----------------------------------------------------------------------
                 Save/Load Bytes, Short and Long Integers
@@ -6631,9 +6676,14 @@ void retesave_one_byte(uint8_t b, FILE* /*f*/)
     fputc(b, rete_fs_file);
 }
 
-uint8_t reteload_one_byte(FILE* f)
+uint8_t reteload_one_byte(FILE* /*f*/)
 {
-    return static_cast<uint8_t>(fgetc(f));
+    /* --- past the end, act like fgetc() returning EOF --- */
+    if (reteload_pos >= reteload_buf.size())
+    {
+        return 0xFF;
+    }
+    return reteload_buf[reteload_pos++];
 }
 
 void retesave_two_bytes(uint16_t w, FILE* f)
@@ -6712,6 +6762,22 @@ uint64_t reteload_eight_bytes(FILE* f)
     return i;
 }
 
+/* --- doubles go out as their IEEE bits, so they reload exactly --- */
+void retesave_double(double d, FILE* f)
+{
+    uint64_t w;
+    memcpy(&w, &d, sizeof(w));
+    retesave_eight_bytes(w, f);
+}
+
+double reteload_double(FILE* f)
+{
+    uint64_t w = reteload_eight_bytes(f);
+    double d;
+    memcpy(&d, &w, sizeof(d));
+    return d;
+}
+
 /* ----------------------------------------------------------------------
                             Save/Load Strings
 
@@ -6741,7 +6807,8 @@ void reteload_string(FILE* f)
         ch = reteload_one_byte(f);
         reteload_string_buf[i++] = static_cast<char>(ch);
     }
-    while (ch);
+    while (ch && (i < static_cast<int>(sizeof(reteload_string_buf)) - 1));
+    reteload_string_buf[i] = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -6762,7 +6829,8 @@ void reteload_string(FILE* f)
          names of all str_constants (each a null-terminated string)
          names of all variables (each a null-terminated string)
          values of all int_constants (each as a null-term. ASCII string)
-         values of all float_constants (each as a null-term. ASCII string)
+         values of all float_constants (each as a null-term. ASCII string,
+           or in version 5 the 8 bytes of the IEEE double)
 
    To reload symbols, we read the records and make new symbols, and
    also create an array (reteload_symbol_table) that maps from the
@@ -6775,7 +6843,7 @@ void reteload_string(FILE* f)
 void retesave_symbol_table(agent* thisAgent, FILE* f)
 {
     thisAgent->current_retesave_symindex = 0;
-    thisAgent->symbolManager->retesave(f);
+    thisAgent->symbolManager->retesave(f, (rete_net_version >= 5));
 }
 
 void reteload_all_symbols(agent* thisAgent, FILE* f)
@@ -6817,9 +6885,16 @@ void reteload_all_symbols(agent* thisAgent, FILE* f)
     }
     for (i = 0; i < num_float_constants; i++)
     {
-        reteload_string(f);
-        *(current_place_in_symtab++) =
-            thisAgent->symbolManager->make_float_constant(strtod(reteload_string_buf, NULL));
+        if (rete_net_version >= 5)
+        {
+            *(current_place_in_symtab++) = thisAgent->symbolManager->make_float_constant(reteload_double(f));
+        }
+        else
+        {
+            reteload_string(f);
+            *(current_place_in_symtab++) =
+                thisAgent->symbolManager->make_float_constant(strtod(reteload_string_buf, NULL));
+        }
     }
 }
 
@@ -6902,12 +6977,11 @@ void retesave_alpha_memories(agent* thisAgent, FILE* f)
     num_ams = 0;
     for (i = 0; i < 16; i++)
     {
-        num_ams += thisAgent->alpha_hash_tables[i]->count;
+        num_ams += thisAgent->alpha_tables[i].get_count();
     }
     retesave_eight_bytes(num_ams, f);
     for (i = 0; i < 16; i++)
-        do_for_all_items_in_hash_table(thisAgent, thisAgent->alpha_hash_tables[i],
-                                       retesave_alpha_mem_and_assign_index, f);
+        thisAgent->alpha_tables[i].do_for_all_items(retesave_alpha_mem_and_assign_index, f);
 }
 
 void reteload_alpha_memories(agent* thisAgent, FILE* f)
@@ -7476,6 +7550,7 @@ rete_test* reteload_rete_test_list(agent* thisAgent, FILE* f)
                 record for the list of RHS actions
                 4 bytes: number of RHS unbound variables
                   RHS unbound variables (symindices for each one)
+                version 5: original rule name, naming depth and RL values
                 1 byte (0 or 1): flag -- is there node_varnames info?
                   if yes:  node_varnames records for this production
      4 bytes: number of children
@@ -7491,8 +7566,45 @@ rete_test* reteload_rete_test_list(agent* thisAgent, FILE* f)
 
    Reteload_node_and_children() reads in the record for a given node and
    all its descendents, and reconstructs the Rete network structures.
+   When adding to an agent that already has WMEs, the make_new_xxx_node()
+   routines only left-unlink a node if both its memories are empty, so the
+   saved flags cannot leave a node unlinked from a side that has matches.
+
+   Before a version 5 save, retesave_mark_justification_only_nodes() marks
+   every node that has no saved production underneath it, so those nodes
+   (and the justifications at the bottom of them) are skipped.
 ---------------------------------------------------------------------- */
 
+std::unordered_set<rete_node*> retesave_skipped_nodes;
+
+bool retesave_mark_justification_only_nodes(rete_node* node)
+{
+    rete_node* child;
+    bool saves_production = false;
+
+    if (node->node_type == P_BNODE)
+    {
+        saves_production = (node->b.p.prod->type != JUSTIFICATION_PRODUCTION_TYPE);
+    }
+    else
+    {
+        /* --- cn_p nodes stand in for their CN node's children --- */
+        child = (node->node_type == CN_PARTNER_BNODE) ? node->b.cn.partner->first_child : node->first_child;
+        for (; child; child = child->next_sibling)
+        {
+            if ((child->node_type != CN_BNODE) && retesave_mark_justification_only_nodes(child))
+            {
+                saves_production = true;
+            }
+        }
+    }
+    if (!saves_production)
+    {
+        retesave_skipped_nodes.insert(node);
+    }
+    return saves_production;
+}
+
 void retesave_rete_node_and_children(agent* thisAgent, rete_node* node, FILE* f);
 
 void retesave_children_of_node(agent* thisAgent, rete_node* node, FILE* f)
@@ -7503,7 +7615,7 @@ void retesave_children_of_node(agent* thisAgent, rete_node* node, FILE* f)
     /* --- Count number of non-CN-node children. --- */
     for (child = node->first_child; child; child = child->next_sibling)
     {
-        if (child->node_type != CN_BNODE)
+        if ((child->node_type != CN_BNODE) && !retesave_skipped_nodes.count(child))
         {
             nodeStack.push(child);
         }
@@ -7599,6 +7711,17 @@ void retesave_rete_node_and_children(agent* thisAgent, rete_node* node, FILE* f)
             {
                 retesave_eight_bytes(static_cast<Symbol*>(c->first)->retesave_symindex, f);
             }
+            if (rete_net_version >= 5)
+            {
+                retesave_string(prod->original_rule_name, f);
+                retesave_eight_bytes(prod->naming_depth, f);
+                retesave_double(prod->rl_update_count, f);
+                retesave_double(prod->rl_delta_bar_delta_beta, f);
+                retesave_double(prod->rl_delta_bar_delta_h, f);
+                retesave_double(prod->rl_ecr, f);
+                retesave_double(prod->rl_efr, f);
+                retesave_double(prod->rl_gql, f);
+            }
             if (node->b.p.parents_nvn)
             {
                 retesave_one_byte(1, f);
@@ -7719,13 +7842,20 @@ void reteload_node_and_children(agent* thisAgent, rete_node* parent, FILE* f)
             prod->last_duplicate_dc = 0;
             prod->explain_its_chunks = false;
             prod->save_for_justification_explanation = false;
+            prod->naming_depth = 0;
+            prod->rl_ref_count = 0;
             prod->p_id = thisAgent->explanationBasedChunker->get_new_prod_id();
 
             sym = reteload_symbol_from_index(thisAgent, f);
+            /* --- when adding to a running agent, the loaded rule replaces one of the same name --- */
+            if (sym->sc->production)
+            {
+                excise_production(thisAgent, sym->sc->production, false, true);
+            }
             thisAgent->symbolManager->symbol_add_ref(sym);
             prod->name = sym;
-            /* If this rule was a chunk, then original rule name might be different.  To
-             * avoid having to alter rete saving, we'll just make the original name after
+            /* If this rule was a chunk, then original rule name might be different.  Files
+             * before version 5 don't have it, so we'll just make the original name after
              * a rete load the same thing as a the saved name.  Side effect is minimal:
              * longer chunk name on chunks based on chunks loaded from rete net, for
              * example chunk*chunk-x2*apply-d12 instead of chunk-x3*apply*d12 */
@@ -7782,6 +7912,21 @@ void reteload_node_and_children(agent* thisAgent, rete_node* parent, FILE* f)
                 }
             }
             prod->rl_template_conds = NIL;
+            prod->rl_pending_index = 0;
+            if (rete_net_version >= 5)
+            {
+                reteload_string(f);
+                free_memory_block_for_string(thisAgent, prod->original_rule_name);
+                prod->original_rule_name = make_memory_block_for_string(thisAgent, reteload_string_buf);
+                prod->naming_depth = reteload_eight_bytes(f);
+                prod->rl_update_count = reteload_double(f);
+                prod->rl_delta_bar_delta_beta = reteload_double(f);
+                prod->rl_delta_bar_delta_h = reteload_double(f);
+                prod->rl_ecr = reteload_double(f);
+                prod->rl_efr = reteload_double(f);
+                prod->rl_gql = reteload_double(f);
+            }
+            rl_update_template_tracking(thisAgent, prod->name->sc->name);
 
             New = make_new_production_node(thisAgent, parent, prod);
             adjust_sharing_factors_from_here_to_top(New, 1);
@@ -7825,64 +7970,98 @@ void reteload_node_and_children(agent* thisAgent, rete_node* parent, FILE* f)
 
   Save_rete_net() and load_rete_net() save and load everything to and
   from the given (already open) files.  They return true if successful,
-  false if any error occurred.
+  false if any error occurred.  64-bit saves are written in version 5.
+
+  Load_rete_net() normally replaces the agent's productions and working
+  memory with the saved net.  With add_to_agent, it instead adds the saved
+  productions to the running agent, replacing any with the same names and
+  leaving working memory alone; those nodes are not shared with the ones
+  already in the net.
 ---------------------------------------------------------------------- */
 
 bool save_rete_net(agent* thisAgent, FILE* dest_file, bool use_rete_net_64)
 {
+    rete_fs_file = dest_file;
+    rete_net_64 = use_rete_net_64;
+    rete_net_version = use_rete_net_64 ? 5 : 3;
+
+    /* --- the RHS of Soar-RL rules is saved, so bring their values up to date --- */
+    rl_write_back_values(thisAgent);
 
     /* --- make sure there are no justifications present --- */
+    retesave_skipped_nodes.clear();
     if (thisAgent->all_productions_of_type[JUSTIFICATION_PRODUCTION_TYPE])
     {
-        thisAgent->outputManager->printa_sf(thisAgent, "Internal error: save_rete_net() with justifications present.\n");
-        return false;
+        if (rete_net_version < 5)
+        {
+            thisAgent->outputManager->printa_sf(thisAgent, "Internal error: save_rete_net() with justifications present.\n");
+            return false;
+        }
+        retesave_mark_justification_only_nodes(thisAgent->dummy_top_node);
     }
 
-    rete_fs_file = dest_file;
-    rete_net_64 = use_rete_net_64;
-    uint8_t version = use_rete_net_64 ? 4 : 3;
-
     retesave_string("SoarCompactReteNet\n", dest_file);
-    retesave_one_byte(version, dest_file);  /* format version number */
+    retesave_one_byte(rete_net_version, dest_file);  /* format version number */
     retesave_symbol_table(thisAgent, dest_file);
     retesave_alpha_memories(thisAgent, dest_file);
     retesave_children_of_node(thisAgent, thisAgent->dummy_top_node, dest_file);
+    retesave_skipped_nodes.clear();
     return true;
 }
 
-bool load_rete_net(agent* thisAgent, FILE* source_file)
+bool load_rete_net(agent* thisAgent, FILE* source_file, bool add_to_agent)
 {
     int format_version_num;
     uint64_t i, count;
+    size_t num_read;
 
-    /* RDF: 20020814 RDF Cleaning up the agent working memory and production
-       memory to avoid unnecessary errors in this function. */
-    reinitialize_soar(thisAgent);
-    excise_all_productions(thisAgent, true);
+    if (!add_to_agent)
+    {
+        /* RDF: 20020814 RDF Cleaning up the agent working memory and production
+           memory to avoid unnecessary errors in this function. */
+        reinitialize_soar(thisAgent);
+        excise_all_productions(thisAgent, true);
 
-    /* DONE clearing old productions */
+        /* DONE clearing old productions */
 
-    /* --- check for empty system --- */
-    if (thisAgent->all_wmes_in_rete)
-    {
-        thisAgent->outputManager->printa_sf(thisAgent, "Internal error: load_rete_net() called with nonempty WM.\n");
-        return false;
-    }
-    for (i = 0; i < NUM_PRODUCTION_TYPES; i++)
-        if (thisAgent->num_productions_of_type[i])
+        /* --- check for empty system --- */
+        if (thisAgent->all_wmes_in_rete)
         {
-            thisAgent->outputManager->printa_sf(thisAgent, "Internal error: load_rete_net() called with nonempty PM.\n");
+            thisAgent->outputManager->printa_sf(thisAgent, "Internal error: load_rete_net() called with nonempty WM.\n");
             return false;
         }
+        for (i = 0; i < NUM_PRODUCTION_TYPES; i++)
+            if (thisAgent->num_productions_of_type[i])
+            {
+                thisAgent->outputManager->printa_sf(thisAgent, "Internal error: load_rete_net() called with nonempty PM.\n");
+                return false;
+            }
+    }
 
     // BADBAD: this is global, used in retesave_one_byte
     rete_fs_file = source_file;
 
+    /* --- read the whole file in one go; everything below reads from memory --- */
+    reteload_buf.clear();
+    reteload_pos = 0;
+    reteload_buf.resize(1 << 16);
+    while ((num_read = fread(&(reteload_buf[reteload_pos]), 1, reteload_buf.size() - reteload_pos, source_file)) > 0)
+    {
+        reteload_pos += num_read;
+        if (reteload_pos == reteload_buf.size())
+        {
+            reteload_buf.resize(reteload_buf.size() * 2);
+        }
+    }
+    reteload_buf.resize(reteload_pos);
+    reteload_pos = 0;
+
     /* --- read file header, make sure it's a valid file --- */
     reteload_string(source_file);
     if (strcmp(reteload_string_buf, "SoarCompactReteNet\n"))
     {
         thisAgent->outputManager->printa_sf(thisAgent, "This file isn't a Soar fastsave file.\n");
+        std::vector<uint8_t>().swap(reteload_buf);
         return false;
     }
     format_version_num = reteload_one_byte(source_file);
@@ -7893,13 +8072,16 @@ bool load_rete_net(agent* thisAgent, FILE* source_file)
             rete_net_64 = false; // used by reteload_eight_bytes
             break;
         case 4:
+        case 5:
             // Since there's already a global, I'm putting the 32- or 64-bit switch out there globally
             rete_net_64 = true; // used by reteload_eight_bytes
             break;
         default:
             thisAgent->outputManager->printa_sf(thisAgent, "This file is in a format (version %d) I don't understand.\n", format_version_num);
+            std::vector<uint8_t>().swap(reteload_buf);
             return false;
     }
+    rete_net_version = static_cast<uint8_t>(format_version_num);
 
     reteload_all_symbols(thisAgent, source_file);
     reteload_alpha_memories(thisAgent, source_file);
@@ -7912,9 +8094,13 @@ bool load_rete_net(agent* thisAgent, FILE* source_file)
     /* --- clean up auxilliary tables --- */
     reteload_free_am_table(thisAgent);
     reteload_free_symbol_table(thisAgent);
+    std::vector<uint8_t>().swap(reteload_buf);
 
     /* RDF: 20020814 Now adding the top state and io symbols and wmes */
-    init_agent_memory(thisAgent);
+    if (!add_to_agent)
+    {
+        init_agent_memory(thisAgent);
+    }
 
     return true;
 }
@@ -9472,8 +9658,9 @@ void init_rete(agent* thisAgent)
 
     for (i = 0; i < 16; i++)
     {
-        thisAgent->alpha_hash_tables[i] = make_hash_table(thisAgent, 0, hash_alpha_mem);
+        thisAgent->alpha_tables[i].init(thisAgent);
     }
+    thisAgent->alpha_tables_in_use = 0;
 
     thisAgent->left_ht = thisAgent->memoryManager->allocate_memory_and_zerofill(sizeof(char*) * LEFT_HT_SIZE, HASH_TABLE_MEM_USAGE);
     thisAgent->right_ht = thisAgent->memoryManager->allocate_memory_and_zerofill(sizeof(char*) * RIGHT_HT_SIZE, HASH_TABLE_MEM_USAGE);
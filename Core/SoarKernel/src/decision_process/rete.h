@@ -49,6 +49,8 @@
    Save_rete_net() and load_rete_net() are used for the fastsave/load
    commands.  They save/load everything to/from the given (already open)
    files.  They return true if successful, false if any error occurred.
+   With add_to_agent, load_rete_net() adds the saved productions to the
+   running agent instead of replacing its productions and working memory.
 ======================================================================= */
 
 #ifndef RETE_H
@@ -131,7 +133,6 @@ test var_test_bound_in_reconstructed_conds(
 /* --- structure of each alpha memory --- */
 typedef struct alpha_mem_struct
 {
-    struct alpha_mem_struct* next_in_hash_table;  /* next mem in hash bucket */
     struct right_mem_struct* right_mems;  /* dll of right_mem structures */
     struct rete_node_struct* beta_nodes;  /* list of attached beta nodes */
     struct rete_node_struct* last_beta_node; /* tail of above dll */
@@ -387,10 +388,12 @@ extern byte add_production_to_rete(agent* thisAgent, production* p, condition* l
 extern void excise_production_from_rete(agent* thisAgent, production* p);
 
 extern void add_wme_to_rete(agent* thisAgent, wme* w);
+extern void add_wmes_to_rete(agent* thisAgent, cons* wmes);
 extern void remove_wme_from_rete(agent* thisAgent, wme* w);
 
 void retesave_eight_bytes(uint64_t w, FILE* f);
 void retesave_string(const char* s, FILE* f);
+void retesave_double(double d, FILE* f);
 
 extern void p_node_to_conditions_and_rhs(agent* thisAgent,
         struct rete_node_struct* p_node,
@@ -417,7 +420,7 @@ extern int get_node_count_statistic(agent* thisAgent, char* node_type_name,
                                     uint64_t* result);
 
 extern bool save_rete_net(agent* thisAgent, FILE* dest_file, bool use_rete_net_64);
-extern bool load_rete_net(agent* thisAgent, FILE* source_file);
+extern bool load_rete_net(agent* thisAgent, FILE* source_file, bool add_to_agent = false);
 
 extern void add_varnames_to_test(agent* thisAgent, varnames* vn, test* t);
 
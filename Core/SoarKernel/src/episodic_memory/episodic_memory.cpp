@@ -3,6 +3,7 @@
 #include "agent.h"
 #include "decide.h"
 #include "ebc.h"
+#include "epmem_snapshot.h"
 #include "instantiation.h"
 #include "preference.h"
 #include "semantic_memory.h"
@@ -118,6 +119,17 @@ epmem_param_container::epmem_param_container(agent* new_agent): soar_module::par
     lazy_commit = new soar_module::boolean_param("lazy-commit", on, new epmem_db_predicate<boolean>(thisAgent));
     add(lazy_commit);
 
+    // group commit - with lazy-commit on, commit every so many episodes and/or milliseconds (0 = never)
+    commit_episodes = new soar_module::integer_param("commit-episodes", 0, new soar_module::gt_predicate<int64_t>(0, true), new epmem_db_predicate<int64_t>(thisAgent));
+    add(commit_episodes);
+
+    commit_ms = new soar_module::integer_param("commit-ms", 0, new soar_module::gt_predicate<int64_t>(0, true), new epmem_db_predicate<int64_t>(thisAgent));
+    add(commit_ms);
+
+    // async-storage - write new episodes to the database on a background thread
+    async_storage = new soar_module::boolean_param("async-storage", on, new epmem_db_predicate<boolean>(thisAgent));
+    add(async_storage);
+
     ////////////////////
     // Retrieval
     ////////////////////
@@ -130,6 +142,10 @@ epmem_param_container::epmem_param_container(agent* new_agent): soar_module::par
     balance = new soar_module::decimal_param("balance", 1, new soar_module::btw_predicate<double>(0, 1, true), new soar_module::f_predicate<double>());
     add(balance);
 
+    // interval-index - walk intervals from memory instead of the database
+    interval_index = new soar_module::boolean_param("interval-index", on, new soar_module::f_predicate<boolean>());
+    add(interval_index);
+
 
     ////////////////////
     // Performance
@@ -164,6 +180,10 @@ epmem_param_container::epmem_param_container(agent* new_agent): soar_module::par
     opt->add_mapping(epmem_param_container::opt_speed, "performance");
     add(opt);
 
+    // query-threads - graph match query candidates on this many threads (1 = in the interval walk)
+    query_threads = new soar_module::integer_param("query-threads", 1, new soar_module::gt_predicate<int64_t>(1, true), new soar_module::f_predicate<int64_t>());
+    add(query_threads);
+
 
     ////////////////////
     // Experimental
@@ -504,6 +524,7 @@ epmem_hash_id epmem_temporal_hash(agent* thisAgent, Symbol* sym, bool add_on_fai
             sym->epmem_hash = NIL;
             sym->epmem_valid = thisAgent->EpMem->epmem_validation;
 
+            std::lock_guard<std::mutex> db_guard(thisAgent->EpMem->epmem_writer->get_lock());
             switch (sym->symbol_type)
             {
                 case STR_CONSTANT_SYMBOL_TYPE:
@@ -1156,6 +1177,32 @@ epmem_graph_statement_container::epmem_graph_statement_container(agent* new_agen
     update_epmem_wmes_identifier_last_episode_id = new soar_module::sqlite_statement(new_db, "UPDATE epmem_wmes_identifier SET last_episode_id=? WHERE wi_id=?");
     add(update_epmem_wmes_identifier_last_episode_id);
 
+    // interval index
+    {
+        const char* epmem_load_interval_queries[2][3] =
+        {
+            {
+                "SELECT start_episode_id, end_episode_id FROM epmem_wmes_constant_range WHERE wc_id=? ORDER BY start_episode_id ASC",
+                "SELECT start_episode_id, 0 FROM epmem_wmes_constant_now WHERE wc_id=?",
+                "SELECT episode_id, 0 FROM epmem_wmes_constant_point WHERE wc_id=? ORDER BY episode_id ASC"
+            },
+            {
+                "SELECT start_episode_id, end_episode_id FROM epmem_wmes_identifier_range WHERE wi_id=? ORDER BY start_episode_id ASC",
+                "SELECT start_episode_id, 0 FROM epmem_wmes_identifier_now WHERE wi_id=?",
+                "SELECT episode_id, 0 FROM epmem_wmes_identifier_point WHERE wi_id=? ORDER BY episode_id ASC"
+            }
+        };
+
+        for (int j = EPMEM_RIT_STATE_NODE; j <= EPMEM_RIT_STATE_EDGE; j++)
+        {
+            for (int m = EPMEM_RANGE_EP; m <= EPMEM_RANGE_POINT; m++)
+            {
+                load_intervals[ j ][ m ] = new soar_module::sqlite_statement(new_db, epmem_load_interval_queries[ j ][ m ]);
+                add(load_intervals[ j ][ m ]);
+            }
+        }
+    }
+
     // init statement pools
     {
         int j, k, m;
@@ -1421,12 +1468,7 @@ bool epmem_get_variable(agent* thisAgent, epmem_variable_key variable_id, int64_
  **************************************************************************/
 void epmem_set_variable(agent* thisAgent, epmem_variable_key variable_id, int64_t variable_value)
 {
-    soar_module::sqlite_statement* var_set = thisAgent->EpMem->epmem_stmts_common->var_set;
-
-    var_set->bind_int(1, variable_id);
-    var_set->bind_int(2, variable_value);
-
-    var_set->execute(soar_module::op_reinit);
+    thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_common->var_set, variable_id, variable_value);
 }
 
 //////////////////////////////////////////////////////////
@@ -1705,18 +1747,245 @@ void epmem_rit_insert_interval(agent* thisAgent, int64_t lower, int64_t upper, e
     std::string temp2 = temp.str();
     thisAgent->outputManager->print(temp2.c_str());*/
 
-    rit_state->add_query->bind_int(1, node);
-    rit_state->add_query->bind_int(2, lower);
-    rit_state->add_query->bind_int(3, upper);
-    rit_state->add_query->bind_int(4, id);
-    //if (lti_id)
     //A horrible error was occuring where instead of defaulting to null in the absense of a given
     //lti_id, another value was used, which ended up effectively assigning lti status to absurd things
     //when they were recorded into the history for episodic memory.
+    thisAgent->EpMem->epmem_writer->execute(rit_state->add_query, node, lower, upper, id, lti_id);
+}
+
+
+//////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////
+// Interval Index Functions (epmem::index)
+//
+// Cue-based retrieval walks, for every edge that can
+// match the cue, the start and end points of the now,
+// point and range rows of that edge, newest first.
+// Issuing six SQL cursors per edge is what makes large
+// stores slow to query, so (with interval-index on) the
+// rows of an edge are read once into sorted arrays the
+// first time a query touches the edge, and storage keeps
+// the arrays of loaded edges up to date.  The database
+// remains the store of record.
+//////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////
+
+/***************************************************************************
+ * Function     : epmem_find_edge_intervals
+ * Notes        : Returns the loaded intervals of a wc_id/wi_id,
+ *                or NULL if no query has needed them yet.
+ **************************************************************************/
+inline epmem_edge_intervals* epmem_find_edge_intervals(agent* thisAgent, int value_is_id, int64_t id)
+{
+    epmem_interval_index* index = &(thisAgent->EpMem->epmem_interval_indexes[ value_is_id ]);
+    epmem_interval_index::iterator p = index->find(id);
+
+    return ((p == index->end()) ? NULL : &(p->second));
+}
+
+/***************************************************************************
+ * Function     : epmem_get_edge_intervals
+ * Notes        : Returns the intervals of a wc_id/wi_id, loading
+ *                them from the database if necessary.
+ **************************************************************************/
+epmem_edge_intervals* epmem_get_edge_intervals(agent* thisAgent, int value_is_id, int64_t id)
+{
+    epmem_edge_intervals* intervals = epmem_find_edge_intervals(thisAgent, value_is_id, id);
+    soar_module::sqlite_statement* q;
+
+    if (intervals)
+    {
+        return intervals;
+    }
+
+    intervals = &(thisAgent->EpMem->epmem_interval_indexes[ value_is_id ][ id ]);
+    intervals->now_start = EPMEM_MEMID_NONE;
+
+    q = thisAgent->EpMem->epmem_stmts_graph->load_intervals[ value_is_id ][ EPMEM_RANGE_EP ];
+    q->bind_int(1, id);
+    while (q->execute() == soar_module::row)
+    {
+        intervals->ranges.push_back(epmem_time_range(q->column_int(0), q->column_int(1)));
+    }
+    q->reinitialize();
+
+    q = thisAgent->EpMem->epmem_stmts_graph->load_intervals[ value_is_id ][ EPMEM_RANGE_NOW ];
+    q->bind_int(1, id);
+    if (q->execute() == soar_module::row)
+    {
+        intervals->now_start = q->column_int(0);
+    }
+    q->reinitialize();
+
+    q = thisAgent->EpMem->epmem_stmts_graph->load_intervals[ value_is_id ][ EPMEM_RANGE_POINT ];
+    q->bind_int(1, id);
+    while (q->execute() == soar_module::row)
+    {
+        intervals->points.push_back(q->column_int(0));
+    }
+    q->reinitialize();
+
+    return intervals;
+}
+
+/***************************************************************************
+ * Function     : epmem_index_open_interval
+ * Notes        : Mirrors the insertion of a NOW row.
+ **************************************************************************/
+inline void epmem_index_open_interval(agent* thisAgent, int value_is_id, int64_t id, epmem_time_id start)
+{
+    epmem_edge_intervals* intervals = epmem_find_edge_intervals(thisAgent, value_is_id, id);
+
+    if (intervals)
+    {
+        intervals->now_start = start;
+    }
+}
+
+/***************************************************************************
+ * Function     : epmem_index_close_interval
+ * Notes        : Mirrors the replacement of a NOW row with a point
+ *                (start == end) or a range.
+ **************************************************************************/
+void epmem_index_close_interval(agent* thisAgent, int value_is_id, int64_t id, epmem_time_id start, epmem_time_id end)
+{
+    epmem_edge_intervals* intervals = epmem_find_edge_intervals(thisAgent, value_is_id, id);
+
+    if (!intervals)
+    {
+        return;
+    }
+
+    intervals->now_start = EPMEM_MEMID_NONE;
+
+    // intervals close in time order, so this is almost always an append
+    if (start == end)
+    {
+        if (intervals->points.empty() || (intervals->points.back() < start))
+        {
+            intervals->points.push_back(start);
+        }
+        else
+        {
+            intervals->points.insert(std::upper_bound(intervals->points.begin(), intervals->points.end(), start), start);
+        }
+    }
+    else
+    {
+        epmem_time_range range(start, end);
+
+        if (intervals->ranges.empty() || (intervals->ranges.back() < range))
+        {
+            intervals->ranges.push_back(range);
+        }
+        else
+        {
+            intervals->ranges.insert(std::upper_bound(intervals->ranges.begin(), intervals->ranges.end(), range), range);
+        }
+    }
+}
+
+/***************************************************************************
+ * Function     : epmem_indexed_interval_time
+ * Notes        : Time of the current row of an indexed interval
+ *                cursor, with the same start offset as the
+ *                interval queries.
+ **************************************************************************/
+inline epmem_time_id epmem_indexed_interval_time(epmem_interval* interval)
+{
+    epmem_time_id t;
+
+    if (interval->interval_type == EPMEM_RANGE_EP)
+    {
+        const epmem_time_range& range = interval->index->ranges[ interval->remaining - 1 ];
+        t = ((interval->is_end_point) ? (range.second) : (range.first - 1));
+    }
+    else
+    {
+        t = interval->index->points[ interval->remaining - 1 ];
+        if (!interval->is_end_point)
+        {
+            t--;
+        }
+    }
+
+    return t;
+}
+
+/***************************************************************************
+ * Function     : epmem_next_indexed_interval
+ * Notes        : Advances an indexed interval cursor (newest
+ *                first), returning false once it is exhausted.
+ **************************************************************************/
+bool epmem_next_indexed_interval(epmem_interval* interval)
+{
+    if (interval->remaining)
+    {
+        interval->remaining--;
+    }
+
+    // NOW rows are never more than one per edge
+    if (interval->interval_type == EPMEM_RANGE_NOW)
     {
-        rit_state->add_query->bind_int(5, (lti_id));
+        interval->remaining = 0;
     }
-    rit_state->add_query->execute(soar_module::op_reinit);
+
+    // ranges still missing their end point don't have one to report
+    if (interval->interval_type == EPMEM_RANGE_EP && interval->is_end_point)
+    {
+        while (interval->remaining && (interval->index->ranges[ interval->remaining - 1 ].second <= 0))
+        {
+            interval->remaining--;
+        }
+    }
+
+    if (!interval->remaining)
+    {
+        return false;
+    }
+
+    interval->time = epmem_indexed_interval_time(interval);
+    return true;
+}
+
+/***************************************************************************
+ * Function     : epmem_open_indexed_interval
+ * Notes        : Positions an interval cursor on the newest row of
+ *                one interval type at or before current_episode;
+ *                the in-memory equivalent of executing one of the
+ *                pool_find_interval_queries.  Returns false if
+ *                there is no such row.
+ **************************************************************************/
+bool epmem_open_indexed_interval(epmem_interval* interval, epmem_edge_intervals* intervals, int point_type, int interval_type, epmem_time_id current_episode)
+{
+    interval->index = intervals;
+    interval->interval_type = interval_type;
+    interval->is_end_point = point_type;
+    interval->sql = NULL;
+
+    switch (interval_type)
+    {
+        case EPMEM_RANGE_EP:
+            interval->remaining = (std::upper_bound(intervals->ranges.begin(), intervals->ranges.end(), epmem_time_range(current_episode, LLONG_MAX)) - intervals->ranges.begin());
+            break;
+
+        case EPMEM_RANGE_NOW:
+            if (intervals->now_start == EPMEM_MEMID_NONE || intervals->now_start > current_episode)
+            {
+                return false;
+            }
+            interval->time = ((point_type == EPMEM_RANGE_END) ? (current_episode) : (intervals->now_start - 1));
+            interval->remaining = 1;
+            return true;
+
+        case EPMEM_RANGE_POINT:
+            interval->remaining = (std::upper_bound(intervals->points.begin(), intervals->points.end(), current_episode) - intervals->points.begin());
+            break;
+    }
+
+    // step onto the first row by pretending we are one past it
+    interval->remaining++;
+    return epmem_next_indexed_interval(interval);
 }
 
 
@@ -1782,6 +2051,60 @@ void epmem_clear_transient_structures(agent* thisAgent)
     thisAgent->EpMem->epmem_id_ref_counts->clear();
     thisAgent->EpMem->epmem_wme_adds->clear();
 
+    // drop the interval index; it is reloaded from the next database
+    thisAgent->EpMem->epmem_interval_indexes[ EPMEM_RIT_STATE_NODE ].clear();
+    thisAgent->EpMem->epmem_interval_indexes[ EPMEM_RIT_STATE_EDGE ].clear();
+}
+
+/***************************************************************************
+ * Function     : epmem_group_commit_enabled
+ * Notes        : Group commit replaces the single lifetime transaction
+ *                of lazy-commit with one transaction per group of
+ *                episodes, ended every commit-episodes episodes or
+ *                commit-ms milliseconds (whichever comes first).
+ **************************************************************************/
+inline bool epmem_group_commit_enabled(agent* thisAgent)
+{
+    return (thisAgent->EpMem->epmem_params->lazy_commit->get_value() == on) &&
+           ((thisAgent->EpMem->epmem_params->commit_episodes->get_value() > 0) ||
+            (thisAgent->EpMem->epmem_params->commit_ms->get_value() > 0));
+}
+
+/***************************************************************************
+ * Function     : epmem_group_commit
+ * Notes        : Called after each new episode.  Ends the current
+ *                transaction and starts the next one if the group is
+ *                full.  A file database is in WAL mode at this point,
+ *                so the commit only appends to the log; copying the
+ *                log back into the database is left to the
+ *                background checkpointer.  Returns true if the
+ *                commit was queued, in which case the caller has to
+ *                flush the writer before the commit counts as done.
+ **************************************************************************/
+bool epmem_group_commit(agent* thisAgent)
+{
+    if (!epmem_group_commit_enabled(thisAgent))
+    {
+        return false;
+    }
+
+    int64_t max_episodes = thisAgent->EpMem->epmem_params->commit_episodes->get_value();
+    int64_t max_ms = thisAgent->EpMem->epmem_params->commit_ms->get_value();
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    thisAgent->EpMem->epmem_uncommitted_episodes++;
+    if (((max_episodes <= 0) || (thisAgent->EpMem->epmem_uncommitted_episodes < static_cast<uint64_t>(max_episodes))) &&
+            ((max_ms <= 0) || (std::chrono::duration_cast<std::chrono::milliseconds>(now - thisAgent->EpMem->epmem_last_commit).count() < max_ms)))
+    {
+        return false;
+    }
+
+    thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_common->commit);
+    thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_common->begin);
+
+    thisAgent->EpMem->epmem_uncommitted_episodes = 0;
+    thisAgent->EpMem->epmem_last_commit = now;
+    return true;
 }
 
 /***************************************************************************
@@ -1795,12 +2118,18 @@ void epmem_close(agent* thisAgent)
     if (thisAgent->EpMem->epmem_db->get_status() == soar_module::connected)
     {
         print_sysparam_trace(thisAgent, TRACE_EPMEM_SYSPARAM, "Closing episodic memory database %s.\n", thisAgent->EpMem->epmem_params->path->get_value());
+        // finish any storage still being written in the background
+        thisAgent->EpMem->epmem_writer->stop();
+
         // if lazy, commit
         if (thisAgent->EpMem->epmem_params->lazy_commit->get_value() == on)
         {
             thisAgent->EpMem->epmem_stmts_common->commit->execute(soar_module::op_reinit);
         }
 
+        // the connection checkpoints whatever is left in the log when it closes
+        thisAgent->EpMem->epmem_checkpointer->stop();
+
         epmem_clear_transient_structures(thisAgent);
 
         // close the database
@@ -2086,8 +2415,19 @@ void epmem_init_db(agent* thisAgent, bool readonly)
                 thisAgent->EpMem->epmem_db->sql_execute(cache_sql.c_str());
             }
 
+            // group commit - commits only append to a write-ahead log, which is
+            // synced when it is checkpointed (in the background) rather than on
+            // every commit.  This needs shared locking, so that the checkpointer's
+            // connection can get at the log, and it overrides the optimization
+            // setting, since a group commit with no journal would gain nothing.
+            if (epmem_group_commit_enabled(thisAgent) && strcmp(db_path, ":memory:"))
+            {
+                thisAgent->EpMem->epmem_db->sql_execute("PRAGMA journal_mode = WAL");
+                thisAgent->EpMem->epmem_db->sql_execute("PRAGMA synchronous = NORMAL");
+                thisAgent->EpMem->epmem_db->sql_execute("PRAGMA wal_autocheckpoint = 0");
+            }
             // optimization
-            if (thisAgent->EpMem->epmem_params->opt->get_value() == epmem_param_container::opt_speed)
+            else if (thisAgent->EpMem->epmem_params->opt->get_value() == epmem_param_container::opt_speed)
             {
                 // synchronous - don't wait for writes to complete (can corrupt the db in case unexpected crash during transaction)
                 thisAgent->EpMem->epmem_db->sql_execute("PRAGMA synchronous = OFF");
@@ -2118,6 +2458,13 @@ void epmem_init_db(agent* thisAgent, bool readonly)
             thisAgent->EpMem->epmem_stmts_graph->structure();
             thisAgent->EpMem->epmem_stmts_graph->prepare();
 
+            // fill the fresh tables from a snapshot being imported, so that
+            // everything below picks its state up from the snapshot's rows
+            if (thisAgent->EpMem->epmem_pending_snapshot)
+            {
+                thisAgent->EpMem->epmem_pending_snapshot->load(thisAgent->EpMem->epmem_db);
+            }
+
             // initialize range tracking
             thisAgent->EpMem->epmem_node_mins->clear();
             thisAgent->EpMem->epmem_node_maxes->clear();
@@ -2375,10 +2722,23 @@ void epmem_init_db(agent* thisAgent, bool readonly)
         }
 
         // if lazy commit, then we encapsulate the entire lifetime of the agent in a single transaction
+        // (or, with group commit, the episodes up to the first commit)
         if (thisAgent->EpMem->epmem_params->lazy_commit->get_value() == on)
         {
             thisAgent->EpMem->epmem_stmts_common->begin->execute(soar_module::op_reinit);
         }
+
+        thisAgent->EpMem->epmem_uncommitted_episodes = 0;
+        thisAgent->EpMem->epmem_last_commit = std::chrono::steady_clock::now();
+        if (epmem_group_commit_enabled(thisAgent) && strcmp(db_path, ":memory:"))
+        {
+            thisAgent->EpMem->epmem_checkpointer->start(db_path);
+        }
+
+        if (thisAgent->EpMem->epmem_params->async_storage->get_value() == on)
+        {
+            thisAgent->EpMem->epmem_writer->start();
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -2456,12 +2816,14 @@ inline void _epmem_store_level(agent* thisAgent,
     // find WME ID for WMEs whose value is an identifier and has a known epmem id (prevents ordering issues with unknown children)
     for (w_p = w_b; w_p != w_e; w_p++)
     {
+        wme_cold* w_cold = wme_cold_data(thisAgent, *w_p);
+
 //      #ifdef DEBUG_EPMEM_WME_ADD
 //      fprintf(stderr, "DEBUG epmem.2132: _epmem_store_level processing wme (types: %d %d %d)\n",
 //              (*w_p)->id->symbol_type,  (*w_p)->attr->var->symbol_type,  (*w_p)->value->symbol_type);
 //      #endif
         // skip over WMEs already in the system
-        if (((*w_p)->epmem_id != EPMEM_NODEID_BAD) && ((*w_p)->epmem_valid == thisAgent->EpMem->epmem_validation))
+        if ((w_cold->epmem_id != EPMEM_NODEID_BAD) && (w_cold->epmem_valid == thisAgent->EpMem->epmem_validation))
         {
             continue;
         }
@@ -2535,15 +2897,17 @@ inline void _epmem_store_level(agent* thisAgent,
 
     for (w_p = w_b; w_p != w_e; w_p++)
     {
+        wme_cold* w_cold = wme_cold_data(thisAgent, *w_p);
+
 #ifdef DEBUG_EPMEM_WME_ADD
         fprintf(stderr, "--------------------------------------------\nProcessing WME: %d ^%s %s\n",
                 (unsigned int) parent_id, symbol_to_string(thisAgent, (*w_p)->attr, true, NIL, 0), symbol_to_string(thisAgent, (*w_p)->value, true, NIL, 0));
 #endif
         // skip over WMEs already in the system
-        if (((*w_p)->epmem_id != EPMEM_NODEID_BAD) && ((*w_p)->epmem_valid == thisAgent->EpMem->epmem_validation))
+        if ((w_cold->epmem_id != EPMEM_NODEID_BAD) && (w_cold->epmem_valid == thisAgent->EpMem->epmem_validation))
         {
 #ifdef DEBUG_EPMEM_WME_ADD
-            fprintf(stderr, "   WME already in system with id %d.\n", (unsigned int)(*w_p)->epmem_id);
+            fprintf(stderr, "   WME already in system with id %d.\n", (unsigned int)w_cold->epmem_id);
 #endif
             continue;
         }
@@ -2562,8 +2926,8 @@ inline void _epmem_store_level(agent* thisAgent,
 #ifdef DEBUG_EPMEM_WME_ADD
             fprintf(stderr, "   WME value is IDENTIFIER.\n");
 #endif
-            (*w_p)->epmem_valid = thisAgent->EpMem->epmem_validation;
-            (*w_p)->epmem_id = EPMEM_NODEID_BAD;
+            w_cold->epmem_valid = thisAgent->EpMem->epmem_validation;
+            w_cold->epmem_id = EPMEM_NODEID_BAD;
 
             my_hash = NIL;
             my_id_repo2 = NIL;
@@ -2576,9 +2940,7 @@ inline void _epmem_store_level(agent* thisAgent,
             if ((*w_p)->value->id->LTI_ID && ((*w_p)->value->id->LTI_epmem_valid != thisAgent->EpMem->epmem_validation) && ((*w_p)->value->id->epmem_id != EPMEM_NODEID_BAD))
             {
                 // Update the node database with the new lti_id
-                thisAgent->EpMem->epmem_stmts_graph->update_node->bind_int(2, (*w_p)->value->id->LTI_ID);
-                thisAgent->EpMem->epmem_stmts_graph->update_node->bind_int(1, (*w_p)->value->id->epmem_id);
-                thisAgent->EpMem->epmem_stmts_graph->update_node->execute(soar_module::op_reinit);
+                thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->update_node, (*w_p)->value->id->epmem_id, (*w_p)->value->id->LTI_ID);
                 (*w_p)->value->id->LTI_epmem_valid = thisAgent->EpMem->epmem_validation;
             }// Steven - This is an important point - It's where we know we're adding an lti for which there wasn't already a known epmem id correspondence assigned to it.
             {
@@ -2601,10 +2963,10 @@ inline void _epmem_store_level(agent* thisAgent,
 
                         if (r_p->second->my_id != EPMEM_NODEID_BAD)
                         {
-                            (*w_p)->epmem_id = r_p->second->my_id;
-                            (*thisAgent->EpMem->epmem_id_replacement)[(*w_p)->epmem_id ] = my_id_repo2;
+                            w_cold->epmem_id = r_p->second->my_id;
+                            (*thisAgent->EpMem->epmem_id_replacement)[w_cold->epmem_id ] = my_id_repo2;
 #ifdef DEBUG_EPMEM_WME_ADD
-                            fprintf(stderr, "   Assigning id from existing pool: %d\n", (unsigned int)(*w_p)->epmem_id);
+                            fprintf(stderr, "   Assigning id from existing pool: %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                         }
 
@@ -2638,11 +3000,11 @@ inline void _epmem_store_level(agent* thisAgent,
                                 {
                                     if (pool_p->first == (*w_p)->value->id->epmem_id)
                                     {
-                                        (*w_p)->epmem_id = pool_p->second;
+                                        w_cold->epmem_id = pool_p->second;
                                         (*my_id_repo)->erase(pool_p);
-                                        (*thisAgent->EpMem->epmem_id_replacement)[(*w_p)->epmem_id ] = (*my_id_repo);
+                                        (*thisAgent->EpMem->epmem_id_replacement)[w_cold->epmem_id ] = (*my_id_repo);
 #ifdef DEBUG_EPMEM_WME_ADD
-                                        fprintf(stderr, "   Assigning id from existing pool: %d\n", (unsigned int)(*w_p)->epmem_id);
+                                        fprintf(stderr, "   Assigning id from existing pool: %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                                         break;
                                     }
@@ -2700,17 +3062,17 @@ inline void _epmem_store_level(agent* thisAgent,
                                         ((*thisAgent->EpMem->epmem_id_ref_counts)[ pool_p->first ]->empty()))
 
                                 {
-                                    (*w_p)->epmem_id = pool_p->second;
+                                    w_cold->epmem_id = pool_p->second;
                                     (*w_p)->value->id->epmem_id = pool_p->first;
 #ifdef DEBUG_EPMEM_WME_ADD
                                     fprintf(stderr, "   Found unused id. Setting wme id for VALUE to %d\n", (unsigned int)(*w_p)->value->id->epmem_id);
 #endif
                                     (*w_p)->value->id->epmem_valid = thisAgent->EpMem->epmem_validation;
                                     (*my_id_repo)->erase(pool_p);
-                                    (*thisAgent->EpMem->epmem_id_replacement)[(*w_p)->epmem_id ] = (*my_id_repo);
+                                    (*thisAgent->EpMem->epmem_id_replacement)[w_cold->epmem_id ] = (*my_id_repo);
 
 #ifdef DEBUG_EPMEM_WME_ADD
-                                    fprintf(stderr, "   Assigning id from existing pool %d.\n", (unsigned int)(*w_p)->epmem_id);
+                                    fprintf(stderr, "   Assigning id from existing pool %d.\n", (unsigned int)w_cold->epmem_id);
 #endif
                                     break;
                                 }
@@ -2732,7 +3094,7 @@ inline void _epmem_store_level(agent* thisAgent,
             }
 
             // add wme if no success above
-            if ((*w_p)->epmem_id == EPMEM_NODEID_BAD)
+            if (w_cold->epmem_id == EPMEM_NODEID_BAD)
             {
 #ifdef DEBUG_EPMEM_WME_ADD
                 fprintf(stderr, "   No success, adding wme to database.");
@@ -2750,15 +3112,11 @@ inline void _epmem_store_level(agent* thisAgent,
                     fprintf(stderr, "   Adding new n_id and setting wme id for VALUE to %d\n", (unsigned int)(*w_p)->value->id->epmem_id);
 #endif
                     // Update the node database with the new n_id
-                    thisAgent->EpMem->epmem_stmts_graph->update_node->bind_int(1, (*w_p)->value->id->epmem_id);
-                    if (!(*w_p)->value->id->LTI_ID)
+                    if ((*w_p)->value->id->LTI_ID)
                     {
-                        thisAgent->EpMem->epmem_stmts_graph->update_node->bind_int(2, 0);
-                    } else {
-                        thisAgent->EpMem->epmem_stmts_graph->update_node->bind_int(2, (*w_p)->value->id->LTI_ID);
                         (*w_p)->value->id->LTI_epmem_valid = thisAgent->EpMem->epmem_validation;
                     }
-                    thisAgent->EpMem->epmem_stmts_graph->update_node->execute(soar_module::op_reinit);
+                    thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->update_node, (*w_p)->value->id->epmem_id, (*w_p)->value->id->LTI_ID);
 
                     // add repository for possible future children
                     (*thisAgent->EpMem->epmem_id_repository)[(*w_p)->value->id->epmem_id ] = new epmem_hashed_id_pool;
@@ -2778,21 +3136,25 @@ inline void _epmem_store_level(agent* thisAgent,
 
                 fprintf(stderr, "   Adding wme to epmem_wmes_identifier table.\n");
 #endif
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(1, parent_id);
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(2, my_hash);
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(3, (*w_p)->value->id->epmem_id);
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(4, LLONG_MAX);
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->execute(soar_module::op_reinit);
+                {
+                    std::lock_guard<std::mutex> db_guard(thisAgent->EpMem->epmem_writer->get_lock());
+
+                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(1, parent_id);
+                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(2, my_hash);
+                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(3, (*w_p)->value->id->epmem_id);
+                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(4, LLONG_MAX);
+                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->execute(soar_module::op_reinit);
 
-                (*w_p)->epmem_id = static_cast<epmem_node_id>(thisAgent->EpMem->epmem_db->last_insert_rowid());
+                    w_cold->epmem_id = static_cast<epmem_node_id>(thisAgent->EpMem->epmem_db->last_insert_rowid());
+                }
 #ifdef DEBUG_EPMEM_WME_ADD
-                fprintf(stderr, "   Incrementing and setting wme id to %d\n", (unsigned int)(*w_p)->epmem_id);
+                fprintf(stderr, "   Incrementing and setting wme id to %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                 // replace the epmem_id and wme id in the right place
-                (*thisAgent->EpMem->epmem_id_replacement)[(*w_p)->epmem_id ] = my_id_repo2;
+                (*thisAgent->EpMem->epmem_id_replacement)[w_cold->epmem_id ] = my_id_repo2;
 
                 // new nodes definitely start
-                epmem_edge.emplace((*w_p)->epmem_id,static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0));
+                epmem_edge.emplace(w_cold->epmem_id,static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0));
                 thisAgent->EpMem->epmem_edge_mins->push_back(time_counter);
                 thisAgent->EpMem->epmem_edge_maxes->push_back(false);
             }
@@ -2802,13 +3164,13 @@ inline void _epmem_store_level(agent* thisAgent,
                 fprintf(stderr, "   No success but already has id, so don't remove.\n");
 #endif
                 // definitely don't remove
-                (*thisAgent->EpMem->epmem_edge_removals)[std::make_pair((*w_p)->epmem_id, static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0)) ] = false;
+                (*thisAgent->EpMem->epmem_edge_removals)[std::make_pair(w_cold->epmem_id, static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0)) ] = false;
 
                 // we add ONLY if the last thing we did was remove
-                if ((*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>((*w_p)->epmem_id - 1)])
+                if ((*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>(w_cold->epmem_id - 1)])
                 {
-                    epmem_edge.emplace((*w_p)->epmem_id,static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0));
-                    (*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>((*w_p)->epmem_id - 1)] = false;
+                    epmem_edge.emplace(w_cold->epmem_id,static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0));
+                    (*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>(w_cold->epmem_id - 1)] = false;
                 }
             }
 
@@ -2849,14 +3211,14 @@ inline void _epmem_store_level(agent* thisAgent,
 #endif
 
             // have we seen this node in this database?
-            if (((*w_p)->epmem_id == EPMEM_NODEID_BAD) || ((*w_p)->epmem_valid != thisAgent->EpMem->epmem_validation))
+            if ((w_cold->epmem_id == EPMEM_NODEID_BAD) || (w_cold->epmem_valid != thisAgent->EpMem->epmem_validation))
             {
 #ifdef DEBUG_EPMEM_WME_ADD
                 fprintf(stderr, "   This is a new wme.\n");
 #endif
 
-                (*w_p)->epmem_id = EPMEM_NODEID_BAD;
-                (*w_p)->epmem_valid = thisAgent->EpMem->epmem_validation;
+                w_cold->epmem_id = EPMEM_NODEID_BAD;
+                w_cold->epmem_valid = thisAgent->EpMem->epmem_validation;
 
                 my_hash = epmem_temporal_hash(thisAgent, (*w_p)->attr);
                 my_hash2 = epmem_temporal_hash(thisAgent, (*w_p)->value);
@@ -2867,20 +3229,22 @@ inline void _epmem_store_level(agent* thisAgent,
 #ifdef DEBUG_EPMEM_WME_ADD
                     fprintf(stderr, "   Looking for id of a duplicate entry in epmem_wmes_constant.\n");
 #endif
+                    std::lock_guard<std::mutex> db_guard(thisAgent->EpMem->epmem_writer->get_lock());
+
                     thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->bind_int(1, parent_id);
                     thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->bind_int(2, my_hash);
                     thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->bind_int(3, my_hash2);
 
                     if (thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->execute() == soar_module::row)
                     {
-                        (*w_p)->epmem_id = thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->column_int(0);
+                        w_cold->epmem_id = thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->column_int(0);
                     }
 
                     thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->reinitialize();
                 }
 
                 // act depending on new/existing feature
-                if ((*w_p)->epmem_id == EPMEM_NODEID_BAD)
+                if (w_cold->epmem_id == EPMEM_NODEID_BAD)
                 {
 #ifdef DEBUG_EPMEM_WME_ADD
                     fprintf(stderr, "   No duplicate wme found in epmem_wmes_constant.  Adding wme to table!!!!\n");
@@ -2888,17 +3252,21 @@ inline void _epmem_store_level(agent* thisAgent,
                             (unsigned int) parent_id, (unsigned int) my_hash, (unsigned int) my_hash2);
 #endif
                     // insert (parent_n_id, attribute_s_id, value_s_id)
-                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->bind_int(1, parent_id);
-                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->bind_int(2, my_hash);
-                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->bind_int(3, my_hash2);
-                    thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->execute(soar_module::op_reinit);
+                    {
+                        std::lock_guard<std::mutex> db_guard(thisAgent->EpMem->epmem_writer->get_lock());
 
-                    (*w_p)->epmem_id = (epmem_node_id) thisAgent->EpMem->epmem_db->last_insert_rowid();
+                        thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->bind_int(1, parent_id);
+                        thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->bind_int(2, my_hash);
+                        thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->bind_int(3, my_hash2);
+                        thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->execute(soar_module::op_reinit);
+
+                        w_cold->epmem_id = (epmem_node_id) thisAgent->EpMem->epmem_db->last_insert_rowid();
+                    }
 #ifdef DEBUG_EPMEM_WME_ADD
-                    fprintf(stderr, "   Setting wme id from last row to %d\n", (unsigned int)(*w_p)->epmem_id);
+                    fprintf(stderr, "   Setting wme id from last row to %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                     // new nodes definitely start
-                    epmem_node.push((*w_p)->epmem_id);
+                    epmem_node.push(w_cold->epmem_id);
                     thisAgent->EpMem->epmem_node_mins->push_back(time_counter);
                     thisAgent->EpMem->epmem_node_maxes->push_back(false);
                 }
@@ -2906,16 +3274,16 @@ inline void _epmem_store_level(agent* thisAgent,
                 {
 #ifdef DEBUG_EPMEM_WME_ADD
                     fprintf(stderr, "   Node found in database, definitely don't remove.\n");
-                    fprintf(stderr, "   Setting wme id from existing node to %d\n", (unsigned int)(*w_p)->epmem_id);
+                    fprintf(stderr, "   Setting wme id from existing node to %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                     // definitely don't remove
-                    (*thisAgent->EpMem->epmem_node_removals)[(*w_p)->epmem_id ] = false;
+                    (*thisAgent->EpMem->epmem_node_removals)[w_cold->epmem_id ] = false;
 
                     // add ONLY if the last thing we did was add
-                    if ((*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>((*w_p)->epmem_id - 1)])
+                    if ((*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>(w_cold->epmem_id - 1)])
                     {
-                        epmem_node.push((*w_p)->epmem_id);
-                        (*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>((*w_p)->epmem_id - 1)] = false;
+                        epmem_node.push(w_cold->epmem_id);
+                        (*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>(w_cold->epmem_id - 1)] = false;
                     }
                 }
             }
@@ -3005,9 +3373,8 @@ void epmem_new_episode(agent* thisAgent)
 
                 // add NOW entry
                 // id = ?, start_episode_id = ?
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant_now->bind_int(1, (*temp_node));
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant_now->bind_int(2, time_counter);
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant_now->execute(soar_module::op_reinit);
+                thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant_now, (*temp_node), time_counter);
+                epmem_index_open_interval(thisAgent, EPMEM_RIT_STATE_NODE, (*temp_node), time_counter);
 
                 // update min
                 (*thisAgent->EpMem->epmem_node_mins)[static_cast<size_t>((*temp_node) - 1)] = time_counter;
@@ -3026,17 +3393,13 @@ void epmem_new_episode(agent* thisAgent)
 
                 // add NOW entry
                 // id = ?, start_episode_id = ?
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_now->bind_int(1, (*temp_node));
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_now->bind_int(2, time_counter);
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_now->bind_int(3, (*lti_id));
-                thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_now->execute(soar_module::op_reinit);
+                thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_now, (*temp_node), time_counter, (*lti_id));
+                epmem_index_open_interval(thisAgent, EPMEM_RIT_STATE_EDGE, (*temp_node), time_counter);
 
                 // update min
                 (*thisAgent->EpMem->epmem_edge_mins)[static_cast<size_t>((*temp_node) - 1)] = time_counter;
 
-                thisAgent->EpMem->epmem_stmts_graph->update_epmem_wmes_identifier_last_episode_id->bind_int(1, LLONG_MAX);
-                thisAgent->EpMem->epmem_stmts_graph->update_epmem_wmes_identifier_last_episode_id->bind_int(2, *temp_node);
-                thisAgent->EpMem->epmem_stmts_graph->update_epmem_wmes_identifier_last_episode_id->execute(soar_module::op_reinit);
+                thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->update_epmem_wmes_identifier_last_episode_id, LLONG_MAX, (*temp_node));
 
                 epmem_edge.pop();
             }
@@ -3059,8 +3422,7 @@ void epmem_new_episode(agent* thisAgent)
 
                         // remove NOW entry
                         // id = ?
-                        thisAgent->EpMem->epmem_stmts_graph->delete_epmem_wmes_constant_now->bind_int(1, r->first);
-                        thisAgent->EpMem->epmem_stmts_graph->delete_epmem_wmes_constant_now->execute(soar_module::op_reinit);
+                        thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->delete_epmem_wmes_constant_now, r->first);
 
                         range_start = (*thisAgent->EpMem->epmem_node_mins)[static_cast<size_t>(r->first - 1)];
                         range_end = (time_counter - 1);
@@ -3068,15 +3430,14 @@ void epmem_new_episode(agent* thisAgent)
                         // point (id, start_episode_id)
                         if (range_start == range_end)
                         {
-                            thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant_point->bind_int(1, r->first);
-                            thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant_point->bind_int(2, range_start);
-                            thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant_point->execute(soar_module::op_reinit);
+                            thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant_point, r->first, range_start);
                         }
                         // node
                         else
                         {
                             epmem_rit_insert_interval(thisAgent, range_start, range_end, r->first, &(thisAgent->EpMem->epmem_rit_state_graph[ EPMEM_RIT_STATE_NODE ]));
                         }
+                        epmem_index_close_interval(thisAgent, EPMEM_RIT_STATE_NODE, r->first, range_start, range_end);
 
                         // update max
                         (*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>(r->first - 1)] = true;
@@ -3095,28 +3456,23 @@ void epmem_new_episode(agent* thisAgent)
                 {
                     // remove NOW entry
                     // id = ?
-                    thisAgent->EpMem->epmem_stmts_graph->delete_epmem_wmes_identifier_now->bind_int(1, r->first.first);
-                    thisAgent->EpMem->epmem_stmts_graph->delete_epmem_wmes_identifier_now->execute(soar_module::op_reinit);
+                    thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->delete_epmem_wmes_identifier_now, r->first.first);
 
                     range_start = (*thisAgent->EpMem->epmem_edge_mins)[static_cast<size_t>(r->first.first - 1)];
                     range_end = (time_counter - 1);
 
-                    thisAgent->EpMem->epmem_stmts_graph->update_epmem_wmes_identifier_last_episode_id->bind_int(1, range_end);
-                    thisAgent->EpMem->epmem_stmts_graph->update_epmem_wmes_identifier_last_episode_id->bind_int(2, r->first.first);
-                    thisAgent->EpMem->epmem_stmts_graph->update_epmem_wmes_identifier_last_episode_id->execute(soar_module::op_reinit);
+                    thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->update_epmem_wmes_identifier_last_episode_id, range_end, r->first.first);
                     // point (id, start_episode_id)
                     if (range_start == range_end)
                     {
-                        thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_point->bind_int(1, r->first.first);
-                        thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_point->bind_int(2, range_start);
-                        thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_point->bind_int(3, r->first.second);
-                        thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_point->execute(soar_module::op_reinit);
+                        thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier_point, r->first.first, range_start, r->first.second);
                     }
                     // node
                     else
                     {
                         epmem_rit_insert_interval(thisAgent, range_start, range_end, r->first.first, &(thisAgent->EpMem->epmem_rit_state_graph[ EPMEM_RIT_STATE_EDGE ]), r->first.second);
                     }
+                    epmem_index_close_interval(thisAgent, EPMEM_RIT_STATE_EDGE, r->first.first, range_start, range_end);
 
                     // update max
                     (*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>(r->first.first - 1)] = true;
@@ -3128,8 +3484,7 @@ void epmem_new_episode(agent* thisAgent)
         }
 
         // add the time id to the epmem_episodes table
-        thisAgent->EpMem->epmem_stmts_graph->add_time->bind_int(1, time_counter);
-        thisAgent->EpMem->epmem_stmts_graph->add_time->execute(soar_module::op_reinit);
+        thisAgent->EpMem->epmem_writer->execute(thisAgent->EpMem->epmem_stmts_graph->add_time, time_counter);
 
         thisAgent->EpMem->epmem_stats->time->set_value(time_counter + 1);
 
@@ -3157,6 +3512,20 @@ void epmem_new_episode(agent* thisAgent)
         {
             thisAgent->EpMem->epmem_wme_adds->clear();
         }
+
+        bool committed = epmem_group_commit(thisAgent);
+
+        // everything from here on is written in the background, but a group
+        // commit must have reached the log before the agent goes on
+        if (committed)
+        {
+            thisAgent->EpMem->epmem_writer->flush();
+            thisAgent->EpMem->epmem_checkpointer->request();
+        }
+        else
+        {
+            thisAgent->EpMem->epmem_writer->submit();
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -3924,6 +4293,7 @@ epmem_literal* epmem_build_dnf(wme* cue_wme, epmem_wme_literal_map& literal_cach
     new(&(literal->matches)) epmem_node_pair_set();
 #endif
     new(&(literal->values)) epmem_node_int_map();
+    new(&(literal->matches_copy)) epmem_node_pair_list_ptr();
 
     literal_cache[cue_wme] = literal;
     return literal;
@@ -4042,6 +4412,7 @@ bool epmem_satisfy_literal(epmem_literal* literal, epmem_node_id parent, epmem_n
     {
         // add the edge as a match
         literal->matches.insert(std::make_pair(parent, child));
+        literal->matches_copy.reset();
         epmem_node_int_map::iterator values_iter = literal->values.find(child);
         if (values_iter == literal->values.end())
         {
@@ -4144,6 +4515,7 @@ bool epmem_unsatisfy_literal(epmem_literal* literal, epmem_node_id parent, epmem
     {
         // erase the edge from this literal's matches
         literal->matches.erase(lit_match_iter);
+        literal->matches_copy.reset();
         epmem_node_int_map::iterator values_iter = literal->values.find(child);
         (*values_iter).second--;
         if ((*values_iter).second == 0)
@@ -4218,7 +4590,32 @@ bool epmem_unsatisfy_literal(epmem_literal* literal, epmem_node_id parent, epmem
     return false;
 }
 
-bool epmem_graph_match(epmem_literal_deque::iterator& dnf_iter, epmem_literal_deque::iterator& iter_end, epmem_literal_node_pair_map& bindings, epmem_node_symbol_map bound_nodes[], agent* thisAgent, int depth = 0)
+// where epmem_graph_match gets the matches of a literal: the literals
+// themselves during the interval walk, or a candidate's copy of them
+// on a query thread (which must also stay clear of the memory pools)
+struct epmem_live_matches
+{
+    typedef epmem_node_pair_set match_set;
+    typedef epmem_node_set node_set;
+    const match_set& operator()(epmem_literal* literal) const
+    {
+        return literal->matches;
+    }
+};
+
+struct epmem_candidate_matches
+{
+    typedef epmem_node_pair_list match_set;
+    typedef std::set<epmem_node_id> node_set;
+    const epmem_gm_candidate* candidate;
+    const match_set& operator()(epmem_literal* literal) const
+    {
+        return *(candidate->matches.find(literal)->second);
+    }
+};
+
+template <class epmem_match_source>
+bool epmem_graph_match(epmem_literal_deque::iterator& dnf_iter, epmem_literal_deque::iterator& iter_end, epmem_literal_node_pair_map& bindings, epmem_node_symbol_map bound_nodes[], const epmem_match_source& matches_of, agent* thisAgent, int depth = 0)
 {
     if (dnf_iter == iter_end)
     {
@@ -4231,15 +4628,11 @@ bool epmem_graph_match(epmem_literal_deque::iterator& dnf_iter, epmem_literal_de
     }
     epmem_literal_deque::iterator next_iter = dnf_iter;
     next_iter++;
-#ifdef USE_MEM_POOL_ALLOCATORS
-    epmem_node_set failed_parents = epmem_node_set(std::less<epmem_node_id>(), soar_module::soar_memory_pool_allocator<epmem_node_id>());
-    epmem_node_set failed_children = epmem_node_set(std::less<epmem_node_id>(), soar_module::soar_memory_pool_allocator<epmem_node_id>());
-#else
-    epmem_node_set failed_parents;
-    epmem_node_set failed_children;
-#endif
+    typename epmem_match_source::node_set failed_parents;
+    typename epmem_match_source::node_set failed_children;
+    const typename epmem_match_source::match_set& matches = matches_of(literal);
     // go through the list of matches, binding each one to this literal in turn
-    for (epmem_node_pair_set::iterator match_iter = literal->matches.begin(); match_iter != literal->matches.end(); match_iter++)
+    for (typename epmem_match_source::match_set::const_iterator match_iter = matches.begin(); match_iter != matches.end(); match_iter++)
     {
         epmem_node_id parent_n_id = (*match_iter).first;
         epmem_node_id child_n_id = (*match_iter).second;
@@ -4333,7 +4726,7 @@ bool epmem_graph_match(epmem_literal_deque::iterator& dnf_iter, epmem_literal_de
         bindings[literal] = std::make_pair(parent_n_id, child_n_id);
         bound_nodes[literal->value_is_id][child_n_id] = literal->value_sym;
         // recurse on the rest of the list
-        bool list_satisfied = epmem_graph_match(next_iter, iter_end, bindings, bound_nodes, thisAgent, depth + 1);
+        bool list_satisfied = epmem_graph_match(next_iter, iter_end, bindings, bound_nodes, matches_of, thisAgent, depth + 1);
         // if the rest of the list matched, we've succeeded
         // otherwise, undo the temporarily modifications and try again
         if (list_satisfied)
@@ -4359,6 +4752,208 @@ bool epmem_graph_match(epmem_literal_deque::iterator& dnf_iter, epmem_literal_de
     return false;
 }
 
+/***************************************************************************
+ * Function     : epmem_new_gm_candidate
+ * Notes        : Records what graph match needs to know about the
+ *                episode the interval walk is currently at.  A
+ *                literal's matches are copied once, the first time
+ *                they are needed after they change, and the copy is
+ *                shared by every candidate until then.
+ **************************************************************************/
+epmem_gm_candidate* epmem_new_gm_candidate(epmem_time_id episode, double score, long int cardinality, epmem_literal_deque& gm_ordering)
+{
+    epmem_gm_candidate* candidate = new epmem_gm_candidate;
+
+    candidate->episode = episode;
+    candidate->score = score;
+    candidate->cardinality = cardinality;
+    candidate->ordering = gm_ordering;
+    for (epmem_literal_deque::iterator lit_iter = gm_ordering.begin(); lit_iter != gm_ordering.end(); lit_iter++)
+    {
+        epmem_literal* literal = *lit_iter;
+        if (!literal->matches_copy)
+        {
+            literal->matches_copy = std::make_shared<epmem_node_pair_list>(literal->matches.begin(), literal->matches.end());
+        }
+        candidate->matches[literal] = literal->matches_copy;
+    }
+    candidate->matched = false;
+    candidate->done = false;
+
+    return candidate;
+}
+
+// called, and returns, with the lock held
+void epmem_gm_pool::match(epmem_gm_candidate* candidate, std::unique_lock<std::mutex>& guard)
+{
+    busy++;
+    guard.unlock();
+
+    epmem_candidate_matches matches_of = { candidate };
+    epmem_node_symbol_map bound_nodes[2];
+    epmem_literal_deque::iterator begin = candidate->ordering.begin();
+    epmem_literal_deque::iterator end = candidate->ordering.end();
+    bool matched = epmem_graph_match(begin, end, candidate->bindings, bound_nodes, matches_of, thisAgent, 2);
+
+    guard.lock();
+    candidate->matched = matched;
+    candidate->done = true;
+    busy--;
+    finished.notify_all();
+}
+
+void epmem_gm_pool::start(size_t threads)
+{
+    if (workers.size() == threads)
+    {
+        return;
+    }
+
+    stop();
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers.push_back(std::thread(&epmem_gm_pool::run, this));
+    }
+}
+
+void epmem_gm_pool::stop()
+{
+    if (workers.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(queue_lock);
+        stopping = true;
+        wake.notify_all();
+    }
+    for (std::vector<std::thread>::iterator w = workers.begin(); w != workers.end(); w++)
+    {
+        w->join();
+    }
+    workers.clear();
+    stopping = false;
+}
+
+void epmem_gm_pool::submit(epmem_gm_candidate* candidate)
+{
+    std::lock_guard<std::mutex> guard(queue_lock);
+    queued.push_back(candidate);
+    wake.notify_one();
+}
+
+bool epmem_gm_pool::is_done(epmem_gm_candidate* candidate, bool wait)
+{
+    std::unique_lock<std::mutex> guard(queue_lock);
+
+    // rather than wait for a thread to get to it, match it here
+    if (wait && !queued.empty() && (queued.front() == candidate))
+    {
+        queued.pop_front();
+        match(candidate, guard);
+    }
+    while (wait && !candidate->done)
+    {
+        finished.wait(guard);
+    }
+    return candidate->done;
+}
+
+void epmem_gm_pool::cancel()
+{
+    std::unique_lock<std::mutex> guard(queue_lock);
+    queued.clear();
+    while (busy)
+    {
+        finished.wait(guard);
+    }
+}
+
+void epmem_gm_pool::run()
+{
+    std::unique_lock<std::mutex> guard(queue_lock);
+    while (true)
+    {
+        while (queued.empty() && !stopping)
+        {
+            wake.wait(guard);
+        }
+        if (stopping)
+        {
+            break;
+        }
+
+        epmem_gm_candidate* candidate = queued.front();
+        queued.pop_front();
+        match(candidate, guard);
+    }
+}
+
+/***************************************************************************
+ * Function     : epmem_graph_match_candidates
+ * Notes        : With query-threads above 1, the interval walk does
+ *                not stop to graph match each episode that satisfies
+ *                every leaf literal.  It submits a candidate to the
+ *                query threads instead and carries on as though the
+ *                match failed.  Between episodes the walk calls this
+ *                to take the oldest candidates that have been matched
+ *                off the front of the list, waiting for the oldest
+ *                one while more than backlog are outstanding (the
+ *                walk passes 0 when it has finished).  The first
+ *                candidate that matched is the episode the walk would
+ *                have stopped at, so it becomes the best episode and
+ *                the rest are dropped; until then the walk is already
+ *                in the right state.  Returns true if there was a
+ *                match.
+ **************************************************************************/
+bool epmem_graph_match_candidates(agent* thisAgent, epmem_gm_candidate_list& candidates, size_t backlog, epmem_time_id& best_episode, double& best_score, long int& best_cardinality, epmem_literal_node_pair_map& best_bindings)
+{
+    epmem_gm_pool* pool = thisAgent->EpMem->epmem_query_pool;
+    epmem_gm_candidate* winner = NULL;
+
+    thisAgent->EpMem->epmem_timers->query_graph_match->start();
+    while (!candidates.empty() && pool->is_done(candidates.front(), candidates.size() > backlog))
+    {
+        if (candidates.front()->matched)
+        {
+            winner = candidates.front();
+            break;
+        }
+        delete candidates.front();
+        candidates.pop_front();
+    }
+    if (winner)
+    {
+        pool->cancel();
+    }
+    thisAgent->EpMem->epmem_timers->query_graph_match->stop();
+
+    if (winner)
+    {
+        best_episode = winner->episode;
+        best_score = winner->score;
+        best_cardinality = winner->cardinality;
+        best_bindings = winner->bindings;
+
+        if (thisAgent->trace_settings[TRACE_EPMEM_SYSPARAM])
+        {
+            char buf[256];
+            SNPRINTF(buf, 254, "NEW KING (perfect, graph-match): (true, true)\n");
+            thisAgent->outputManager->printa_sf(thisAgent, buf);
+            xml_generate_warning(thisAgent, buf);
+        }
+
+        for (epmem_gm_candidate_list::iterator c = candidates.begin(); c != candidates.end(); c++)
+        {
+            delete (*c);
+        }
+        candidates.clear();
+    }
+
+    return (winner != NULL);
+}
+
 void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Symbol* neg_query, epmem_time_list& prohibits, epmem_time_id before, epmem_time_id after, wme_set& cue_wmes, symbol_triple_list& meta_wmes, symbol_triple_list& retrieval_wmes, int level = 3)
 {
     // a query must contain a positive cue
@@ -4390,6 +4985,8 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
 
     // epmem options
     bool do_graph_match = (thisAgent->EpMem->epmem_params->graph_match->get_value() == on);
+    bool use_interval_index = (thisAgent->EpMem->epmem_params->interval_index->get_value() == on);
+    int64_t query_threads = thisAgent->EpMem->epmem_params->query_threads->get_value();
     epmem_param_container::gm_ordering_choices gm_order = thisAgent->EpMem->epmem_params->gm_ordering->get_value();
 
     // variables needed for cleanup
@@ -4433,6 +5030,7 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
 
     // variables needed for graphmatch
     epmem_literal_deque gm_ordering;
+    epmem_gm_candidate_list gm_candidates;
 
     if (level > 1)
     {
@@ -4457,6 +5055,7 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
             new(&(root_literal->matches)) epmem_node_pair_set();
 #endif
             new(&(root_literal->values)) epmem_node_int_map();
+            new(&(root_literal->matches_copy)) epmem_node_pair_list_ptr();
             symbol_num_incoming[pos_query] = 1;
             literal_cache[NULL] = root_literal;
 
@@ -4563,6 +5162,7 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
             root_interval->sql->prepare();
             root_interval->sql->bind_int(1, before);
             root_interval->sql->execute(soar_module::op_reinit);
+            root_interval->index = NULL;
             root_interval->time = before;
             interval_pq.push(root_interval);
             interval_cleanup.insert(root_interval);
@@ -4574,6 +5174,10 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
         }
 
         // main loop of interval walk
+        if (do_graph_match && query_threads > 1)
+        {
+            thisAgent->EpMem->epmem_query_pool->start(static_cast<size_t>(query_threads));
+        }
         thisAgent->EpMem->epmem_timers->query_walk->start();
         while (pedge_pq.size() && current_episode > after)
         {
@@ -4632,78 +5236,106 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
                     // create interval queries for this partial edge
                     bool created = false;
                     int64_t edge_id = pedge->sql->column_int(0);
-                    for (int interval_type = EPMEM_RANGE_EP; interval_type <= EPMEM_RANGE_POINT; interval_type++)
+                    if (use_interval_index)
                     {
-                        for (int point_type = EPMEM_RANGE_START; point_type <= EPMEM_RANGE_END; point_type++)
+                        epmem_edge_intervals* intervals = epmem_get_edge_intervals(thisAgent, pedge->value_is_id, edge_id);
+                        for (int interval_type = EPMEM_RANGE_EP; interval_type <= EPMEM_RANGE_POINT; interval_type++)
                         {
-                            // pick a timer (any timer)
-                            soar_module::timer* sql_timer = NULL;
-                            switch (interval_type)
-                            {
-                                case EPMEM_RANGE_EP:
-                                    if (point_type == EPMEM_RANGE_START)
-                                    {
-                                        sql_timer = thisAgent->EpMem->epmem_timers->query_sql_start_ep;
-                                    }
-                                    else
-                                    {
-                                        sql_timer = thisAgent->EpMem->epmem_timers->query_sql_end_ep;
-                                    }
-                                    break;
-                                case EPMEM_RANGE_NOW:
-                                    if (point_type == EPMEM_RANGE_START)
-                                    {
-                                        sql_timer = thisAgent->EpMem->epmem_timers->query_sql_start_now;
-                                    }
-                                    else
-                                    {
-                                        sql_timer = thisAgent->EpMem->epmem_timers->query_sql_end_now;
-                                    }
-                                    break;
-                                case EPMEM_RANGE_POINT:
-                                    if (point_type == EPMEM_RANGE_START)
-                                    {
-                                        sql_timer = thisAgent->EpMem->epmem_timers->query_sql_start_point;
-                                    }
-                                    else
-                                    {
-                                        sql_timer = thisAgent->EpMem->epmem_timers->query_sql_end_point;
-                                    }
-                                    break;
-                            }
-                            // create the SQL query and bind it
-                            // try to find an existing query first; if none exist, allocate a new one from the memory pools
-                            soar_module::pooled_sqlite_statement* interval_sql = NULL;
-                            interval_sql = thisAgent->EpMem->epmem_stmts_graph->pool_find_interval_queries[pedge->value_is_id][point_type][interval_type]->request(sql_timer);
-                            int bind_pos = 1;
-                            if (point_type == EPMEM_RANGE_END && interval_type == EPMEM_RANGE_NOW)
-                            {
-                                interval_sql->bind_int(bind_pos++, current_episode);
-                            }
-                            interval_sql->bind_int(bind_pos++, edge_id);
-                            interval_sql->bind_int(bind_pos++, current_episode);
-                            if (interval_sql->execute() == soar_module::row)
+                            for (int point_type = EPMEM_RANGE_START; point_type <= EPMEM_RANGE_END; point_type++)
                             {
                                 epmem_interval* interval;
                                 thisAgent->memoryManager->allocate_with_pool(MP_epmem_interval, &interval);
-                                interval->is_end_point = point_type;
                                 interval->uedge = uedge;
-                                // If it's an start point of a range (ie. not a point) and it's before the promo time
-                                // (this is possible if a the promotion is in the middle of a range)
-                                // trim it to the promo time.
-                                // This will only happen if the LTI is promoted in the last interval it appeared in
-                                // (since otherwise the start point would not be before its promotion).
-                                // We don't care about the remaining results of the query
-                                interval->time = interval_sql->column_int(0);
-                                interval->sql = interval_sql;
-                                interval_pq.push(interval);
-                                interval_cleanup.insert(interval);
-                                uedge->intervals++;
-                                created = true;
+                                if (epmem_open_indexed_interval(interval, intervals, point_type, interval_type, current_episode))
+                                {
+                                    interval_pq.push(interval);
+                                    interval_cleanup.insert(interval);
+                                    uedge->intervals++;
+                                    created = true;
+                                }
+                                else
+                                {
+                                    thisAgent->memoryManager->free_with_pool(MP_epmem_interval, interval);
+                                }
                             }
-                            else
+                        }
+                    }
+                    else
+                    {
+                        for (int interval_type = EPMEM_RANGE_EP; interval_type <= EPMEM_RANGE_POINT; interval_type++)
+                        {
+                            for (int point_type = EPMEM_RANGE_START; point_type <= EPMEM_RANGE_END; point_type++)
                             {
-                                interval_sql->get_pool()->release(interval_sql);
+                                // pick a timer (any timer)
+                                soar_module::timer* sql_timer = NULL;
+                                switch (interval_type)
+                                {
+                                    case EPMEM_RANGE_EP:
+                                        if (point_type == EPMEM_RANGE_START)
+                                        {
+                                            sql_timer = thisAgent->EpMem->epmem_timers->query_sql_start_ep;
+                                        }
+                                        else
+                                        {
+                                            sql_timer = thisAgent->EpMem->epmem_timers->query_sql_end_ep;
+                                        }
+                                        break;
+                                    case EPMEM_RANGE_NOW:
+                                        if (point_type == EPMEM_RANGE_START)
+                                        {
+                                            sql_timer = thisAgent->EpMem->epmem_timers->query_sql_start_now;
+                                        }
+                                        else
+                                        {
+                                            sql_timer = thisAgent->EpMem->epmem_timers->query_sql_end_now;
+                                        }
+                                        break;
+                                    case EPMEM_RANGE_POINT:
+                                        if (point_type == EPMEM_RANGE_START)
+                                        {
+                                            sql_timer = thisAgent->EpMem->epmem_timers->query_sql_start_point;
+                                        }
+                                        else
+                                        {
+                                            sql_timer = thisAgent->EpMem->epmem_timers->query_sql_end_point;
+                                        }
+                                        break;
+                                }
+                                // create the SQL query and bind it
+                                // try to find an existing query first; if none exist, allocate a new one from the memory pools
+                                soar_module::pooled_sqlite_statement* interval_sql = NULL;
+                                interval_sql = thisAgent->EpMem->epmem_stmts_graph->pool_find_interval_queries[pedge->value_is_id][point_type][interval_type]->request(sql_timer);
+                                int bind_pos = 1;
+                                if (point_type == EPMEM_RANGE_END && interval_type == EPMEM_RANGE_NOW)
+                                {
+                                    interval_sql->bind_int(bind_pos++, current_episode);
+                                }
+                                interval_sql->bind_int(bind_pos++, edge_id);
+                                interval_sql->bind_int(bind_pos++, current_episode);
+                                if (interval_sql->execute() == soar_module::row)
+                                {
+                                    epmem_interval* interval;
+                                    thisAgent->memoryManager->allocate_with_pool(MP_epmem_interval, &interval);
+                                    interval->is_end_point = point_type;
+                                    interval->uedge = uedge;
+                                    // If it's an start point of a range (ie. not a point) and it's before the promo time
+                                    // (this is possible if a the promotion is in the middle of a range)
+                                    // trim it to the promo time.
+                                    // This will only happen if the LTI is promoted in the last interval it appeared in
+                                    // (since otherwise the start point would not be before its promotion).
+                                    // We don't care about the remaining results of the query
+                                    interval->time = interval_sql->column_int(0);
+                                    interval->sql = interval_sql;
+                                    interval->index = NULL;
+                                    interval_pq.push(interval);
+                                    interval_cleanup.insert(interval);
+                                    uedge->intervals++;
+                                    created = true;
+                                }
+                                else
+                                {
+                                    interval_sql->get_pool()->release(interval_sql);
+                                }
                             }
                         }
                     }
@@ -4799,15 +5431,23 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
                     }
                     // put the interval query back into the queue if there's more and some literal cares
                     // otherwise, reinitialize the query and put it in a pool
-                    if (interval->sql && interval->sql->execute() == soar_module::row)
+                    if (interval->index && epmem_next_indexed_interval(interval))
+                    {
+                        interval_pq.push(interval);
+                    }
+                    else if (interval->sql && interval->sql->execute() == soar_module::row)
                     {
                         interval->time = interval->sql->column_int(0);
                         interval_pq.push(interval);
                     }
-                    else if (interval->sql)
+                    else if (interval->sql || interval->index)
                     {
-                        interval->sql->get_pool()->release(interval->sql);
-                        interval->sql = NULL;
+                        if (interval->sql)
+                        {
+                            interval->sql->get_pool()->release(interval->sql);
+                            interval->sql = NULL;
+                        }
+                        interval->index = NULL;
                         uedge->intervals--;
                         if (uedge->intervals)
                         {
@@ -4871,18 +5511,27 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
                             {
                                 std::sort(gm_ordering.begin(), gm_ordering.end(), epmem_gm_mcv_comparator);
                             }
-                            epmem_literal_deque::iterator begin = gm_ordering.begin();
-                            epmem_literal_deque::iterator end = gm_ordering.end();
-                            best_bindings.clear();
-                            epmem_node_symbol_map bound_nodes[2];
-                            if (QUERY_DEBUG >= 1)
+                            if (query_threads > 1)
+                            {
+                                // match it on the query threads while the walk carries on
+                                gm_candidates.push_back(epmem_new_gm_candidate(current_episode, current_score, current_cardinality, gm_ordering));
+                                thisAgent->EpMem->epmem_query_pool->submit(gm_candidates.back());
+                            }
+                            else
                             {
-                                std::cout << "	GRAPH MATCH" << std::endl;
-                                epmem_print_retrieval_state(literal_cache, pedge_caches, uedge_caches);
+                                epmem_literal_deque::iterator begin = gm_ordering.begin();
+                                epmem_literal_deque::iterator end = gm_ordering.end();
+                                best_bindings.clear();
+                                epmem_node_symbol_map bound_nodes[2];
+                                if (QUERY_DEBUG >= 1)
+                                {
+                                    std::cout << "	GRAPH MATCH" << std::endl;
+                                    epmem_print_retrieval_state(literal_cache, pedge_caches, uedge_caches);
+                                }
+                                thisAgent->EpMem->epmem_timers->query_graph_match->start();
+                                graph_matched = epmem_graph_match(begin, end, best_bindings, bound_nodes, epmem_live_matches(), thisAgent, 2);
+                                thisAgent->EpMem->epmem_timers->query_graph_match->stop();
                             }
-                            thisAgent->EpMem->epmem_timers->query_graph_match->start();
-                            graph_matched = epmem_graph_match(begin, end, best_bindings, bound_nodes, thisAgent, 2);
-                            thisAgent->EpMem->epmem_timers->query_graph_match->stop();
                         }
                         if (!do_graph_match || graph_matched)
                         {
@@ -4901,6 +5550,13 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
                     }
                 }
 
+                // let the walk get at most two candidates per query thread ahead
+                if (!gm_candidates.empty() && epmem_graph_match_candidates(thisAgent, gm_candidates, static_cast<size_t>(2 * query_threads), best_episode, best_score, best_cardinality, best_bindings))
+                {
+                    best_graph_matched = true;
+                    current_episode = EPMEM_MEMID_NONE;
+                }
+
                 if (current_episode == EPMEM_MEMID_NONE)
                 {
                     break;
@@ -4912,6 +5568,10 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
             }
             thisAgent->EpMem->epmem_timers->query_walk_interval->stop();
         }
+        if (!gm_candidates.empty() && epmem_graph_match_candidates(thisAgent, gm_candidates, 0, best_episode, best_score, best_cardinality, best_bindings))
+        {
+            best_graph_matched = true;
+        }
         thisAgent->EpMem->epmem_timers->query_walk->stop();
 
         // if the best episode is the default, fail
@@ -5045,6 +5705,7 @@ void epmem_process_query(agent* thisAgent, Symbol* state, Symbol* pos_query, Sym
         literal->children.~epmem_literal_set();
         literal->matches.~epmem_node_pair_set();
         literal->values.~epmem_node_int_map();
+        literal->matches_copy.~epmem_node_pair_list_ptr();
         thisAgent->memoryManager->free_with_pool(MP_epmem_literal, literal);
     }
     thisAgent->EpMem->epmem_timers->query_cleanup->stop();
@@ -5074,6 +5735,7 @@ inline std::string _epmem_print_sti(epmem_node_id id)
 void epmem_print_episode(agent* thisAgent, epmem_time_id memory_id, std::string* buf)
 {
     epmem_attach(thisAgent);
+    thisAgent->EpMem->epmem_writer->flush();
 
     // if bad memory, bail
     buf->clear();
@@ -5204,6 +5866,7 @@ void epmem_print_episode(agent* thisAgent, epmem_time_id memory_id, std::string*
 void epmem_visualize_episode(agent* thisAgent, epmem_time_id memory_id, std::string* buf)
 {
     epmem_attach(thisAgent);
+    thisAgent->EpMem->epmem_writer->flush();
 
     // if bad memory, bail
     buf->clear();
@@ -5777,6 +6440,9 @@ void epmem_respond_to_cmd(agent* thisAgent)
         // and there is something on the cue
         if (new_cue && wme_count)
         {
+            // queries need every stored episode to be in the database
+            thisAgent->EpMem->epmem_writer->flush();
+
             _epmem_respond_to_cmd_parse(thisAgent, cmds, good_cue, path, retrieve, next, previous, query, neg_query, prohibit, before, after, cue_wmes);
 
             ////////////////////////////////////////////////////////////////////////////
@@ -5938,6 +6604,8 @@ bool epmem_backup_db(agent* thisAgent, const char* file_name, std::string* err)
 
     if (thisAgent->EpMem->epmem_db->get_status() == soar_module::connected)
     {
+        thisAgent->EpMem->epmem_writer->flush();
+
         if (thisAgent->EpMem->epmem_params->lazy_commit->get_value() == on)
         {
             thisAgent->EpMem->epmem_stmts_common->commit->execute(soar_module::op_reinit);
@@ -5958,6 +6626,79 @@ bool epmem_backup_db(agent* thisAgent, const char* file_name, std::string* err)
     return return_val;
 }
 
+/***************************************************************************
+ * Function     : epmem_export_db
+ * Notes        : Writes the episodic store to a compact snapshot file
+ *                (see epmem_snapshot.h).  Like a backup, this first
+ *                finishes any storage still being written.
+ **************************************************************************/
+bool epmem_export_db(agent* thisAgent, const char* file_name, std::string* err)
+{
+    if (thisAgent->EpMem->epmem_db->get_status() != soar_module::connected)
+    {
+        err->assign("Episodic database is not currently connected.");
+        return false;
+    }
+
+    thisAgent->EpMem->epmem_writer->flush();
+
+    return epmem_snapshot::write(thisAgent->EpMem->epmem_db, file_name, err);
+}
+
+/***************************************************************************
+ * Function     : epmem_import_db
+ * Notes        : Replaces the contents of the episodic memory database
+ *                with those of a snapshot file.  The file is checked
+ *                before anything is touched; the database is then
+ *                re-initialized, loading the snapshot's rows before
+ *                epmem_init_db reads its state back out of the tables.
+ *                Re-initializing erases an in-memory store, or a file
+ *                with append off, so the snapshot is first loaded into
+ *                a scratch copy of the schema and the existing store is
+ *                only given up once that has worked.
+ **************************************************************************/
+bool epmem_import_db(agent* thisAgent, const char* file_name, std::string* err)
+{
+    epmem_snapshot snapshot;
+
+    if (!snapshot.open(file_name))
+    {
+        err->assign(snapshot.get_error());
+        return false;
+    }
+
+    epmem_attach(thisAgent);
+    if (thisAgent->EpMem->epmem_db->get_status() == soar_module::connected)
+    {
+        thisAgent->EpMem->epmem_writer->flush();
+
+        if (!snapshot.try_load(thisAgent->EpMem->epmem_db))
+        {
+            err->assign(snapshot.get_error());
+            return false;
+        }
+    }
+
+    epmem_close(thisAgent);
+
+    thisAgent->EpMem->epmem_pending_snapshot = &snapshot;
+    epmem_init_db(thisAgent);
+    thisAgent->EpMem->epmem_pending_snapshot = NULL;
+
+    if (thisAgent->EpMem->epmem_db->get_status() != soar_module::connected)
+    {
+        err->assign("Could not open episodic memory database.");
+        return false;
+    }
+    if (!snapshot.get_error().empty())
+    {
+        err->assign(snapshot.get_error());
+        return false;
+    }
+
+    return true;
+}
+
 EpMem_Manager::EpMem_Manager(agent* myAgent)
 {
     thisAgent = myAgent;
@@ -5996,6 +6737,14 @@ EpMem_Manager::EpMem_Manager(agent* myAgent)
 
      epmem_validation = 0;
 
+     epmem_checkpointer = new soar_module::sqlite_checkpointer();
+     epmem_writer = new soar_module::sqlite_writer();
+     epmem_uncommitted_episodes = 0;
+
+     epmem_pending_snapshot = NULL;
+
+     epmem_query_pool = new epmem_gm_pool(thisAgent);
+
 };
 
 void EpMem_Manager::clean_up_for_agent_deletion()
@@ -6022,6 +6771,9 @@ void EpMem_Manager::clean_up_for_agent_deletion()
 
     delete epmem_wme_adds;
 
+    delete epmem_query_pool;
+    delete epmem_writer;
+    delete epmem_checkpointer;
     delete epmem_db;
 }
 void epmem_param_container::print_settings(agent* thisAgent)
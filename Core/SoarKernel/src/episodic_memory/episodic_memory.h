@@ -23,12 +23,19 @@
 #include <stack>
 #include <set>
 #include <queue>
+#include <unordered_map>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 //////////////////////////////////////////////////////////
 // EpMem Parameters
 //////////////////////////////////////////////////////////
 
 class epmem_path_param;
+class epmem_snapshot;
 
 class epmem_param_container: public soar_module::param_container
 {
@@ -65,17 +72,22 @@ class epmem_param_container: public soar_module::param_container
         soar_module::constant_param<db_choices>* database;
         epmem_path_param* path;
         soar_module::boolean_param* lazy_commit;
+        soar_module::integer_param* commit_episodes;
+        soar_module::integer_param* commit_ms;
+        soar_module::boolean_param* async_storage;
         soar_module::boolean_param* append_db;
 
         // retrieval
         soar_module::boolean_param* graph_match;
         soar_module::decimal_param* balance;
+        soar_module::boolean_param* interval_index;
 
         // performance
         soar_module::constant_param<page_choices>* page_size;
         soar_module::integer_param* cache_size;
         soar_module::constant_param<opt_choices>* opt;
         soar_module::constant_param<soar_module::timer::timer_level>* timers;
+        soar_module::integer_param* query_threads;
 
         // experimental
         soar_module::constant_param<gm_ordering_choices>* gm_ordering;
@@ -334,6 +346,10 @@ class epmem_graph_statement_container: public soar_module::sqlite_statement_cont
 
         //
 
+        soar_module::sqlite_statement* load_intervals[2][3];
+
+        //
+
         soar_module::sqlite_statement_pool* pool_find_edge_queries[2][2];
         soar_module::sqlite_statement_pool* pool_find_interval_queries[2][2][3];
 //        soar_module::sqlite_statement_pool* pool_find_lti_queries[2][3];
@@ -379,6 +395,19 @@ typedef struct epmem_rit_state_struct
     soar_module::sqlite_statement* add_query;
 } epmem_rit_state;
 
+// in-memory copy of the now/point/range rows of one wc_id/wi_id,
+// used by cue-based retrieval instead of the interval queries
+typedef std::pair<epmem_time_id, epmem_time_id> epmem_time_range;
+
+typedef struct epmem_edge_intervals_struct
+{
+    std::vector<epmem_time_range> ranges;                   // ascending, non-overlapping
+    std::vector<epmem_time_id> points;                      // ascending
+    epmem_time_id now_start;                                // EPMEM_MEMID_NONE if not in wm
+} epmem_edge_intervals;
+
+typedef std::unordered_map<int64_t, epmem_edge_intervals> epmem_interval_index;
+
 //////////////////////////////////////////////////////////
 // Soar Integration Types
 //////////////////////////////////////////////////////////
@@ -475,6 +504,8 @@ extern void epmem_clear_transient_structures(agent* thisAgent);
 // perform epmem actions
 extern void epmem_go(agent* thisAgent, bool allow_store = true);
 extern bool epmem_backup_db(agent* thisAgent, const char* file_name, std::string* err);
+extern bool epmem_export_db(agent* thisAgent, const char* file_name, std::string* err);
+extern bool epmem_import_db(agent* thisAgent, const char* file_name, std::string* err);
 extern void epmem_init_db(agent* thisAgent, bool readonly = false);
 // visualization
 extern void epmem_visualize_episode(agent* thisAgent, epmem_time_id memory_id, std::string* buf);
@@ -491,6 +522,7 @@ typedef struct epmem_literal_struct epmem_literal;
 typedef struct epmem_pedge_struct epmem_pedge;
 typedef struct epmem_uedge_struct epmem_uedge;
 typedef struct epmem_interval_struct epmem_interval;
+typedef struct epmem_gm_candidate_struct epmem_gm_candidate;
 
 // pairs
 typedef struct std::pair<Symbol*, epmem_literal*> epmem_symbol_literal_pair;
@@ -512,6 +544,10 @@ typedef std::map<epmem_triple, epmem_pedge*> epmem_triple_pedge_map;
 typedef std::map<wme*, epmem_literal*> epmem_wme_literal_map;
 typedef std::set<epmem_literal*> epmem_literal_set;
 typedef std::set<epmem_pedge*> epmem_pedge_set;
+typedef std::vector<epmem_node_pair> epmem_node_pair_list;
+typedef std::shared_ptr<const epmem_node_pair_list> epmem_node_pair_list_ptr;
+typedef std::map<epmem_literal*, epmem_node_pair_list_ptr> epmem_literal_matches_map;
+typedef std::deque<epmem_gm_candidate*> epmem_gm_candidate_list;
 
 #ifdef USE_MEM_POOL_ALLOCATORS
 typedef std::map<epmem_triple, epmem_uedge*, std::less<epmem_triple>, soar_module::soar_memory_pool_allocator<std::pair<epmem_triple const, epmem_uedge*> > > epmem_triple_uedge_map;
@@ -562,6 +598,10 @@ struct epmem_literal_struct
     epmem_literal_set children;
     epmem_node_pair_set matches;
     epmem_node_int_map values;
+
+    // copy of matches shared by the graph match candidates taken since
+    // matches last changed (see epmem_new_gm_candidate)
+    epmem_node_pair_list_ptr matches_copy;
 };
 
 struct epmem_pedge_struct
@@ -588,9 +628,70 @@ struct epmem_interval_struct
     epmem_uedge* uedge;
     int is_end_point;
     soar_module::pooled_sqlite_statement* sql;
+    epmem_edge_intervals* index;    // used in place of sql when the interval index is on
+    int interval_type;
+    size_t remaining;
     epmem_time_id time;
 };
 
+// an episode waiting to be graph matched by a query thread,
+// with the literal matches as of that episode
+struct epmem_gm_candidate_struct
+{
+    epmem_time_id episode;
+    double score;
+    long int cardinality;
+    epmem_literal_deque ordering;
+    epmem_literal_matches_map matches;
+    epmem_literal_node_pair_map bindings;
+    bool matched;
+    bool done;      // guarded by the pool's lock
+};
+
+// the query threads: they graph match candidates in the order the
+// interval walk submits them, while the walk carries on
+class epmem_gm_pool
+{
+    protected:
+        agent* thisAgent;
+
+        std::vector<std::thread> workers;
+        std::deque<epmem_gm_candidate*> queued;
+        std::mutex queue_lock;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        size_t busy;
+        bool stopping;
+
+        void match(epmem_gm_candidate* candidate, std::unique_lock<std::mutex>& guard);
+        void run();
+
+    public:
+        epmem_gm_pool(agent* myAgent): thisAgent(myAgent), busy(0), stopping(false) {}
+        ~epmem_gm_pool()
+        {
+            stop();
+        }
+
+        // (re)starts the pool with this many threads, if it has not got them
+        void start(size_t threads);
+        void stop();
+
+        inline size_t size()
+        {
+            return workers.size();
+        }
+
+        void submit(epmem_gm_candidate* candidate);
+
+        // whether the candidate has been matched, waiting for it (or
+        // matching it on this thread, if no thread has taken it) if asked
+        bool is_done(epmem_gm_candidate* candidate, bool wait);
+
+        // drops the queued candidates and waits for the ones being matched
+        void cancel();
+};
+
 // priority queues and comparison functions
 struct epmem_pedge_comparator
 {
@@ -663,6 +764,23 @@ class EpMem_Manager
 
         epmem_rit_state epmem_rit_state_graph[2];
 
+        // interval index (see epmem_get_edge_intervals)
+        epmem_interval_index epmem_interval_indexes[2];
+
+        // group commit (see epmem_group_commit)
+        soar_module::sqlite_checkpointer* epmem_checkpointer;
+
+        // background storage (see epmem_new_episode)
+        soar_module::sqlite_writer* epmem_writer;
+        uint64_t epmem_uncommitted_episodes;
+        std::chrono::steady_clock::time_point epmem_last_commit;
+
+        // snapshot being imported (see epmem_import_db)
+        epmem_snapshot* epmem_pending_snapshot;
+
+        // query threads (see epmem_graph_match_candidates)
+        epmem_gm_pool* epmem_query_pool;
+
         uint64_t epmem_validation;
 
     private:
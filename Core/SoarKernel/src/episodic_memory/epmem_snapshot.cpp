@@ -0,0 +1,652 @@
+/*
+ * epmem_snapshot.cpp
+ *
+ *  Compact, column-oriented snapshot files of an episodic memory
+ *  database.  See epmem_snapshot.h for an overview.
+ */
+
+#include "epmem_snapshot.h"
+
+#include "constants.h"
+
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define EPMEM_SNAPSHOT_MAGIC "EPMEMSNP"
+#define EPMEM_SNAPSHOT_MAGIC_LENGTH 8
+#define EPMEM_SNAPSHOT_FORMAT 1
+
+/* Column kinds */
+#define EPMEM_SNAPSHOT_INT 'i'
+#define EPMEM_SNAPSHOT_REAL 'r'
+#define EPMEM_SNAPSHOT_TEXT 't'
+
+typedef struct epmem_snapshot_table_spec_struct
+{
+    const char*     name;
+    const char*     columns;
+    const char*     kinds;
+    const char*     order;
+} epmem_snapshot_table_spec;
+
+/* Every table a snapshot holds, in the order it holds them. */
+static const epmem_snapshot_table_spec epmem_snapshot_tables[] =
+{
+    { "epmem_persistent_variables",  "variable_id,variable_value",                                     "ii",    "variable_id" },
+    { "epmem_symbols_type",          "s_id,symbol_type",                                               "ii",    "s_id" },
+    { "epmem_symbols_integer",       "s_id,symbol_value",                                              "ii",    "s_id" },
+    { "epmem_symbols_float",         "s_id,symbol_value",                                              "ir",    "s_id" },
+    { "epmem_symbols_string",        "s_id,symbol_value",                                              "it",    "s_id" },
+    { "epmem_nodes",                 "n_id,lti_id",                                                    "ii",    "n_id" },
+    { "epmem_episodes",              "episode_id",                                                     "i",     "episode_id" },
+    { "epmem_wmes_constant",         "wc_id,parent_n_id,attribute_s_id,value_s_id",                    "iiii",  "wc_id" },
+    { "epmem_wmes_identifier",       "wi_id,parent_n_id,attribute_s_id,child_n_id,last_episode_id",    "iiiii", "wi_id" },
+    { "epmem_wmes_constant_now",     "wc_id,start_episode_id",                                         "ii",    "start_episode_id,wc_id" },
+    { "epmem_wmes_identifier_now",   "wi_id,start_episode_id,lti_id",                                  "iii",   "start_episode_id,wi_id" },
+    { "epmem_wmes_constant_point",   "wc_id,episode_id",                                               "ii",    "episode_id,wc_id" },
+    { "epmem_wmes_identifier_point", "wi_id,episode_id,lti_id",                                        "iii",   "episode_id,wi_id" },
+    { "epmem_wmes_constant_range",   "rit_id,start_episode_id,end_episode_id,wc_id",                   "iiii",  "start_episode_id,wc_id" },
+    { "epmem_wmes_identifier_range", "rit_id,start_episode_id,end_episode_id,wi_id,lti_id",            "iiiii", "start_episode_id,wi_id" }
+};
+
+#define EPMEM_SNAPSHOT_NUM_TABLES (sizeof(epmem_snapshot_tables) / sizeof(epmem_snapshot_tables[0]))
+
+/* ----------------------------------------------------------------------
+                          Varint Encoding
+---------------------------------------------------------------------- */
+
+static inline void epmem_snapshot_put_varint(std::string& out, uint64_t val)
+{
+    while (val >= 0x80)
+    {
+        out.push_back(static_cast<char>((val & 0x7F) | 0x80));
+        val >>= 7;
+    }
+    out.push_back(static_cast<char>(val));
+}
+
+/* Reads a varint, returning false if it would run past end. */
+static inline bool epmem_snapshot_get_varint(const uint8_t*& pos, const uint8_t* end, uint64_t& val)
+{
+    int shift = 0;
+
+    val = 0;
+    while ((pos < end) && (shift < 64))
+    {
+        uint8_t byte = *(pos++);
+        val |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+/* --- signed deltas as small unsigned values: 0, -1, 1, -2, 2, ... --- */
+static inline uint64_t epmem_snapshot_zigzag(int64_t val)
+{
+    return (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63);
+}
+
+static inline int64_t epmem_snapshot_unzigzag(uint64_t val)
+{
+    return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+}
+
+/* ----------------------------------------------------------------------
+                          Float Encoding
+---------------------------------------------------------------------- */
+
+#define EPMEM_SNAPSHOT_REAL_SIZE 8
+
+/* --- doubles are written as their IEEE 754 bits, least significant byte first --- */
+static inline void epmem_snapshot_put_real(std::string& out, double val)
+{
+    uint64_t bits;
+
+    memcpy(&bits, &val, sizeof(bits));
+    for (int i = 0; i < EPMEM_SNAPSHOT_REAL_SIZE; i++)
+    {
+        out.push_back(static_cast<char>(bits & 0xFF));
+        bits >>= 8;
+    }
+}
+
+static inline double epmem_snapshot_get_real(const uint8_t*& pos)
+{
+    uint64_t bits = 0;
+    double val;
+
+    for (int i = EPMEM_SNAPSHOT_REAL_SIZE - 1; i >= 0; i--)
+    {
+        bits = (bits << 8) | pos[i];
+    }
+    pos += EPMEM_SNAPSHOT_REAL_SIZE;
+
+    memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+/* ----------------------------------------------------------------------
+                              Writing
+---------------------------------------------------------------------- */
+
+bool epmem_snapshot::write(soar_module::sqlite_database* db, const char* file_name, std::string* err)
+{
+    std::ofstream out(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    std::string header;
+    size_t schema_length = strlen(EPMEM_SCHEMA_VERSION);
+
+    if (!out)
+    {
+        err->assign("Could not open file for writing.");
+        return false;
+    }
+
+    header.append(EPMEM_SNAPSHOT_MAGIC, EPMEM_SNAPSHOT_MAGIC_LENGTH);
+    epmem_snapshot_put_varint(header, EPMEM_SNAPSHOT_FORMAT);
+    epmem_snapshot_put_varint(header, schema_length);
+    header.append(EPMEM_SCHEMA_VERSION, schema_length);
+    epmem_snapshot_put_varint(header, EPMEM_SNAPSHOT_NUM_TABLES);
+    out.write(header.data(), header.size());
+
+    for (size_t t = 0; t < EPMEM_SNAPSHOT_NUM_TABLES; t++)
+    {
+        const epmem_snapshot_table_spec* spec = &(epmem_snapshot_tables[t]);
+        size_t num_columns = strlen(spec->kinds);
+        std::vector<std::string> data(num_columns);
+        std::vector<std::string> nulls(num_columns);
+        std::vector<bool> has_nulls(num_columns, false);
+        std::vector<int64_t> last(num_columns, 0);
+        uint64_t rows = 0;
+        std::string sql;
+
+        sql.append("SELECT ").append(spec->columns).append(" FROM ").append(spec->name).append(" ORDER BY ").append(spec->order);
+        soar_module::sqlite_statement* q = new soar_module::sqlite_statement(db, sql.c_str());
+        q->prepare();
+        if (q->get_status() != soar_module::ready)
+        {
+            delete q;
+            err->assign("Could not read episodic memory table ").append(spec->name).append(".");
+            return false;
+        }
+
+        while (q->execute() == soar_module::row)
+        {
+            if ((rows % 8) == 0)
+            {
+                for (size_t c = 0; c < num_columns; c++)
+                {
+                    nulls[c].push_back(0);
+                }
+            }
+
+            for (size_t c = 0; c < num_columns; c++)
+            {
+                int col = static_cast<int>(c);
+
+                if (q->column_type(col) == soar_module::null_t)
+                {
+                    nulls[c][rows / 8] |= static_cast<char>(1 << (rows % 8));
+                    has_nulls[c] = true;
+                    continue;
+                }
+
+                switch (spec->kinds[c])
+                {
+                    case EPMEM_SNAPSHOT_INT:
+                    {
+                        int64_t val = q->column_int(col);
+                        epmem_snapshot_put_varint(data[c], epmem_snapshot_zigzag(static_cast<int64_t>(static_cast<uint64_t>(val) - static_cast<uint64_t>(last[c]))));
+                        last[c] = val;
+                        break;
+                    }
+
+                    case EPMEM_SNAPSHOT_REAL:
+                    {
+                        epmem_snapshot_put_real(data[c], q->column_double(col));
+                        break;
+                    }
+
+                    case EPMEM_SNAPSHOT_TEXT:
+                    {
+                        const char* val = q->column_text(col);
+                        data[c].append(val, strlen(val) + 1);
+                        break;
+                    }
+                }
+            }
+            rows++;
+        }
+        delete q;
+
+        std::string table_header;
+        size_t name_length = strlen(spec->name);
+        epmem_snapshot_put_varint(table_header, name_length);
+        table_header.append(spec->name, name_length);
+        epmem_snapshot_put_varint(table_header, rows);
+        epmem_snapshot_put_varint(table_header, num_columns);
+        out.write(table_header.data(), table_header.size());
+
+        for (size_t c = 0; c < num_columns; c++)
+        {
+            std::string column_header;
+            column_header.push_back(spec->kinds[c]);
+            column_header.push_back(has_nulls[c] ? 1 : 0);
+            if (has_nulls[c])
+            {
+                column_header.append(nulls[c]);
+            }
+            epmem_snapshot_put_varint(column_header, data[c].size());
+            out.write(column_header.data(), column_header.size());
+            out.write(data[c].data(), data[c].size());
+        }
+    }
+
+    out.close();
+    if (!out)
+    {
+        err->assign("Error while writing file.");
+        return false;
+    }
+
+    return true;
+}
+
+/* ----------------------------------------------------------------------
+                              Reading
+---------------------------------------------------------------------- */
+
+epmem_snapshot::epmem_snapshot()
+{
+    contents = NULL;
+    contents_size = 0;
+    mapped = false;
+}
+
+epmem_snapshot::~epmem_snapshot()
+{
+    close();
+}
+
+bool epmem_snapshot::open(const char* file_name)
+{
+    close();
+
+#ifdef _WIN32
+    std::ifstream in(file_name, std::ios::in | std::ios::binary);
+    if (!in)
+    {
+        error.assign("Could not open file.");
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    contents = buffer.empty() ? NULL : &(buffer[0]);
+    contents_size = buffer.size();
+#else
+    int fd = ::open(file_name, O_RDONLY);
+    struct stat file_stat;
+
+    if (fd < 0)
+    {
+        error.assign("Could not open file.");
+        return false;
+    }
+    if ((fstat(fd, &file_stat) == 0) && (file_stat.st_size > 0))
+    {
+        void* view = mmap(NULL, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED)
+        {
+            contents = static_cast<const uint8_t*>(view);
+            contents_size = static_cast<size_t>(file_stat.st_size);
+            mapped = true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    if (!parse())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void epmem_snapshot::close()
+{
+#ifndef _WIN32
+    if (mapped)
+    {
+        munmap(const_cast<uint8_t*>(contents), contents_size);
+    }
+#endif
+    buffer.clear();
+    contents = NULL;
+    contents_size = 0;
+    mapped = false;
+    tables.clear();
+}
+
+/* Walks the whole file, recording where each column starts and checking
+ * that every column holds exactly one value per non-NULL row, so load()
+ * can't run off the end of a truncated or corrupt snapshot. */
+bool epmem_snapshot::parse()
+{
+    const uint8_t* pos = contents;
+    const uint8_t* end = contents + contents_size;
+    uint64_t val;
+
+    error.assign("Not a valid episodic memory snapshot.");
+
+    if (!contents || (contents_size < EPMEM_SNAPSHOT_MAGIC_LENGTH) || memcmp(pos, EPMEM_SNAPSHOT_MAGIC, EPMEM_SNAPSHOT_MAGIC_LENGTH))
+    {
+        return false;
+    }
+    pos += EPMEM_SNAPSHOT_MAGIC_LENGTH;
+
+    if (!epmem_snapshot_get_varint(pos, end, val) || (val != EPMEM_SNAPSHOT_FORMAT))
+    {
+        error.assign("Unsupported episodic memory snapshot format.");
+        return false;
+    }
+
+    if (!epmem_snapshot_get_varint(pos, end, val) || (val > static_cast<uint64_t>(end - pos)))
+    {
+        return false;
+    }
+    if (std::string(reinterpret_cast<const char*>(pos), static_cast<size_t>(val)) != EPMEM_SCHEMA_VERSION)
+    {
+        error.assign("Snapshot was made from an episodic memory database with a different schema version.");
+        return false;
+    }
+    pos += val;
+
+    if (!epmem_snapshot_get_varint(pos, end, val) || (val != EPMEM_SNAPSHOT_NUM_TABLES))
+    {
+        return false;
+    }
+
+    tables.resize(EPMEM_SNAPSHOT_NUM_TABLES);
+    for (size_t t = 0; t < EPMEM_SNAPSHOT_NUM_TABLES; t++)
+    {
+        const epmem_snapshot_table_spec* spec = &(epmem_snapshot_tables[t]);
+        size_t num_columns = strlen(spec->kinds);
+        epmem_snapshot_table* table = &(tables[t]);
+
+        if (!epmem_snapshot_get_varint(pos, end, val) || (val != strlen(spec->name)) ||
+                (val > static_cast<uint64_t>(end - pos)) || memcmp(pos, spec->name, static_cast<size_t>(val)))
+        {
+            return false;
+        }
+        pos += val;
+
+        if (!epmem_snapshot_get_varint(pos, end, table->rows) ||
+                !epmem_snapshot_get_varint(pos, end, val) || (val != num_columns))
+        {
+            return false;
+        }
+
+        table->columns.resize(num_columns);
+        for (size_t c = 0; c < num_columns; c++)
+        {
+            epmem_snapshot_column* column = &(table->columns[c]);
+            uint64_t bitmap_size = (table->rows + 7) / 8;
+            uint64_t values = table->rows;
+
+            if ((end - pos < 2) || (pos[0] != static_cast<uint8_t>(spec->kinds[c])) || (pos[1] > 1))
+            {
+                return false;
+            }
+            column->kind = spec->kinds[c];
+            column->nulls = NULL;
+            if (pos[1])
+            {
+                pos += 2;
+                if (bitmap_size > static_cast<uint64_t>(end - pos))
+                {
+                    return false;
+                }
+                column->nulls = pos;
+                for (uint64_t r = 0; r < table->rows; r++)
+                {
+                    if (column->nulls[r / 8] & (1 << (r % 8)))
+                    {
+                        values--;
+                    }
+                }
+                pos += bitmap_size;
+            }
+            else
+            {
+                pos += 2;
+            }
+
+            if (!epmem_snapshot_get_varint(pos, end, val) || (val > static_cast<uint64_t>(end - pos)))
+            {
+                return false;
+            }
+            column->data = pos;
+            column->data_end = pos + val;
+            pos = column->data_end;
+
+            /* --- count what the column actually holds --- */
+            const uint8_t* data = column->data;
+            uint64_t found = 0;
+            switch (column->kind)
+            {
+                case EPMEM_SNAPSHOT_INT:
+                    while (data < column->data_end)
+                    {
+                        if (!epmem_snapshot_get_varint(data, column->data_end, val))
+                        {
+                            return false;
+                        }
+                        found++;
+                    }
+                    break;
+
+                case EPMEM_SNAPSHOT_REAL:
+                    if ((column->data_end - data) % EPMEM_SNAPSHOT_REAL_SIZE)
+                    {
+                        return false;
+                    }
+                    found = (column->data_end - data) / EPMEM_SNAPSHOT_REAL_SIZE;
+                    break;
+
+                case EPMEM_SNAPSHOT_TEXT:
+                    while (data < column->data_end)
+                    {
+                        data = static_cast<const uint8_t*>(memchr(data, 0, column->data_end - data));
+                        if (!data)
+                        {
+                            return false;
+                        }
+                        data++;
+                        found++;
+                    }
+                    break;
+            }
+            if (found != values)
+            {
+                return false;
+            }
+        }
+    }
+
+    if (pos != end)
+    {
+        return false;
+    }
+
+    error.clear();
+    return true;
+}
+
+bool epmem_snapshot::load(soar_module::sqlite_database* db)
+{
+    if (tables.size() != EPMEM_SNAPSHOT_NUM_TABLES)
+    {
+        error.assign("No episodic memory snapshot is open.");
+        return false;
+    }
+
+    if (!db->sql_execute("BEGIN"))
+    {
+        error.assign("Could not start a transaction on the episodic memory database.");
+        return false;
+    }
+
+    for (size_t t = 0; t < EPMEM_SNAPSHOT_NUM_TABLES; t++)
+    {
+        const epmem_snapshot_table_spec* spec = &(epmem_snapshot_tables[t]);
+        epmem_snapshot_table* table = &(tables[t]);
+        size_t num_columns = table->columns.size();
+        std::vector<const uint8_t*> cursors(num_columns);
+        std::vector<int64_t> last(num_columns, 0);
+        std::string sql;
+
+        sql.assign("DELETE FROM ").append(spec->name);
+        if (!db->sql_execute(sql.c_str()))
+        {
+            db->sql_execute("ROLLBACK");
+            error.assign("Could not clear episodic memory table ").append(spec->name).append(".");
+            return false;
+        }
+
+        sql.assign("INSERT INTO ").append(spec->name).append(" (").append(spec->columns).append(") VALUES (?");
+        for (size_t c = 1; c < num_columns; c++)
+        {
+            sql.append(",?");
+        }
+        sql.append(")");
+
+        soar_module::sqlite_statement* q = new soar_module::sqlite_statement(db, sql.c_str());
+        q->prepare();
+        if (q->get_status() != soar_module::ready)
+        {
+            delete q;
+            db->sql_execute("ROLLBACK");
+            error.assign("Could not write episodic memory table ").append(spec->name).append(".");
+            return false;
+        }
+
+        for (size_t c = 0; c < num_columns; c++)
+        {
+            cursors[c] = table->columns[c].data;
+        }
+
+        for (uint64_t r = 0; r < table->rows; r++)
+        {
+            for (size_t c = 0; c < num_columns; c++)
+            {
+                epmem_snapshot_column* column = &(table->columns[c]);
+                int param = static_cast<int>(c) + 1;
+
+                if (column->nulls && (column->nulls[r / 8] & (1 << (r % 8))))
+                {
+                    q->bind_null(param);
+                    continue;
+                }
+
+                switch (column->kind)
+                {
+                    case EPMEM_SNAPSHOT_INT:
+                    {
+                        uint64_t val;
+                        epmem_snapshot_get_varint(cursors[c], column->data_end, val);
+                        last[c] = static_cast<int64_t>(static_cast<uint64_t>(last[c]) + static_cast<uint64_t>(epmem_snapshot_unzigzag(val)));
+                        q->bind_int(param, last[c]);
+                        break;
+                    }
+
+                    case EPMEM_SNAPSHOT_REAL:
+                    {
+                        q->bind_double(param, epmem_snapshot_get_real(cursors[c]));
+                        break;
+                    }
+
+                    case EPMEM_SNAPSHOT_TEXT:
+                    {
+                        const char* val = reinterpret_cast<const char*>(cursors[c]);
+                        cursors[c] += strlen(val) + 1;
+                        q->bind_text(param, val);
+                        break;
+                    }
+                }
+            }
+
+            if (q->execute(soar_module::op_reinit) != soar_module::ok)
+            {
+                delete q;
+                db->sql_execute("ROLLBACK");
+                error.assign("Could not insert into episodic memory table ").append(spec->name).append(".");
+                return false;
+            }
+        }
+
+        delete q;
+    }
+
+    if (!db->sql_execute("COMMIT"))
+    {
+        db->sql_execute("ROLLBACK");
+        error.assign("Could not commit the snapshot to the episodic memory database.");
+        return false;
+    }
+
+    return true;
+}
+
+/* Creates db's tables and indices in a scratch in-memory database and
+ * loads the snapshot there, leaving db itself alone.  Constraint
+ * violations that parse() can't see turn up here. */
+bool epmem_snapshot::try_load(soar_module::sqlite_database* db)
+{
+    soar_module::sqlite_database scratch;
+    bool return_val = true;
+
+    scratch.connect(":memory:");
+    if (scratch.get_status() != soar_module::connected)
+    {
+        error.assign("Could not create a scratch database to check the snapshot.");
+        return false;
+    }
+
+    soar_module::sqlite_statement* q = new soar_module::sqlite_statement(db, "SELECT sql FROM sqlite_master WHERE sql IS NOT NULL AND name NOT LIKE 'sqlite_%' ORDER BY type DESC");
+    q->prepare();
+    if (q->get_status() != soar_module::ready)
+    {
+        return_val = false;
+    }
+    while (return_val && (q->execute() == soar_module::row))
+    {
+        return_val = scratch.sql_execute(q->column_text(0));
+    }
+    delete q;
+
+    if (!return_val)
+    {
+        error.assign("Could not copy the episodic memory schema to check the snapshot.");
+    }
+    else
+    {
+        return_val = load(&scratch);
+    }
+
+    scratch.disconnect();
+
+    return return_val;
+}
@@ -0,0 +1,101 @@
+/*
+ * epmem_snapshot.h
+ *
+ *  Compact, column-oriented snapshot files of an episodic memory
+ *  database.  See the comment at the end of the file.
+ */
+
+#ifndef CORE_SOARKERNEL_SRC_EPISODIC_MEMORY_EPMEM_SNAPSHOT_H_
+#define CORE_SOARKERNEL_SRC_EPISODIC_MEMORY_EPMEM_SNAPSHOT_H_
+
+#include "kernel.h"
+
+#include "soar_db.h"
+
+#include <string>
+#include <vector>
+
+typedef struct epmem_snapshot_column_struct
+{
+    char            kind;
+    const uint8_t*  nulls;
+    const uint8_t*  data;
+    const uint8_t*  data_end;
+} epmem_snapshot_column;
+
+typedef struct epmem_snapshot_table_struct
+{
+    uint64_t                            rows;
+    std::vector<epmem_snapshot_column>  columns;
+} epmem_snapshot_table;
+
+class epmem_snapshot
+{
+    public:
+
+        epmem_snapshot();
+        ~epmem_snapshot();
+
+        /* --- writes every table of an open epmem database to a snapshot file --- */
+        static bool write(soar_module::sqlite_database* db, const char* file_name, std::string* err);
+
+        /* --- maps a snapshot file and checks that all of its tables decode --- */
+        bool        open(const char* file_name);
+        void        close();
+
+        /* --- replaces the contents of the epmem tables with the snapshot's rows --- */
+        bool        load(soar_module::sqlite_database* db);
+
+        /* --- loads the snapshot into a scratch copy of db's schema, leaving db alone --- */
+        bool        try_load(soar_module::sqlite_database* db);
+
+        const std::string& get_error() { return error; }
+
+    private:
+
+        const uint8_t*                      contents;
+        size_t                              contents_size;
+        bool                                mapped;
+        std::vector<uint8_t>                buffer;
+
+        std::vector<epmem_snapshot_table>   tables;
+        std::string                         error;
+
+        bool                                parse();
+};
+
+/* ======================================================================
+                              epmem_snapshot.h
+
+   epmem --backup copies the SQLite file page for page, indices and all.
+   A snapshot instead stores just the rows of the tables that define the
+   episodic store (the temporal hash, the node/edge dictionaries, the
+   episode list and the now/point/range interval tables), one column
+   after another:
+
+     - integer columns are delta-encoded against the previous row and
+       written as zig-zag LEB128 varints.  Tables are written sorted by
+       their episode column, so episode ids usually cost a byte apiece,
+       and the node, edge and symbol ids they refer to stay small since
+       they are handed out densely;
+     - symbols are only ever stored once, in the epmem_symbols_* tables,
+       which act as the dictionary for every other table;
+     - a column with any NULLs is preceded by a null bitmap, and the
+       NULL rows take no other space.
+
+   The indices and the RIT scratch tables are rebuilt rather than
+   stored.  Importing a snapshot maps the file read-only and validates
+   every column, then loads the rows into a scratch in-memory copy of
+   the schema, since re-opening the episodic memory database erases an
+   in-memory store (or a file with append off) and the existing store
+   must be kept if the rows won't go in.  Only then is the database
+   re-opened and the rows bulk inserted inside a single transaction,
+   before the usual start-up code reads its state back out of the
+   tables.  Retrievals then run against the rebuilt database as usual.
+
+   Floats are stored as the eight bytes of their IEEE 754 representation,
+   least significant first, so snapshots move between machines of either
+   byte order.
+====================================================================== */
+
+#endif /* CORE_SOARKERNEL_SRC_EPISODIC_MEMORY_EPMEM_SNAPSHOT_H_ */
@@ -59,12 +59,13 @@ using namespace soar_TraceNames;
 
 void Explanation_Based_Chunker::add_to_grounds(condition* cond)
 {
+    wme_cold* lCold = wme_cold_data(thisAgent, cond->bt.wme_);
     if ((cond)->bt.wme_->tc != grounds_tc)
     {
         (cond)->bt.wme_->tc = grounds_tc;
-        cond->bt.wme_->chunker_bt_last_ground_cond = cond;
+        lCold->chunker_bt_last_ground_cond = cond;
     }
-    if ((cond->bt.wme_->chunker_bt_last_ground_cond != cond) && ebc_settings[SETTING_EBC_LEARNING_ON])
+    if ((lCold->chunker_bt_last_ground_cond != cond) && ebc_settings[SETTING_EBC_LEARNING_ON])
     {
         check_for_singleton_unification(cond);
     }
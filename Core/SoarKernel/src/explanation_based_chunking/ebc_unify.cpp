@@ -135,7 +135,7 @@ void Explanation_Based_Chunker::check_for_singleton_unification(condition* pCond
 {
     if (wme_is_a_singleton(pCond->bt.wme_))
     {
-        condition* last_cond = pCond->bt.wme_->chunker_bt_last_ground_cond;
+        condition* last_cond = pCond->bt.wme_->cold->chunker_bt_last_ground_cond;
         if (pCond->data.tests.value_test->eq_test->identity || last_cond->data.tests.value_test->eq_test->identity)
         {
             if (!pCond->data.tests.value_test->eq_test->identity)
@@ -158,7 +158,7 @@ void Explanation_Based_Chunker::check_for_singleton_unification(condition* pCond
         (pCond->bt.wme_->value->is_sti() &&  pCond->bt.wme_->value->id->isa_operator) &&
         (!pCond->test_for_acceptable_preference))
     {
-        condition* last_cond = pCond->bt.wme_->chunker_bt_last_ground_cond;
+        condition* last_cond = pCond->bt.wme_->cold->chunker_bt_last_ground_cond;
         if (pCond->data.tests.value_test->eq_test->identity || last_cond->data.tests.value_test->eq_test->identity)
         {
             Identity* pCondIDSet = get_joined_identity(pCond->data.tests.value_test->eq_test->identity);
@@ -273,13 +273,14 @@ void Explanation_Based_Chunker::clear_singletons()
 
 void Explanation_Based_Chunker::add_to_singletons(wme* pWME)
 {
-    pWME->singleton_status_checked = true;
-    pWME->is_singleton = true;
+    wme_cold* lCold = wme_cold_data(thisAgent, pWME);
+    lCold->singleton_status_checked = true;
+    lCold->is_singleton = true;
 }
 
 bool Explanation_Based_Chunker::wme_is_a_singleton(wme* pWME)
 {
-    if (pWME->singleton_status_checked) return pWME->is_singleton;
+    if (pWME->cold && pWME->cold->singleton_status_checked) return pWME->cold->is_singleton;
     if (!pWME->attr->is_string() || !pWME->attr->sc->singleton.possible) return false;
 
     /* This WME has a valid singleton attribute but has never had it's identifier and
@@ -299,7 +300,8 @@ bool Explanation_Based_Chunker::wme_is_a_singleton(wme* pWME)
                     ((value_type == ebc_constant)   && pWME->value->is_constant()) ||
                     ((value_type == ebc_operator)   && pWME->value->is_operator()));
 
-    pWME->is_singleton = lIDPassed && lValuePassed;
-    pWME->singleton_status_checked = true;
-    return pWME->is_singleton;
+    wme_cold* lCold = wme_cold_data(thisAgent, pWME);
+    lCold->is_singleton = lIDPassed && lValuePassed;
+    lCold->singleton_status_checked = true;
+    return lCold->is_singleton;
 }
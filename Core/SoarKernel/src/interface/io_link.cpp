@@ -274,9 +274,9 @@ bool remove_input_wme(agent* thisAgent, wme* w)
     /* --- go ahead and remove the wme --- */
     remove_from_dll(w->id->id->input_wmes, w, next, prev);
     /* REW: begin 09.15.96 */
-    if (w->gds)
+    if (wme_gds(w))
     {
-        if (w->gds->goal != NIL)
+        if (w->cold->gds->goal != NIL)
         {
             gds_invalid_so_remove_goal(thisAgent, w);
             /* NOTE: the call to remove_wme_from_wm will take care
@@ -18,6 +18,8 @@
 #include "print.h"
 #include "soar_instance.h"
 
+SOAR_THREAD_LOCAL Output_Manager::print_format Output_Manager::m_format;
+
 bool is_DT_mode_enabled(TraceMode mode) { return Output_Manager::Get_OM().is_trace_enabled(mode); }
 
 AgentOutput_Info::AgentOutput_Info()
@@ -50,14 +52,14 @@ void Output_Manager::set_output_params_global(bool pDebugEnabled){
     {
         m_print_actual = true;
         m_print_identity = true;
-        m_print_actual_effective = true;
-        m_print_identity_effective = true;
+        current_format().print_actual_effective = true;
+        current_format().print_identity_effective = true;
         stdout_mode = true;
     } else {
         m_print_actual = true;
         m_print_identity = false;
-        m_print_actual_effective = true;
-        m_print_identity_effective = false;
+        current_format().print_actual_effective = true;
+        current_format().print_identity_effective = false;
         stdout_mode = false;
     }
 }
@@ -106,8 +108,8 @@ Output_Manager::Output_Manager()
 {
     m_defaultAgent = NIL;
     m_params = new OM_Parameters(NULL, settings);
-    m_pre_string = strdup("          ");
-    m_post_string = NULL;
+    m_print_actual = true;
+    m_print_identity = false;
 
     reset_column_indents();
 
@@ -128,8 +130,6 @@ Output_Manager::Output_Manager()
 Output_Manager::~Output_Manager()
 {
     free(NULL_SYM_STR);
-    if (m_pre_string) free(m_pre_string);
-    if (m_post_string) free(m_post_string);
 
     for (int i = 0; i < num_trace_modes; i++)
     {
@@ -14,7 +14,10 @@
 #define OUTPUT_MANAGER_H_
 
 #include "kernel.h"
+#include "memory_manager.h"
 
+#include <atomic>
+#include <string.h>
 #include <string>
 #include <list>
 #include <stdlib.h>
@@ -89,12 +92,34 @@ class Output_Manager
 
         /* -- Settings for how tests are printed (actual, original production tests, test identity) -- */
         bool m_print_actual, m_print_identity;
-        bool m_print_actual_effective, m_print_identity_effective;
-        char* m_pre_string, *m_post_string;
-        int  m_column_indent[MAX_COLUMNS];
+
+        /* -- Formatting that callers set and clear around a single print job.  Agents may step on
+         *    different run threads, so each thread keeps its own copy (see current_format()), which
+         *    releases its strings when that thread exits. -- */
+        typedef struct print_format_struct
+        {
+            bool    initialized;
+            bool    print_actual_effective, print_identity_effective;
+            std::string pre_string, post_string;
+            int     column_indent[MAX_COLUMNS];
+        } print_format;
+        static SOAR_THREAD_LOCAL print_format m_format;
+        print_format& current_format()
+        {
+            if (!m_format.initialized)
+            {
+                m_format.initialized = true;
+                m_format.print_actual_effective = m_print_actual;
+                m_format.print_identity_effective = m_print_identity;
+                m_format.pre_string = "          ";
+                m_format.post_string.clear();
+                for (int i=0; i<MAX_COLUMNS; i++) m_format.column_indent[i] = 0;
+            }
+            return m_format;
+        }
 
         /* -- The following tracks column of the next character to print if Soar is writing to cout --*/
-        int     global_printer_output_column;
+        std::atomic<int> global_printer_output_column;
         void    update_printer_columns(agent* pSoarAgent, const char* msg);
 
         void action_to_string(agent* thisAgent, action* a, std::string &destString);
@@ -181,22 +206,8 @@ class Output_Manager
 
         void set_print_indents(const char* pPre = NULL, const char* pPost = NULL)
         {
-            if (pPre) {
-                if (m_pre_string) free(m_pre_string);
-                if (strlen(pPre) > 0) {
-                    m_pre_string = strdup(pPre);
-                } else {
-                    m_pre_string = NULL;
-                }
-            }
-            if (pPost) {
-                if (m_post_string) free(m_post_string);
-                if (strlen(pPost) > 0) {
-                    m_post_string = strdup(pPost);
-                } else {
-                    m_post_string = NULL;
-                }
-            }
+            if (pPre) current_format().pre_string = pPre;
+            if (pPost) current_format().post_string = pPost;
         }
         void set_default_print_test_format(bool pActual, bool pPrintIdentity)
         {
@@ -206,21 +217,21 @@ class Output_Manager
 
         void set_print_test_format(bool pActual, bool pPrintIdentity)
         {
-            m_print_actual_effective = pActual;
-            m_print_identity_effective = pPrintIdentity;
+            current_format().print_actual_effective = pActual;
+            current_format().print_identity_effective = pPrintIdentity;
         }
         void clear_print_test_format()
         {
-            m_print_actual_effective = m_print_actual;
-            m_print_identity_effective = m_print_identity;
+            current_format().print_actual_effective = m_print_actual;
+            current_format().print_identity_effective = m_print_identity;
         }
         void clear_print_indents() { set_print_indents(); }
 
         void set_column_indent(int pColumnIndex, int pColumnNum) {
             if (pColumnIndex >= MAX_COLUMNS) return;
-            m_column_indent[pColumnIndex] = pColumnNum; }
+            current_format().column_indent[pColumnIndex] = pColumnNum; }
 
-        void reset_column_indents() { for (int i=0; i<MAX_COLUMNS; i++) m_column_indent[i] = 0; }
+        void reset_column_indents() { for (int i=0; i<MAX_COLUMNS; i++) current_format().column_indent[i] = 0; }
 
         /* -- The following should all be refactored into to_string functions to be used with format strings -- */
         void print_identifiers(TraceMode mode);
@@ -351,8 +351,8 @@ void Output_Manager::vsnprint_sf(agent* thisAgent, std::string &destString, cons
                         next_position = (this->get_printer_output_column(thisAgent) + destString.length());
                         for (next_column = 0; next_column < MAX_COLUMNS; next_column++)
                         {
-                            if (next_position < m_column_indent[next_column]) {
-                                indent_amount = (m_column_indent[next_column] - next_position);
+                            if (next_position < current_format().column_indent[next_column]) {
+                                indent_amount = (current_format().column_indent[next_column] - next_position);
                                 break;
                             }
                         }
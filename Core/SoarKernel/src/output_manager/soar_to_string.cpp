@@ -50,7 +50,7 @@ void Output_Manager::WM_to_string(agent* thisAgent, std::string &destString)
     destString += "--------------------------- WMEs --------------------------\n";
     for (wme* w = m_defaultAgent->all_wmes_in_rete; w != NIL; w = w->rete_next)
     {
-//        if (m_pre_string) destString += m_pre_string;
+//        if (current_format().pre_string) destString += current_format().pre_string;
         if (wme_to_string(thisAgent, w, destString))
         {
             destString += '\n';
@@ -210,7 +210,7 @@ void Output_Manager::condition_cons_to_string(agent* thisAgent, cons* c, std::st
 {
     while (c)
     {
-        sprinta_sf(thisAgent, destString, "%s: %l\n", m_pre_string, static_cast<condition_struct*>(c->first));
+        sprinta_sf(thisAgent, destString, "%s: %l\n", current_format().pre_string.c_str(), static_cast<condition_struct*>(c->first));
         c = c->rest;
     }
     return;
@@ -220,16 +220,16 @@ void Output_Manager::condition_to_string(agent* thisAgent, condition* cond, std:
 {
     if (cond->type != CONJUNCTIVE_NEGATION_CONDITION)
     {
-        if (m_print_actual_effective)
+        if (current_format().print_actual_effective)
         {
             sprinta_sf(thisAgent, destString, "(%t%s^%t %t)",
             cond->data.tests.id_test,
                 (cond->type == NEGATIVE_CONDITION) ? " -": " ",
             cond->data.tests.attr_test, cond->data.tests.value_test);
         }
-        if (m_print_identity_effective) {
+        if (current_format().print_identity_effective) {
             sprinta_sf(thisAgent, destString, "%s(%g%s^%g %g)",
-                m_print_actual_effective ? ", " : NULL,
+                current_format().print_actual_effective ? ", " : NULL,
                 cond->data.tests.id_test,
                 (cond->type == NEGATIVE_CONDITION) ? " -": " ",
                 cond->data.tests.attr_test, cond->data.tests.value_test);
@@ -250,7 +250,7 @@ void Output_Manager::condition_list_to_string(agent* thisAgent, condition* top_c
 
     for (cond = top_cond; cond != NIL; cond = cond->next)
     {
-        sprinta_sf(thisAgent, destString, "%s%d: %l\n", m_pre_string, ++count, cond);
+        sprinta_sf(thisAgent, destString, "%s%d: %l\n", current_format().pre_string.c_str(), ++count, cond);
     }
     return;
 }
@@ -290,7 +290,7 @@ void Output_Manager::rhs_value_to_string(rhs_value rv, std::string &destString,
     {
         /* -- rhs symbol -- */
         rsym = rhs_value_to_rhs_symbol(rv);
-        if (this->m_print_actual_effective || (!pEmptyStringForNullIdentity && (!rsym->inst_identity)))
+        if (this->current_format().print_actual_effective || (!pEmptyStringForNullIdentity && (!rsym->inst_identity)))
         {
             if (rsym->referent)
             {
@@ -299,10 +299,10 @@ void Output_Manager::rhs_value_to_string(rhs_value rv, std::string &destString,
                 destString += '#';
             }
         }
-        if (m_print_identity_effective && (rsym->inst_identity || rsym->identity_id_unjoined)) {
+        if (current_format().print_identity_effective && (rsym->inst_identity || rsym->identity_id_unjoined)) {
             Identity* l_identity = rsym->identity;
 
-            if (m_print_actual_effective) destString += ' ';
+            if (current_format().print_actual_effective) destString += ' ';
             if (l_identity)
             {
                 if (l_identity->joined_identity != l_identity)
@@ -381,10 +381,10 @@ void Output_Manager::action_to_string(agent* thisAgent, action* a, std::string &
 {
     if (a->type == FUNCALL_ACTION)
     {
-        if (m_pre_string) destString += m_pre_string;
+        destString += current_format().pre_string;
         rhs_value_to_string(a->value, destString);
     } else {
-        if (m_pre_string) destString += m_pre_string;
+        destString += current_format().pre_string;
         destString += '(';
         rhs_value_to_string(a->id, destString);
         destString += " ^";
@@ -432,7 +432,7 @@ void Output_Manager::identity_to_string(agent* thisAgent, uint64_t pID, const Id
 
 void Output_Manager::pref_to_string(agent* thisAgent, preference* pref, std::string &destString)
 {
-    if (m_print_actual_effective)
+    if (current_format().print_actual_effective)
     {
         sprinta_sf(thisAgent, destString, "(%y ^%y %y) %c", pref->id, pref->attr, pref->value, preference_to_char(pref->type));
         if (preference_is_binary(pref->type))
@@ -440,7 +440,7 @@ void Output_Manager::pref_to_string(agent* thisAgent, preference* pref, std::str
             sprinta_sf(thisAgent, destString, " %y", pref->referent);
         }
     }
-    if (m_print_identity_effective)
+    if (current_format().print_identity_effective)
     {
         std::string lID, lAttr, lValue, lReferent;
         if (pref->inst_identities.id || pref->identities.id)
@@ -456,7 +456,7 @@ void Output_Manager::pref_to_string(agent* thisAgent, preference* pref, std::str
         else
             lValue = pref->value->to_string(true);
 
-        sprinta_sf(thisAgent, destString, "%s(%s ^%s %s) %c", (m_print_actual_effective) ? ", " : "",
+        sprinta_sf(thisAgent, destString, "%s(%s ^%s %s) %c", (current_format().print_actual_effective) ? ", " : "",
             lID.c_str(), lAttr.c_str(), lValue.c_str(), preference_to_char(pref->type));
 
         if (preference_is_binary(pref->type))
@@ -479,7 +479,7 @@ void Output_Manager::preflist_inst_to_string(agent* thisAgent, preference* top_p
 {
     for (preference* pref = top_pref; pref != NIL;)
     {
-        sprinta_sf(thisAgent, destString, "%s%p\n", m_pre_string, pref);
+        sprinta_sf(thisAgent, destString, "%s%p\n", current_format().pre_string.c_str(), pref);
         pref = pref->inst_next;
     }
 }
@@ -488,7 +488,7 @@ void Output_Manager::preflist_result_to_string(agent* thisAgent, preference* top
 {
     for (preference* pref = top_pref; pref != NIL;)
     {
-        sprinta_sf(thisAgent, destString, "%s%p\n", m_pre_string, pref);
+        sprinta_sf(thisAgent, destString, "%s%p\n", current_format().pre_string.c_str(), pref);
         pref = pref->next_result;
     }
 }
@@ -503,7 +503,7 @@ void Output_Manager::cond_prefs_to_string(agent* thisAgent, condition* top_cond,
         }
         set_print_test_format(true, false);
         condition_list_to_string(thisAgent, top_cond, destString);
-        if (m_pre_string) destString += m_pre_string;
+        destString += current_format().pre_string;
         destString += "-->\n";
         preflist_inst_to_string(thisAgent, top_pref, destString);
         clear_print_test_format();
@@ -516,7 +516,7 @@ void Output_Manager::cond_prefs_to_string(agent* thisAgent, condition* top_cond,
         }
         set_print_test_format(false, true);
         condition_list_to_string(thisAgent, top_cond, destString);
-        if (m_pre_string) destString += m_pre_string;
+        destString += current_format().pre_string;
         destString += "-->\n";
         preflist_inst_to_string(thisAgent, top_pref, destString);
         clear_print_test_format();
@@ -533,7 +533,7 @@ void Output_Manager::cond_results_to_string(agent* thisAgent, condition* top_con
         }
         set_print_test_format(true, false);
         condition_list_to_string(thisAgent, top_cond, destString);
-        if (m_pre_string) destString += m_pre_string;
+        destString += current_format().pre_string;
         destString += "-->\n";
         preflist_result_to_string(thisAgent, top_pref, destString);
         clear_print_test_format();
@@ -546,7 +546,7 @@ void Output_Manager::cond_results_to_string(agent* thisAgent, condition* top_con
         }
         set_print_test_format(false, true);
         condition_list_to_string(thisAgent, top_cond, destString);
-        if (m_pre_string) destString += m_pre_string;
+        destString += current_format().pre_string;
         destString += "-->\n";
         preflist_result_to_string(thisAgent, top_pref, destString);
         clear_print_test_format();
@@ -563,7 +563,7 @@ void Output_Manager::cond_actions_to_string(agent* thisAgent, condition* top_con
         }
         set_print_test_format(true, false);
         condition_list_to_string(thisAgent, top_cond, destString);
-        sprinta_sf(thisAgent, destString, "%s-->\n", m_pre_string);
+        sprinta_sf(thisAgent, destString, "%s-->\n", current_format().pre_string.c_str());
         action_list_to_string(thisAgent, top_action, destString);
         clear_print_test_format();
     }
@@ -575,7 +575,7 @@ void Output_Manager::cond_actions_to_string(agent* thisAgent, condition* top_con
             set_print_test_format(false, true);
         }
         condition_list_to_string(thisAgent, top_cond, destString);
-        sprinta_sf(thisAgent, destString, "%s-->\n", m_pre_string);
+        sprinta_sf(thisAgent, destString, "%s-->\n", current_format().pre_string.c_str());
         action_list_to_string(thisAgent, top_action, destString);
         clear_print_test_format();
     }
@@ -584,7 +584,7 @@ void Output_Manager::cond_actions_to_string(agent* thisAgent, condition* top_con
 void Output_Manager::instantiation_to_string(agent* thisAgent, instantiation* inst, std::string &destString)
 {
     sprinta_sf(thisAgent, destString, "%sInstantiation (i %u) matched %y in state %y (level %d)\n",
-        m_pre_string, inst->i_id, inst->prod_name, inst->match_goal, inst->match_goal_level);
+        current_format().pre_string.c_str(), inst->i_id, inst->prod_name, inst->match_goal, inst->match_goal_level);
     cond_prefs_to_string(thisAgent, inst->top_of_instantiated_conditions, inst->preferences_generated, destString);
 }
 
@@ -820,7 +820,7 @@ void Output_Manager::print_identifiers(TraceMode mode)
     if (!m_defaultAgent) return;
 
     print("--- Identifiers: ---\n");
-    do_for_all_items_in_hash_table(m_defaultAgent, m_defaultAgent->symbolManager->identifier_hash_table, om_print_sym, &mode);
+    m_defaultAgent->symbolManager->identifier_hash_table.do_for_all_items(om_print_sym, &mode);
 }
 
 void Output_Manager::print_variables(TraceMode mode)
@@ -830,7 +830,7 @@ void Output_Manager::print_variables(TraceMode mode)
     if (!m_defaultAgent) return;
 
     print("--- Variables: ---\n");
-    do_for_all_items_in_hash_table(m_defaultAgent, m_defaultAgent->symbolManager->variable_hash_table, om_print_sym, &mode);
+    m_defaultAgent->symbolManager->variable_hash_table.do_for_all_items(om_print_sym, &mode);
 }
 
 
@@ -637,11 +637,11 @@ preference* exploration_choose_according_to_policy(agent* thisAgent, slot* s, pr
             break;
 
         case USER_SELECT_RANDOM:
-            return_val = exploration_randomly_select(candidates);
+            return_val = exploration_randomly_select(thisAgent, candidates);
             break;
 
         case USER_SELECT_SOFTMAX:
-            return_val = exploration_probabilistically_select(candidates);
+            return_val = exploration_probabilistically_select(thisAgent, candidates);
             break;
 
         case USER_SELECT_E_GREEDY:
@@ -812,7 +812,7 @@ double exploration_probability_according_to_policy(agent* thisAgent, slot* s, pr
 /***************************************************************************
  * Function     : exploration_randomly_select
  **************************************************************************/
-preference* exploration_randomly_select(preference* candidates, const bool &update_rho)
+preference* exploration_randomly_select(agent* thisAgent, preference* candidates, const bool &update_rho)
 {
     unsigned int cand_count = 0;
     for (const preference* cand = candidates; cand; cand = cand->next_candidate)
@@ -827,7 +827,7 @@ preference* exploration_randomly_select(preference* candidates, const bool &upda
     }
 
     preference* cand = candidates;
-    for (uint32_t chosen_num = SoarRandInt(cand_count - 1); chosen_num; --chosen_num)
+    for (uint32_t chosen_num = thisAgent->rng->randInt(cand_count - 1); chosen_num; --chosen_num)
     {
         cand = cand->next_candidate;
     }
@@ -838,7 +838,7 @@ preference* exploration_randomly_select(preference* candidates, const bool &upda
 /***************************************************************************
  * Function     : exploration_probabilistically_select
  **************************************************************************/
-preference* exploration_probabilistically_select(preference* candidates)
+preference* exploration_probabilistically_select(agent* thisAgent, preference* candidates)
 {
     // IF THIS FUNCTION CHANGES, SEE soar_ecPrintPreferences
 
@@ -853,7 +853,7 @@ preference* exploration_probabilistically_select(preference* candidates)
     // if nothing positive, resort to random
     if (total_probability == 0.0)
     {
-        return exploration_randomly_select(candidates);
+        return exploration_randomly_select(thisAgent, candidates);
     }
 
     for (preference* cand = candidates; cand; cand = cand->next_candidate)
@@ -869,7 +869,7 @@ preference* exploration_probabilistically_select(preference* candidates)
     }
 
     // choose a random preference within the distribution
-    const double selected_probability = total_probability * SoarRand();
+    const double selected_probability = total_probability * thisAgent->rng->rand();
 
     // select the candidate based upon the chosen preference
     double current_sum = 0.0;
@@ -958,7 +958,7 @@ preference* exploration_boltzmann_select(agent* thisAgent, preference* candidate
         }
     }
 
-    double r = SoarRand(exptotal);
+    double r = thisAgent->rng->rand(exptotal);
     double sum = 0.0;
 
     for (c = candidates, i = expvals.begin(); c; c = c->next_candidate, i++)
@@ -995,13 +995,13 @@ preference* exploration_epsilon_greedy_select(agent* thisAgent, preference* cand
     }
 
     preference *cand;
-    if (SoarRand() < epsilon)
+    if (thisAgent->rng->rand() < epsilon)
     {
-        cand = exploration_randomly_select(candidates, false);
+        cand = exploration_randomly_select(thisAgent, candidates, false);
     }
     else
     {
-        cand = exploration_get_highest_q_value_pref(candidates);
+        cand = exploration_get_highest_q_value_pref(thisAgent, candidates);
     }
 
     unsigned int cand_count = 0;
@@ -1020,7 +1020,7 @@ preference* exploration_epsilon_greedy_select(agent* thisAgent, preference* cand
 /***************************************************************************
  * Function     : exploration_get_highest_q_value_pref
  **************************************************************************/
-preference* exploration_get_highest_q_value_pref(preference* candidates)
+preference* exploration_get_highest_q_value_pref(agent* thisAgent, preference* candidates)
 {
     preference* top_cand = candidates;
     double top_value = candidates->numeric_value;
@@ -1053,7 +1053,7 @@ preference* exploration_get_highest_q_value_pref(preference* candidates)
         }
 
         // if operators tied for highest Q-value, select among tied set at random
-        for (uint32_t chosen_num = SoarRandInt(num_max_cand - 1); chosen_num; --chosen_num)
+        for (uint32_t chosen_num = thisAgent->rng->randInt(num_max_cand - 1); chosen_num; --chosen_num)
         {
             cand = cand->next_candidate;
 
@@ -18,10 +18,14 @@
 #include "working_memory.h"
 #include "xml.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
 #include <vector>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <map>
 #include <sstream>
 
 RL_Manager::RL_Manager(agent* myAgent)
@@ -343,6 +347,83 @@ void rl_reset_data(agent* thisAgent)
     }
 }
 
+/////////////////////////////////////////////////////
+/////////////////////////////////////////////////////
+
+void rl_et_store::erase(production* prod)
+{
+    for (size_t i = 0; i < prods.size(); i++)
+    {
+        if (prods[i] == prod)
+        {
+            prods.erase(prods.begin() + i);
+            traces.erase(traces.begin() + i);
+            return;
+        }
+    }
+}
+
+void rl_et_store::decay(double lambda, double discount)
+{
+    double* t = traces.data();
+    size_t n = traces.size();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        t[i] *= lambda;
+        t[i] *= discount;
+    }
+}
+
+void rl_et_store::prune_and_increment(double tolerance, double scale, production_list* fired, double increment)
+{
+    // sorted, so each trace can find its rule among those just fired
+    std::vector<production*> fired_prods(fired->begin(), fired->end());
+    std::vector<bool> found(fired_prods.size(), false);
+    std::sort(fired_prods.begin(), fired_prods.end());
+
+    size_t kept = 0;
+    for (size_t i = 0; i < prods.size(); i++)
+    {
+        if (traces[i] < tolerance)
+        {
+            continue;
+        }
+
+        prods[kept] = prods[i];
+        traces[kept] = traces[i] * scale;
+
+        std::vector<production*>::iterator f = std::lower_bound(fired_prods.begin(), fired_prods.end(), prods[kept]);
+        for (; (f != fired_prods.end()) && (*f == prods[kept]); f++)
+        {
+            traces[kept] += increment;
+            found[f - fired_prods.begin()] = true;
+        }
+        kept++;
+    }
+    prods.resize(kept);
+    traces.resize(kept);
+
+    // rules without a trace get one, bumped once for each time they fired
+    for (size_t f = 0; f < fired_prods.size(); f++)
+    {
+        if (found[f])
+        {
+            continue;
+        }
+        if ((f > 0) && (fired_prods[f - 1] == fired_prods[f]))
+        {
+            traces.back() += increment;
+            continue;
+        }
+        prods.push_back(fired_prods[f]);
+        traces.push_back(increment);
+    }
+}
+
+/////////////////////////////////////////////////////
+/////////////////////////////////////////////////////
+
 // removes rl references to a production (used for excise)
 void rl_remove_refs_for_prod(agent* thisAgent, production* prod)
 {
@@ -791,6 +872,26 @@ void rl_store_data(agent* thisAgent, Symbol* goal, preference* cand)
     }
 }
 
+// gives preferences generated by current instantiations of a rule the rule's value
+static void rl_update_live_preferences(agent* thisAgent, production* prod)
+{
+    if (prod->instantiations)
+    {
+        rl_write_back_value(thisAgent, prod);
+        Symbol* new_value = rhs_value_to_symbol(prod->action_list->referent);
+
+        for (instantiation* inst = prod->instantiations; inst; inst = inst->next)
+        {
+            for (preference* pref = inst->preferences_generated; pref; pref = pref->inst_next)
+            {
+                thisAgent->symbolManager->symbol_remove_ref(&pref->referent);
+                pref->referent = new_value;
+                thisAgent->symbolManager->symbol_add_ref(new_value);
+            }
+        }
+    }
+}
+
 // performs the rl update at a state
 void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* goal, bool update_efr)
 {
@@ -802,7 +903,8 @@ void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* go
 
         if (!data->prev_op_rl_rules->empty())
         {
-            rl_et_map::iterator iter;
+            rl_et_store* et = data->eligibility_traces;
+            bool using_gql = ((thisAgent->RL->rl_params->learning_policy->get_value() & rl_param_container::gql) != 0);
             double alpha = thisAgent->RL->rl_params->learning_rate->get_value();
             double eta = thisAgent->RL->rl_params->step_size_parameter->get_value();
             double lambda = thisAgent->RL->rl_params->et_decay_rate->get_value();
@@ -829,44 +931,21 @@ void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* go
                 xml_generate_warning(thisAgent, buf);
             }
 
-            // Iterate through eligibility_traces, decay traces. If less than TOLERANCE, remove from map.
+            // Decay traces.  Those that fall below tolerance are dropped
+            // below, before the traces of the just fired prods are bumped.
             if (lambda == 0)
             {
-                if (!data->eligibility_traces->empty())
-                {
-                    data->eligibility_traces->clear();
-                }
+                et->clear();
             }
             else
             {
-                for (iter = data->eligibility_traces->begin(); iter != data->eligibility_traces->end();)
-                {
-                    iter->second *= lambda;
-                    iter->second *= discount;
-                    if (iter->second < tolerance)
-                    {
-                        data->eligibility_traces->erase(iter++);
-                    }
-                    else
-                    {
-                        ++iter;
-                    }
-                }
-            }
-
-            if (thisAgent->RL->rl_params->learning_policy->get_value() & rl_param_container::gql)
-            {
-                for (iter = data->eligibility_traces->begin(); iter != data->eligibility_traces->end(); iter++)
-                {
-                    iter->second *= data->rho;
-                }
+                et->decay(lambda, discount);
             }
 
             // Update trace for just fired prods
             double sum_old_ecr = 0.0;
             double sum_old_efr = 0.0;
             double dot_w_phi = 0.0;
-            if (!data->prev_op_rl_rules->empty())
             {
                 /// I = 0.0 for non-terminal states when using hierarchical reinforcement learning
                 const double I = goal->id->lower_goal ? 0.0 : 1.0;
@@ -877,95 +956,111 @@ void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* go
                 {
                     sum_old_ecr += (*p)->rl_ecr;
                     sum_old_efr += (*p)->rl_efr;
-
-                    iter = data->eligibility_traces->find((*p));
-
-                    if (iter != data->eligibility_traces->end())
-                    {
-                        iter->second += trace_increment;
-                    }
-                    else
-                    {
-                        (*data->eligibility_traces)[(*p) ] = trace_increment;
-                    }
-
                     dot_w_phi += (*p)->rl_gql;
                 }
+
+                et->prune_and_increment(tolerance, (using_gql ? data->rho : 1.0), data->prev_op_rl_rules, trace_increment);
             }
 
             // For each prod with a trace, perform update
             {
-                double old_ecr = 0.0, old_efr = 0.0, old_gql = 0.0;
-                double delta_ecr = 0.0, delta_efr = 0.0;
-                double new_combined = 0.0, new_ecr = 0.0, new_efr = 0.0, new_gql = 0.0;
+                size_t num_traces = et->size();
+                production** prods = et->prods.data();
+                const double* traces = et->traces.data();
                 double delta_t = (data->reward + discount * op_value) - (sum_old_ecr + sum_old_efr);
 
                 double dot_w_e = 0.0;
-                for (iter = data->eligibility_traces->begin(); iter != data->eligibility_traces->end(); iter++)
+                if (using_gql)
                 {
-                    dot_w_e += iter->first->rl_gql * iter->second;
+                    for (size_t i = 0; i < num_traces; i++)
+                    {
+                        dot_w_e += prods[i]->rl_gql * traces[i];
+                    }
                 }
 
-                for (iter = data->eligibility_traces->begin(); iter != data->eligibility_traces->end(); iter++)
+                // Adjust alpha based on decay policy
+                // Miller 11/14/2011
+                std::vector<double>& alphas = thisAgent->RL->rl_update_alpha;
+                alphas.resize(num_traces);
+                switch (thisAgent->RL->rl_params->decay_mode->get_value())
                 {
-                    production* prod = iter->first;
-
-                    // get old vals
-                    old_ecr = prod->rl_ecr;
-                    old_efr = prod->rl_efr;
-                    old_gql = prod->rl_gql;
-
-                    // Adjust alpha based on decay policy
-                    // Miller 11/14/2011
-                    double adjusted_alpha;
-                    switch (thisAgent->RL->rl_params->decay_mode->get_value())
-                    {
-                        case rl_param_container::exponential_decay:
-                            adjusted_alpha = 1.0 / (prod->rl_update_count + 1.0);
-                            break;
-                        case rl_param_container::logarithmic_decay:
-                            adjusted_alpha = 1.0 / (log(prod->rl_update_count + 1.0) + 1.0);
-                            break;
-                        case rl_param_container::delta_bar_delta_decay:
+                    case rl_param_container::exponential_decay:
+                        for (size_t i = 0; i < num_traces; i++)
+                        {
+                            alphas[i] = 1.0 / (prods[i]->rl_update_count + 1.0);
+                        }
+                        break;
+                    case rl_param_container::logarithmic_decay:
+                        for (size_t i = 0; i < num_traces; i++)
+                        {
+                            alphas[i] = 1.0 / (log(prods[i]->rl_update_count + 1.0) + 1.0);
+                        }
+                        break;
+                    case rl_param_container::delta_bar_delta_decay:
+                        for (size_t i = 0; i < num_traces; i++)
                         {
                             // Note that in this case, x_i = 1.0 for all productions that are being updated.
                             // Those values have been included here for consistency with the algorithm as described in the delta bar delta paper.
+                            production* prod = prods[i];
                             prod->rl_delta_bar_delta_beta = prod->rl_delta_bar_delta_beta + theta * delta_t * 1.0 * prod->rl_delta_bar_delta_h;
-                            adjusted_alpha = exp(prod->rl_delta_bar_delta_beta);
-                            double decay_term = 1.0 - adjusted_alpha * 1.0 * 1.0;
+                            alphas[i] = exp(prod->rl_delta_bar_delta_beta);
+                            double decay_term = 1.0 - alphas[i] * 1.0 * 1.0;
                             if (decay_term < 0.0)
                             {
                                 decay_term = 0.0;
                             }
-                            prod->rl_delta_bar_delta_h = prod->rl_delta_bar_delta_h * decay_term + adjusted_alpha * delta_t * 1.0;
-                            break;
+                            prod->rl_delta_bar_delta_h = prod->rl_delta_bar_delta_h * decay_term + alphas[i] * delta_t * 1.0;
                         }
-                        case rl_param_container::normal_decay:
-                        default:
-                            adjusted_alpha = alpha;
-                            break;
-                    }
+                        break;
+                    case rl_param_container::normal_decay:
+                    default:
+                        alphas.assign(num_traces, alpha);
+                        break;
+                }
 
-                    // calculate updates
-                    delta_ecr = (adjusted_alpha * iter->second * (data->reward - sum_old_ecr));
+                // calculate updates
+                std::vector<double>& deltas_ecr = thisAgent->RL->rl_update_delta_ecr;
+                std::vector<double>& deltas_efr = thisAgent->RL->rl_update_delta_efr;
+                double ecr_error = (data->reward - sum_old_ecr);
+                double efr_error = ((discount * op_value) - sum_old_efr);
 
-                    if (update_efr)
-                    {
-                        delta_efr = (adjusted_alpha * iter->second * ((discount * op_value) - sum_old_efr));
-                    }
-                    else
+                deltas_ecr.resize(num_traces);
+                for (size_t i = 0; i < num_traces; i++)
+                {
+                    deltas_ecr[i] = (alphas[i] * traces[i] * ecr_error);
+                }
+
+                if (update_efr)
+                {
+                    deltas_efr.resize(num_traces);
+                    for (size_t i = 0; i < num_traces; i++)
                     {
-                        delta_efr = 0.0;
+                        deltas_efr[i] = (alphas[i] * traces[i] * efr_error);
                     }
+                }
+                else
+                {
+                    deltas_efr.assign(num_traces, 0.0);
+                }
+
+                bool trace_updates = thisAgent->trace_settings[ TRACE_RL_SYSPARAM ];
+                for (size_t i = 0; i < num_traces; i++)
+                {
+                    production* prod = prods[i];
+
+                    // get old vals
+                    double old_ecr = prod->rl_ecr;
+                    double old_efr = prod->rl_efr;
+                    double old_gql = prod->rl_gql;
 
                     // calculate new vals
-                    new_ecr = (old_ecr + delta_ecr);
-                    new_efr = (old_efr + delta_efr);
-                    new_combined = (new_ecr + new_efr);
-                    new_gql = old_gql + eta * (delta_ecr + delta_efr);
+                    double new_ecr = (old_ecr + deltas_ecr[i]);
+                    double new_efr = (old_efr + deltas_efr[i]);
+                    double new_combined = (new_ecr + new_efr);
+                    double new_gql = old_gql + eta * (deltas_ecr[i] + deltas_efr[i]);
 
                     // print as necessary
-                    if (thisAgent->trace_settings[ TRACE_RL_SYSPARAM ])
+                    if (trace_updates)
                     {
                         std::ostringstream ss;
                         ss << "RL update " << prod->name->sc->name << " "
@@ -986,10 +1081,8 @@ void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* go
                         }
                     }
 
-                    // Change value of rule
-                    Symbol* lSym = rhs_value_to_symbol(prod->action_list->referent);
-                    deallocate_rhs_value(thisAgent, prod->action_list->referent);
-                    prod->action_list->referent = allocate_rhs_value_for_symbol_no_refcount(thisAgent, thisAgent->symbolManager->make_float_constant(new_combined), 0, 0);
+                    // Change value of rule, which reaches the RHS when something needs it
+                    rl_set_pending_value(thisAgent, prod, new_combined);
 
                     prod->rl_update_count += 1;
                     prod->rl_ecr = new_ecr;
@@ -997,7 +1090,7 @@ void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* go
                     prod->rl_gql = new_gql;
                 }
 
-                if (thisAgent->RL->rl_params->learning_policy->get_value() & rl_param_container::gql)
+                if (using_gql)
                 {
                     for (preference* pref = goal->id->operator_slot->preferences[ NUMERIC_INDIFFERENT_PREFERENCE_TYPE ]; pref; pref = pref->next)
                     {
@@ -1010,9 +1103,9 @@ void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* go
                     }
                 }
 
-                for (iter = data->eligibility_traces->begin(); iter != data->eligibility_traces->end(); iter++)
+                for (size_t i = 0; i < num_traces; i++)
                 {
-                    production* prod = iter->first;
+                    production* prod = prods[i];
 
                     // change documentation
                     if (thisAgent->RL->rl_params->meta->get_value() == on)
@@ -1041,17 +1134,7 @@ void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* go
                     }
 
                     // Change value of preferences generated by current instantiations of this rule
-                    if (prod->instantiations)
-                    {
-                        for (instantiation* inst = prod->instantiations; inst; inst = inst->next)
-                        {
-                            for (preference* pref = inst->preferences_generated; pref; pref = pref->inst_next)
-                            {
-                                thisAgent->symbolManager->symbol_remove_ref(&pref->referent);
-                                pref->referent = thisAgent->symbolManager->make_float_constant(new_combined);
-                            }
-                        }
-                    }
+                    rl_update_live_preferences(thisAgent, prod);
                 }
             }
         }
@@ -1062,8 +1145,401 @@ void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Symbol* go
     }
 }
 
+/////////////////////////////////////////////////////
+/////////////////////////////////////////////////////
+
+/* Every update used to replace the rule's RHS value with a newly made
+ * float constant.  Instead, new values go into a dense per-agent list
+ * (RL->rl_pending_values, with each rule's prod->rl_pending_index
+ * pointing at its entry) and are only made into symbols when something
+ * reads the RHS: the rule firing, the rule being excised or compared
+ * against a new rule, a command being run, or preferences of the rule
+ * that are still in working memory being updated.  A rule updated many
+ * times between those points only has its last value made into a
+ * symbol. */
+
+void rl_set_pending_value(agent* thisAgent, production* prod, double value)
+{
+    std::vector<rl_pending_value>& pending = thisAgent->RL->rl_pending_values;
+
+    if (prod->rl_pending_index)
+    {
+        pending[prod->rl_pending_index - 1].value = value;
+    }
+    else
+    {
+        rl_pending_value entry = { prod, value };
+        pending.push_back(entry);
+        prod->rl_pending_index = pending.size();
+    }
+}
+
+// replaces a rule's RHS value with a symbol for the given value
+static void rl_set_rhs_value(agent* thisAgent, production* prod, double value)
+{
+    deallocate_rhs_value(thisAgent, prod->action_list->referent);
+    prod->action_list->referent = allocate_rhs_value_for_symbol_no_refcount(thisAgent, thisAgent->symbolManager->make_float_constant(value), 0, 0);
+}
+
+void rl_write_back_value(agent* thisAgent, production* prod)
+{
+    if (!prod->rl_pending_index)
+    {
+        return;
+    }
+
+    std::vector<rl_pending_value>& pending = thisAgent->RL->rl_pending_values;
+    uint64_t i = prod->rl_pending_index - 1;
+
+    rl_set_rhs_value(thisAgent, prod, pending[i].value);
+    prod->rl_pending_index = 0;
+
+    // move the last entry into the gap
+    if (i != (pending.size() - 1))
+    {
+        pending[i] = pending.back();
+        pending[i].prod->rl_pending_index = i + 1;
+    }
+    pending.pop_back();
+}
+
+void rl_write_back_values(agent* thisAgent)
+{
+    std::vector<rl_pending_value>& pending = thisAgent->RL->rl_pending_values;
+
+    for (std::vector<rl_pending_value>::iterator p = pending.begin(); p != pending.end(); p++)
+    {
+        rl_set_rhs_value(thisAgent, p->prod, p->value);
+        p->prod->rl_pending_index = 0;
+    }
+    pending.clear();
+}
+
+/////////////////////////////////////////////////////
+/////////////////////////////////////////////////////
+
 // clears eligibility traces
 void rl_watkins_clear(agent* /*thisAgent*/, Symbol* goal)
 {
     goal->id->rl_info->eligibility_traces->clear();
 }
+
+/////////////////////////////////////////////////////
+/////////////////////////////////////////////////////
+
+/* A weights file holds the learned state of every Soar-RL rule, so that
+ * it can be checkpointed and put back into an agent whose rules are
+ * already loaded, without printing and re-sourcing the rules.  All
+ * numbers are little-endian:
+ *
+ *   "SoarRLW" 0x02, rule count (8 bytes), then per rule:
+ *     kind (1 byte), key length (4 bytes), key,
+ *     value, ecr, efr, gql, update count,
+ *     delta-bar-delta beta, delta-bar-delta h (IEEE doubles, 8 bytes each)
+ *
+ * Most rules are keyed by name.  Rules made from templates get numbered
+ * names that depend on the order they were made in, so they are keyed
+ * instead by their template's name and the constants their conditions
+ * test (see rl_weights_template_key). */
+
+static const char rl_weights_magic[8] = { 'S', 'o', 'a', 'r', 'R', 'L', 'W', 0x02 };
+
+enum rl_weights_key_kind { rl_weights_rule_name = 0, rl_weights_template_instance = 1 };
+
+static void rl_weights_put_uint(std::string& buf, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        buf.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+}
+
+static void rl_weights_put_double(std::string& buf, double d)
+{
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    rl_weights_put_uint(buf, bits, 8);
+}
+
+static bool rl_weights_get_uint(const std::string& buf, size_t& pos, uint64_t& v, int bytes)
+{
+    if ((buf.size() - pos) < static_cast<size_t>(bytes))
+    {
+        return false;
+    }
+
+    v = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        v |= (static_cast<uint64_t>(static_cast<unsigned char>(buf[pos++])) << (8 * i));
+    }
+    return true;
+}
+
+static bool rl_weights_get_double(const std::string& buf, size_t& pos, double& d)
+{
+    uint64_t bits;
+    if (!rl_weights_get_uint(buf, pos, bits, 8))
+    {
+        return false;
+    }
+    memcpy(&d, &bits, sizeof(d));
+    return true;
+}
+
+// returns the template a rule was made from, or NIL
+static production* rl_weights_template_of(agent* thisAgent, production* prod)
+{
+    if (!prod->original_rule_name || !strcmp(prod->original_rule_name, prod->name->sc->name))
+    {
+        return NIL;
+    }
+
+    Symbol* sym = thisAgent->symbolManager->find_str_constant(prod->original_rule_name);
+    if (!sym || !sym->sc->production || (sym->sc->production->type != TEMPLATE_PRODUCTION_TYPE))
+    {
+        return NIL;
+    }
+    return sym->sc->production;
+}
+
+// appends the constants a test compares against.  Variables are left out,
+// since their names depend on the order instances were made in too.
+static void rl_weights_test_key(test t, std::string& key)
+{
+    if (t && (t->type == CONJUNCTIVE_TEST))
+    {
+        for (cons* c = t->data.conjunct_list; c; c = c->rest)
+        {
+            rl_weights_test_key(static_cast<test>(c->first), key);
+        }
+    }
+    else if (t && test_has_referent(t) && t->data.referent->is_constant())
+    {
+        std::string temp;
+        key.append(to_string(static_cast<int>(t->type), temp)).append(t->data.referent->to_string(true)).push_back(' ');
+    }
+    key.push_back('|');
+}
+
+// appends one line per condition, sorted so the key doesn't depend on condition order
+static void rl_weights_conditions_key(condition* conds, std::string& key)
+{
+    std::vector<std::string> lines;
+
+    for (condition* cond = conds; cond; cond = cond->next)
+    {
+        std::string line;
+        if (cond->type == CONJUNCTIVE_NEGATION_CONDITION)
+        {
+            line.push_back('{');
+            rl_weights_conditions_key(cond->data.ncc.top, line);
+            line.push_back('}');
+        }
+        else
+        {
+            line.push_back((cond->type == NEGATIVE_CONDITION) ? '-' : '+');
+            rl_weights_test_key(cond->data.tests.id_test, line);
+            rl_weights_test_key(cond->data.tests.attr_test, line);
+            rl_weights_test_key(cond->data.tests.value_test, line);
+        }
+        lines.push_back(line);
+    }
+
+    std::sort(lines.begin(), lines.end());
+    for (std::vector<std::string>::iterator l = lines.begin(); l != lines.end(); l++)
+    {
+        key.append(*l).push_back('\n');
+    }
+}
+
+// a template instance's key: its template's name and the constants its
+// conditions test, which are what tell one instance of a template from another
+static std::string rl_weights_template_key(agent* thisAgent, production* prod, production* my_template)
+{
+    std::string key(my_template->name->sc->name);
+    condition* c_top;
+    condition* c_bottom;
+
+    key.push_back('\n');
+    p_node_to_conditions_and_rhs(thisAgent, prod->p_node, NIL, NIL, &c_top, &c_bottom, NIL);
+    rl_weights_conditions_key(c_top, key);
+    deallocate_condition_list(thisAgent, c_top);
+
+    return key;
+}
+
+bool rl_save_weights(agent* thisAgent, const char* file_name, uint64_t* count, std::string* err)
+{
+    std::string buf(rl_weights_magic, sizeof(rl_weights_magic));
+    rl_weights_put_uint(buf, 0, 8);
+
+    *count = 0;
+    for (int type = 0; type < NUM_PRODUCTION_TYPES; type++)
+    {
+        for (production* prod = thisAgent->all_productions_of_type[type]; prod; prod = prod->next)
+        {
+            if (!prod->rl_rule)
+            {
+                continue;
+            }
+
+            rl_write_back_value(thisAgent, prod);
+            production* my_template = rl_weights_template_of(thisAgent, prod);
+            std::string key = (my_template ? rl_weights_template_key(thisAgent, prod, my_template) : std::string(prod->name->sc->name));
+
+            rl_weights_put_uint(buf, (my_template ? rl_weights_template_instance : rl_weights_rule_name), 1);
+            rl_weights_put_uint(buf, key.size(), 4);
+            buf.append(key);
+            rl_weights_put_double(buf, get_number_from_symbol(rhs_value_to_symbol(prod->action_list->referent)));
+            rl_weights_put_double(buf, prod->rl_ecr);
+            rl_weights_put_double(buf, prod->rl_efr);
+            rl_weights_put_double(buf, prod->rl_gql);
+            rl_weights_put_double(buf, prod->rl_update_count);
+            rl_weights_put_double(buf, prod->rl_delta_bar_delta_beta);
+            rl_weights_put_double(buf, prod->rl_delta_bar_delta_h);
+            (*count)++;
+        }
+    }
+
+    // fill in the rule count
+    for (int i = 0; i < 8; i++)
+    {
+        buf[sizeof(rl_weights_magic) + i] = static_cast<char>(((*count) >> (8 * i)) & 0xFF);
+    }
+
+    std::ofstream file(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        err->assign("Could not open file for writing.");
+        return false;
+    }
+    file.write(buf.data(), buf.size());
+    file.close();
+    if (!file)
+    {
+        err->assign("Could not write file.");
+        return false;
+    }
+
+    return true;
+}
+
+bool rl_load_weights(agent* thisAgent, const char* file_name, uint64_t* count, uint64_t* unmatched, std::string* err)
+{
+    typedef struct rl_weights_record_struct
+    {
+        production* prod;
+        double values[7];
+    } rl_weights_record;
+
+    std::ifstream file(file_name, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        err->assign("Could not open file for reading.");
+        return false;
+    }
+    std::string buf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    if ((buf.size() < sizeof(rl_weights_magic)) || (buf.compare(0, sizeof(rl_weights_magic), rl_weights_magic, sizeof(rl_weights_magic)) != 0))
+    {
+        err->assign("Not a Soar-RL weights file.");
+        return false;
+    }
+
+    // read and check the whole file before changing any rule
+    size_t pos = sizeof(rl_weights_magic);
+    uint64_t num_records;
+    std::vector<rl_weights_record> records;
+    rl_weights_record record;
+    std::map<std::string, production*> template_instances;
+    bool template_instances_found = false;
+
+    *count = 0;
+    *unmatched = 0;
+    if (!rl_weights_get_uint(buf, pos, num_records, 8))
+    {
+        err->assign("Weights file is truncated.");
+        return false;
+    }
+    for (uint64_t r = 0; r < num_records; r++)
+    {
+        uint64_t kind, key_len;
+        if (!rl_weights_get_uint(buf, pos, kind, 1) || !rl_weights_get_uint(buf, pos, key_len, 4) || ((buf.size() - pos) < key_len))
+        {
+            err->assign("Weights file is truncated.");
+            return false;
+        }
+        if ((kind != rl_weights_rule_name) && (kind != rl_weights_template_instance))
+        {
+            err->assign("Weights file is corrupt.");
+            return false;
+        }
+        std::string key(buf, pos, key_len);
+        pos += key_len;
+
+        for (int v = 0; v < 7; v++)
+        {
+            if (!rl_weights_get_double(buf, pos, record.values[v]))
+            {
+                err->assign("Weights file is truncated.");
+                return false;
+            }
+        }
+
+        if (kind == rl_weights_template_instance)
+        {
+            // key the loaded template instances the same way, the first time one is needed
+            if (!template_instances_found)
+            {
+                for (production* prod = thisAgent->all_productions_of_type[USER_PRODUCTION_TYPE]; prod; prod = prod->next)
+                {
+                    production* my_template = (prod->rl_rule ? rl_weights_template_of(thisAgent, prod) : NIL);
+                    if (my_template)
+                    {
+                        template_instances[rl_weights_template_key(thisAgent, prod, my_template)] = prod;
+                    }
+                }
+                template_instances_found = true;
+            }
+
+            std::map<std::string, production*>::iterator p = template_instances.find(key);
+            record.prod = ((p != template_instances.end()) ? p->second : NIL);
+        }
+        else
+        {
+            Symbol* sym = thisAgent->symbolManager->find_str_constant(key.c_str());
+            record.prod = (sym ? sym->sc->production : NIL);
+        }
+        if (!record.prod || !record.prod->rl_rule)
+        {
+            (*unmatched)++;
+            continue;
+        }
+        records.push_back(record);
+    }
+    if (pos != buf.size())
+    {
+        err->assign("Weights file has trailing data.");
+        return false;
+    }
+
+    for (std::vector<rl_weights_record>::iterator p = records.begin(); p != records.end(); p++)
+    {
+        production* prod = p->prod;
+
+        rl_set_pending_value(thisAgent, prod, p->values[0]);
+        prod->rl_ecr = p->values[1];
+        prod->rl_efr = p->values[2];
+        prod->rl_gql = p->values[3];
+        prod->rl_update_count = p->values[4];
+        prod->rl_delta_bar_delta_beta = p->values[5];
+        prod->rl_delta_bar_delta_h = p->values[6];
+
+        rl_update_live_preferences(thisAgent, prod);
+    }
+    *count = records.size();
+
+    return true;
+}
@@ -212,10 +212,34 @@ class rl_stat_container: public soar_module::stat_container
 //////////////////////////////////////////////////////////
 
 
+// eligibility traces of a state, as parallel arrays of rules and trace
+// values so the per-update passes over them are flat loops
+class rl_et_store
+{
+    public:
+        std::vector<production*>    prods;
+        std::vector<double>         traces;
+
+        size_t  size() { return prods.size(); }
+        bool    empty() { return prods.empty(); }
+        void    clear() { prods.clear(); traces.clear(); }
+
+        // removes the trace of a rule, if any
+        void    erase(production* prod);
+
+        // multiplies every trace by lambda and then by discount
+        void    decay(double lambda, double discount);
+
+        // drops traces below tolerance and multiplies the rest by scale, then
+        // adds increment to the trace of each rule in fired (once per
+        // occurrence), making new traces as needed
+        void    prune_and_increment(double tolerance, double scale, production_list* fired, double increment);
+};
+
 // rl data associated with each state
 typedef struct rl_data_struct
 {
-    rl_et_map*          eligibility_traces;        // traces associated with productions
+    rl_et_store*        eligibility_traces;        // traces associated with productions
     production_list*    prev_op_rl_rules;         // rl rules associated with the previous operator
     wme*                rl_link_wme;
 
@@ -310,6 +334,36 @@ extern void rl_perform_update(agent* thisAgent, double op_value, bool op_rl, Sym
 // clears eligibility traces in accordance with watkins
 extern void rl_watkins_clear(agent* thisAgent, Symbol* goal);
 
+//////////////////////////////////////////////////////////
+// Pending Values
+//////////////////////////////////////////////////////////
+
+// records a rule's new value, to be written into its RHS later
+extern void rl_set_pending_value(agent* thisAgent, production* prod, double value);
+
+// writes a rule's pending value, if any, into its RHS
+extern void rl_write_back_value(agent* thisAgent, production* prod);
+
+// writes all pending values into their rules' RHS
+extern void rl_write_back_values(agent* thisAgent);
+
+//////////////////////////////////////////////////////////
+// Weights
+//////////////////////////////////////////////////////////
+
+// writes the values and learning state of all Soar-RL rules to a binary file
+extern bool rl_save_weights(agent* thisAgent, const char* file_name, uint64_t* count, std::string* err);
+
+// applies a file written by rl_save_weights to the loaded rules of the same names
+extern bool rl_load_weights(agent* thisAgent, const char* file_name, uint64_t* count, uint64_t* unmatched, std::string* err);
+
+// a Soar-RL rule's updated value, not yet written into its RHS
+typedef struct rl_pending_value_struct
+{
+    production* prod;
+    double value;
+} rl_pending_value;
+
 class RL_Manager
 {
     public:
@@ -325,6 +379,10 @@ class RL_Manager
         rl_production_memory*                   rl_prods;
         int                                     rl_template_count;
         std::map<goal_stack_level, RL_Trace>    rl_trace;
+        std::vector<rl_pending_value>           rl_pending_values;  /* see rl_write_back_values() */
+        std::vector<double>                     rl_update_alpha;    /* per-trace scratch for rl_perform_update() */
+        std::vector<double>                     rl_update_delta_ecr;
+        std::vector<double>                     rl_update_delta_efr;
 
     private:
 
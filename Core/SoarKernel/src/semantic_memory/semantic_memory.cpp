@@ -719,6 +719,7 @@ SMem_Manager::SMem_Manager(agent* myAgent)
     timers = new smem_timer_container(thisAgent);
 
     DB = new soar_module::sqlite_database();
+    native_store = NULL;
 
     smem_validation = 0;
 
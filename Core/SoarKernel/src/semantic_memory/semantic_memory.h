@@ -22,6 +22,8 @@
 
 #include <string>
 
+class SMem_Native_Store;
+
 //#define SMEM_EXPERIMENT  // hijack the main SMem function for tight-loop experimentation/timing
 
 class SMem_Manager
@@ -68,6 +70,7 @@ class SMem_Manager
         bool        CLI_add(const char* str_to_LTMs, std::string** err_msg);
         bool        CLI_query(const char* ltms, std::string** err_msg, std::string** result_message, uint64_t number_to_retrieve);
         bool        CLI_remove(const char* ltms, std::string** err_msg, std::string** result_message, bool force = false);
+        bool        CLI_import(const char* file_name, std::string** err_msg, std::string** result_message);
 
         void        calc_spread_trajectories();
         void        invalidate_trajectories(uint64_t lti_parent_id, std::map<uint64_t, int64_t>* delta_children);
@@ -121,6 +124,7 @@ class SMem_Manager
         smem_param_container*           settings;
         smem_stat_container*            statistics;
         soar_module::sqlite_database*   DB;
+        SMem_Native_Store*              native_store;   /* NULL unless the native-store setting is on */
 
         /* Temporary maps used when creating an instance of an LTM */
         id_to_sym_map                   lti_to_sti_map;
@@ -180,6 +184,11 @@ class SMem_Manager
         void            STM_to_LTM(Symbol* pSTI, smem_storage_type store_type, bool pCreateNewLTM, bool pOverwriteOldLinkToLTM, tc_number tc = NIL);
         void            LTM_to_DB(uint64_t pLTI_ID, ltm_slot_map* children, bool remove_old_children, bool activate, smem_storage_type store_type = store_level);
 
+        /* Methods for bulk loading knowledge (smem --import) */
+        bool            import_clauses(const char* text, smem_bulk_aug_list& augs, std::string** err_msg);
+        bool            import_triples(const char* file_name, char separator, smem_bulk_aug_list& augs, std::string** err_msg);
+        uint64_t        bulk_load(smem_bulk_aug_list& augs);
+
         /* Methods for creating an instance of a LTM using STIs */
         uint64_t        get_current_LTI_for_iSTI(Symbol* pSTI, bool useLookupTable, bool pOverwriteOldLinkToLTM);
 
@@ -187,12 +196,16 @@ class SMem_Manager
         bool                            process_cue_wme(wme* w, bool pos_cue, smem_prioritized_weighted_cue& weighted_pq, MathQuery* mathQuery);
         uint64_t                        process_query(Symbol* state, std::list<Symbol*> query, Symbol* negquery, Symbol* mathQuery, id_set* prohibit, wme_set& cue_wmes, symbol_triple_list& meta_wmes, symbol_triple_list& retrieval_wmes, smem_query_levels query_level = qry_full, uint64_t number_to_retrieve = 1, std::list<uint64_t>* match_ids = NIL, uint64_t depth = 1, smem_install_type install_type = wm_install);
         std::pair<bool, bool>*          processMathQuery(Symbol* mathQuery, smem_prioritized_weighted_cue* weighted_pq);
+        bool                            math_query_value_met(MathQuery* mathQuery, smem_hash_id value_hash);
         soar_module::sqlite_statement*  setup_web_crawl(smem_weighted_cue_element* el);
         soar_module::sqlite_statement*  setup_web_crawl_without_spread(smem_weighted_cue_element* el);
         soar_module::sqlite_statement*  setup_cheap_web_crawl(smem_weighted_cue_element* el);
         soar_module::sqlite_statement*  setup_web_crawl_spread(smem_weighted_cue_element* el);
 
         /* Methods for supporting spreading activation */
+        std::map<uint64_t, std::list<std::pair<uint64_t,double>>*> spread_children; /* children and edge weights, kept across cycles (bounded) */
+        void invalidate_spread_children(uint64_t lti_id);
+        void clear_spread_children();
         void child_spread(uint64_t lti_id, std::map<uint64_t, std::list<std::pair<uint64_t,double>>*>& lti_trajectories, int depth);
         void trajectory_construction(uint64_t lti_id, std::map<uint64_t, std::list<std::pair<uint64_t, double>>*>& lti_trajectories, int depth, bool initial);
         //void calc_likelihoods_for_trajectories(uint64_t lti_id);
@@ -9,6 +9,7 @@
 
 #include "smem_settings.h"
 #include "smem_db.h"
+#include "smem_native_store.h"
 #include "smem_stats.h"
 #include "smem_timers.h"
 #include "working_memory_activation.h"
@@ -347,12 +348,20 @@ double SMem_Manager::lti_activate(uint64_t pLTI_ID, bool add_access, uint64_t nu
         SQL->act_set->bind_double(1, new_base+modified_spread);
         SQL->act_set->bind_int(2, pLTI_ID);
         SQL->act_set->execute(soar_module::op_reinit);
+        if (native_store)
+        {
+            native_store->set_activation(pLTI_ID, new_base+modified_spread);
+        }
     }
     else if (num_edges >= static_cast<uint64_t>(settings->thresh->get_value()) && !already_in_spread_table)
     {
         SQL->act_set->bind_double(1, SMEM_ACT_MAX);
         SQL->act_set->bind_int(2, pLTI_ID);
         SQL->act_set->execute(soar_module::op_reinit);
+        if (native_store)
+        {
+            native_store->set_activation(pLTI_ID, static_cast<double>(SMEM_ACT_MAX));
+        }
     }
     else if (num_edges < static_cast<uint64_t>(settings->thresh->get_value()) && already_in_spread_table)
     {
@@ -368,9 +377,35 @@ double SMem_Manager::lti_activate(uint64_t pLTI_ID, bool add_access, uint64_t nu
     return new_base+modified_spread;
 }
 
+void SMem_Manager::invalidate_spread_children(uint64_t lti_id)
+{
+    std::map<uint64_t, std::list<std::pair<uint64_t,double>>*>::iterator cached = spread_children.find(lti_id);
+    if (cached != spread_children.end())
+    {
+        delete cached->second;
+        spread_children.erase(cached);
+    }
+}
+
+void SMem_Manager::clear_spread_children()
+{
+    for (std::map<uint64_t, std::list<std::pair<uint64_t,double>>*>::iterator to_delete = spread_children.begin(); to_delete != spread_children.end(); ++to_delete)
+    {
+        delete to_delete->second;
+    }
+    spread_children.clear();
+}
+
 void SMem_Manager::child_spread(uint64_t lti_id, std::map<uint64_t, std::list<std::pair<uint64_t,double>>*>& lti_trajectories, int depth = 10)
 {
-    if (lti_trajectories.find(lti_id) == lti_trajectories.end())
+    std::map<uint64_t, std::list<std::pair<uint64_t,double>>*>::iterator cached = lti_trajectories.find(lti_id);
+    if (cached != lti_trajectories.end() && smem_edges_to_update->find(lti_id) != smem_edges_to_update->end())
+    {//The children are kept from earlier cycles, but pending edge weight updates have to be applied to the db first.
+        delete cached->second;
+        lti_trajectories.erase(cached);
+        cached = lti_trajectories.end();
+    }
+    if (cached == lti_trajectories.end())
     {//If we don't already have the children and their edge weights, we need to get them.
         soar_module::sqlite_statement* children_q = SQL->web_val_child;
         std::list<uint64_t> children;
@@ -714,7 +749,7 @@ void SMem_Manager::calc_spread_trajectories()
     }
     lti_all->reinitialize();
     //smem_create_trajectory_indices();//TODO: Fix this and the above commend about it. YELL AT ME.
-    //Cleanup the map.
+    //Cleanup the map. This walks the whole store, so it is not kept in spread_children.
     for (std::map<uint64_t,std::list<std::pair<uint64_t, double>>*>::iterator to_delete = lti_trajectories.begin(); to_delete != lti_trajectories.end(); ++to_delete)
     {
         delete to_delete->second;
@@ -778,7 +813,12 @@ void SMem_Manager::calc_spread(std::set<uint64_t>* current_candidates, bool do_m
     timers->spreading->start();
     ////////////////////////////////////////////////////////////////////////////
     uint64_t count = 0;
-    std::map<uint64_t,std::list<std::pair<uint64_t,double>>*> lti_trajectories;
+    //The cache of children is bounded; past the bound it is simply started over.
+    if (spread_children.size() > SMEM_SPREAD_CHILDREN_LIMIT)
+    {
+        clear_spread_children();
+    }
+    std::map<uint64_t,std::list<std::pair<uint64_t,double>>*>& lti_trajectories = spread_children;
     timers->spreading_wma_3->start();
     batch_invalidate_from_lti();
     timers->spreading_wma_3->stop();
@@ -849,16 +889,9 @@ void SMem_Manager::calc_spread(std::set<uint64_t>* current_candidates, bool do_m
             SQL->trajectory_get->reinitialize();
         }
     }*/
-    ////////////////////////////////////////////////////////////////////////////
-    timers->spreading_2->start();
-    ////////////////////////////////////////////////////////////////////////////
-    for (std::map<uint64_t,std::list<std::pair<uint64_t,double>>*>::iterator to_delete = lti_trajectories.begin(); to_delete != lti_trajectories.end(); ++to_delete)
-    {
-        delete to_delete->second;
-    }
-    ////////////////////////////////////////////////////////////////////////////
-    timers->spreading_2->stop();
-    ////////////////////////////////////////////////////////////////////////////
+    //The children gathered for the traversals stay in spread_children for later cycles, up to
+    //SMEM_SPREAD_CHILDREN_LIMIT LTIs. They are dropped as soon as the LTI is stored to again
+    //(see invalidate_spread_children).
     ////////////////////////////////////////////////////////////////////////////
     timers->spreading_3->start();
     ////////////////////////////////////////////////////////////////////////////
@@ -964,6 +997,10 @@ void SMem_Manager::calc_spread(std::set<uint64_t>* current_candidates, bool do_m
                         SQL->act_set->bind_double(1, prev_base);
                         SQL->act_set->bind_int(2, *recipient_it);
                         SQL->act_set->execute(soar_module::op_reinit);
+                        if (native_store)
+                        {
+                            native_store->set_activation(*recipient_it, prev_base);
+                        }
 
                         //SQL->act_lti_fake_get->reinitialize();
                     }
@@ -1033,7 +1070,6 @@ void SMem_Manager::calc_spread(std::set<uint64_t>* current_candidates, bool do_m
 
     soar_module::sqlite_statement* calc_current_spread = SQL->calc_current_spread;
     std::set<uint64_t>* actual_candidates = ( do_manual_crawl ? &pruned_candidates : current_candidates);
-    std::unordered_set<uint64_t> updated_candidates;
     //spreaded_to->clear();
     ////////////////////////////////////////////////////////////////////////////
     timers->spreading_6->stop();
@@ -1073,57 +1109,29 @@ void SMem_Manager::calc_spread(std::set<uint64_t>* current_candidates, bool do_m
         while (calc_current_spread->execute() == soar_module::row && calc_current_spread->column_double(2))
         {
             //First, I need to get the existing info for this lti_id.
-            bool already_in_spread_table = false;
-
             bool addition = (((int)(calc_current_spread->column_int(3))) == 1);
             if (addition)
             {
 
-                if (spreaded_to->find(*candidate) == spreaded_to->end())//(updated_candidates.find(*candidate) == updated_candidates.end())
-                {
+                if (spreaded_to->find(*candidate) == spreaded_to->end())
+                {//The first source for this candidate this cycle: start from its base-level and no spread.
                     ////////////////////////////////////////////////////////////////////////////
                     timers->spreading_7_2_1->start();
                     ////////////////////////////////////////////////////////////////////////////
                     (*spreaded_to)[*candidate] = 1;
                     SQL->act_lti_get->bind_int(1,*candidate);
                     SQL->act_lti_get->execute();
-                    spread = SQL->act_lti_get->column_double(1);//This is the spread before changes.
                     prev_base = SQL->act_lti_get->column_double(0);
                     SQL->act_lti_get->reinitialize();
+                    spread = 0;
                     ////////////////////////////////////////////////////////////////////////////
                     timers->spreading_7_2_1->stop();
                     ////////////////////////////////////////////////////////////////////////////
                 }
                 else
-                {
-                    ////////////////////////////////////////////////////////////////////////////
-                    timers->spreading_7_2_2->start();
-                    ////////////////////////////////////////////////////////////////////////////
-                    already_in_spread_table = true;
-                    //if (!(updated_candidates.find(*candidate) == updated_candidates.end()))
-                    {
-                        (*spreaded_to)[*candidate] = (*spreaded_to)[*candidate] + 1;
-                    }
-                    SQL->act_lti_fake_get->bind_int(1,*candidate);
-                    SQL->act_lti_fake_get->execute();
-                    spread = SQL->act_lti_fake_get->column_double(1);//This is the spread before changes.
-                    prev_base = SQL->act_lti_fake_get->column_double(0);
-                    SQL->act_lti_fake_get->reinitialize();
-                    ////////////////////////////////////////////////////////////////////////////
-                    timers->spreading_7_2_2->stop();
-                    ////////////////////////////////////////////////////////////////////////////
-                }
-                ////////////////////////////////////////////////////////////////////////////
-                timers->spreading_7_2_3->start();
-                ////////////////////////////////////////////////////////////////////////////
-                if (updated_candidates.find(*candidate) == updated_candidates.end())
-                {//If we have yet to update the spread to this candidate this cycle, we need to reset it to 0.
-                    spread = 0;
-                    updated_candidates.insert(*candidate);
+                {//Later sources add to the spread accumulated so far, which is only written out once they all have.
+                    (*spreaded_to)[*candidate] = (*spreaded_to)[*candidate] + 1;
                 }
-                ////////////////////////////////////////////////////////////////////////////
-                timers->spreading_7_2_3->stop();
-                ////////////////////////////////////////////////////////////////////////////
 /*
                 if (settings->spreading_normalization->get_value() == off && settings->spreading_traversal->get_value() == smem_param_container::deterministic && settings->spreading_loop_avoidance->get_value() == on)
                 {
@@ -1203,71 +1211,6 @@ void SMem_Manager::calc_spread(std::set<uint64_t>* current_candidates, bool do_m
                 ////////////////////////////////////////////////////////////////////////////
                 timers->spreading_7_2_5->stop();
                 ////////////////////////////////////////////////////////////////////////////
-                ////////////////////////////////////////////////////////////////////////////
-                timers->spreading_7_2_6->start();
-                ////////////////////////////////////////////////////////////////////////////
-                SQL->act_lti_child_ct_get->bind_int(1, *candidate);
-                SQL->act_lti_child_ct_get->execute();
-                uint64_t num_edges = SQL->act_lti_child_ct_get->column_int(0);
-
-                SQL->act_lti_child_ct_get->reinitialize();
-                double modified_spread = (log(spread)-log(offset));
-                double new_base;
-                if (static_cast<double>(prev_base)==static_cast<double>(SMEM_ACT_LOW) || static_cast<double>(prev_base) == 0)
-                {//used for base-level - thisAgent->smem_max_cycle - We assume that the memory was accessed at least "age of the agent" ago if there is no record.
-                    double decay = settings->base_decay->get_value();
-                    new_base = pow(static_cast<double>(smem_max_cycle+settings->base_unused_age_offset->get_value()),static_cast<double>(-decay));
-                    new_base = log(new_base/(1+new_base));
-                }
-                else
-                {
-                    new_base = prev_base;
-                }
-                ////////////////////////////////////////////////////////////////////////////
-                timers->spreading_7_2_6->stop();
-                ////////////////////////////////////////////////////////////////////////////
-                //SQL->add_committed_fingerprint->bind_int(1,*candidate);
-                //SQL->add_committed_fingerprint->bind_double(2,(double)(calc_current_spread->column_double(2)));
-                //SQL->add_committed_fingerprint->bind_double(3,(double)(calc_current_spread->column_double(1)));
-                //SQL->add_committed_fingerprint->bind_int(4,(calc_current_spread->column_int(4)));
-                //SQL->add_committed_fingerprint->execute(soar_module::op_reinit);
-                if (already_in_spread_table)
-                {
-                    ////////////////////////////////////////////////////////////////////////////
-                    timers->spreading_7_2_7->start();
-                    ////////////////////////////////////////////////////////////////////////////
-                    SQL->act_lti_fake_set->bind_double(1, ((static_cast<double>(prev_base)==0) ? (SMEM_ACT_LOW):(prev_base)));
-                    SQL->act_lti_fake_set->bind_double(2, spread);
-                    SQL->act_lti_fake_set->bind_double(3, modified_spread+ new_base);
-                    SQL->act_lti_fake_set->bind_int(4, *candidate);
-                    SQL->act_lti_fake_set->execute(soar_module::op_reinit);
-                    ////////////////////////////////////////////////////////////////////////////
-                    timers->spreading_7_2_7->stop();
-                    ////////////////////////////////////////////////////////////////////////////
-                }
-                else
-                {
-                    ////////////////////////////////////////////////////////////////////////////
-                    timers->spreading_7_2_8->start();
-                    ////////////////////////////////////////////////////////////////////////////
-                    SQL->act_lti_fake_insert->bind_int(1, *candidate);
-                    SQL->act_lti_fake_insert->bind_double(2, ((static_cast<double>(prev_base)==0) ? (SMEM_ACT_LOW):(prev_base)));
-                    SQL->act_lti_fake_insert->bind_double(3, spread);
-                    SQL->act_lti_fake_insert->bind_double(4, modified_spread+ new_base);
-                    SQL->act_lti_fake_insert->execute(soar_module::op_reinit);
-
-                    //In order to prevent the activation from the augmentations table from coming into play after this has been given spread, we set the augmentations bla to be smemactlow
-                    /*SQL->act_set->bind_double(1, SMEM_ACT_LOW);
-                    SQL->act_set->bind_int(2, *candidate);
-                    SQL->act_set->execute(soar_module::op_reinit);*/
-                    // The above fix was abhorrently slow. Instead of changing the activation value and forcing a reindexing for like 3 indexes on the largest table,
-                    // I fix the issue by using more clever queries that involve not pulling lti activations from the default table when it has spread.
-
-                    ////////////////////////////////////////////////////////////////////////////
-                    timers->spreading_7_2_8->stop();
-                    ////////////////////////////////////////////////////////////////////////////
-                }
-
             }
             /*else
             {
@@ -1355,6 +1298,45 @@ void SMem_Manager::calc_spread(std::set<uint64_t>* current_candidates, bool do_m
             }*/
         }
         calc_current_spread->reinitialize();
+        if (spreaded_to->find(*candidate) != spreaded_to->end())
+        {//Every source has added in its spread, so the candidate's activation is written out once.
+            ////////////////////////////////////////////////////////////////////////////
+            timers->spreading_7_2_6->start();
+            ////////////////////////////////////////////////////////////////////////////
+            double modified_spread = (log(spread)-log(offset));
+            double new_base;
+            if (static_cast<double>(prev_base)==static_cast<double>(SMEM_ACT_LOW) || static_cast<double>(prev_base) == 0)
+            {//used for base-level - thisAgent->smem_max_cycle - We assume that the memory was accessed at least "age of the agent" ago if there is no record.
+                double decay = settings->base_decay->get_value();
+                new_base = pow(static_cast<double>(smem_max_cycle+settings->base_unused_age_offset->get_value()),static_cast<double>(-decay));
+                new_base = log(new_base/(1+new_base));
+            }
+            else
+            {
+                new_base = prev_base;
+            }
+            ////////////////////////////////////////////////////////////////////////////
+            timers->spreading_7_2_6->stop();
+            ////////////////////////////////////////////////////////////////////////////
+            ////////////////////////////////////////////////////////////////////////////
+            timers->spreading_7_2_8->start();
+            ////////////////////////////////////////////////////////////////////////////
+            SQL->act_lti_fake_insert->bind_int(1, *candidate);
+            SQL->act_lti_fake_insert->bind_double(2, ((static_cast<double>(prev_base)==0) ? (SMEM_ACT_LOW):(prev_base)));
+            SQL->act_lti_fake_insert->bind_double(3, spread);
+            SQL->act_lti_fake_insert->bind_double(4, modified_spread+ new_base);
+            SQL->act_lti_fake_insert->execute(soar_module::op_reinit);
+
+            //In order to prevent the activation from the augmentations table from coming into play after this has been given spread, we set the augmentations bla to be smemactlow
+            /*SQL->act_set->bind_double(1, SMEM_ACT_LOW);
+            SQL->act_set->bind_int(2, *candidate);
+            SQL->act_set->execute(soar_module::op_reinit);*/
+            // The above fix was abhorrently slow. Instead of changing the activation value and forcing a reindexing for like 3 indexes on the largest table,
+            // I fix the issue by using more clever queries that involve not pulling lti activations from the default table when it has spread.
+            ////////////////////////////////////////////////////////////////////////////
+            timers->spreading_7_2_8->stop();
+            ////////////////////////////////////////////////////////////////////////////
+        }
         ////////////////////////////////////////////////////////////////////////////
         timers->spreading_7_2->stop();
         ////////////////////////////////////////////////////////////////////////////
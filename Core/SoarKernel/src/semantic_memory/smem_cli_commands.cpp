@@ -913,6 +913,7 @@ bool SMem_Manager::parse_add_clause(soar::Lexer* lexer, str_to_ltm_map* str_to_L
                             l_ltm_value = new ltm_value;
                             l_ltm_value->val_lti.val_type = value_lti_t;
                             l_ltm_value->val_lti.val_value = l_ltm_temp;
+                            l_ltm_value->val_lti.edge_weight = 0;
                             l_ltm_slot = make_ltm_slot(l_ltm_intermediate_parent->slots, l_ltm_attr);
                             l_ltm_slot->push_back(l_ltm_value);
 
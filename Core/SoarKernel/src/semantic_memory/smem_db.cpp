@@ -7,6 +7,7 @@
 
 #include "semantic_memory.h"
 #include "smem_db.h"
+#include "smem_native_store.h"
 #include "smem_timers.h"
 #include "smem_settings.h"
 #include "smem_stats.h"
@@ -74,20 +75,31 @@ void smem_statement_container::create_tables()
     }
 }
 
+/* --- indices on smem_augmentations, by name, so that bulk loads can drop
+ *     them while inserting and build them once afterwards --- */
+static const char* smem_augmentation_indices[][2] =
+{
+    { "smem_augmentations_parent_attr_val_lti", "CREATE INDEX smem_augmentations_parent_attr_val_lti ON smem_augmentations (lti_id, attribute_s_id, value_constant_s_id, value_lti_id, edge_weight)" },
+    { "smem_augmentations_attr_val_lti_cycle", "CREATE INDEX smem_augmentations_attr_val_lti_cycle ON smem_augmentations (attribute_s_id, value_constant_s_id, value_lti_id, activation_value)" },
+    { "smem_augmentations_attr_cycle", "CREATE INDEX smem_augmentations_attr_cycle ON smem_augmentations (attribute_s_id, activation_value)" },
+    //the index below is used for forward spread.
+    { "smem_augmentations_parent_val_lti", "CREATE INDEX smem_augmentations_parent_val_lti ON smem_augmentations (lti_id, value_constant_s_id, value_lti_id, edge_weight)" },
+    { NULL, NULL }
+};
+
 void smem_statement_container::create_indices()
 {
     add_structure("CREATE UNIQUE INDEX smem_symbols_int_const ON smem_symbols_integer (symbol_value)");
     add_structure("CREATE UNIQUE INDEX smem_symbols_float_const ON smem_symbols_float (symbol_value)");
     add_structure("CREATE UNIQUE INDEX smem_symbols_str_const ON smem_symbols_string (symbol_value)");
     add_structure("CREATE INDEX smem_lti_t ON smem_lti (activations_last)");
-    add_structure("CREATE INDEX smem_augmentations_parent_attr_val_lti ON smem_augmentations (lti_id, attribute_s_id, value_constant_s_id, value_lti_id, edge_weight)");
-    add_structure("CREATE INDEX smem_augmentations_attr_val_lti_cycle ON smem_augmentations (attribute_s_id, value_constant_s_id, value_lti_id, activation_value)");
-    add_structure("CREATE INDEX smem_augmentations_attr_cycle ON smem_augmentations (attribute_s_id, activation_value)");
+    for (int i = 0; smem_augmentation_indices[i][0]; i++)
+    {
+        add_structure(smem_augmentation_indices[i][1]);
+    }
     add_structure("CREATE UNIQUE INDEX smem_wmes_constant_frequency_attr_val ON smem_wmes_constant_frequency (attribute_s_id, value_constant_s_id)");
     add_structure("CREATE UNIQUE INDEX smem_ct_lti_attr_val ON smem_wmes_lti_frequency (attribute_s_id, value_lti_id)");
     /* The indexes below are for spreading. */
-    //the index below is used for forward spread.
-    add_structure("CREATE INDEX smem_augmentations_parent_val_lti ON smem_augmentations (lti_id, value_constant_s_id, value_lti_id, edge_weight)");
     //scijones - I'm not sure, but the below index is for backwards spread, which is no longer supported.
     //add_structure("CREATE INDEX smem_augmentations_backlink ON smem_augmentations (value_lti_id, value_constant_s_id, lti_id)");
     add_structure("CREATE INDEX trajectory_lti ON smem_likelihood_trajectories (lti_id, valid_bit)");
@@ -114,6 +126,37 @@ void smem_statement_container::create_indices()
     add_structure("CREATE INDEX lti_source ON smem_uncommitted_spread (lti_source)");
 }
 
+void smem_statement_container::drop_augmentation_indices(soar_module::sqlite_database* db)
+{
+    std::string sql;
+
+    for (int i = 0; smem_augmentation_indices[i][0]; i++)
+    {
+        sql.assign("DROP INDEX IF EXISTS ");
+        sql.append(smem_augmentation_indices[i][0]);
+        db->sql_execute(sql.c_str());
+    }
+}
+
+void smem_statement_container::add_augmentation_indices(soar_module::sqlite_database* db)
+{
+    for (int i = 0; smem_augmentation_indices[i][0]; i++)
+    {
+        db->sql_execute(smem_augmentation_indices[i][1]);
+    }
+}
+
+// recounts the frequency tables from smem_augmentations, one grouping each
+void smem_statement_container::rebuild_frequencies(soar_module::sqlite_database* db)
+{
+    db->sql_execute("DELETE FROM smem_attribute_frequency");
+    db->sql_execute("INSERT INTO smem_attribute_frequency (attribute_s_id, edge_frequency) SELECT attribute_s_id, COUNT(DISTINCT lti_id) FROM smem_augmentations GROUP BY attribute_s_id");
+    db->sql_execute("DELETE FROM smem_wmes_constant_frequency");
+    db->sql_execute("INSERT INTO smem_wmes_constant_frequency (attribute_s_id, value_constant_s_id, edge_frequency) SELECT attribute_s_id, value_constant_s_id, COUNT(*) FROM smem_augmentations WHERE value_lti_id=" SMEM_AUGMENTATIONS_NULL_STR " GROUP BY attribute_s_id, value_constant_s_id");
+    db->sql_execute("DELETE FROM smem_wmes_lti_frequency");
+    db->sql_execute("INSERT INTO smem_wmes_lti_frequency (attribute_s_id, value_lti_id, edge_frequency) SELECT attribute_s_id, value_lti_id, COUNT(*) FROM smem_augmentations WHERE value_constant_s_id=" SMEM_AUGMENTATIONS_NULL_STR " GROUP BY attribute_s_id, value_lti_id");
+}
+
 void smem_statement_container::drop_tables(agent* new_agent)
 {
     new_agent->SMem->DB->sql_execute("DROP TABLE IF EXISTS smem_persistent_variables");
@@ -1117,6 +1160,12 @@ void SMem_Manager::init_db()
 
         reset_id_counters();
 
+        if (settings->native_store->get_value() == on)
+        {
+            native_store = new SMem_Native_Store();
+            native_store->load(DB);
+        }
+
         // if lazy commit, then we encapsulate the entire lifetime of the agent in a single transaction
         if (settings->lazy_commit->get_value() == on)
         {
@@ -1195,6 +1244,9 @@ void SMem_Manager::close()
 
         // de-allocate common statements
         delete SQL;
+        delete native_store;
+        native_store = NULL;
+        clear_spread_children();
         delete thisAgent->lastCue;
         thisAgent->lastCue = NULL;
 
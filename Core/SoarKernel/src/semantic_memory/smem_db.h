@@ -169,6 +169,11 @@ class smem_statement_container: public soar_module::sqlite_statement_container
 
         smem_statement_container(agent* new_agent);
 
+        /* --- used by bulk loads, which insert first and index afterwards --- */
+        static void drop_augmentation_indices(soar_module::sqlite_database* db);
+        static void add_augmentation_indices(soar_module::sqlite_database* db);
+        static void rebuild_frequencies(soar_module::sqlite_database* db);
+
     private:
 
         void create_tables();
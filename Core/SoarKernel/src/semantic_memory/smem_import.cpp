@@ -0,0 +1,716 @@
+/*
+ * smem_import.cpp
+ *
+ *  Bulk loading of knowledge into semantic memory (smem --import), from
+ *  smem --add clauses or from a file of triples.
+ */
+
+#include "semantic_memory.h"
+#include "smem_db.h"
+#include "smem_native_store.h"
+#include "smem_settings.h"
+#include "smem_stats.h"
+
+#include "agent.h"
+#include "lexer.h"
+#include "misc.h"
+#include "symbol_manager.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/* --- an LTI's augmentations, constants first, in the order LTM_to_DB
+ *     would have stored them --- */
+static bool smem_import_aug_order(const smem_bulk_aug& a, const smem_bulk_aug& b)
+{
+    if (a.lti_id != b.lti_id)
+    {
+        return (a.lti_id < b.lti_id);
+    }
+    if ((a.value_lti == SMEM_AUGMENTATIONS_NULL) != (b.value_lti == SMEM_AUGMENTATIONS_NULL))
+    {
+        return (a.value_lti == SMEM_AUGMENTATIONS_NULL);
+    }
+    if (a.attr != b.attr)
+    {
+        return (a.attr < b.attr);
+    }
+    if (a.value_const != b.value_const)
+    {
+        return (a.value_const < b.value_const);
+    }
+    return (a.value_lti < b.value_lti);
+}
+
+static bool smem_import_aug_same(const smem_bulk_aug& a, const smem_bulk_aug& b)
+{
+    return ((a.lti_id == b.lti_id) && (a.attr == b.attr) && (a.value_const == b.value_const) && (a.value_lti == b.value_lti));
+}
+
+/* --- one field of a triple: an LTI (@id or <name>) or a constant --- */
+typedef struct smem_import_field_struct
+{
+    bool            is_lti;
+    uint64_t        lti_id;         // for @id, else NIL
+    byte            const_type;
+    std::string     text;           // the LTI's name, or the constant
+    int64_t         int_val;
+    double          float_val;
+} smem_import_field;
+
+static void smem_import_trim(std::string& text)
+{
+    size_t first = text.find_first_not_of(" \t\r");
+    size_t last = text.find_last_not_of(" \t\r");
+
+    if (first == std::string::npos)
+    {
+        text.clear();
+    }
+    else
+    {
+        text = text.substr(first, last - first + 1);
+    }
+}
+
+static bool smem_import_number_like(const std::string& text)
+{
+    size_t i = ((text[0] == '+') || (text[0] == '-')) ? 1 : 0;
+
+    if ((i < text.size()) && (text[i] == '.'))
+    {
+        i++;
+    }
+    return ((i < text.size()) && isdigit(static_cast<unsigned char>(text[i])));
+}
+
+static bool smem_import_parse_field(std::string text, smem_import_field& field)
+{
+    char* end;
+
+    smem_import_trim(text);
+    if (text.empty())
+    {
+        return false;
+    }
+
+    field.is_lti = false;
+    field.lti_id = NIL;
+    field.const_type = STR_CONSTANT_SYMBOL_TYPE;
+    field.int_val = 0;
+    field.float_val = 0.0;
+
+    if (text[0] == '@')
+    {
+        if ((text.size() < 2) || (text.find_first_not_of("0123456789", 1) != std::string::npos))
+        {
+            return false;
+        }
+        field.is_lti = true;
+        field.lti_id = static_cast<uint64_t>(strtoull(text.c_str() + 1, NULL, 10));
+        return (field.lti_id != NIL);
+    }
+    if ((text.size() > 2) && (text[0] == '<') && (text[text.size() - 1] == '>'))
+    {
+        field.is_lti = true;
+        field.text = text;
+        return true;
+    }
+    if ((text.size() >= 2) && (text[0] == '|') && (text[text.size() - 1] == '|'))
+    {
+        field.text = text.substr(1, text.size() - 2);
+        return true;
+    }
+
+    field.text = text;
+    if (smem_import_number_like(text))
+    {
+        errno = 0;
+        field.int_val = static_cast<int64_t>(strtoll(text.c_str(), &end, 10));
+        if ((*end == '\0') && (errno == 0))
+        {
+            field.const_type = INT_CONSTANT_SYMBOL_TYPE;
+            return true;
+        }
+
+        field.float_val = strtod(text.c_str(), &end);
+        if (*end == '\0')
+        {
+            field.const_type = FLOAT_CONSTANT_SYMBOL_TYPE;
+            return true;
+        }
+    }
+
+    return true;
+}
+
+/* --- splits a line of a triples file, skipping blank and comment lines;
+ *     returns false for a malformed line --- */
+static bool smem_import_parse_triple(const std::string& line, char separator, bool& is_triple, smem_import_field* fields, double& edge_weight)
+{
+    std::vector<std::string> columns;
+    std::string column;
+    std::istringstream line_stream(line);
+    char* end;
+
+    edge_weight = 0.0;
+    is_triple = false;
+
+    column = line;
+    smem_import_trim(column);
+    if (column.empty() || (column[0] == '#'))
+    {
+        return true;
+    }
+
+    while (std::getline(line_stream, column, separator))
+    {
+        columns.push_back(column);
+    }
+    if ((columns.size() < 3) || (columns.size() > 4))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (!smem_import_parse_field(columns[i], fields[i]))
+        {
+            return false;
+        }
+    }
+
+    // ids are LTIs, attributes are constants
+    if (!fields[0].is_lti || fields[1].is_lti)
+    {
+        return false;
+    }
+
+    if (columns.size() == 4)
+    {
+        smem_import_trim(columns[3]);
+        if (!fields[2].is_lti || columns[3].empty())
+        {
+            return false;
+        }
+        edge_weight = strtod(columns[3].c_str(), &end);
+        if (*end != '\0')
+        {
+            return false;
+        }
+    }
+
+    is_triple = true;
+    return true;
+}
+
+bool SMem_Manager::CLI_import(const char* file_name, std::string** err_msg, std::string** result_message)
+{
+    std::string name(file_name);
+    std::string extension;
+    smem_bulk_aug_list augs;
+    bool return_val;
+    uint64_t nodes_before;
+    uint64_t num_added = 0;
+
+    size_t dot = name.find_last_of('.');
+    size_t slash = name.find_last_of("/\\");
+    if ((dot != std::string::npos) && ((slash == std::string::npos) || (dot > slash)))
+    {
+        extension = name.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    }
+
+    std::ifstream file(file_name, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        (*err_msg)->append("Could not open file ");
+        (*err_msg)->append(name);
+        return false;
+    }
+
+    // parsing ltms requires an open semantic database
+    attach();
+    nodes_before = statistics->nodes->get_value();
+
+    // with lazy-commit on, a transaction is already open
+    if (settings->lazy_commit->get_value() == off)
+    {
+        SQL->begin->execute(soar_module::op_reinit);
+    }
+
+    if ((extension == "csv") || (extension == "tsv"))
+    {
+        file.close();
+        return_val = import_triples(file_name, ((extension == "csv") ? ',' : '\t'), augs, err_msg);
+    }
+    else
+    {
+        std::stringstream contents;
+        contents << file.rdbuf();
+        file.close();
+        return_val = import_clauses(contents.str().c_str(), augs, err_msg);
+    }
+
+    if (return_val)
+    {
+        num_added = bulk_load(augs);
+    }
+
+    if (settings->lazy_commit->get_value() == off)
+    {
+        SQL->commit->execute(soar_module::op_reinit);
+    }
+
+    if (return_val)
+    {
+        std::string num;
+
+        to_string(num_added, num);
+        (*result_message)->append("Imported ");
+        (*result_message)->append(num);
+        (*result_message)->append(" augmentations and ");
+        to_string(statistics->nodes->get_value() - nodes_before, num);
+        (*result_message)->append(num);
+        (*result_message)->append(" new LTIs into semantic memory.");
+    }
+
+    return return_val;
+}
+
+/* Parses the whole of a set of smem --add clauses before storing any of
+ * it, so that a bad clause leaves semantic memory as it was. */
+bool SMem_Manager::import_clauses(const char* text, smem_bulk_aug_list& augs, std::string** err_msg)
+{
+    bool good_ltm = true;
+    uint64_t clause_count = 0;
+
+    soar::Lexer lexer(thisAgent, text);
+
+    str_to_ltm_map ltms;
+    ltm_set newbies;
+    std::vector<ltm_object*> parsed;
+    std::unordered_set<ltm_object*> seen;
+
+    // consume next token
+    lexer.get_lexeme();
+
+    if (lexer.current_lexeme.type != L_PAREN_LEXEME)
+    {
+        good_ltm = false;
+    }
+
+    while ((lexer.current_lexeme.type == L_PAREN_LEXEME) && (good_ltm))
+    {
+        good_ltm = parse_add_clause(&lexer, &(ltms), &(newbies));
+
+        if (good_ltm)
+        {
+            // an ltm is a newbie of every clause that adds to it; its slots accumulate
+            for (ltm_set::iterator c_new = newbies.begin(); c_new != newbies.end(); c_new++)
+            {
+                if (seen.insert(*c_new).second)
+                {
+                    parsed.push_back(*c_new);
+                }
+            }
+            clause_count++;
+            newbies.clear();
+        }
+    }
+
+    if (good_ltm)
+    {
+        smem_bulk_aug aug;
+        ltm_slot_map::iterator s;
+        ltm_slot::iterator v;
+
+        // name all of the ltms, then flatten their slots
+        for (std::vector<ltm_object*>::iterator c = parsed.begin(); c != parsed.end(); c++)
+        {
+            if ((*c)->lti_id == NIL)
+            {
+                (*c)->lti_id = add_new_LTI();
+            }
+            else if (!lti_exists((*c)->lti_id))
+            {
+                add_specific_LTI((*c)->lti_id);
+            }
+        }
+
+        for (std::vector<ltm_object*>::iterator c = parsed.begin(); c != parsed.end(); c++)
+        {
+            if (!(*c)->slots)
+            {
+                continue;
+            }
+
+            aug.lti_id = (*c)->lti_id;
+            for (s = (*c)->slots->begin(); s != (*c)->slots->end(); s++)
+            {
+                aug.attr = hash(s->first);
+                for (v = s->second->begin(); v != s->second->end(); v++)
+                {
+                    if ((*v)->val_const.val_type == value_const_t)
+                    {
+                        aug.value_const = hash((*v)->val_const.val_value);
+                        aug.value_lti = SMEM_AUGMENTATIONS_NULL;
+                        aug.edge_weight = 0.0;
+                    }
+                    else
+                    {
+                        aug.value_const = SMEM_AUGMENTATIONS_NULL;
+                        aug.value_lti = (*v)->val_lti.val_value->lti_id;
+                        aug.edge_weight = (*v)->val_lti.edge_weight;
+                    }
+                    augs.push_back(aug);
+                }
+            }
+        }
+    }
+    else
+    {
+        std::string num;
+        to_string(clause_count, num);
+
+        (*err_msg)->append("Error parsing clause #");
+        (*err_msg)->append(num);
+    }
+
+    // deallocate contents, then each ltm once
+    for (std::vector<ltm_object*>::iterator c = parsed.begin(); c != parsed.end(); c++)
+    {
+        deallocate_ltm(*c, false);
+    }
+    for (str_to_ltm_map::iterator c_old = ltms.begin(); c_old != ltms.end(); c_old++)
+    {
+        if (seen.insert(c_old->second).second)
+        {
+            deallocate_ltm(c_old->second, false);
+            parsed.push_back(c_old->second);
+        }
+    }
+    for (std::vector<ltm_object*>::iterator c = parsed.begin(); c != parsed.end(); c++)
+    {
+        delete (*c);
+    }
+
+    return good_ltm;
+}
+
+/* Reads "id, attribute, value[, edge weight]" lines, checking all of them
+ * before storing any.  Ids and LTI values are written @<number> or
+ * <name>, names standing for new LTIs; values may be |quoted| strings. */
+bool SMem_Manager::import_triples(const char* file_name, char separator, smem_bulk_aug_list& augs, std::string** err_msg)
+{
+    std::ifstream file(file_name, std::ios::in | std::ios::binary);
+    std::string line;
+    uint64_t line_count = 0;
+    smem_import_field fields[3];
+    double edge_weight;
+    bool is_triple;
+
+    // check every line first
+    while (std::getline(file, line))
+    {
+        line_count++;
+        if (!smem_import_parse_triple(line, separator, is_triple, fields, edge_weight))
+        {
+            std::string num;
+            to_string(line_count, num);
+
+            (*err_msg)->append("Error parsing line #");
+            (*err_msg)->append(num);
+            return false;
+        }
+    }
+
+    std::unordered_map<std::string, uint64_t> lti_names;
+    std::unordered_set<uint64_t> known_ltis;
+    std::unordered_map<std::string, smem_hash_id> const_hashes[3];
+    smem_bulk_aug aug;
+
+    file.clear();
+    file.seekg(0);
+    while (std::getline(file, line))
+    {
+        smem_import_parse_triple(line, separator, is_triple, fields, edge_weight);
+        if (!is_triple)
+        {
+            continue;
+        }
+
+        uint64_t lti_ids[3] = { NIL, NIL, NIL };
+        smem_hash_id hashes[3] = { NIL, NIL, NIL };
+
+        for (int i = 0; i < 3; i++)
+        {
+            smem_import_field& field = fields[i];
+
+            if (field.is_lti && (field.lti_id == NIL))
+            {
+                std::unordered_map<std::string, uint64_t>::iterator p = lti_names.find(field.text);
+                if (p == lti_names.end())
+                {
+                    p = lti_names.insert(std::make_pair(field.text, add_new_LTI())).first;
+                    known_ltis.insert(p->second);
+                }
+                lti_ids[i] = p->second;
+            }
+            else if (field.is_lti)
+            {
+                if (known_ltis.insert(field.lti_id).second && !lti_exists(field.lti_id))
+                {
+                    add_specific_LTI(field.lti_id);
+                }
+                lti_ids[i] = field.lti_id;
+            }
+            else
+            {
+                // one cache per constant type, so that 5 and |5| differ
+                int type_index = ((field.const_type == INT_CONSTANT_SYMBOL_TYPE) ? 1 : ((field.const_type == FLOAT_CONSTANT_SYMBOL_TYPE) ? 2 : 0));
+                std::unordered_map<std::string, smem_hash_id>::iterator p = const_hashes[type_index].find(field.text);
+                if (p == const_hashes[type_index].end())
+                {
+                    smem_hash_id hash_value;
+                    switch (field.const_type)
+                    {
+                        case INT_CONSTANT_SYMBOL_TYPE:
+                            hash_value = hash_int(field.int_val);
+                            break;
+                        case FLOAT_CONSTANT_SYMBOL_TYPE:
+                            hash_value = hash_float(field.float_val);
+                            break;
+                        default:
+                            hash_value = hash_str(const_cast<char*>(field.text.c_str()));
+                            break;
+                    }
+                    p = const_hashes[type_index].insert(std::make_pair(field.text, hash_value)).first;
+                }
+                hashes[i] = p->second;
+            }
+        }
+
+        aug.lti_id = lti_ids[0];
+        aug.attr = hashes[1];
+        aug.value_const = (fields[2].is_lti ? SMEM_AUGMENTATIONS_NULL : hashes[2]);
+        aug.value_lti = (fields[2].is_lti ? lti_ids[2] : SMEM_AUGMENTATIONS_NULL);
+        aug.edge_weight = edge_weight;
+        augs.push_back(aug);
+    }
+
+    return true;
+}
+
+/* --- an LTI with augmentations in a bulk load --- */
+typedef struct smem_import_lti_struct
+{
+    uint64_t    lti_id;
+    size_t      first_aug;              // its new augmentations are [first_aug, last_aug)
+    size_t      last_aug;
+    uint64_t    existing_edges;
+    uint64_t    existing_lti_edges;
+    uint64_t    new_lti_edges;          // existing ones included
+    bool        weighted;               // some new LTI value came with an edge weight
+} smem_import_lti;
+
+/* Stores a batch of augmentations the way LTM_to_DB would store them one
+ * LTI at a time (appending, without activating), but with the indices on
+ * smem_augmentations dropped while inserting and the frequency tables
+ * recounted once at the end.  Returns the number of augmentations that
+ * were new. */
+uint64_t SMem_Manager::bulk_load(smem_bulk_aug_list& augs)
+{
+    std::vector<smem_import_lti> ltis;
+    size_t kept = 0;
+    double web_act = static_cast<double>(SMEM_ACT_LOW);
+    uint64_t thresh = static_cast<uint64_t>(settings->thresh->get_value());
+
+    std::stable_sort(augs.begin(), augs.end(), smem_import_aug_order);
+
+    // drop repeats and augmentations already stored, while the indices are
+    // still there to find them
+    for (size_t i = 0; i < augs.size(); i++)
+    {
+        const smem_bulk_aug aug = augs[i];
+
+        if (ltis.empty() || (ltis.back().lti_id != aug.lti_id))
+        {
+            smem_import_lti lti;
+
+            lti.lti_id = aug.lti_id;
+            lti.first_aug = lti.last_aug = kept;
+            lti.weighted = false;
+
+            SQL->act_lti_child_ct_get->bind_int(1, aug.lti_id);
+            SQL->act_lti_child_ct_get->execute();
+            lti.existing_edges = static_cast<uint64_t>(SQL->act_lti_child_ct_get->column_int(0));
+            SQL->act_lti_child_ct_get->reinitialize();
+
+            SQL->act_lti_child_lti_ct_get->bind_int(1, aug.lti_id);
+            SQL->act_lti_child_lti_ct_get->execute();
+            lti.existing_lti_edges = static_cast<uint64_t>(SQL->act_lti_child_lti_ct_get->column_int(0));
+            SQL->act_lti_child_lti_ct_get->reinitialize();
+
+            lti.new_lti_edges = lti.existing_lti_edges;
+            ltis.push_back(lti);
+        }
+
+        smem_import_lti& lti = ltis.back();
+
+        if ((kept > lti.first_aug) && smem_import_aug_same(augs[kept - 1], aug))
+        {
+            continue;
+        }
+
+        if (lti.existing_edges)
+        {
+            soar_module::sqlite_statement* q;
+
+            if (aug.value_lti == SMEM_AUGMENTATIONS_NULL)
+            {
+                // lti_id, attribute_s_id, val_const
+                q = SQL->web_const_child;
+                q->bind_int(3, aug.value_const);
+            }
+            else
+            {
+                // lti_id, attribute_s_id, val_lti
+                q = SQL->web_lti_child;
+                q->bind_int(3, aug.value_lti);
+            }
+            q->bind_int(1, aug.lti_id);
+            q->bind_int(2, aug.attr);
+            if (q->execute(soar_module::op_reinit) == soar_module::row)
+            {
+                continue;
+            }
+        }
+
+        if (aug.value_lti != SMEM_AUGMENTATIONS_NULL)
+        {
+            lti.new_lti_edges++;
+            if (aug.edge_weight != 0.0)
+            {
+                lti.weighted = true;
+            }
+        }
+        augs[kept++] = aug;
+        lti.last_aug = kept;
+    }
+    augs.resize(kept);
+
+    if (!augs.empty())
+    {
+        smem_statement_container::drop_augmentation_indices(DB);
+    }
+
+    for (std::vector<smem_import_lti>::iterator l = ltis.begin(); l != ltis.end(); l++)
+    {
+        for (size_t i = l->first_aug; i < l->last_aug; i++)
+        {
+            const smem_bulk_aug& aug = augs[i];
+
+            // lti_id, attribute_s_id, val_const, value_lti_id, activation_value, edge_weight
+            SQL->web_add->bind_int(1, l->lti_id);
+            SQL->web_add->bind_int(2, aug.attr);
+            SQL->web_add->bind_int(3, aug.value_const);
+            SQL->web_add->bind_int(4, aug.value_lti);
+            SQL->web_add->bind_double(5, web_act);
+            if (aug.value_lti == SMEM_AUGMENTATIONS_NULL)
+            {
+                SQL->web_add->bind_double(6, 0.0);
+            }
+            else if (aug.edge_weight != 0.0)
+            {
+                SQL->web_add->bind_double(6, aug.edge_weight);
+            }
+            else
+            {
+                SQL->web_add->bind_double(6, 1.0 / static_cast<double>(l->new_lti_edges));
+            }
+            SQL->web_add->execute(soar_module::op_reinit);
+            if (native_store)
+            {
+                native_store->add_augmentation(l->lti_id, aug.attr, aug.value_const, aug.value_lti, web_act);
+            }
+        }
+
+        // update edge counters
+        SQL->act_lti_child_ct_set->bind_int(1, l->existing_edges + (l->last_aug - l->first_aug));
+        SQL->act_lti_child_ct_set->bind_int(2, l->lti_id);
+        SQL->act_lti_child_ct_set->execute(soar_module::op_reinit);
+
+        SQL->act_lti_child_lti_ct_set->bind_int(1, l->new_lti_edges);
+        SQL->act_lti_child_lti_ct_set->bind_int(2, l->lti_id);
+        SQL->act_lti_child_lti_ct_set->execute(soar_module::op_reinit);
+
+        SQL->prohibit_add->bind_int(1, l->lti_id);
+        SQL->prohibit_add->execute(soar_module::op_reinit);
+    }
+
+    if (augs.empty())
+    {
+        return 0;
+    }
+
+    smem_statement_container::add_augmentation_indices(DB);
+    smem_statement_container::rebuild_frequencies(DB);
+
+    // what LTM_to_DB does to an LTI's older augmentations
+    for (std::vector<smem_import_lti>::iterator l = ltis.begin(); l != ltis.end(); l++)
+    {
+        uint64_t new_edges = l->existing_edges + (l->last_aug - l->first_aug);
+
+        // crossing the activation threshold
+        if (l->existing_edges && (l->existing_edges < thresh) && (new_edges >= thresh))
+        {
+            SQL->act_set->bind_double(1, web_act);
+            SQL->act_set->bind_int(2, l->lti_id);
+            SQL->act_set->execute(soar_module::op_reinit);
+            if (native_store)
+            {
+                native_store->set_activation(l->lti_id, web_act);
+            }
+        }
+
+        if (l->new_lti_edges != l->existing_lti_edges)
+        {
+            // a new fan for the older LTI values
+            if (l->existing_lti_edges && !l->weighted)
+            {
+                SQL->web_update_all_lti_child_edges->bind_double(1, 1.0 / static_cast<double>(l->new_lti_edges));
+                SQL->web_update_all_lti_child_edges->bind_int(2, l->lti_id);
+                SQL->web_update_all_lti_child_edges->execute(soar_module::op_reinit);
+            }
+
+            if (settings->spreading->get_value() == on)
+            {
+                std::map<uint64_t, int64_t> new_children;
+
+                for (size_t i = l->first_aug; i < l->last_aug; i++)
+                {
+                    if (augs[i].value_lti != SMEM_AUGMENTATIONS_NULL)
+                    {
+                        new_children[augs[i].value_lti]++;
+                    }
+                }
+                invalidate_trajectories(l->lti_id, &new_children);
+            }
+        }
+
+        invalidate_spread_children(l->lti_id);
+    }
+
+    statistics->edges->set_value(statistics->edges->get_value() + augs.size());
+
+    return augs.size();
+}
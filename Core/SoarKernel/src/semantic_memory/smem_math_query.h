@@ -12,6 +12,14 @@
 #undef min
 #undef max
 
+//Which value a query is met by first, for walking values in order
+enum MathQueryOrder
+{
+    MathQueryOrderNone,
+    MathQueryOrderHighest,
+    MathQueryOrderLowest
+};
+
 class MathQuery
 {
     public:
@@ -23,6 +31,18 @@ class MathQuery
         //Use this to record things like the new max values
         virtual void commit() = 0;
         virtual void rollback() = 0;
+        
+        //Every acceptable value lies within [low, high] (possibly a superset,
+        //valueIsAcceptable still has the final say)
+        virtual void acceptableRange(double& low, double& high)
+        {
+            low = -std::numeric_limits<double>::infinity();
+            high = std::numeric_limits<double>::infinity();
+        }
+        virtual MathQueryOrder valueOrder()
+        {
+            return MathQueryOrderNone;
+        }
 };
 
 class MathQueryLess: public MathQuery
@@ -64,6 +84,12 @@ class MathQueryLess: public MathQuery
             return value < longValue;
         }
         
+        void acceptableRange(double& low, double& high)
+        {
+            low = -std::numeric_limits<double>::infinity();
+            high = (isDouble ? doubleValue : static_cast<double>(longValue));
+        }
+        
         //There is no running data in this query
         void commit() {}
         void rollback() {}
@@ -108,6 +134,12 @@ class MathQueryGreater: public MathQuery
             return value > longValue;
         }
         
+        void acceptableRange(double& low, double& high)
+        {
+            low = (isDouble ? doubleValue : static_cast<double>(longValue));
+            high = std::numeric_limits<double>::infinity();
+        }
+        
         //There is no running data in this query
         void commit() {}
         void rollback() {}
@@ -151,6 +183,12 @@ class MathQueryLessOrEqual: public MathQuery
             return value <= longValue;
         }
         
+        void acceptableRange(double& low, double& high)
+        {
+            low = -std::numeric_limits<double>::infinity();
+            high = (isDouble ? doubleValue : static_cast<double>(longValue));
+        }
+        
         //There is no running data in this query
         void commit() {}
         void rollback() {}
@@ -195,6 +233,12 @@ class MathQueryGreaterOrEqual: public MathQuery
             return value >= longValue;
         }
         
+        void acceptableRange(double& low, double& high)
+        {
+            low = (isDouble ? doubleValue : static_cast<double>(longValue));
+            high = std::numeric_limits<double>::infinity();
+        }
+        
         //There is no running data in this query
         void commit() {}
         void rollback() {}
@@ -251,6 +295,11 @@ class MathQueryMax: public MathQuery
             return false;
         }
         
+        MathQueryOrder valueOrder()
+        {
+            return MathQueryOrderHighest;
+        }
+        
         void commit()
         {
             doubleValue = stagedDoubleValue;
@@ -314,6 +363,11 @@ class MathQueryMin: public MathQuery
             return false;
         }
         
+        MathQueryOrder valueOrder()
+        {
+            return MathQueryOrderLowest;
+        }
+        
         void commit()
         {
             doubleValue = stagedDoubleValue;
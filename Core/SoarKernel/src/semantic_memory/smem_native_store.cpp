@@ -0,0 +1,351 @@
+/*
+ * smem_native_store.cpp
+ *
+ *  In-memory copy of smem_augmentations that cue-based retrievals are
+ *  answered from.  See smem_native_store.h for an overview.
+ */
+
+#include "smem_native_store.h"
+
+#include "constants.h"
+
+#include <algorithm>
+
+SMem_Native_Store::~SMem_Native_Store()
+{
+    delete number_get;
+}
+
+void SMem_Native_Store::load(soar_module::sqlite_database* db)
+{
+    soar_module::sqlite_statement* q;
+    smem_native_aug aug;
+    uint64_t lti_id;
+    number_info info;
+
+    ltis.clear();
+    index.clear();
+    numbers_by_attr.clear();
+    number_infos.clear();
+    last_seq = 0;
+
+    // numbers first, so the augmentations can be filed by value
+    q = new soar_module::sqlite_statement(db, "SELECT s_id, symbol_value FROM smem_symbols_integer");
+    q->prepare();
+    info.is_number = true;
+    info.is_int = true;
+    while (q->execute() == soar_module::row)
+    {
+        info.int_value = q->column_int(1);
+        info.value = static_cast<double>(info.int_value);
+        number_infos[static_cast<smem_hash_id>(q->column_int(0))] = info;
+    }
+    delete q;
+
+    q = new soar_module::sqlite_statement(db, "SELECT s_id, symbol_value FROM smem_symbols_float");
+    q->prepare();
+    info.is_int = false;
+    info.int_value = 0;
+    while (q->execute() == soar_module::row)
+    {
+        info.value = q->column_double(1);
+        number_infos[static_cast<smem_hash_id>(q->column_int(0))] = info;
+    }
+    delete q;
+
+    // constants hashed later are looked up as they show up
+    delete number_get;
+    number_get = new soar_module::sqlite_statement(db, "SELECT t.symbol_type, i.symbol_value, f.symbol_value FROM smem_symbols_type t LEFT JOIN smem_symbols_integer i ON i.s_id=t.s_id LEFT JOIN smem_symbols_float f ON f.s_id=t.s_id WHERE t.s_id=?");
+    number_get->prepare();
+
+    q = new soar_module::sqlite_statement(db, "SELECT rowid, lti_id, attribute_s_id, value_constant_s_id, value_lti_id, activation_value FROM smem_augmentations ORDER BY rowid");
+    q->prepare();
+    while (q->execute() == soar_module::row)
+    {
+        aug.seq = static_cast<uint64_t>(q->column_int(0));
+        lti_id = static_cast<uint64_t>(q->column_int(1));
+        aug.attr = static_cast<smem_hash_id>(q->column_int(2));
+        aug.value_const = static_cast<smem_hash_id>(q->column_int(3));
+        aug.value_lti = static_cast<uint64_t>(q->column_int(4));
+        aug.activation = q->column_double(5);
+
+        ltis[lti_id].push_back(aug);
+        index_aug(lti_id, aug);
+        last_seq = aug.seq;
+    }
+    delete q;
+}
+
+const SMem_Native_Store::number_info& SMem_Native_Store::number_for(smem_hash_id value_hash)
+{
+    std::unordered_map<smem_hash_id, number_info>::iterator p = number_infos.find(value_hash);
+    number_info info;
+
+    if (p != number_infos.end())
+    {
+        return p->second;
+    }
+
+    info.is_number = false;
+    info.is_int = false;
+    info.int_value = 0;
+    info.value = 0.0;
+
+    number_get->bind_int(1, value_hash);
+    if (number_get->execute() == soar_module::row)
+    {
+        switch (number_get->column_int(0))
+        {
+            case INT_CONSTANT_SYMBOL_TYPE:
+                info.is_number = true;
+                info.is_int = true;
+                info.int_value = number_get->column_int(1);
+                info.value = static_cast<double>(info.int_value);
+                break;
+            case FLOAT_CONSTANT_SYMBOL_TYPE:
+                info.is_number = true;
+                info.value = number_get->column_double(2);
+                break;
+        }
+    }
+    number_get->reinitialize();
+
+    return (number_infos[value_hash] = info);
+}
+
+smem_native_candidate_list* SMem_Native_Store::list_for(smem_cue_element_type element_type, smem_hash_id attr, uint64_t value)
+{
+    smem_native_key key;
+
+    key.element_type = element_type;
+    key.attr = attr;
+    key.value = value;
+
+    return &(index[key]);
+}
+
+void SMem_Native_Store::index_aug(uint64_t lti_id, const smem_native_aug& aug)
+{
+    smem_native_candidate cand = { aug.activation, aug.seq, lti_id };
+
+    list_for(attr_t, aug.attr, 0)->insert(cand);
+    if (aug.value_lti == SMEM_AUGMENTATIONS_NULL)
+    {
+        list_for(value_const_t, aug.attr, aug.value_const)->insert(cand);
+
+        const number_info& info = number_for(aug.value_const);
+        if (info.is_number)
+        {
+            smem_native_number number = { info.value, info.is_int, info.int_value, aug.seq, lti_id, aug.activation };
+            numbers_by_attr[aug.attr].insert(number);
+        }
+    }
+    else
+    {
+        list_for(value_lti_t, aug.attr, aug.value_lti)->insert(cand);
+    }
+}
+
+void SMem_Native_Store::unindex_aug(uint64_t lti_id, const smem_native_aug& aug)
+{
+    smem_native_candidate cand = { aug.activation, aug.seq, lti_id };
+
+    list_for(attr_t, aug.attr, 0)->erase(cand);
+    if (aug.value_lti == SMEM_AUGMENTATIONS_NULL)
+    {
+        list_for(value_const_t, aug.attr, aug.value_const)->erase(cand);
+
+        const number_info& info = number_for(aug.value_const);
+        if (info.is_number)
+        {
+            smem_native_number number = { info.value, info.is_int, info.int_value, aug.seq, lti_id, aug.activation };
+            numbers_by_attr[aug.attr].erase(number);
+        }
+    }
+    else
+    {
+        list_for(value_lti_t, aug.attr, aug.value_lti)->erase(cand);
+    }
+}
+
+void SMem_Native_Store::add_augmentation(uint64_t lti_id, smem_hash_id attr, smem_hash_id value_const, uint64_t value_lti, double activation)
+{
+    smem_native_aug aug;
+
+    aug.attr = attr;
+    aug.value_const = value_const;
+    aug.value_lti = value_lti;
+    aug.seq = ++last_seq;
+    aug.activation = activation;
+
+    ltis[lti_id].push_back(aug);
+    index_aug(lti_id, aug);
+}
+
+void SMem_Native_Store::remove_augmentations(uint64_t lti_id)
+{
+    std::unordered_map<uint64_t, smem_native_aug_list>::iterator p = ltis.find(lti_id);
+
+    if (p != ltis.end())
+    {
+        for (smem_native_aug_list::iterator a = p->second.begin(); a != p->second.end(); a++)
+        {
+            unindex_aug(lti_id, *a);
+        }
+        ltis.erase(p);
+    }
+}
+
+void SMem_Native_Store::set_activation(uint64_t lti_id, double activation)
+{
+    std::unordered_map<uint64_t, smem_native_aug_list>::iterator p = ltis.find(lti_id);
+
+    if (p != ltis.end())
+    {
+        for (smem_native_aug_list::iterator a = p->second.begin(); a != p->second.end(); a++)
+        {
+            if (a->activation != activation)
+            {
+                unindex_aug(lti_id, *a);
+                a->activation = activation;
+                index_aug(lti_id, *a);
+            }
+        }
+    }
+}
+
+const smem_native_candidate_list* SMem_Native_Store::candidates(smem_cue_element_type element_type, smem_hash_id attr, smem_hash_id value_hash, uint64_t value_lti)
+{
+    smem_native_key key;
+    std::unordered_map<smem_native_key, smem_native_candidate_list, smem_native_key_hash>::iterator p;
+
+    key.element_type = element_type;
+    key.attr = attr;
+    key.value = (element_type == value_const_t) ? value_hash : ((element_type == value_lti_t) ? value_lti : 0);
+
+    p = index.find(key);
+    return ((p != index.end()) ? &(p->second) : NULL);
+}
+
+bool SMem_Native_Store::has_augmentation(uint64_t lti_id, smem_cue_element_type element_type, smem_hash_id attr, smem_hash_id value_hash, uint64_t value_lti)
+{
+    std::unordered_map<uint64_t, smem_native_aug_list>::iterator p = ltis.find(lti_id);
+
+    if (p != ltis.end())
+    {
+        for (smem_native_aug_list::iterator a = p->second.begin(); a != p->second.end(); a++)
+        {
+            if (a->attr != attr)
+            {
+                continue;
+            }
+            if ((element_type == attr_t) ||
+                    ((element_type == value_const_t) && (a->value_const == value_hash)) ||
+                    ((element_type == value_lti_t) && (a->value_const == SMEM_AUGMENTATIONS_NULL) && (a->value_lti == value_lti)))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+const smem_native_aug_list* SMem_Native_Store::augmentations(uint64_t lti_id)
+{
+    std::unordered_map<uint64_t, smem_native_aug_list>::iterator p = ltis.find(lti_id);
+
+    return ((p != ltis.end()) ? &(p->second) : NULL);
+}
+
+const smem_native_number_list* SMem_Native_Store::numbers(smem_hash_id attr)
+{
+    std::unordered_map<smem_hash_id, smem_native_number_list>::iterator p = numbers_by_attr.find(attr);
+
+    return ((p != numbers_by_attr.end()) ? &(p->second) : NULL);
+}
+
+bool SMem_Native_Store::numbers_in_range(smem_hash_id attr, double low, double high, uint64_t limit, smem_native_candidate_list& out)
+{
+    const smem_native_number_list* list = numbers(attr);
+    smem_native_number bound = { low, false, 0, 0, 0, 0.0 };
+    uint64_t count = 0;
+
+    out.clear();
+    if (!list)
+    {
+        return true;
+    }
+
+    // bound sorts ahead of every entry whose value is low
+    for (smem_native_number_list::const_iterator p = list->lower_bound(bound); (p != list->end()) && (p->value <= high); p++)
+    {
+        if (++count > limit)
+        {
+            out.clear();
+            return false;
+        }
+
+        smem_native_candidate cand = { p->activation, p->seq, p->lti_id };
+        out.insert(cand);
+    }
+
+    return true;
+}
+
+static bool smem_native_group_order(const smem_native_candidate& a, const smem_native_candidate& b)
+{
+    return smem_native_candidate_order()(a, b);
+}
+
+bool smem_candidate_cursor::next_number()
+{
+    if (started && (++group_pos < group.size()))
+    {
+        return true;
+    }
+
+    // gather the next run of equal values, most active first
+    group.clear();
+    group_pos = 0;
+    if (highest_first)
+    {
+        if (!started)
+        {
+            number_rpos = numbers->rbegin();
+        }
+        started = true;
+        if (number_rpos == numbers->rend())
+        {
+            return false;
+        }
+
+        const smem_native_number first = *number_rpos;
+        for (; (number_rpos != numbers->rend()) && smem_native_number_order::same_value(*number_rpos, first); number_rpos++)
+        {
+            smem_native_candidate cand = { number_rpos->activation, number_rpos->seq, number_rpos->lti_id };
+            group.push_back(cand);
+        }
+    }
+    else
+    {
+        if (!started)
+        {
+            number_pos = numbers->begin();
+        }
+        started = true;
+        if (number_pos == numbers->end())
+        {
+            return false;
+        }
+
+        const smem_native_number first = *number_pos;
+        for (; (number_pos != numbers->end()) && smem_native_number_order::same_value(*number_pos, first); number_pos++)
+        {
+            smem_native_candidate cand = { number_pos->activation, number_pos->seq, number_pos->lti_id };
+            group.push_back(cand);
+        }
+    }
+    std::sort(group.begin(), group.end(), smem_native_group_order);
+
+    return true;
+}
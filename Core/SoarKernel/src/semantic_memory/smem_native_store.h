@@ -0,0 +1,272 @@
+/*
+ * smem_native_store.h
+ *
+ *  In-memory copy of smem_augmentations that cue-based retrievals are
+ *  answered from.  See the comment at the end of the file.
+ */
+
+#ifndef CORE_SOARKERNEL_SRC_SEMANTIC_MEMORY_SMEM_NATIVE_STORE_H_
+#define CORE_SOARKERNEL_SRC_SEMANTIC_MEMORY_SMEM_NATIVE_STORE_H_
+
+#include "kernel.h"
+
+#include "soar_db.h"
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+typedef struct smem_native_aug_struct
+{
+    smem_hash_id    attr;
+    smem_hash_id    value_const;
+    uint64_t        value_lti;
+    uint64_t        seq;            // insertion order, standing in for the rowid
+    double          activation;
+} smem_native_aug;
+
+typedef std::vector<smem_native_aug> smem_native_aug_list;
+
+typedef struct smem_native_candidate_struct
+{
+    double          activation;
+    uint64_t        seq;
+    uint64_t        lti_id;
+} smem_native_candidate;
+
+/* --- same order as "ORDER BY activation_value DESC" over the augmentation
+ *     indices, which break ties newest row first --- */
+struct smem_native_candidate_order
+{
+    bool operator()(const smem_native_candidate& a, const smem_native_candidate& b) const
+    {
+        if (a.activation != b.activation)
+        {
+            return (a.activation > b.activation);
+        }
+        return (a.seq > b.seq);
+    }
+};
+
+typedef std::set<smem_native_candidate, smem_native_candidate_order> smem_native_candidate_list;
+
+/* --- a numeric constant value of some attribute --- */
+typedef struct smem_native_number_struct
+{
+    double          value;
+    bool            is_int;
+    int64_t         int_value;      // exact value of integers, which value may round
+    uint64_t        seq;
+    uint64_t        lti_id;
+    double          activation;     // not part of the ordering
+} smem_native_number;
+
+struct smem_native_number_order
+{
+    bool operator()(const smem_native_number& a, const smem_native_number& b) const
+    {
+        if (a.value != b.value)
+        {
+            return (a.value < b.value);
+        }
+        if (a.is_int != b.is_int)
+        {
+            return b.is_int;
+        }
+        if (a.int_value != b.int_value)
+        {
+            return (a.int_value < b.int_value);
+        }
+        return (a.seq < b.seq);
+    }
+
+    /* --- same constant, for grouping entries of equal value --- */
+    static bool same_value(const smem_native_number& a, const smem_native_number& b)
+    {
+        return ((a.value == b.value) && (a.is_int == b.is_int) && (a.int_value == b.int_value));
+    }
+};
+
+typedef std::set<smem_native_number, smem_native_number_order> smem_native_number_list;
+
+typedef struct smem_native_key_struct
+{
+    smem_cue_element_type   element_type;
+    smem_hash_id            attr;
+    uint64_t                value;
+
+    bool operator==(const smem_native_key_struct& other) const
+    {
+        return ((element_type == other.element_type) && (attr == other.attr) && (value == other.value));
+    }
+} smem_native_key;
+
+struct smem_native_key_hash
+{
+    size_t operator()(const smem_native_key& key) const
+    {
+        return static_cast<size_t>((key.attr * 0x9E3779B97F4A7C15ull) ^ (key.value * 0xC2B2AE3D27D4EB4Full) ^ static_cast<uint64_t>(key.element_type));
+    }
+};
+
+class SMem_Native_Store
+{
+    public:
+
+        SMem_Native_Store() { last_seq = 0; number_get = NULL; };
+        ~SMem_Native_Store();
+
+        /* --- copies smem_augmentations; the store is kept up to date by
+         *     mirroring every later change to that table --- */
+        void                                load(soar_module::sqlite_database* db);
+
+        void                                add_augmentation(uint64_t lti_id, smem_hash_id attr, smem_hash_id value_const, uint64_t value_lti, double activation);
+        void                                remove_augmentations(uint64_t lti_id);
+        void                                set_activation(uint64_t lti_id, double activation);
+
+        /* --- LTIs with an augmentation matching a cue element, most active first --- */
+        const smem_native_candidate_list*   candidates(smem_cue_element_type element_type, smem_hash_id attr, smem_hash_id value_hash, uint64_t value_lti);
+
+        bool                                has_augmentation(uint64_t lti_id, smem_cue_element_type element_type, smem_hash_id attr, smem_hash_id value_hash, uint64_t value_lti);
+        const smem_native_aug_list*         augmentations(uint64_t lti_id);
+
+        /* --- numeric values of an attribute, in increasing order --- */
+        const smem_native_number_list*      numbers(smem_hash_id attr);
+
+        /* --- fills out with the LTIs that have a numeric value of attr in
+         *     [low, high]; gives up, returning false, past limit entries --- */
+        bool                                numbers_in_range(smem_hash_id attr, double low, double high, uint64_t limit, smem_native_candidate_list& out);
+
+    private:
+
+        /* --- what a constant's hash stands for, as far as ordering goes --- */
+        typedef struct number_info_struct
+        {
+            bool        is_number;
+            bool        is_int;
+            int64_t     int_value;
+            double      value;
+        } number_info;
+
+        std::unordered_map<uint64_t, smem_native_aug_list>                                      ltis;
+        std::unordered_map<smem_native_key, smem_native_candidate_list, smem_native_key_hash>   index;
+        uint64_t                                                                                last_seq;
+
+        std::unordered_map<smem_hash_id, smem_native_number_list>                               numbers_by_attr;
+        std::unordered_map<smem_hash_id, number_info>                                           number_infos;
+        soar_module::sqlite_statement*                                                          number_get;
+
+        const number_info&                  number_for(smem_hash_id value_hash);
+        smem_native_candidate_list*         list_for(smem_cue_element_type element_type, smem_hash_id attr, uint64_t value);
+        void                                index_aug(uint64_t lti_id, const smem_native_aug& aug);
+        void                                unindex_aug(uint64_t lti_id, const smem_native_aug& aug);
+};
+
+/* Walks the candidates for a cue element either from an SQL crawl
+ * (lti_id, activation_value), from a native candidate list, or from the
+ * numeric values of an attribute, highest or lowest value first (equal
+ * values most active first). */
+class smem_candidate_cursor
+{
+    public:
+
+        smem_candidate_cursor(soar_module::sqlite_statement* pStmt): stmt(pStmt), list(NULL), numbers(NULL), highest_first(false), group_pos(0), started(false) {};
+        smem_candidate_cursor(const smem_native_candidate_list* pList): stmt(NULL), list(pList), numbers(NULL), highest_first(false), group_pos(0), started(false) {};
+        smem_candidate_cursor(const smem_native_number_list* pNumbers, bool pHighestFirst): stmt(NULL), list(NULL), numbers(pNumbers), highest_first(pHighestFirst), group_pos(0), started(false) {};
+
+        /* --- whether candidates come in order of value rather than activation --- */
+        bool        value_ordered() { return (numbers != NULL); }
+
+        bool next()
+        {
+            if (stmt)
+            {
+                return (stmt->execute() == soar_module::row);
+            }
+            if (numbers)
+            {
+                return next_number();
+            }
+            if (!list)
+            {
+                return false;
+            }
+            if (started)
+            {
+                ++pos;
+            }
+            else
+            {
+                pos = list->begin();
+                started = true;
+            }
+            return (pos != list->end());
+        }
+
+        uint64_t    lti_id() { return (stmt ? static_cast<uint64_t>(stmt->column_int(0)) : (numbers ? group[group_pos].lti_id : pos->lti_id)); }
+        double      activation() { return (stmt ? stmt->column_double(1) : (numbers ? group[group_pos].activation : pos->activation)); }
+
+        void reset()
+        {
+            if (stmt)
+            {
+                stmt->reinitialize();
+            }
+            started = false;
+            group.clear();
+        }
+
+    private:
+
+        soar_module::sqlite_statement*                  stmt;
+        const smem_native_candidate_list*               list;
+        smem_native_candidate_list::const_iterator      pos;
+        const smem_native_number_list*                  numbers;
+        bool                                            highest_first;
+        smem_native_number_list::const_iterator         number_pos;
+        smem_native_number_list::const_reverse_iterator number_rpos;
+        std::vector<smem_native_candidate>              group;
+        size_t                                          group_pos;
+        bool                                            started;
+
+        bool                                            next_number();
+};
+
+#endif /* CORE_SOARKERNEL_SRC_SEMANTIC_MEMORY_SMEM_NATIVE_STORE_H_ */
+
+/* ======================================================================
+                           smem_native_store.h
+
+   Every cue-based retrieval walks the LTIs that have the cue's most
+   selective element, in decreasing order of activation, and checks each
+   one against the rest of the cue.  With only SQLite, that is one
+   prepared statement step per candidate plus one indexed lookup per
+   candidate per cue element, even when the database is in memory.
+
+   When the native-store setting is on, SMem_Manager keeps a copy of
+   smem_augmentations in two shapes:
+
+     - per LTI, the list of its augmentations, which answers the "does
+       this candidate have the rest of the cue" checks, and
+     - per cue element (attribute, attribute/constant or attribute/LTI),
+       an ordered set of the LTIs with that augmentation, sorted the way
+       the web crawl queries sort them, which replaces the crawl.
+
+   The database is still the store of record: the store is filled from
+   it when semantic memory is initialized, every write to
+   smem_augmentations is mirrored here, and nothing else is cached, so
+   saving, backups and the other smem commands are unchanged.
+
+   Constants that are numbers are also kept per attribute in a set ordered
+   by value, so that math queries do not have to test every LTI with the
+   attribute.  A max or min query walks that set from the top or bottom
+   and stops at the first LTI that meets the whole cue; a range query
+   (less, greater, ...) walks only the LTIs whose value is in range, most
+   active first, whenever there are fewer of them than candidates for the
+   most selective cue element.  Integers are ordered by their value as a
+   double and then exactly, and the math query itself still vets every
+   value, so the bounds can afford to be loose.  Queries
+   with spreading activation on still crawl through SQLite, since the
+   spread activations live in their own tables, but use the native
+   lists for the per-candidate checks.
+====================================================================== */
@@ -7,6 +7,7 @@
 
 #include "semantic_memory.h"
 #include "smem_db.h"
+#include "smem_native_store.h"
 #include "smem_math_query.h"
 #include "smem_timers.h"
 #include "smem_settings.h"
@@ -392,6 +393,29 @@ std::pair<bool, bool>* SMem_Manager::processMathQuery(Symbol* mathQuery, smem_pr
     return result;
 }
 
+//checks one stored value of a math query's attribute against the query
+bool SMem_Manager::math_query_value_met(MathQuery* mathQuery, smem_hash_id value_hash)
+{
+    bool met = false;
+
+    SQL->hash_rev_type->bind_int(1, value_hash);
+    if (SQL->hash_rev_type->execute() == soar_module::row)
+    {
+        switch (SQL->hash_rev_type->column_int(1 - 1))
+        {
+            case FLOAT_CONSTANT_SYMBOL_TYPE:
+                met = mathQuery->valueIsAcceptable(rhash__float(value_hash));
+                break;
+            case INT_CONSTANT_SYMBOL_TYPE:
+                met = mathQuery->valueIsAcceptable(rhash__int(value_hash));
+                break;
+        }
+    }
+    SQL->hash_rev_type->reinitialize();
+
+    return met;
+}
+
 uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Symbol* negquery, Symbol* mathQuery, id_set* prohibit, wme_set& cue_wmes, symbol_triple_list& meta_wmes, symbol_triple_list& retrieval_wmes, smem_query_levels query_level, uint64_t number_to_retrieve , std::list<uint64_t>* match_ids, uint64_t depth, smem_install_type install_type)
 {
     //Under the philosophy that activation only matters in the service of a query, we defer processing prohibits until now..
@@ -528,6 +552,46 @@ uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Sy
                 }
             }
 
+            // a lone math element can instead dictate the candidates through
+            // the ordered numeric values of its attribute: max/min walk them
+            // from the extreme down, range queries walk just the ones in range
+            smem_weighted_cue_list::iterator math_set = weighted_cue.end();
+            smem_native_candidate_list math_range;
+            bool math_by_value = false;
+            bool math_by_range = false;
+            if (native_store && (settings->spreading->get_value() == off) &&
+                    !((settings->activation_mode->get_value() == smem_param_container::act_base) && (settings->base_update->get_value() == smem_param_container::bupt_naive)))
+            {
+                int math_elements = 0;
+                for (next_element = weighted_cue.begin(); next_element != weighted_cue.end(); next_element++)
+                {
+                    if ((*next_element)->mathElement != NIL)
+                    {
+                        math_set = next_element;
+                        math_elements++;
+                    }
+                }
+
+                if ((math_elements == 1) && native_store->numbers((*math_set)->attr_hash))
+                {
+                    if ((*math_set)->mathElement->valueOrder() != MathQueryOrderNone)
+                    {
+                        math_by_value = true;
+                    }
+                    else
+                    {
+                        double low, high;
+                        (*math_set)->mathElement->acceptableRange(low, high);
+                        math_by_range = native_store->numbers_in_range((*math_set)->attr_hash, low, high, (*cand_set)->weight, math_range);
+                    }
+
+                    if (math_by_value || math_by_range)
+                    {
+                        cand_set = math_set;
+                    }
+                }
+            }
+
             timers->query->stop();
 
             if (settings->spreading->get_value() == on)
@@ -568,33 +632,52 @@ uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Sy
                 // confirmation walk
                 if (settings->base_update->get_value() == smem_param_container::bupt_naive)
                 {
-                    q =setup_web_crawl((*cand_set));
+                    smem_candidate_cursor crawl = (native_store ?
+                        smem_candidate_cursor(native_store->candidates((*cand_set)->element_type, (*cand_set)->attr_hash, (*cand_set)->value_hash, (*cand_set)->value_lti)) :
+                        smem_candidate_cursor(setup_web_crawl((*cand_set))));
 
                     // queue up distinct lti's to update
                     // - set because queries could contain wilds
                     // - not in loop because the effects of activation may actually
                     //   alter the resultset of the query (isolation???)
                     std::set< uint64_t > to_update;
-                    while (q->execute() == soar_module::row)
+                    while (crawl.next())
                     {
-                        to_update.insert(q->column_int(0));
+                        to_update.insert(crawl.lti_id());
                     }
+                    crawl.reset();
 
                     for (std::set< uint64_t >::iterator it = to_update.begin(); it != to_update.end(); it++)
                     {
                         lti_activate((*it), false);
                     }
-
-                    q->reinitialize();
                 }
             }
 
             // setup first query, which is sorted on activation already
-            q =setup_web_crawl_without_spread((*cand_set));
+            // (the native lists can only stand in for it while nothing has
+            // been moved into the spread activation table)
+            smem_candidate_cursor crawl(static_cast<soar_module::sqlite_statement*>(NULL));
+            if (math_by_value)
+            {
+                crawl = smem_candidate_cursor(native_store->numbers((*cand_set)->attr_hash), ((*cand_set)->mathElement->valueOrder() == MathQueryOrderHighest));
+            }
+            else if (math_by_range)
+            {
+                crawl = smem_candidate_cursor(&math_range);
+            }
+            else if (native_store && (settings->spreading->get_value() == off))
+            {
+                crawl = smem_candidate_cursor(native_store->candidates((*cand_set)->element_type, (*cand_set)->attr_hash, (*cand_set)->value_hash, (*cand_set)->value_lti));
+            }
+            else
+            {
+                crawl = smem_candidate_cursor(setup_web_crawl_without_spread((*cand_set)));
+            }
             thisAgent->lastCue = new agent::BasicWeightedCue((*cand_set)->cue_element, (*cand_set)->weight);
 
             // this becomes the minimal set to walk (till match or fail)
-            bool rows = q->execute() == soar_module::row;
+            bool rows = crawl.next();
             if (rows || settings->spreading->get_value() == on)
             {
                 smem_prioritized_activated_lti_queue plentiful_parents;
@@ -602,14 +685,14 @@ uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Sy
                 bool use_db = false;
                 bool has_feature = false;
 
-                while (more_rows && (q->column_double(1) == static_cast<double>(SMEM_ACT_MAX)))
+                while (more_rows && !crawl.value_ordered() && (crawl.activation() == static_cast<double>(SMEM_ACT_MAX)))
                 {
-                    SQL->act_lti_get->bind_int(1, q->column_int(0));
+                    SQL->act_lti_get->bind_int(1, crawl.lti_id());
                     SQL->act_lti_get->execute();
-                    plentiful_parents.push(std::make_pair< double, uint64_t >(SQL->act_lti_get->column_double(2), q->column_int(0)));
+                    plentiful_parents.push(std::make_pair< double, uint64_t >(SQL->act_lti_get->column_double(2), crawl.lti_id()));
                     SQL->act_lti_get->reinitialize();
 
-                    more_rows = (q->execute() == soar_module::row);
+                    more_rows = crawl.next();
                 }
                 if (thisAgent->SMem->settings->spreading->get_value() == on)
                 {
@@ -638,14 +721,14 @@ uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Sy
                         }
                         else
                         {
-                            use_db = (q->column_double(1) >  plentiful_parents.top().first);
+                            use_db = (crawl.activation() >  plentiful_parents.top().first);
                         }
 
                         if (use_db)
                         {
-                            cand = q->column_int(0);
-                            cand_act = q->column_double(1);
-                            more_rows = (q->execute() == soar_module::row);
+                            cand = crawl.lti_id();
+                            cand_act = crawl.activation();
+                            more_rows = crawl.next();
                         }
                         else
                         {
@@ -670,6 +753,36 @@ uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Sy
                                 continue;
                             }
 
+                            if (native_store)
+                            {
+                                bool mathQueryMet = false;
+                                if ((*next_element)->mathElement != NIL)
+                                {
+                                    const smem_native_aug_list* augs = native_store->augmentations(cand);
+                                    if (augs)
+                                    {
+                                        for (smem_native_aug_list::const_iterator a = augs->begin(); a != augs->end(); a++)
+                                        {
+                                            if ((a->attr == (*next_element)->attr_hash) && (a->value_lti == SMEM_AUGMENTATIONS_NULL))
+                                            {
+                                                mathQueryMet |= math_query_value_met((*next_element)->mathElement, a->value_const);
+                                            }
+                                        }
+                                    }
+                                    good_cand = mathQueryMet;
+                                }
+                                else
+                                {
+                                    has_feature = native_store->has_augmentation(cand, (*next_element)->element_type, (*next_element)->attr_hash, (*next_element)->value_hash, (*next_element)->value_lti);
+                                    good_cand = (((*next_element)->pos_element) ? (has_feature) : (!has_feature));
+                                }
+                                if (!good_cand)
+                                {
+                                    break;
+                                }
+                                continue;
+                            }
+
                             if ((*next_element)->element_type == attr_t)
                             {
                                 // parent=? AND attribute_s_id=?
@@ -698,26 +811,7 @@ uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Sy
                             {
                                 do
                                 {
-                                    smem_hash_id valueHash = q2->column_int(2 - 1);
-                                    SQL->hash_rev_type->bind_int(1, valueHash);
-
-                                    if (SQL->hash_rev_type->execute() != soar_module::row)
-                                    {
-                                        good_cand = false;
-                                    }
-                                    else
-                                    {
-                                        switch (SQL->hash_rev_type->column_int(1 - 1))
-                                        {
-                                            case FLOAT_CONSTANT_SYMBOL_TYPE:
-                                                mathQueryMet |= (*next_element)->mathElement->valueIsAcceptable(rhash__float(valueHash));
-                                                break;
-                                            case INT_CONSTANT_SYMBOL_TYPE:
-                                                mathQueryMet |= (*next_element)->mathElement->valueIsAcceptable(rhash__int(valueHash));
-                                                break;
-                                        }
-                                    }
-                                    SQL->hash_rev_type->reinitialize();
+                                    mathQueryMet |= math_query_value_met((*next_element)->mathElement, q2->column_int(2 - 1));
                                 }
                                 while (q2->execute() == soar_module::row);
                                 good_cand = mathQueryMet;
@@ -762,6 +856,12 @@ uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Sy
                                 }
                             }
                         }
+
+                        // in order of value, nothing after the first match can beat it
+                        if (good_cand && crawl.value_ordered())
+                        {
+                            break;
+                        }
                     }
                 }
     //            if (!match_ids->empty())
@@ -769,7 +869,7 @@ uint64_t SMem_Manager::process_query(Symbol* state, std::list<Symbol*> query, Sy
     //                king_id = match_ids->front();
     //            }
             }
-            q->reinitialize();
+            crawl.reset();
 
             // clean weighted cue
             for (next_element = weighted_cue.begin(); next_element != weighted_cue.end(); next_element++)
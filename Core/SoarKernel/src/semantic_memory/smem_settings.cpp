@@ -70,6 +70,10 @@ smem_param_container::smem_param_container(agent* new_agent): soar_module::param
     opt->add_mapping(opt_speed, "performance");
     add(opt);
 
+    // native store - answer cue-based retrievals from in-memory copies of the augmentations
+    native_store = new soar_module::boolean_param("native-store", on, new smem_db_predicate<boolean>(thisAgent));
+    add(native_store);
+
     // thresh
     thresh = new soar_module::integer_param("thresh", 100, new soar_module::predicate<int64_t>(), new smem_db_predicate<int64_t>(thisAgent));
     add(thresh);
@@ -335,6 +339,7 @@ void smem_param_container::print_settings(agent* thisAgent)
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("smem --backup","<filename>", 55).c_str(), "Saves a copy of database");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("smem --clear","", 55).c_str(), "Deletes all semantic knowledge");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("smem --export","<filename> [<LTI>]", 55).c_str(), "Export database to text file");
+    outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("smem --import","<filename>", 55).c_str(), "Bulk load concepts from a file");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("smem --init ","", 55).c_str(), "Reinitialize semantic memory store");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("smem --query ","{(cue)* [<num>]}", 55).c_str(), "Query for concepts in semantic store matching cue");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("smem --remove","{ (id [^attr [value]])* }", 55).c_str(), "Remove semantic memory structures");
@@ -365,6 +370,7 @@ void smem_param_container::print_settings(agent* thisAgent)
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("optimization", opt->get_string(), 55).c_str(), "safety, performance");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("cache-size", cache_size->get_string(), 55).c_str(), "Number of memory pages used for SQLite cache");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("page-size", page_size->get_string(), 55).c_str(), "Size of each memory page used");
+    outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("native-store", native_store->get_string(), 55).c_str(), "Answer queries from in-memory copy of store");
     outputManager->printa(thisAgent, "----------------- Timers and Statistics ---------------\n");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("timers <detail>", timers->get_string(), 55).c_str(), "How detailed timers should be (use --set)");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("smem --timers ","[<timer>]", 55).c_str(), "Print timer summary or specific statistic");
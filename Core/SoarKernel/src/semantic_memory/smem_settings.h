@@ -34,6 +34,7 @@ class smem_param_container: public soar_module::param_container
         soar_module::constant_param<page_choices>* page_size;
         soar_module::integer_param* cache_size;
         soar_module::constant_param<opt_choices>* opt;
+        soar_module::boolean_param* native_store;
 
         soar_module::integer_param* thresh;
 
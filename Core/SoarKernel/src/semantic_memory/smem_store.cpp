@@ -7,6 +7,7 @@
 
 #include "semantic_memory.h"
 #include "smem_db.h"
+#include "smem_native_store.h"
 #include "smem_stats.h"
 #include "smem_settings.h"
 
@@ -177,6 +178,11 @@ void SMem_Manager::disconnect_ltm(uint64_t pLTI_ID, std::map<uint64_t, uint64_t>
     {
         SQL->web_truncate->bind_int(1, pLTI_ID);
         SQL->web_truncate->execute(soar_module::op_reinit);
+        if (native_store)
+        {
+            native_store->remove_augmentations(pLTI_ID);
+        }
+        invalidate_spread_children(pLTI_ID);
     }
 }
 
@@ -187,6 +193,8 @@ void SMem_Manager::LTM_to_DB(uint64_t pLTI_ID, ltm_slot_map* children, bool remo
     assert(pLTI_ID);
     std::map<uint64_t, uint64_t>* old_children = NULL;
     std::map<uint64_t, int64_t>* new_children = NULL;
+    // the children and edge weights of this lti may change below
+    invalidate_spread_children(pLTI_ID);
     if (settings->spreading->get_value() == on)
     {
         new_children = new std::map<uint64_t, int64_t>();
@@ -420,6 +428,10 @@ void SMem_Manager::LTM_to_DB(uint64_t pLTI_ID, ltm_slot_map* children, bool remo
                 SQL->act_set->bind_double(1, web_act);
                 SQL->act_set->bind_int(2, pLTI_ID);
                 SQL->act_set->execute(soar_module::op_reinit);
+                if (native_store)
+                {
+                    native_store->set_activation(pLTI_ID, web_act);
+                }
             }
         }
     }
@@ -473,6 +485,10 @@ void SMem_Manager::LTM_to_DB(uint64_t pLTI_ID, ltm_slot_map* children, bool remo
                     SQL->web_add->bind_double(5, web_act);
                     SQL->web_add->bind_double(6, 0.0);
                     SQL->web_add->execute(soar_module::op_reinit);
+                    if (native_store)
+                    {
+                        native_store->add_augmentation(pLTI_ID, p->first, p->second, SMEM_AUGMENTATIONS_NULL, web_act);
+                    }
                 }
 
                 // update counter
@@ -525,6 +541,10 @@ void SMem_Manager::LTM_to_DB(uint64_t pLTI_ID, ltm_slot_map* children, bool remo
                         SQL->web_add->bind_double(6, 1.0/((double)new_lti_edges));
                     }
                     SQL->web_add->execute(soar_module::op_reinit);
+                    if (native_store)
+                    {
+                        native_store->add_augmentation(pLTI_ID, p->first, SMEM_AUGMENTATIONS_NULL, p->second, web_act);
+                    }
                 }
 
                 // update counter
@@ -13,6 +13,7 @@
 #include "stl_typedefs.h"
 
 #include <queue>
+#include <vector>
 
 typedef struct smem_data_struct
 {   uint64_t                last_cmd_time[2];          // last update to smem.command
@@ -100,4 +101,15 @@ typedef union ltm_value_union
     struct ltm_value_lti         val_lti;
 } ltm_value;
 
+/* --- one augmentation of a bulk load (smem --import) --- */
+typedef struct smem_bulk_aug_struct
+{   uint64_t                lti_id;
+    smem_hash_id            attr;
+    smem_hash_id            value_const;    // SMEM_AUGMENTATIONS_NULL for LTI values
+    uint64_t                value_lti;      // SMEM_AUGMENTATIONS_NULL for constants
+    double                  edge_weight;    // 0 unless one was given
+} smem_bulk_aug;
+
+typedef std::vector<smem_bulk_aug> smem_bulk_aug_list;
+
 #endif /* CORE_SOARKERNEL_SRC_SEMANTIC_MEMORY_SMEM_STRUCTS_H_ */
@@ -127,7 +127,7 @@ void load_param_container::print_settings(agent* thisAgent)
     outputManager->printa(thisAgent,    "------------------------------------------------------------\n");
     outputManager->printa_sf(thisAgent, "load library %-<filename> <args...>\n");
     outputManager->printa(thisAgent,    "------------------------------------------------------------\n");
-    outputManager->printa_sf(thisAgent, "load rete-network %---load <filename>\n");
+    outputManager->printa_sf(thisAgent, "load rete-network %---load <filename> [--add]\n");
     outputManager->printa(thisAgent,    "------------------------------------------------------------\n");
     outputManager->printa_sf(thisAgent, "load percepts %---open <filename>\n");
     outputManager->printa_sf(thisAgent, "load percepts %---close\n");
@@ -111,6 +111,7 @@
 #define SMEM_ACT_HISTORY_ENTRIES 10
 #define SMEM_ACT_LOW -1000000000
 #define SMEM_SCHEMA_VERSION "3.0"
+#define SMEM_SPREAD_CHILDREN_LIMIT 65536   /* LTIs whose children spreading keeps across cycles */
 
 
 /* -------------------------------------------------- */
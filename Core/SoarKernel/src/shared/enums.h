@@ -256,6 +256,7 @@ MP_instantiation,
 MP_chunk_cond,
 MP_preference,
 MP_wme,
+MP_wme_cold,
 MP_output_link,
 MP_io_wme,
 MP_slot,
@@ -280,7 +281,6 @@ MP_rl_info,
 MP_rl_et,
 MP_rl_rule,
 MP_wma_decay_element,
-MP_wma_decay_set,
 MP_wma_wme_oset,
 MP_wma_slot_refs,
 MP_epmem_wmes,
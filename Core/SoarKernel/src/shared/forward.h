@@ -64,6 +64,7 @@ class wma_timer_container;
 typedef uint64_t wma_d_cycle;
 typedef uint64_t wma_reference;
 typedef struct wma_decay_element_struct wma_decay_element;
+class wma_forget_wheel;
 typedef struct wme_struct wme;
 
 class Output_Manager;
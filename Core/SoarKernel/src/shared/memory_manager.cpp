@@ -39,8 +39,12 @@
    number, must be prime */
 #define DEFAULT_BLOCK_SIZE 0x7FF0   /* about 32K bytes per block */
 
+MemoryPoolOwnership                 Memory_Manager::pool_ownership = MPO_shared;
+SOAR_THREAD_LOCAL Memory_Manager*   Memory_Manager::active_MPM = NIL;
+
 Memory_Manager::Memory_Manager()
 {
+    memory_pools_in_use = NIL;
     memory_for_usage_overhead = memory_for_usage + STATS_OVERHEAD_MEM_USAGE;
 
     for (int i = 0; i < NUM_MEM_USAGE_CODES; i++)
@@ -69,6 +73,31 @@ Memory_Manager::~Memory_Manager()
     dyn_memory_pools.clear();
 }
 
+/* Returns the MPM a new agent should use.  In shared mode that is the
+ * process-wide singleton; otherwise the agent gets a private one that
+ * must be released with Destroy_Agent_MPM after the agent is gone. */
+Memory_Manager* Memory_Manager::Create_Agent_MPM()
+{
+    if (pool_ownership == MPO_shared)
+    {
+        return &Get_MPM();
+    }
+    return new Memory_Manager();
+}
+
+void Memory_Manager::Destroy_Agent_MPM(Memory_Manager* pMPM)
+{
+    if (!pMPM || pMPM->is_shared())
+    {
+        return;
+    }
+    if (active_MPM == pMPM)
+    {
+        active_MPM = NIL;
+    }
+    delete pMPM;
+}
+
 void Memory_Manager::init_memory_pool_by_ptr(memory_pool* pThisPool, size_t item_size, const char* name)
 {
     if (pThisPool->initialized) return;
@@ -24,6 +24,14 @@
  * - Agent caches a pointer to MPM to ease access.  Also made
  *   refactoring slightly less painful.
  *
+ * - Pool ownership can be switched to MPO_agent before agents are
+ *   created.  Each new agent then gets its own Memory_Manager, so
+ *   allocate_with_pool/free_with_pool on thisAgent->memoryManager
+ *   never touch another agent's free lists.  The STL pool allocators
+ *   resolve to the "active" MPM of the current thread, which is the
+ *   agent's MPM while an Agent_MPM_Scope for it is alive and the
+ *   process-wide MPM otherwise.
+ *
  * =======================================================================
  */
 
@@ -47,6 +55,19 @@
 
 #define NUM_MEM_USAGE_CODES 5
 
+/* MSVC 2013 does not support the C++11 thread_local keyword */
+#if defined(_MSC_VER) && (_MSC_VER < 1900)
+    #define SOAR_THREAD_LOCAL __declspec(thread)
+#else
+    #define SOAR_THREAD_LOCAL thread_local
+#endif
+
+enum MemoryPoolOwnership
+{
+    MPO_shared,     /* All agents share the process-wide MPM (default) */
+    MPO_agent       /* Each agent owns its own MPM and pools */
+};
+
 typedef struct memory_pool_struct
 {
     void* free_list;             /* header of chain of free items */
@@ -124,6 +145,27 @@ class Memory_Manager
             static Memory_Manager instance;
             return instance;
         }
+
+        /* Agent-owned MPMs are created through this so that the shared one stays a singleton */
+        static Memory_Manager* Create_Agent_MPM();
+        static void Destroy_Agent_MPM(Memory_Manager* pMPM);
+
+        /* The MPM used by STL pool allocators created on this thread */
+        static Memory_Manager* Get_Active_MPM()
+        {
+            return active_MPM ? active_MPM : &Get_MPM();
+        }
+        static Memory_Manager* Set_Active_MPM(Memory_Manager* pMPM)
+        {
+            Memory_Manager* lPrevious = active_MPM;
+            active_MPM = pMPM;
+            return lPrevious;
+        }
+
+        static void set_pool_ownership(MemoryPoolOwnership pOwnership) { pool_ownership = pOwnership; }
+        static MemoryPoolOwnership get_pool_ownership() { return pool_ownership; }
+        bool is_shared() { return (this == &Get_MPM()); }
+
         virtual ~Memory_Manager();
 
         void init_memory_pool(MemoryPoolType mempool_index, size_t item_size, const char* name);
@@ -158,6 +200,9 @@ class Memory_Manager
 
         void free_memory_pool_by_ptr(memory_pool* pThisPool);
 
+        static MemoryPoolOwnership                  pool_ownership;
+        static SOAR_THREAD_LOCAL Memory_Manager*    active_MPM;
+
     public:
         template <typename T>
         inline void allocate_with_pool(MemoryPoolType mempool_index, T** dest_item_pointer)
@@ -337,4 +382,20 @@ class Memory_Manager
 
 };
 
+/* Makes an agent's MPM the active one for the current thread.  Used around
+ * anything that runs an agent so that STL containers it creates draw from
+ * its own pools. */
+class Agent_MPM_Scope
+{
+    public:
+        Agent_MPM_Scope(Memory_Manager* pMPM) { m_previous = Memory_Manager::Set_Active_MPM(pMPM); }
+        ~Agent_MPM_Scope() { Memory_Manager::Set_Active_MPM(m_previous); }
+
+    private:
+        Memory_Manager* m_previous;
+
+        Agent_MPM_Scope(Agent_MPM_Scope const&) {};
+        void operator=(Agent_MPM_Scope const&) {};
+};
+
 #endif
@@ -54,7 +54,7 @@ namespace soar_module
         public:
             soar_memory_pool_allocator() : mem_pool(NULL), memory_manager(NULL)
         {
-                memory_manager = &(Memory_Manager::Get_MPM());
+                memory_manager = Memory_Manager::Get_Active_MPM();
                 mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
         }
 
@@ -62,7 +62,7 @@ namespace soar_module
             {
                 // useful for debugging
                 // std::string temp_this( typeid( value_type ).name() );
-                memory_manager = &(Memory_Manager::Get_MPM());
+                memory_manager = Memory_Manager::Get_Active_MPM();
                 mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
@@ -70,7 +70,7 @@ namespace soar_module
             {
                 // useful for debugging
                 // std::string temp_this( typeid( value_type ).name() );
-                memory_manager = &(Memory_Manager::Get_MPM());
+                memory_manager = obj.get_memory_manager();
                 mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
@@ -80,7 +80,7 @@ namespace soar_module
                     // useful for debugging
                     // std::string temp_this( typeid( T ).name() );
                     // std::string temp_other( typeid( _other ).name() );
-                    memory_manager = &(Memory_Manager::Get_MPM());
+                    memory_manager = other.get_memory_manager();
                     mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
@@ -137,6 +137,12 @@ namespace soar_module
             };
 
 
+            /* Copies and rebinds must return items to the MPM that allocated them */
+            Memory_Manager* get_memory_manager() const
+            {
+                return memory_manager;
+            }
+
         private:
             //            agent* thisAgent;
             Memory_Manager* memory_manager;
@@ -161,7 +167,7 @@ namespace soar_module
         public:
             soar_memory_pool_allocator_n() : mem_pool(NULL), memory_manager(NULL)
         {
-                memory_manager = &(Memory_Manager::Get_MPM());
+                memory_manager = Memory_Manager::Get_Active_MPM();
                 mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
         }
 
@@ -169,7 +175,7 @@ namespace soar_module
             {
                 // useful for debugging
                 // std::string temp_this( typeid( value_type ).name() );
-                memory_manager = &(Memory_Manager::Get_MPM());
+                memory_manager = Memory_Manager::Get_Active_MPM();
                 mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
@@ -177,7 +183,7 @@ namespace soar_module
             {
                 // useful for debugging
                 // std::string temp_this( typeid( value_type ).name() );
-                memory_manager = &(Memory_Manager::Get_MPM());
+                memory_manager = obj.get_memory_manager();
                 mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
@@ -187,7 +193,7 @@ namespace soar_module
                     // useful for debugging
                     // std::string temp_this( typeid( T ).name() );
                     // std::string temp_other( typeid( _other ).name() );
-                    memory_manager = &(Memory_Manager::Get_MPM());
+                    memory_manager = other.get_memory_manager();
                     mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
@@ -257,16 +263,22 @@ namespace soar_module
             };
 
 
+            /* Copies and rebinds must return items to the MPM that allocated them */
+            Memory_Manager* get_memory_manager() const
+            {
+                return memory_manager;
+            }
+
         private:
             //            agent* thisAgent;
             Memory_Manager* memory_manager;
             memory_pool* mem_pool;
 
     };
-    template<class T> bool operator==(const soar_memory_pool_allocator_n<T>&, const soar_memory_pool_allocator_n<T>&) { return true; }
-    template<class T> bool operator!=(const soar_memory_pool_allocator_n<T>&, const soar_memory_pool_allocator_n<T>&) { return false; }
-    template<class T> bool operator==(const soar_memory_pool_allocator<T>&, const soar_memory_pool_allocator<T>&) { return true; }
-    template<class T> bool operator!=(const soar_memory_pool_allocator<T>&, const soar_memory_pool_allocator<T>&) { return false; }
+    template<class T> bool operator==(const soar_memory_pool_allocator_n<T>& a, const soar_memory_pool_allocator_n<T>& b) { return a.get_memory_manager() == b.get_memory_manager(); }
+    template<class T> bool operator!=(const soar_memory_pool_allocator_n<T>& a, const soar_memory_pool_allocator_n<T>& b) { return a.get_memory_manager() != b.get_memory_manager(); }
+    template<class T> bool operator==(const soar_memory_pool_allocator<T>& a, const soar_memory_pool_allocator<T>& b) { return a.get_memory_manager() == b.get_memory_manager(); }
+    template<class T> bool operator!=(const soar_memory_pool_allocator<T>& a, const soar_memory_pool_allocator<T>& b) { return a.get_memory_manager() != b.get_memory_manager(); }
 #endif
 }
 #endif
@@ -102,6 +102,205 @@ namespace soar_module
         return return_val;
     }
     
+    bool sqlite_checkpointer::start(const char* file_name)
+    {
+        if (is_running())
+        {
+            return true;
+        }
+
+        if (sqlite3_open_v2(file_name, &(my_db), SQLITE_OPEN_READWRITE, NULL) != SQLITE_OK)
+        {
+            sqlite3_close(my_db);
+            my_db = NULL;
+            return false;
+        }
+
+        pending = false;
+        stopping = false;
+        worker = std::thread(&sqlite_checkpointer::run, this);
+        return true;
+    }
+    
+    void sqlite_checkpointer::request()
+    {
+        if (is_running())
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            pending = true;
+            wake.notify_one();
+        }
+    }
+    
+    void sqlite_checkpointer::stop()
+    {
+        if (!is_running())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+            wake.notify_one();
+        }
+        worker.join();
+
+        sqlite3_close(my_db);
+        my_db = NULL;
+    }
+    
+    void sqlite_checkpointer::run()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            while (!pending && !stopping)
+            {
+                wake.wait(guard);
+            }
+            if (stopping)
+            {
+                break;
+            }
+            pending = false;
+
+            // a passive checkpoint copies whatever frames no reader still needs
+            // and never blocks the writer, so it is safe to run at any time
+            guard.unlock();
+            sqlite3_wal_checkpoint_v2(my_db, NULL, SQLITE_CHECKPOINT_PASSIVE, NULL, NULL);
+            guard.lock();
+        }
+    }
+    
+    void sqlite_writer::start()
+    {
+        if (running)
+        {
+            return;
+        }
+
+        stopping = false;
+        busy = false;
+        running = true;
+        worker = std::thread(&sqlite_writer::run, this);
+    }
+    
+    void sqlite_writer::stop()
+    {
+        if (!running)
+        {
+            return;
+        }
+
+        flush();
+        {
+            std::lock_guard<std::mutex> guard(queue_lock);
+            stopping = true;
+            wake.notify_one();
+        }
+        worker.join();
+        running = false;
+    }
+    
+    void sqlite_writer::add(sqlite_statement* stmt, int num_params, int64_t p1, int64_t p2, int64_t p3, int64_t p4, int64_t p5)
+    {
+        queued_write w;
+
+        w.stmt = stmt;
+        w.num_params = num_params;
+        w.params[0] = p1;
+        w.params[1] = p2;
+        w.params[2] = p3;
+        w.params[3] = p4;
+        w.params[4] = p5;
+
+        if (running)
+        {
+            pending.push_back(w);
+        }
+        else
+        {
+            write(w);
+        }
+    }
+    
+    void sqlite_writer::write(queued_write& w)
+    {
+        for (int i = 0; i < w.num_params; i++)
+        {
+            w.stmt->bind_int(i + 1, w.params[i]);
+        }
+        w.stmt->execute(op_reinit);
+    }
+    
+    void sqlite_writer::submit()
+    {
+        if (!running || pending.empty())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(queue_lock);
+        if (submitted.empty())
+        {
+            submitted.swap(pending);
+        }
+        else
+        {
+            submitted.insert(submitted.end(), pending.begin(), pending.end());
+            pending.clear();
+        }
+        wake.notify_one();
+    }
+    
+    void sqlite_writer::flush()
+    {
+        if (!running)
+        {
+            return;
+        }
+
+        submit();
+
+        std::unique_lock<std::mutex> guard(queue_lock);
+        while (!submitted.empty() || busy)
+        {
+            idle.wait(guard);
+        }
+    }
+    
+    void sqlite_writer::run()
+    {
+        std::unique_lock<std::mutex> guard(queue_lock);
+        while (true)
+        {
+            while (submitted.empty() && !stopping)
+            {
+                wake.wait(guard);
+            }
+            if (submitted.empty())
+            {
+                break;
+            }
+
+            working.swap(submitted);
+            busy = true;
+            guard.unlock();
+
+            for (std::vector<queued_write>::iterator w = working.begin(); w != working.end(); w++)
+            {
+                std::lock_guard<std::mutex> db_guard(db_lock);
+                write(*w);
+            }
+            working.clear();
+
+            guard.lock();
+            busy = false;
+            idle.notify_all();
+        }
+    }
+    
     bool sqlite_database::print_table(const char* table_name)
     {
         sqlite3_stmt* statement;
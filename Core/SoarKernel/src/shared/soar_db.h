@@ -13,7 +13,11 @@
 #include "sqlite3.h"
 
 #include <list>
+#include <vector>
 #include <assert.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 /* -- Tracing functions that print SQL processing and errors -- */
 //    #define DEBUG_SQL_ERRORS
@@ -325,6 +329,142 @@ namespace soar_module
     };
 
 
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Checkpoints the write-ahead log of a file database from its own
+    // connection and thread, so that the connection doing the writing
+    // never waits on the copy back into the database file.
+    class sqlite_checkpointer
+    {
+        protected:
+            sqlite3* my_db;
+
+            std::thread worker;
+            std::mutex lock;
+            std::condition_variable wake;
+            bool pending;
+            bool stopping;
+
+            void run();
+
+        public:
+            sqlite_checkpointer(): my_db(NULL), pending(false), stopping(false) {}
+            virtual ~sqlite_checkpointer()
+            {
+                stop();
+            }
+
+            // opens a second connection to file_name and starts the thread
+            bool start(const char* file_name);
+
+            // asks for a (passive) checkpoint; returns right away
+            void request();
+
+            // waits for any checkpoint in progress and closes the connection
+            void stop();
+
+            inline bool is_running()
+            {
+                return (my_db != NULL);
+            }
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    class sqlite_statement;
+
+    // Executes write-only statements on a background thread, in the order
+    // they were queued.  Statements are queued along with their integer
+    // parameters and handed to the thread a batch at a time by submit().
+    // When the thread isn't running, execute() runs the statement right away.
+    //
+    // While the thread is running, anything else that uses the connection
+    // must either hold get_lock() or call flush() first.
+    class sqlite_writer
+    {
+        protected:
+            struct queued_write
+            {
+                sqlite_statement* stmt;
+                int num_params;
+                int64_t params[5];
+            };
+
+            std::vector<queued_write> pending;      // queued since the last submit()
+            std::vector<queued_write> submitted;    // waiting for the thread
+            std::vector<queued_write> working;      // being written by the thread
+
+            std::thread worker;
+            std::mutex queue_lock;
+            std::mutex db_lock;
+            std::condition_variable wake;
+            std::condition_variable idle;
+            bool running;
+            bool stopping;
+            bool busy;
+
+            void add(sqlite_statement* stmt, int num_params, int64_t p1, int64_t p2, int64_t p3, int64_t p4, int64_t p5);
+            void write(queued_write& w);
+            void run();
+
+        public:
+            sqlite_writer(): running(false), stopping(false), busy(false) {}
+            virtual ~sqlite_writer()
+            {
+                stop();
+            }
+
+            void start();
+
+            // writes everything queued so far, then stops the thread
+            void stop();
+
+            inline bool is_running()
+            {
+                return running;
+            }
+
+            inline std::mutex& get_lock()
+            {
+                return db_lock;
+            }
+
+            inline void execute(sqlite_statement* stmt)
+            {
+                add(stmt, 0, 0, 0, 0, 0, 0);
+            }
+            inline void execute(sqlite_statement* stmt, int64_t p1)
+            {
+                add(stmt, 1, p1, 0, 0, 0, 0);
+            }
+            inline void execute(sqlite_statement* stmt, int64_t p1, int64_t p2)
+            {
+                add(stmt, 2, p1, p2, 0, 0, 0);
+            }
+            inline void execute(sqlite_statement* stmt, int64_t p1, int64_t p2, int64_t p3)
+            {
+                add(stmt, 3, p1, p2, p3, 0, 0);
+            }
+            inline void execute(sqlite_statement* stmt, int64_t p1, int64_t p2, int64_t p3, int64_t p4)
+            {
+                add(stmt, 4, p1, p2, p3, p4, 0);
+            }
+            inline void execute(sqlite_statement* stmt, int64_t p1, int64_t p2, int64_t p3, int64_t p4, int64_t p5)
+            {
+                add(stmt, 5, p1, p2, p3, p4, p5);
+            }
+
+            // hands the statements queued so far to the thread
+            void submit();
+
+            // submits and waits until the thread has written everything
+            void flush();
+    };
+
+
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 
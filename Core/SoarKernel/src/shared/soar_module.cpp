@@ -64,9 +64,9 @@ namespace soar_module
         {
             remove_from_dll(my_slot->wmes, w, next, prev);
 
-            if (w->gds)
+            if (wme_gds(w))
             {
-                if (w->gds->goal != NIL)
+                if (w->cold->gds->goal != NIL)
                 {
                     gds_invalid_so_remove_goal(thisAgent, w);
 
@@ -38,3 +38,20 @@ void SoarSeedRNG(const uint32_t seed)
 {
     gSoarRand.seed(seed);
 }
+
+MTRand* SoarCreateAgentRNG(bool pPrivate)
+{
+    if (!pPrivate)
+    {
+        return &gSoarRand;
+    }
+    return new MTRand(gSoarRand.randInt());
+}
+
+void SoarDestroyAgentRNG(MTRand* pRNG)
+{
+    if (pRNG != &gSoarRand)
+    {
+        delete pRNG;
+    }
+}
@@ -491,6 +491,14 @@ EXPORT void SoarSeedRNG();
 // seed with a provided value
 EXPORT void SoarSeedRNG(const uint32_t seed);
 
+// generator for a new agent: a private one (seeded from the shared
+// generator, so runs stay reproducible after srand) when the agent may step
+// on its own thread, otherwise the shared process-wide generator
+EXPORT MTRand* SoarCreateAgentRNG(bool pPrivate);
+
+// releases a generator returned by SoarCreateAgentRNG
+EXPORT void SoarDestroyAgentRNG(MTRand* pRNG);
+
 #endif  // SOAR_RAND_H
 
 // Change log:
@@ -56,6 +56,7 @@
 #include "smem_structs.h"
 #include "soar_instance.h"
 #include "soar_module.h"
+#include "soar_rand.h"
 #include "stats.h"
 #include "symbol.h"
 #include "trace.h"
@@ -109,11 +110,10 @@ void init_soar_agent(agent* thisAgent)
     thisAgent->memoryManager->init_memory_pool(MP_gds, sizeof(goal_dependency_set), "gds");
 
     thisAgent->memoryManager->init_memory_pool(MP_rl_info, sizeof(rl_data), "rl_id_data");
-    thisAgent->memoryManager->init_memory_pool(MP_rl_et, sizeof(rl_et_map), "rl_et");
+    thisAgent->memoryManager->init_memory_pool(MP_rl_et, sizeof(rl_et_store), "rl_et");
     thisAgent->memoryManager->init_memory_pool(MP_rl_rule, sizeof(production_list), "rl_rules");
 
     thisAgent->memoryManager->init_memory_pool(MP_wma_decay_element, sizeof(wma_decay_element), "wma_decay");
-    thisAgent->memoryManager->init_memory_pool(MP_wma_decay_set, sizeof(wma_decay_set), "wma_decay_set");
     thisAgent->memoryManager->init_memory_pool(MP_wma_wme_oset, sizeof(wme_set), "wma_oset");
     thisAgent->memoryManager->init_memory_pool(MP_wma_slot_refs, sizeof(wma_sym_reference_map), "wma_slot_ref");
 
@@ -164,6 +164,11 @@ agent* create_soar_agent(char* agent_name)
 {
     char cur_path[MAXPATHLEN];
 
+    /* Agent-owned pools (if enabled) must be active before anything in the
+     * agent creates an STL container, including the agent struct itself */
+    Memory_Manager* lMPM = Memory_Manager::Create_Agent_MPM();
+    Agent_MPM_Scope lMPMScope(lMPM);
+
     agent* thisAgent = new agent();
     thisAgent->name                                     = savestring(agent_name);
     thisAgent->output_settings                          = new AgentOutput_Info();
@@ -256,7 +261,8 @@ agent* create_soar_agent(char* agent_name)
     soar_init_callbacks(thisAgent);
 
     //
-    thisAgent->memoryManager = &Memory_Manager::Get_MPM();
+    thisAgent->memoryManager = lMPM;
+    thisAgent->rng = SoarCreateAgentRNG(!lMPM->is_shared());
     init_memory_utilities(thisAgent);
 
     //
@@ -384,7 +390,7 @@ void destroy_soar_agent(agent* delete_agent)
     /* Releasing memory allocated in init_rete */
     for (int i = 0; i < 16; i++)
     {
-        free_hash_table(delete_agent, delete_agent->alpha_hash_tables[i]);
+        delete_agent->alpha_tables[i].clean_up();
     }
 
     /* Release module managers */
@@ -401,8 +407,12 @@ void destroy_soar_agent(agent* delete_agent)
     /* Release data used by XML generation */
     xml_destroy(delete_agent);
 
-    /* Release agent data structure */
+    /* Release agent data structure.  An agent-owned MPM goes last, since
+     * everything above may still return items to its pools. */
+    Memory_Manager* lMPM = delete_agent->memoryManager;
+    SoarDestroyAgentRNG(delete_agent->rng);
     delete delete_agent;
+    Memory_Manager::Destroy_Agent_MPM(lMPM);
 }
 
 void reinitialize_agent(agent* thisAgent)
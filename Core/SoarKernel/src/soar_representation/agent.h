@@ -21,6 +21,7 @@
 #define AGENT_H
 
 #include "kernel.h"
+#include "alpha_table.h"
 
 #include "Export.h"
 #include "mem.h"
@@ -43,6 +44,7 @@ typedef struct alpha_mem_struct alpha_mem;
 typedef struct token_struct token;
 
 class stats_statement_container;
+class MTRand;
 #ifndef NO_SVS
 class svs_interface;
 #endif
@@ -77,7 +79,8 @@ typedef struct EXPORT agent_struct
     /* Hash tables for alpha memories, and for entries in left & right memories */
     void*               left_ht;
     void*               right_ht;
-    hash_table*        (alpha_hash_tables[16]);
+    Alpha_Table         alpha_tables[16];
+    uint32_t            alpha_tables_in_use;    /* bit i set if alpha_tables[i] isn't empty */
 
     /* Number of WMEs, and list of WMEs, the Rete has been told about */
     uint64_t            num_wmes_in_rete;
@@ -476,6 +479,9 @@ typedef struct EXPORT agent_struct
     // select
     select_info* select;
 
+    // random number generator, private when pools are agent-owned
+    MTRand*      rng;
+
     // predict
     uint32_t     predict_seed;
     std::string* prediction;
@@ -779,12 +779,13 @@ void finalize_instantiation(agent* thisAgent, instantiation* inst, bool need_to_
                 }
             }
             /* Check for local singletons */
-            if (cond->bt.wme_->local_singleton_value_identity_set && lDoIdentities && (cond->bt.wme_->id == inst->match_goal))
+            if (cond->bt.wme_->cold && cond->bt.wme_->cold->local_singleton_value_identity_set && lDoIdentities && (cond->bt.wme_->id == inst->match_goal))
             {
-                thisAgent->explanationBasedChunker->force_id_to_identity_mapping(cond->data.tests.id_test->eq_test->inst_identity, cond->bt.wme_->local_singleton_id_identity_set);
-                thisAgent->explanationBasedChunker->force_id_to_identity_mapping(cond->data.tests.value_test->eq_test->inst_identity, cond->bt.wme_->local_singleton_value_identity_set);
-                set_test_identity(thisAgent, cond->data.tests.id_test->eq_test, cond->bt.wme_->local_singleton_id_identity_set);
-                set_test_identity(thisAgent, cond->data.tests.value_test->eq_test, cond->bt.wme_->local_singleton_value_identity_set);
+                wme_cold* lCold = cond->bt.wme_->cold;
+                thisAgent->explanationBasedChunker->force_id_to_identity_mapping(cond->data.tests.id_test->eq_test->inst_identity, lCold->local_singleton_id_identity_set);
+                thisAgent->explanationBasedChunker->force_id_to_identity_mapping(cond->data.tests.value_test->eq_test->inst_identity, lCold->local_singleton_value_identity_set);
+                set_test_identity(thisAgent, cond->data.tests.id_test->eq_test, lCold->local_singleton_id_identity_set);
+                set_test_identity(thisAgent, cond->data.tests.value_test->eq_test, lCold->local_singleton_value_identity_set);
                 thisAgent->explanationMemory->increment_stat_identity_propagations();
             }
             if (lDoIdentities)
@@ -1062,6 +1063,7 @@ void create_instantiation(agent* thisAgent, production* prod, struct token_struc
     }
 
     thisAgent->production_being_fired = inst->prod;
+    rl_write_back_value(thisAgent, prod);
     prod->firing_count++;
     thisAgent->production_firing_count++;
 
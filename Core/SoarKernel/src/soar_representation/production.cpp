@@ -461,6 +461,7 @@ production* make_production(agent*          thisAgent,
         }
     }
     p->rl_template_conds = NIL;
+    p->rl_pending_index = 0;
 
     rl_update_template_tracking(thisAgent, name->sc->name);
 
@@ -495,6 +496,9 @@ void deallocate_production(agent* thisAgent, production* prod)
 
 void excise_production(agent* thisAgent, production* prod, bool print_sharp_sign, bool cacheProdForExplainer)
 {
+    /* Bring the RHS up to date before anything below copies it */
+    rl_write_back_value(thisAgent, prod);
+
     /* When excising, the explainer needs to save the production before we excise it from
      * the RETE.  Otherwise, it won't be able to reconstruct the cached conditions/actions */
     if (cacheProdForExplainer && prod->save_for_justification_explanation && thisAgent->explanationMemory->is_any_enabled())
@@ -50,6 +50,7 @@ typedef struct production_struct
     double rl_gql;                // second value for implementation of GQ(\lambda)
 
     condition* rl_template_conds;
+    uint64_t rl_pending_index;    /* 1 + index of this rule's entry in rl_pending_values, or 0 */
 
     int      duplicate_chunks_this_cycle;
     uint64_t last_duplicate_dc;
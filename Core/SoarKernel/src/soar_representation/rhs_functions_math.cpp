@@ -1507,9 +1507,9 @@ Symbol* rand_float_rhs_function_code(agent* thisAgent, cons* args, void* /*user_
 
     if (n > 0)
     {
-        return thisAgent->symbolManager->make_float_constant(SoarRand(n));
+        return thisAgent->symbolManager->make_float_constant(thisAgent->rng->rand(n));
     }
-    return thisAgent->symbolManager->make_float_constant(SoarRand());
+    return thisAgent->symbolManager->make_float_constant(thisAgent->rng->rand());
 }
 
 /* --------------------------------------------------------------------
@@ -1551,9 +1551,9 @@ Symbol* rand_int_rhs_function_code(agent* thisAgent, cons* args, void* /*user_da
 
     if (n > 0)
     {
-        return thisAgent->symbolManager->make_int_constant(static_cast<int64_t>(SoarRandInt(static_cast<uint32_t>(n))));
+        return thisAgent->symbolManager->make_int_constant(static_cast<int64_t>(thisAgent->rng->randInt(static_cast<uint32_t>(n))));
     }
-    return thisAgent->symbolManager->make_int_constant(SoarRandInt());
+    return thisAgent->symbolManager->make_int_constant(thisAgent->rng->randInt());
 }
 
 inline double _dice_zero_tolerance(double in)
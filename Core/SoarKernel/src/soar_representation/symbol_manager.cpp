@@ -32,132 +32,157 @@ Symbol_Manager::Symbol_Manager(agent* pAgent)
 
 Symbol_Manager::~Symbol_Manager()
 {
-    free_hash_table(thisAgent, variable_hash_table);
-    free_hash_table(thisAgent, identifier_hash_table);
-    free_hash_table(thisAgent, str_constant_hash_table);
-    free_hash_table(thisAgent, int_constant_hash_table);
-    free_hash_table(thisAgent, float_constant_hash_table);
+    variable_hash_table.clean_up();
+    identifier_hash_table.clean_up();
+    str_constant_hash_table.clean_up();
+    int_constant_hash_table.clean_up();
+    float_constant_hash_table.clean_up();
 }
 
 /* -------------------------------------------------------------------
                            Hash Functions
 
-   Compress() takes a 32-bit hash value and compresses it down to a few
-   bits, xor-ing pieces of the 32-bit value to avoid throwing away bits
-   that might be important for the hash function to be effective.
+   Hash_string() produces a 32-bit hash value for a string of characters.
 
-   Hash_string() produces a hash value for a string of characters.
+   Hash_integer() produces a 32-bit hash value for a 64-bit number,
+   mixing all of its bits so that nearby values spread out across the
+   symbol tables.
 
    Hash_xxx_raw_info() are the hash functions for the five kinds of
    symbols.  These functions operate on the basic info about the symbol
    (i.e., the name, value, etc.).  Hash_xxx(), on the other hand,
-   operate on the symbol table entries for the five kinds of symbols--
-   these routines are the callback hashing functions used by the
-   resizable hash table routines.
-------------------------------------------------------------------- */
-
-uint32_t compress(uint32_t h, short num_bits)
-{
-    uint32_t result;
+   operate on the symbol table entries for the five kinds of symbols.
+   Unlike the generic hash tables in mem.h, the symbol tables store
+   the full hash value and mask it themselves, so these don't take a
+   number of bits.
 
-    if (num_bits < 16)
-    {
-        h = (h & 0xFFFF) ^ (h >> 16);
-    }
-    if (num_bits < 8)
-    {
-        h = (h & 0xFF) ^ (h >> 8);
-    }
-    result = 0;
-    while (h)
-    {
-        result ^= (h & masks_for_n_low_order_bits[num_bits]);
-        h = h >> num_bits;
-    }
-    return result;
-}
+   Match_xxx() are the comparison callbacks the symbol tables use to
+   check a candidate symbol against the basic info being looked up.
+------------------------------------------------------------------- */
 
-uint32_t hash_string(const char* s)      /* AGR 600 */
+uint32_t hash_string(const char* s)
 {
     uint32_t h;
 
-    h = 0;
+    h = 2166136261u;
     while (*s != 0)
     {
-        h = ((h << 8) | (h >> 24)) ^ (*s);
+        h = (h ^ static_cast<unsigned char>(*s)) * 16777619u;
         s++;
     }
     return h;
 }
 
+uint32_t hash_integer(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<uint32_t>(h);
+}
+
 /* -----------------------------------------
    Hashing symbols using their basic info
 ----------------------------------------- */
 
-uint32_t hash_variable_raw_info(const char* name, short num_bits)
+uint32_t hash_variable_raw_info(const char* name)
 {
-    return compress(hash_string(name), num_bits);
+    return hash_string(name);
 }
 
-uint32_t hash_identifier_raw_info(char name_letter,
-                                  uint64_t name_number,
-                                  short num_bits)
+uint32_t hash_identifier_raw_info(char name_letter, uint64_t name_number)
 {
-    return compress(static_cast<uint32_t>(name_number) ^ (static_cast<uint32_t>(name_letter) << 24), num_bits);  // FIXME: cast from 64 to 32 bits
+    return hash_integer(name_number ^ (static_cast<uint64_t>(name_letter) << 56));
 }
 
-uint32_t hash_str_constant_raw_info(const char* name, short num_bits)
+uint32_t hash_str_constant_raw_info(const char* name)
 {
-    return compress(hash_string(name), num_bits);
+    return hash_string(name);
 }
 
-uint32_t hash_int_constant_raw_info(int64_t value, short num_bits)
+uint32_t hash_int_constant_raw_info(int64_t value)
 {
-    return compress(static_cast<uint32_t>(value), num_bits);
+    return hash_integer(static_cast<uint64_t>(value));
 }
 
-uint32_t hash_float_constant_raw_info(double value, short num_bits)
+uint32_t hash_float_constant_raw_info(double value)
 {
-    return compress(static_cast<uint32_t>(value), num_bits);
+    uint64_t bits;
+
+    /* --- 0.0 and -0.0 compare equal, so they must hash the same --- */
+    if (value == 0.0)
+    {
+        value = 0.0;
+    }
+    memcpy(&bits, &value, sizeof(bits));
+    return hash_integer(bits);
 }
 
 /* ---------------------------------------------------
    Hashing symbols using their symbol table entries
 --------------------------------------------------- */
 
-uint32_t hash_variable(void* item, short num_bits)
+uint32_t hash_variable(Symbol* sym)
+{
+    return hash_variable_raw_info(sym->var->name);
+}
+
+uint32_t hash_identifier(Symbol* sym)
+{
+    return hash_identifier_raw_info(sym->id->name_letter, sym->id->name_number);
+}
+
+uint32_t hash_str_constant(Symbol* sym)
+{
+    return hash_str_constant_raw_info(sym->sc->name);
+}
+
+uint32_t hash_int_constant(Symbol* sym)
+{
+    return hash_int_constant_raw_info(sym->ic->value);
+}
+
+uint32_t hash_float_constant(Symbol* sym)
+{
+    return hash_float_constant_raw_info(sym->fc->value);
+}
+
+/* ---------------------------------------------------
+   Matching symbol table entries against basic info
+--------------------------------------------------- */
+
+typedef struct identifier_key_struct
+{
+    char        name_letter;
+    uint64_t    name_number;
+} identifier_key;
+
+bool match_variable(Symbol* sym, const void* key)
 {
-    varSymbol* var;
-    var = static_cast<varSymbol*>(item);
-    return compress(hash_string(var->name), num_bits);
+    return !strcmp(sym->var->name, static_cast<const char*>(key));
 }
 
-uint32_t hash_identifier(void* item, short num_bits)
+bool match_identifier(Symbol* sym, const void* key)
 {
-    idSymbol* id;
-    id = static_cast<idSymbol*>(item);
-    return compress(static_cast<uint32_t>(id->name_number) ^ (static_cast<uint32_t>(id->name_letter) << 24), num_bits);  // FIXME: cast from 64 to 32 bits
+    const identifier_key* lKey = static_cast<const identifier_key*>(key);
+    return (lKey->name_letter == sym->id->name_letter) && (lKey->name_number == sym->id->name_number);
 }
 
-uint32_t hash_str_constant(void* item, short num_bits)
+bool match_str_constant(Symbol* sym, const void* key)
 {
-    strSymbol* sc;
-    sc = static_cast<strSymbol*>(item);
-    return compress(hash_string(sc->name), num_bits);
+    return !strcmp(sym->sc->name, static_cast<const char*>(key));
 }
 
-uint32_t hash_int_constant(void* item, short num_bits)
+bool match_int_constant(Symbol* sym, const void* key)
 {
-    intSymbol* ic;
-    ic = static_cast<intSymbol*>(item);
-    return compress(static_cast<uint32_t>(ic->value), num_bits);
+    return (*static_cast<const int64_t*>(key) == sym->ic->value);
 }
 
-uint32_t hash_float_constant(void* item, short num_bits)
+bool match_float_constant(Symbol* sym, const void* key)
 {
-    floatSymbol* fc;
-    fc = static_cast<floatSymbol*>(item);
-    return compress(static_cast<uint32_t>(fc->value), num_bits);
+    return (*static_cast<const double*>(key) == sym->fc->value);
 }
 
 /* -----------------------------------------------------------------
@@ -215,11 +240,11 @@ uint32_t hash_float_constant(void* item, short num_bits)
 
 void Symbol_Manager::init_symbol_tables()
 {
-    variable_hash_table = make_hash_table(thisAgent, 0, hash_variable);
-    identifier_hash_table = make_hash_table(thisAgent, 0, hash_identifier);
-    str_constant_hash_table = make_hash_table(thisAgent, 0, hash_str_constant);
-    int_constant_hash_table = make_hash_table(thisAgent, 0, hash_int_constant);
-    float_constant_hash_table = make_hash_table(thisAgent, 0, hash_float_constant);
+    variable_hash_table.init(thisAgent);
+    identifier_hash_table.init(thisAgent);
+    str_constant_hash_table.init(thisAgent);
+    int_constant_hash_table.init(thisAgent);
+    float_constant_hash_table.init(thisAgent);
 
     thisAgent->memoryManager->init_memory_pool(MP_variable, sizeof(varSymbol), "variable");
     thisAgent->memoryManager->init_memory_pool(MP_identifier, sizeof(idSymbol), "identifier");
@@ -242,109 +267,59 @@ bool retesave_symbol_and_assign_index(agent* thisAgent, void* item, void* userda
     return false;
 }
 
+bool retesave_float_symbol_and_assign_index(agent* thisAgent, void* item, void* userdata)
+{
+    Symbol* sym;
+    FILE* f = reinterpret_cast<FILE*>(userdata);
+
+    sym = static_cast<symbol_struct*>(item);
+    thisAgent->current_retesave_symindex++;
+    sym->retesave_symindex = thisAgent->current_retesave_symindex;
+    retesave_double(sym->fc->value, f);
+    return false;
+}
 
-void Symbol_Manager::retesave(FILE* f)
+void Symbol_Manager::retesave(FILE* f, bool exact_floats)
 {
     thisAgent->current_retesave_symindex = 0;
 
-    retesave_eight_bytes(str_constant_hash_table->count, f);
-    retesave_eight_bytes(variable_hash_table->count, f);
-    retesave_eight_bytes(int_constant_hash_table->count, f);
-    retesave_eight_bytes(float_constant_hash_table->count, f);
+    retesave_eight_bytes(str_constant_hash_table.get_count(), f);
+    retesave_eight_bytes(variable_hash_table.get_count(), f);
+    retesave_eight_bytes(int_constant_hash_table.get_count(), f);
+    retesave_eight_bytes(float_constant_hash_table.get_count(), f);
 
-    do_for_all_items_in_hash_table(thisAgent, str_constant_hash_table, retesave_symbol_and_assign_index, f);
-    do_for_all_items_in_hash_table(thisAgent, variable_hash_table, retesave_symbol_and_assign_index, f);
-    do_for_all_items_in_hash_table(thisAgent, int_constant_hash_table, retesave_symbol_and_assign_index, f);
-    do_for_all_items_in_hash_table(thisAgent, float_constant_hash_table, retesave_symbol_and_assign_index, f);
+    str_constant_hash_table.do_for_all_items(retesave_symbol_and_assign_index, f);
+    variable_hash_table.do_for_all_items(retesave_symbol_and_assign_index, f);
+    int_constant_hash_table.do_for_all_items(retesave_symbol_and_assign_index, f);
+    float_constant_hash_table.do_for_all_items(exact_floats ? retesave_float_symbol_and_assign_index : retesave_symbol_and_assign_index, f);
 }
 Symbol* Symbol_Manager::find_variable(const char* name)
 {
-    uint32_t hash_value;
-    varSymbol* sym;
-
-    hash_value = hash_variable_raw_info(name, variable_hash_table->log2size);
-    sym = reinterpret_cast<varSymbol*>(*(variable_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<varSymbol*>(sym->next_in_hash_table))
-    {
-        if (!strcmp(sym->name, name))
-        {
-            return sym;
-        }
-    }
-    return NIL;
+    return variable_hash_table.find(hash_variable_raw_info(name), name, match_variable);
 }
 
 Symbol* Symbol_Manager::find_identifier(char name_letter, uint64_t name_number)
 {
-    uint32_t hash_value;
-    idSymbol* sym;
+    identifier_key lKey;
 
-    hash_value = hash_identifier_raw_info(name_letter, name_number,
-                                          identifier_hash_table->log2size);
-    sym = reinterpret_cast<idSymbol*>(*(identifier_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<idSymbol*>(sym->next_in_hash_table))
-    {
-        if ((name_letter == sym->name_letter) &&
-                (name_number == sym->name_number))
-        {
-            return sym;
-        }
-    }
-    return NIL;
+    lKey.name_letter = name_letter;
+    lKey.name_number = name_number;
+    return identifier_hash_table.find(hash_identifier_raw_info(name_letter, name_number), &lKey, match_identifier);
 }
 
 Symbol* Symbol_Manager::find_str_constant(const char* name)
 {
-    uint32_t hash_value;
-    strSymbol* sym;
-
-    hash_value = hash_str_constant_raw_info(name,
-                                            str_constant_hash_table->log2size);
-    sym = reinterpret_cast<strSymbol*>(*(str_constant_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<strSymbol*>(sym->next_in_hash_table))
-    {
-        if (!strcmp(sym->name, name))
-        {
-            return sym;
-        }
-    }
-    return NIL;
+    return str_constant_hash_table.find(hash_str_constant_raw_info(name), name, match_str_constant);
 }
 
 Symbol* Symbol_Manager::find_int_constant(int64_t value)
 {
-    uint32_t hash_value;
-    intSymbol* sym;
-
-    hash_value = hash_int_constant_raw_info(value,
-                                            int_constant_hash_table->log2size);
-    sym = reinterpret_cast<intSymbol*>(*(int_constant_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<intSymbol*>(sym->next_in_hash_table))
-    {
-        if (value == sym->value)
-        {
-            return sym;
-        }
-    }
-    return NIL;
+    return int_constant_hash_table.find(hash_int_constant_raw_info(value), &value, match_int_constant);
 }
 
 Symbol* Symbol_Manager::find_float_constant(double value)
 {
-    uint32_t hash_value;
-    floatSymbol* sym;
-
-    hash_value = hash_float_constant_raw_info(value,
-                 float_constant_hash_table->log2size);
-    sym = reinterpret_cast<floatSymbol*>(*(float_constant_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<floatSymbol*>(sym->next_in_hash_table))
-    {
-        if (value == sym->value)
-        {
-            return sym;
-        }
-    }
-    return NIL;
+    return float_constant_hash_table.find(hash_float_constant_raw_info(value), &value, match_float_constant);
 }
 
 Symbol* Symbol_Manager::make_variable(const char* name)
@@ -376,7 +351,7 @@ Symbol* Symbol_Manager::make_variable(const char* name)
     sym->id = NULL;
     sym->var = sym;
     symbol_add_ref(sym);
-    add_to_hash_table(thisAgent, variable_hash_table, sym);
+    variable_hash_table.add(sym, hash_variable(sym));
 
     return sym;
 }
@@ -465,7 +440,7 @@ Symbol* Symbol_Manager::make_new_identifier(char name_letter, goal_stack_level l
     sym->var = NULL;
     sym->id = sym;
     symbol_add_ref(sym);
-    add_to_hash_table(thisAgent, identifier_hash_table, sym);
+    identifier_hash_table.add(sym, hash_identifier(sym));
 
     return sym;
 }
@@ -497,7 +472,7 @@ Symbol* Symbol_Manager::make_str_constant_no_find(char const* name)
     sym->var = NULL;
     sym->sc = sym;
     symbol_add_ref(sym);
-    add_to_hash_table(thisAgent, str_constant_hash_table, sym);
+    str_constant_hash_table.add(sym, hash_str_constant(sym));
 
     return sym;
 }
@@ -543,7 +518,7 @@ Symbol* Symbol_Manager::make_int_constant(int64_t value)
         sym->var = NULL;
         sym->ic = sym;
         symbol_add_ref(sym);
-        add_to_hash_table(thisAgent, int_constant_hash_table, sym);
+        int_constant_hash_table.add(sym, hash_int_constant(sym));
     }
     return sym;
 }
@@ -577,7 +552,7 @@ Symbol* Symbol_Manager::make_float_constant(double value)
         sym->var = NULL;
         sym->fc = sym;
         symbol_add_ref(sym);
-        add_to_hash_table(thisAgent, float_constant_hash_table, sym);
+        float_constant_hash_table.add(sym, hash_float_constant(sym));
     }
     return sym;
 }
@@ -904,31 +879,31 @@ void Symbol_Manager::deallocate_symbol(Symbol*& sym)
     switch (sym->symbol_type)
     {
         case VARIABLE_SYMBOL_TYPE:
-            remove_from_hash_table(thisAgent, variable_hash_table, sym);
+            variable_hash_table.remove(sym, hash_variable(sym));
             free_memory_block_for_string(thisAgent, sym->var->name);
             thisAgent->memoryManager->free_with_pool(MP_variable, sym);
             break;
         case IDENTIFIER_SYMBOL_TYPE:
             if (sym->id->cached_print_str) free_memory_block_for_string(thisAgent, sym->id->cached_print_str);
             if (sym->id->cached_lti_str) free_memory_block_for_string(thisAgent, sym->id->cached_lti_str);
-            remove_from_hash_table(thisAgent, identifier_hash_table, sym);
+            identifier_hash_table.remove(sym, hash_identifier(sym));
             thisAgent->memoryManager->free_with_pool(MP_identifier, sym);
             break;
         case STR_CONSTANT_SYMBOL_TYPE:
             if (sym->sc->cached_rereadable_print_str && (sym->sc->cached_rereadable_print_str != sym->sc->name))
                 free_memory_block_for_string(thisAgent, sym->sc->cached_rereadable_print_str);
-            remove_from_hash_table(thisAgent, str_constant_hash_table, sym);
+            str_constant_hash_table.remove(sym, hash_str_constant(sym));
             free_memory_block_for_string(thisAgent, sym->sc->name);
             thisAgent->memoryManager->free_with_pool(MP_str_constant, sym);
             break;
         case INT_CONSTANT_SYMBOL_TYPE:
             if (sym->ic->cached_print_str) free_memory_block_for_string(thisAgent, sym->ic->cached_print_str);
-            remove_from_hash_table(thisAgent, int_constant_hash_table, sym);
+            int_constant_hash_table.remove(sym, hash_int_constant(sym));
             thisAgent->memoryManager->free_with_pool(MP_int_constant, sym);
             break;
         case FLOAT_CONSTANT_SYMBOL_TYPE:
             if (sym->fc->cached_print_str) free_memory_block_for_string(thisAgent, sym->fc->cached_print_str);
-            remove_from_hash_table(thisAgent, float_constant_hash_table, sym);
+            float_constant_hash_table.remove(sym, hash_float_constant(sym));
             thisAgent->memoryManager->free_with_pool(MP_float_constant, sym);
             break;
         default:
@@ -1019,40 +994,40 @@ bool print_sym(agent* thisAgent, void* item, void*)
 
 void Symbol_Manager::clear_variable_gensym_numbers()
 {
-    do_for_all_items_in_hash_table(thisAgent, variable_hash_table, clear_gensym_number, 0);
+    variable_hash_table.do_for_all_items(clear_gensym_number, 0);
 }
 
 void Symbol_Manager::print_internal_symbols()
 {
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Symbolic Constants: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, str_constant_hash_table, print_sym, 0);
+    str_constant_hash_table.do_for_all_items(print_sym, 0);
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Integer Constants: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, int_constant_hash_table, print_sym, 0);
+    int_constant_hash_table.do_for_all_items(print_sym, 0);
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Floating-Point Constants: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, float_constant_hash_table, print_sym, 0);
+    float_constant_hash_table.do_for_all_items(print_sym, 0);
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Identifiers: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
+    identifier_hash_table.do_for_all_items(print_sym, 0);
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Variables: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, variable_hash_table, print_sym, 0);
+    variable_hash_table.do_for_all_items(print_sym, 0);
 }
 
 void Symbol_Manager::reset_hash_table(MemoryPoolType lHashTable)
 {
     if (lHashTable == MP_identifier)
     {
-        if (identifier_hash_table->count != 0)
+        if (identifier_hash_table.get_count() != 0)
         {
             if (Soar_Instance::Get_Soar_Instance().was_run_from_unit_test())
             {
                 /* If you #define CONFIGURE_SOAR_FOR_UNIT_TESTS and INIT_AFTER_RUN unit_tests.h, the following
                  * detect refcount leaks in unit tests and print out a message accordingly */
                 #ifndef SOAR_RELEASE_VERSION
-                    if (identifier_hash_table->count < 23)
-                        do_for_all_items_in_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
+                    if (identifier_hash_table.get_count() < 23)
+                        identifier_hash_table.do_for_all_items(print_sym, 0);
                     else
-                        std::cout << "Refcount leak of " << identifier_hash_table->count << " identifiers detected. ";
+                        std::cout << "Refcount leak of " << identifier_hash_table.get_count() << " identifiers detected. ";
                 #else
-                    std::cout << "Refcount leak of " << identifier_hash_table->count << " identifiers detected. ";
+                    std::cout << "Refcount leak of " << identifier_hash_table.get_count() << " identifiers detected. ";
                 #endif
             }
             else
@@ -1060,16 +1035,16 @@ void Symbol_Manager::reset_hash_table(MemoryPoolType lHashTable)
             if (thisAgent->outputManager->settings[OM_WARNINGS])
             #endif
             {
-                thisAgent->outputManager->printa_sf(thisAgent, "%d identifiers still exist.  Forcing deletion.\n", identifier_hash_table->count);
-                /* Note:  The do_for_all_items_in_hash_table printing could cause a crash if there's
+                thisAgent->outputManager->printa_sf(thisAgent, "%d identifiers still exist.  Forcing deletion.\n", identifier_hash_table.get_count());
+                /* Note:  The do_for_all_items printing could cause a crash if there's
                  *        memory corruption, but usually prints out and is good for debugging. */
                 #ifndef SOAR_RELEASE_VERSION
-                do_for_all_items_in_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
+                identifier_hash_table.do_for_all_items(print_sym, 0);
                 #endif
             }
-            free_hash_table(thisAgent, identifier_hash_table);
+            identifier_hash_table.clean_up();
             thisAgent->memoryManager->free_memory_pool(MP_identifier);
-            identifier_hash_table = make_hash_table(thisAgent, 0, hash_identifier);
+            identifier_hash_table.init(thisAgent);
         }
     }
 }
@@ -1090,8 +1065,8 @@ bool reset_tc_num(agent* /*thisAgent*/, void* item, void*)
 
 void Symbol_Manager::reset_id_and_variable_tc_numbers()
 {
-    do_for_all_items_in_hash_table(thisAgent, identifier_hash_table, reset_tc_num, 0);
-    do_for_all_items_in_hash_table(thisAgent, variable_hash_table, reset_tc_num, 0);
+    identifier_hash_table.do_for_all_items(reset_tc_num, 0);
+    variable_hash_table.do_for_all_items(reset_tc_num, 0);
 }
 
 Symbol* Symbol_Manager::generate_new_str_constant(const char* prefix, uint64_t* counter)
@@ -11,6 +11,7 @@
 #include "kernel.h"
 
 #include "symbol.h"
+#include "symbol_table.h"
 #include "symbols_predefined.h"
 
 #include <iostream>
@@ -28,7 +29,7 @@ class EXPORT Symbol_Manager {
         predefined_symbols  soarSymbols;
 
         void init_symbol_tables();
-        void retesave(FILE* f);
+        void retesave(FILE* f, bool exact_floats = false);
 
         void create_predefined_symbols();
         void create_common_variables_and_numbers();
@@ -109,11 +110,11 @@ class EXPORT Symbol_Manager {
         uint64_t    current_variable_gensym_number;
         uint64_t    gensymed_variable_count[26];
 
-        struct hash_table_struct* float_constant_hash_table;
-        struct hash_table_struct* identifier_hash_table;
-        struct hash_table_struct* int_constant_hash_table;
-        struct hash_table_struct* str_constant_hash_table;
-        struct hash_table_struct* variable_hash_table;
+        Symbol_Table float_constant_hash_table;
+        Symbol_Table identifier_hash_table;
+        Symbol_Table int_constant_hash_table;
+        Symbol_Table str_constant_hash_table;
+        Symbol_Table variable_hash_table;
 
         void clear_variable_gensym_numbers();
 
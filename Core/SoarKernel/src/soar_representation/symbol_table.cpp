@@ -0,0 +1,251 @@
+/*
+ * symbol_table.cpp
+ *
+ *  Open-addressing hash table that the Symbol_Manager uses to find
+ *  existing symbols.  See symbol_table.h for an overview.
+ */
+
+#include "symbol_table.h"
+
+#include "agent.h"
+#include "memory_manager.h"
+
+#include <assert.h>
+
+/* Smallest number of slots a table ever has.  Must be a power of two. */
+#define SYMBOL_TABLE_MINIMUM_SIZE 64
+
+/* Number of old slots moved into the new array on each add or remove
+ * while a resize is in progress.  With a growth threshold of 1/2 and a
+ * shrink threshold of 1/8, this always drains the old slots before the
+ * next resize is due. */
+#define SYMBOL_TABLE_MIGRATE_STEP 16
+
+/* Marks a slot in the old array whose symbol was moved or removed. */
+#define SYMBOL_TABLE_TOMBSTONE reinterpret_cast<Symbol*>(1)
+
+Symbol_Table::Symbol_Table()
+{
+    thisAgent = NULL;
+    slots = NULL;
+    size = 0;
+    count = 0;
+    old_slots = NULL;
+    old_size = 0;
+    migrate_index = 0;
+}
+
+void Symbol_Table::init(agent* pAgent)
+{
+    thisAgent = pAgent;
+    size = SYMBOL_TABLE_MINIMUM_SIZE;
+    slots = allocate_slots(size);
+    count = 0;
+    old_slots = NULL;
+    old_size = 0;
+    migrate_index = 0;
+}
+
+void Symbol_Table::clean_up()
+{
+    if (slots)
+    {
+        thisAgent->memoryManager->free_memory(slots, HASH_TABLE_MEM_USAGE);
+        slots = NULL;
+    }
+    if (old_slots)
+    {
+        thisAgent->memoryManager->free_memory(old_slots, HASH_TABLE_MEM_USAGE);
+        old_slots = NULL;
+    }
+    size = 0;
+    old_size = 0;
+    count = 0;
+}
+
+symbol_table_slot* Symbol_Table::allocate_slots(uint32_t pSize)
+{
+    return static_cast<symbol_table_slot*>(thisAgent->memoryManager->allocate_memory_and_zerofill(pSize * sizeof(symbol_table_slot), HASH_TABLE_MEM_USAGE));
+}
+
+Symbol* Symbol_Table::find(uint32_t hash, const void* key, symbol_match_fn match)
+{
+    uint32_t mask = size - 1;
+    uint32_t i;
+
+    for (i = hash & mask; slots[i].sym; i = (i + 1) & mask)
+    {
+        if ((slots[i].hash == hash) && (*match)(slots[i].sym, key))
+        {
+            return slots[i].sym;
+        }
+    }
+
+    if (old_slots)
+    {
+        mask = old_size - 1;
+        for (i = hash & mask; old_slots[i].sym; i = (i + 1) & mask)
+        {
+            if ((old_slots[i].sym != SYMBOL_TABLE_TOMBSTONE) && (old_slots[i].hash == hash) && (*match)(old_slots[i].sym, key))
+            {
+                return old_slots[i].sym;
+            }
+        }
+    }
+    return NIL;
+}
+
+void Symbol_Table::insert_slot(uint32_t hash, Symbol* sym)
+{
+    uint32_t mask = size - 1;
+    uint32_t i = hash & mask;
+
+    while (slots[i].sym)
+    {
+        i = (i + 1) & mask;
+    }
+    slots[i].hash = hash;
+    slots[i].sym = sym;
+}
+
+void Symbol_Table::delete_slot(uint32_t index)
+{
+    uint32_t mask = size - 1;
+    uint32_t hole = index;
+    uint32_t i = index;
+    uint32_t home;
+
+    /* --- pull back any later entry in the run whose probe sequence
+     *     passes through the hole --- */
+    for (i = (i + 1) & mask; slots[i].sym; i = (i + 1) & mask)
+    {
+        home = slots[i].hash & mask;
+        if ((hole < i) ? ((home <= hole) || (home > i)) : ((home <= hole) && (home > i)))
+        {
+            slots[hole] = slots[i];
+            hole = i;
+        }
+    }
+    slots[hole].hash = 0;
+    slots[hole].sym = NIL;
+}
+
+void Symbol_Table::add(Symbol* sym, uint32_t hash)
+{
+    migrate_some_slots();
+    count++;
+    if (count > (size / 2))
+    {
+        start_resize(size * 2);
+    }
+    insert_slot(hash, sym);
+}
+
+void Symbol_Table::remove(Symbol* sym, uint32_t hash)
+{
+    uint32_t mask = size - 1;
+    uint32_t i;
+
+    migrate_some_slots();
+
+    for (i = hash & mask; slots[i].sym; i = (i + 1) & mask)
+    {
+        if (slots[i].sym == sym)
+        {
+            delete_slot(i);
+            count--;
+            if (!old_slots && (size > SYMBOL_TABLE_MINIMUM_SIZE) && (count < (size / 8)))
+            {
+                start_resize(size / 2);
+            }
+            return;
+        }
+    }
+
+    if (old_slots)
+    {
+        mask = old_size - 1;
+        for (i = hash & mask; old_slots[i].sym; i = (i + 1) & mask)
+        {
+            if (old_slots[i].sym == sym)
+            {
+                old_slots[i].sym = SYMBOL_TABLE_TOMBSTONE;
+                count--;
+                return;
+            }
+        }
+    }
+    assert(false && "Couldn't find symbol to remove from symbol table!");
+}
+
+void Symbol_Table::start_resize(uint32_t new_size)
+{
+    /* --- normally already drained; only finishes early if the table
+     *     swings between growing and shrinking very quickly --- */
+    finish_migration();
+
+    old_slots = slots;
+    old_size = size;
+    migrate_index = 0;
+    slots = allocate_slots(new_size);
+    size = new_size;
+}
+
+void Symbol_Table::migrate_some_slots()
+{
+    if (!old_slots)
+    {
+        return;
+    }
+
+    uint32_t last = migrate_index + SYMBOL_TABLE_MIGRATE_STEP;
+    if (last > old_size)
+    {
+        last = old_size;
+    }
+    for (; migrate_index < last; migrate_index++)
+    {
+        symbol_table_slot* lSlot = &(old_slots[migrate_index]);
+        if (lSlot->sym && (lSlot->sym != SYMBOL_TABLE_TOMBSTONE))
+        {
+            insert_slot(lSlot->hash, lSlot->sym);
+            lSlot->sym = SYMBOL_TABLE_TOMBSTONE;
+        }
+    }
+
+    if (migrate_index == old_size)
+    {
+        thisAgent->memoryManager->free_memory(old_slots, HASH_TABLE_MEM_USAGE);
+        old_slots = NULL;
+        old_size = 0;
+        migrate_index = 0;
+    }
+}
+
+void Symbol_Table::finish_migration()
+{
+    while (old_slots)
+    {
+        migrate_some_slots();
+    }
+}
+
+void Symbol_Table::do_for_all_items(hash_table_callback_fn2 f, void* userdata)
+{
+    uint32_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        if (slots[i].sym && (*f)(thisAgent, slots[i].sym, userdata))
+        {
+            return;
+        }
+    }
+    for (i = 0; i < old_size; i++)
+    {
+        if (old_slots[i].sym && (old_slots[i].sym != SYMBOL_TABLE_TOMBSTONE) && (*f)(thisAgent, old_slots[i].sym, userdata))
+        {
+            return;
+        }
+    }
+}
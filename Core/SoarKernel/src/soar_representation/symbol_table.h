@@ -0,0 +1,85 @@
+/*
+ * symbol_table.h
+ *
+ *  Open-addressing hash table that the Symbol_Manager uses to find
+ *  existing symbols.  See the comment at the end of the file.
+ */
+
+#ifndef CORE_SOARKERNEL_SRC_SOAR_REPRESENTATION_SYMBOL_TABLE_H_
+#define CORE_SOARKERNEL_SRC_SOAR_REPRESENTATION_SYMBOL_TABLE_H_
+
+#include "kernel.h"
+#include "mem.h"
+
+typedef bool (*symbol_match_fn)(Symbol* sym, const void* key);
+
+typedef struct symbol_table_slot_struct
+{
+    uint32_t    hash;
+    Symbol*     sym;
+} symbol_table_slot;
+
+class Symbol_Table
+{
+    public:
+
+        Symbol_Table();
+        ~Symbol_Table() {};
+
+        void        init(agent* pAgent);
+        void        clean_up();
+
+        uint64_t    get_count() { return count; }
+
+        Symbol*     find(uint32_t hash, const void* key, symbol_match_fn match);
+        void        add(Symbol* sym, uint32_t hash);
+        void        remove(Symbol* sym, uint32_t hash);
+
+        void        do_for_all_items(hash_table_callback_fn2 f, void* userdata);
+
+    private:
+
+        agent*              thisAgent;
+
+        symbol_table_slot*  slots;
+        uint32_t            size;
+        uint64_t            count;
+
+        symbol_table_slot*  old_slots;
+        uint32_t            old_size;
+        uint32_t            migrate_index;
+
+        symbol_table_slot*  allocate_slots(uint32_t pSize);
+        void                insert_slot(uint32_t hash, Symbol* sym);
+        void                delete_slot(uint32_t index);
+        void                start_resize(uint32_t new_size);
+        void                migrate_some_slots();
+        void                finish_migration();
+};
+
+#endif /* CORE_SOARKERNEL_SRC_SOAR_REPRESENTATION_SYMBOL_TABLE_H_ */
+
+/* ======================================================================
+                              symbol_table.h
+
+   The symbol tables are the hottest hash tables in the kernel: every
+   constant that comes in on the input link is looked up, and usually
+   created, through one of them.  Rather than use the generic chained
+   tables in mem.h, which rehash every item at once when they grow,
+   a Symbol_Table keeps an array of (hash, symbol) slots and uses linear
+   probing, so a lookup is a single probe sequence over adjacent slots.
+   The full 32-bit hash of each symbol is stored in its slot, so string
+   comparisons only happen when the hashes agree.
+
+   The table grows when it is half full and shrinks when it is less than
+   an eighth full.  Resizing does not move any symbols right away.  The
+   current slots are kept as the "old" slots and every later add() or
+   remove() moves a few of them into the new array, so the cost of a
+   resize is spread across many operations instead of causing a pause.
+   Until the old slots are drained, find() probes the new array and then
+   the old one.  Slots vacated in the old array are marked with a
+   tombstone so that probe sequences running through them stay intact.
+
+   Deleting from the current array uses backward-shift deletion, so no
+   tombstones ever build up there.
+====================================================================== */
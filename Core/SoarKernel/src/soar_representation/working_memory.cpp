@@ -55,8 +55,7 @@ WM_Manager::WM_Manager(agent* myAgent)
     wma_stats = new wma_stat_container(thisAgent);
     wma_timers = new wma_timer_container(thisAgent);
 
-    wma_forget_pq = new wma_forget_p_queue();
-    wma_touched_sets = new wma_decay_cycle_set();
+    wma_forget_pq = new wma_forget_wheel();
     wma_touched_elements = new wme_set();
     wma_initialized = false;
     wma_tc_counter = 2;
@@ -72,7 +71,6 @@ void WM_Manager::clean_up_for_agent_deletion()
     wma_params->activation->set_value(off);
     delete wma_forget_pq;
     delete wma_touched_elements;
-    delete wma_touched_sets;
     delete wma_params;
     delete wma_stats;
     delete wma_timers;
@@ -110,27 +108,38 @@ wme* make_wme(agent* thisAgent, Symbol* id, Symbol* attr, Symbol* value, bool ac
     w->preference = NIL;
     w->output_link = NIL;
     w->tc = 0;
-    w->chunker_bt_last_ground_cond = NULL;
-    w->is_singleton = false;
-    w->singleton_status_checked = false;
-    w->local_singleton_id_identity_set = NULL_IDENTITY_SET;
-    w->local_singleton_value_identity_set = NULL_IDENTITY_SET;
     w->next = NIL;
     w->prev = NIL;
     w->rete_next = NIL;
     w->rete_prev = NIL;
+    w->cold = NIL;
 
-    w->gds = NIL;
-    w->gds_prev = NIL;
-    w->gds_next = NIL;
+    return w;
+}
 
-    w->wma_decay_el = NIL;
-    w->wma_tc_value = 0;
+wme_cold* make_wme_cold(agent* thisAgent, wme* w)
+{
+    wme_cold* c;
 
-    w->epmem_id = EPMEM_NODEID_BAD;
-    w->epmem_valid = NIL;
+    thisAgent->memoryManager->allocate_with_pool(MP_wme_cold, &c);
+    c->chunker_bt_last_ground_cond = NULL;
+    c->is_singleton = false;
+    c->singleton_status_checked = false;
+    c->local_singleton_id_identity_set = NULL_IDENTITY_SET;
+    c->local_singleton_value_identity_set = NULL_IDENTITY_SET;
 
-    return w;
+    c->gds = NIL;
+    c->gds_prev = NIL;
+    c->gds_next = NIL;
+
+    c->wma_decay_el = NIL;
+    c->wma_tc_value = 0;
+
+    c->epmem_id = EPMEM_NODEID_BAD;
+    c->epmem_valid = NIL;
+
+    w->cold = c;
+    return c;
 }
 
 /* --- lists of buffered WM changes --- */
@@ -165,14 +174,15 @@ void remove_wme_from_wm(agent* thisAgent, wme* w)
     /* When we remove a WME, we always have to determine if it's on a GDS, and, if
     so, after removing the WME, if there are no longer any WMEs on the GDS,
     then we can free the GDS memory */
-    if (w->gds)
+    goal_dependency_set* gds = wme_gds(w);
+    if (gds)
     {
-        fast_remove_from_dll(w->gds->wmes_in_gds, w, wme, gds_next, gds_prev);
+        fast_remove_from_dll(gds->wmes_in_gds, w, wme, cold->gds_next, cold->gds_prev);
 
-        if (!w->gds->wmes_in_gds)
+        if (!gds->wmes_in_gds)
         {
-            if (w->gds->goal) w->gds->goal->id->gds = NIL;
-            thisAgent->memoryManager->free_with_pool(MP_gds, w->gds);
+            if (gds->goal) gds->goal->id->gds = NIL;
+            thisAgent->memoryManager->free_with_pool(MP_gds, gds);
         }
     }
 }
@@ -245,8 +255,8 @@ void do_buffered_wm_changes(agent* thisAgent)
             }
         }
         #endif
-        add_wme_to_rete(thisAgent, static_cast<wme_struct*>(c->first));
     }
+    add_wmes_to_rete(thisAgent, thisAgent->wmes_to_add);
     for (c = thisAgent->wmes_to_remove; c != NIL; c = c->rest)
     {
         w = (wme_struct*)(c->first);
@@ -340,10 +350,14 @@ void deallocate_wme(agent* thisAgent, wme* w)
 {
     if (wma_enabled(thisAgent)) wma_remove_decay_element(thisAgent, w);
 
-    if (w->local_singleton_value_identity_set)
+    if (w->cold)
     {
-        IdentitySet_remove_ref(thisAgent, w->local_singleton_id_identity_set);
-        IdentitySet_remove_ref(thisAgent, w->local_singleton_value_identity_set);
+        if (w->cold->local_singleton_value_identity_set)
+        {
+            IdentitySet_remove_ref(thisAgent, w->cold->local_singleton_id_identity_set);
+            IdentitySet_remove_ref(thisAgent, w->cold->local_singleton_value_identity_set);
+        }
+        thisAgent->memoryManager->free_with_pool(MP_wme_cold, w->cold);
     }
     thisAgent->symbolManager->symbol_remove_ref(&w->id);
     thisAgent->symbolManager->symbol_remove_ref(&w->attr);
@@ -61,8 +61,7 @@ class WM_Manager
         wma_timer_container*    wma_timers;
 
         wme_set*                wma_touched_elements;
-        wma_forget_p_queue*     wma_forget_pq;
-        wma_decay_cycle_set*    wma_touched_sets;
+        wma_forget_wheel*       wma_forget_pq;
 
         unsigned int            wma_power_size;
         double*                 wma_power_array;
@@ -80,40 +79,66 @@ class WM_Manager
 
 };
 
+/* Subsystem state that the matcher never looks at.  It is kept out of the
+   wme itself so that the fields the rete walks stay packed together, and is
+   only allocated the first time a subsystem stores something for the wme. */
+typedef struct wme_cold_struct
+{
+    struct condition_struct*    chunker_bt_last_ground_cond;
+    bool                        is_singleton;
+    bool                        singleton_status_checked;
+    Identity*                   local_singleton_id_identity_set;
+    Identity*                   local_singleton_value_identity_set;
+
+    struct gds_struct*          gds;
+    struct wme_struct*          gds_next, *gds_prev;   /* wmes in gds */
+
+    epmem_node_id               epmem_id;
+    uint64_t                    epmem_valid;
+
+    wma_decay_element*          wma_decay_el;
+    tc_number                   wma_tc_value;
+} wme_cold;
+
 typedef struct wme_struct
 {
     /* WARNING:  The next three fields (id,attr,value) MUST be consecutive.  The rete code relies on this! */
     Symbol*                     id;
     Symbol*                     attr;
     Symbol*                     value;
-    bool                        acceptable;
-    uint64_t                    timetag;
-    uint64_t                    reference_count;
-
     struct wme_struct           *rete_next, *rete_prev;
     struct right_mem_struct*    right_mems;
     struct token_struct*        tokens;
     struct wme_struct           *next, *prev;
 
+    uint64_t                    timetag;
+    uint64_t                    reference_count;
+    tc_number                   tc;
+    bool                        acceptable;
+
     struct preference_struct*   preference;             /* pref. supporting it, or NIL */
     struct output_link_struct*  output_link;            /* for top-state output commands */
 
-    tc_number                   tc;
-    struct condition_struct*    chunker_bt_last_ground_cond;
-    bool                        is_singleton;
-    bool                        singleton_status_checked;
-    Identity*                   local_singleton_id_identity_set;
-    Identity*                   local_singleton_value_identity_set;
+    wme_cold*                   cold;                   /* EBC, GDS, epmem and WMA state, or NIL */
+} wme;
 
-    struct gds_struct*          gds;
-    struct wme_struct*          gds_next, *gds_prev;   /* wmes in gds */
+wme_cold* make_wme_cold(agent* thisAgent, wme* w);
 
-    epmem_node_id               epmem_id;
-    uint64_t                    epmem_valid;
+/* Returns the cold record of a wme, allocating it if this is the first use */
+inline wme_cold* wme_cold_data(agent* thisAgent, wme* w)
+{
+    return w->cold ? w->cold : make_wme_cold(thisAgent, w);
+}
 
-    wma_decay_element*          wma_decay_el;
-    tc_number                   wma_tc_value;
-} wme;
+inline goal_dependency_set* wme_gds(wme* w)
+{
+    return w->cold ? w->cold->gds : NIL;
+}
+
+inline wma_decay_element* wme_wma_decay_el(wme* w)
+{
+    return w->cold ? w->cold->wma_decay_el : NIL;
+}
 
 inline void wme_add_ref(wme* w, bool always_add = false)
 {
@@ -175,8 +200,16 @@ inline Symbol* get_wme_element(wme* w, WME_Field f)
       tc:  used by EBC when determining whether a wme is in the grounds,
            or locals
 
-      chunker_bt_pref: used by EBC; set to cond->bt.trace when
-         a wme is added to either the potentials or locals set
+      cold:  the wme's wme_cold record, which holds the fields below.  It
+         is NIL until wme_cold_data() is first called for the wme, so code
+         that only reads these fields must treat a NIL record as holding
+         the defaults (NIL/false/0, EPMEM_NODEID_BAD for epmem_id).
+
+      chunker_bt_last_ground_cond: used by EBC; set to the last grounded
+         condition that tested the wme while backtracing
+
+      is_singleton, singleton_status_checked, local_singleton_*_identity_set:
+         used by EBC to cache singleton checks on superstate wmes
 
       These are the additions to the WME structure that will be used
          to track dependencies for goals.  Each working memory element
@@ -191,6 +224,11 @@ inline Symbol* get_wme_element(wme* w, WME_Field f)
      dependent for more than one goal, then it will point to the GDS
      of the highest goal.
 
+      epmem_id, epmem_valid:  node id of the wme in the episodic store and
+         the epmem validation counter it was assigned under
+
+      wma_decay_el, wma_tc_value:  working memory activation state
+
    Reference counts on wmes:
       +1 if the wme is currently in WM
       +1 for each instantiation condition that points to it (bt.wme)
@@ -290,14 +290,8 @@ void wma_deinit(agent* thisAgent)
 
     // clear touched
     thisAgent->WM->wma_touched_elements->clear();
-    thisAgent->WM->wma_touched_sets->clear();
 
     // clear forgetting priority queue
-    for (wma_forget_p_queue::iterator pq_p = thisAgent->WM->wma_forget_pq->begin(); pq_p != thisAgent->WM->wma_forget_pq->end(); pq_p++)
-    {
-        pq_p->second->~wma_decay_set();
-        thisAgent->memoryManager->free_with_pool(MP_wma_decay_set, pq_p->second);
-    }
     thisAgent->WM->wma_forget_pq->clear();
 
     thisAgent->WM->wma_initialized = false;
@@ -340,48 +334,68 @@ inline double wma_pow(agent* thisAgent, wma_d_cycle cycle_diff)
     }
 }
 
-inline double wma_sum_history(agent* thisAgent, wma_history* history, wma_d_cycle current_cycle)
+inline void wma_history_to_columns(agent* thisAgent, wma_history* history, wma_history_columns* columns)
 {
-    double return_val = 0.0;
-
     unsigned int p = history->next_p;
-    unsigned int counter = history->history_ct;
-    wma_d_cycle cycle_diff = 0;
-
-    //
 
-    while (counter)
+    columns->count = history->history_ct;
+    columns->total_references = 0.0;
+    for (unsigned int i = 0; i < columns->count; i++)
     {
         p = wma_history_prev(p);
 
-        cycle_diff = (current_cycle - history->access_history[ p ].d_cycle);
+        columns->cycles[ i ] = history->access_history[ p ].d_cycle;
+        columns->references[ i ] = static_cast<double>(history->access_history[ p ].num_references);
+        columns->total_references += columns->references[ i ];
+    }
 
-        return_val += (history->access_history[ p ].num_references * wma_pow(thisAgent, cycle_diff));
+    // see (Petrov, 2006)
+    columns->older_references = 0.0;
+    if ((thisAgent->WM->wma_params->petrov_approx->get_value() == on) && (history->total_references > history->history_references))
+    {
+        columns->older_references = static_cast<double>(history->total_references - history->history_references);
+        columns->first_reference = history->first_reference;
 
-        counter--;
+        // decay_rate is negated (for nice printing)
+        columns->d_inv = (1 + thisAgent->WM->wma_params->decay_rate->get_value());
     }
+}
 
-    // see (Petrov, 2006)
-    if (thisAgent->WM->wma_params->petrov_approx->get_value() == on)
+inline double wma_sum_columns(agent* thisAgent, wma_history_columns* columns, wma_d_cycle current_cycle)
+{
+    double return_val = 0.0;
+    wma_d_cycle cycle_diff = 0;
+
+    for (unsigned int i = 0; i < columns->count; i++)
     {
-        // if ( n > k )
-        if (history->total_references > history->history_references)
-        {
-            // ( n - k ) * ( tn^(1-d) - tk^(1-d) )
-            // -----------------------------------
-            // ( 1 - d ) * ( tn - tk )
+        cycle_diff = (current_cycle - columns->cycles[ i ]);
 
-            // decay_rate is negated (for nice printing)
-            double d_inv = (1 + thisAgent->WM->wma_params->decay_rate->get_value());
+        return_val += (columns->references[ i ] * wma_pow(thisAgent, cycle_diff));
+    }
 
-            return_val += (((history->total_references - history->history_references) * (pow(static_cast<double>(current_cycle - history->first_reference), d_inv) - pow(static_cast<double>(cycle_diff), d_inv))) /
-                           (d_inv * ((current_cycle - history->first_reference) - cycle_diff)));
-        }
+    // if ( n > k )
+    if (columns->older_references > 0.0)
+    {
+        // ( n - k ) * ( tn^(1-d) - tk^(1-d) )
+        // -----------------------------------
+        // ( 1 - d ) * ( tn - tk )
+
+        return_val += ((columns->older_references * (pow(static_cast<double>(current_cycle - columns->first_reference), columns->d_inv) - pow(static_cast<double>(cycle_diff), columns->d_inv))) /
+                       (columns->d_inv * ((current_cycle - columns->first_reference) - cycle_diff)));
     }
 
     return return_val;
 }
 
+inline double wma_sum_history(agent* thisAgent, wma_history* history, wma_d_cycle current_cycle)
+{
+    wma_history_columns columns;
+
+    wma_history_to_columns(thisAgent, history, &columns);
+
+    return wma_sum_columns(thisAgent, &columns, current_cycle);
+}
+
 inline double wma_calculate_decay_activation(agent* thisAgent, wma_decay_element* decay_el, wma_d_cycle current_cycle, bool log_result)
 {
     wma_history* history = &(decay_el->touches);
@@ -429,14 +443,14 @@ inline wma_reference wma_calculate_initial_boost(agent* thisAgent, wme* w)
         {
             for (cond = pref->inst->top_of_instantiated_conditions; cond != NIL; cond = cond->next)
             {
-                if ((cond->type == POSITIVE_CONDITION) && (cond->bt.wme_->wma_tc_value != tc))
+                if ((cond->type == POSITIVE_CONDITION) && (wme_cold_data(thisAgent, cond->bt.wme_)->wma_tc_value != tc))
                 {
                     cond_wme = cond->bt.wme_;
-                    cond_wme->wma_tc_value = tc;
+                    cond_wme->cold->wma_tc_value = tc;
 
-                    if (cond_wme->wma_decay_el)
+                    if (wme_wma_decay_el(cond_wme))
                     {
-                        if (!cond_wme->wma_decay_el->just_created)
+                        if (!cond_wme->cold->wma_decay_el->just_created)
                         {
                             num_cond_wmes++;
                             combined_time_sum += wma_get_wme_activation(thisAgent, cond_wme, false);
@@ -448,12 +462,12 @@ inline wma_reference wma_calculate_initial_boost(agent* thisAgent, wme* w)
                         {
                             for (wme_p = cond_wme->preference->wma_o_set->begin(); wme_p != cond_wme->preference->wma_o_set->end(); wme_p++)
                             {
-                                if (((*wme_p)->wma_tc_value != tc) && (!(*wme_p)->wma_decay_el || !(*wme_p)->wma_decay_el->just_created))
+                                if ((wme_cold_data(thisAgent, *wme_p)->wma_tc_value != tc) && (!(*wme_p)->cold->wma_decay_el || !(*wme_p)->cold->wma_decay_el->just_created))
                                 {
                                     num_cond_wmes++;
                                     combined_time_sum += wma_get_wme_activation(thisAgent, (*wme_p), false);
 
-                                    (*wme_p)->wma_tc_value = tc;
+                                    (*wme_p)->cold->wma_tc_value = tc;
                                 }
                             }
                         }
@@ -481,7 +495,7 @@ void wma_activate_wme(agent* thisAgent, wme* w, wma_reference num_references, wm
     // o-supported, non-architectural WME
     if (wma_should_have_decay_element(w))
     {
-        wma_decay_element* temp_el = w->wma_decay_el;
+        wma_decay_element* temp_el = wme_wma_decay_el(w);
 
         // if decay structure doesn't exist, create it
         if (!temp_el)
@@ -509,8 +523,10 @@ void wma_activate_wme(agent* thisAgent, wme* w, wma_reference num_references, wm
 
             // prevents confusion with delayed forgetting
             temp_el->forget_cycle = static_cast< wma_d_cycle >(-1);
+            temp_el->forget_next = NULL;
+            temp_el->forget_pprev = NULL;
 
-            w->wma_decay_el = temp_el;
+            wme_cold_data(thisAgent, w)->wma_decay_el = temp_el;
             if (w->id->symbol_type == IDENTIFIER_SYMBOL_TYPE && w->id->id->LTI_ID)
             {
                 thisAgent->SMem->smem_wmas->emplace(w->id->id->LTI_ID,temp_el);
@@ -663,9 +679,9 @@ void wma_activate_wme(agent* thisAgent, wme* w, wma_reference num_references, wm
             // the wme preference)
             else
             {
-                if ((*wme_p)->wma_decay_el)
+                if (wme_wma_decay_el(*wme_p))
                 {
-                    (*wme_p)->wma_decay_el->num_references += num_references;
+                    (*wme_p)->cold->wma_decay_el->num_references += num_references;
                     thisAgent->WM->wma_touched_elements->insert((*wme_p));
                 }
             }
@@ -685,7 +701,7 @@ void wma_activate_wme(agent* thisAgent, wme* w, wma_reference num_references, wm
 inline void wma_forgetting_remove_from_p_queue(agent* thisAgent, wma_decay_element* decay_el);
 void wma_deactivate_element(agent* thisAgent, wme* w)
 {
-    wma_decay_element* temp_el = w->wma_decay_el;
+    wma_decay_element* temp_el = wme_wma_decay_el(w);
 
     if (temp_el)
     {
@@ -705,7 +721,7 @@ void wma_deactivate_element(agent* thisAgent, wme* w)
                 auto wmas = thisAgent->SMem->smem_wmas->equal_range(w->id->id->LTI_ID);
                 for (auto wma = wmas.first; wma != wmas.second; ++wma)
                 {
-                    if (wma->second == w->wma_decay_el)
+                    if (wma->second == temp_el)
                     {
                         thisAgent->SMem->smem_wmas->erase(wma);
                         break;
@@ -719,7 +735,7 @@ void wma_deactivate_element(agent* thisAgent, wme* w)
 
 void wma_remove_decay_element(agent* thisAgent, wme* w)
 {
-    wma_decay_element* temp_el = w->wma_decay_el;
+    wma_decay_element* temp_el = wme_wma_decay_el(w);
 
     if (temp_el)
     {
@@ -751,7 +767,7 @@ void wma_remove_decay_element(agent* thisAgent, wme* w)
         }
 
         thisAgent->memoryManager->free_with_pool(MP_wma_decay_element, temp_el);
-        w->wma_decay_el = NULL;
+        w->cold->wma_decay_el = NULL;
     }
 }
 
@@ -782,62 +798,296 @@ void wma_remove_pref_o_set(agent* thisAgent, preference* pref)
 //////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////
 
-inline void wma_forgetting_add_to_p_queue(agent* thisAgent, wma_decay_element* decay_el, wma_d_cycle new_cycle)
+void wma_forget_wheel::reset()
 {
-    if (decay_el)
+    for (int level = 0; level < LEVELS; level++)
     {
-        decay_el->forget_cycle = new_cycle;
+        for (int i = 0; i < SIZE; i++)
+        {
+            slots[ level ][ i ] = NULL;
+        }
+    }
+    overflow = NULL;
+    due = NULL;
+    current = 0;
+    count = 0;
+}
+
+void wma_forget_wheel::clear()
+{
+    wma_decay_element* decay_el;
 
-        wma_forget_p_queue::iterator pq_p = thisAgent->WM->wma_forget_pq->find(new_cycle);
-        if (pq_p == thisAgent->WM->wma_forget_pq->end())
+    while ((decay_el = pop_due()))
+    {
+        // keep going until every slot has been emptied
+    }
+    for (int level = 0; level < LEVELS; level++)
+    {
+        for (int i = 0; i < SIZE; i++)
         {
-            wma_decay_set* newbie;
-            thisAgent->memoryManager->allocate_with_pool(MP_wma_decay_set, &newbie);
-#ifdef USE_MEM_POOL_ALLOCATORS
-            newbie = new(newbie) wma_decay_set(std::less< wma_decay_element* >(), soar_module::soar_memory_pool_allocator< wma_decay_element* >(thisAgent));
-#else
-            newbie = new(newbie) wma_decay_set();
-#endif
-            newbie->insert(decay_el);
+            while ((decay_el = slots[ level ][ i ]))
+            {
+                remove(decay_el);
+            }
+        }
+    }
+    while ((decay_el = overflow))
+    {
+        remove(decay_el);
+    }
+    reset();
+}
+
+void wma_forget_wheel::link(wma_decay_element** head, wma_decay_element* decay_el)
+{
+    decay_el->forget_next = (*head);
+    if (*head)
+    {
+        (*head)->forget_pprev = &(decay_el->forget_next);
+    }
+    (*head) = decay_el;
+    decay_el->forget_pprev = head;
+}
+
+void wma_forget_wheel::file(wma_decay_element* decay_el)
+{
+    wma_d_cycle cycle = decay_el->forget_cycle;
+
+    if (cycle < current)
+    {
+        link(&due, decay_el);
+        return;
+    }
 
-            thisAgent->WM->wma_forget_pq->insert(std::make_pair(new_cycle, newbie));
+    wma_d_cycle delta = (cycle - current);
+    for (int level = 0; level < LEVELS; level++)
+    {
+        if (delta < (static_cast<wma_d_cycle>(1) << (BITS * (level + 1))))
+        {
+            link(&(slots[ level ][ (cycle >> (BITS * level)) & (SIZE - 1) ]), decay_el);
+            return;
         }
-        else
+    }
+    link(&overflow, decay_el);
+}
+
+void wma_forget_wheel::refile(wma_decay_element** head)
+{
+    wma_decay_element* decay_el = (*head);
+    wma_decay_element* next_el;
+
+    (*head) = NULL;
+    for (; decay_el; decay_el = next_el)
+    {
+        next_el = decay_el->forget_next;
+        file(decay_el);
+    }
+}
+
+void wma_forget_wheel::schedule(wma_decay_element* decay_el, wma_d_cycle cycle)
+{
+    remove(decay_el);
+
+    decay_el->forget_cycle = cycle;
+    file(decay_el);
+    count++;
+}
+
+void wma_forget_wheel::remove(wma_decay_element* decay_el)
+{
+    if (decay_el->forget_pprev)
+    {
+        (*decay_el->forget_pprev) = decay_el->forget_next;
+        if (decay_el->forget_next)
         {
-            pq_p->second->insert(decay_el);
+            decay_el->forget_next->forget_pprev = decay_el->forget_pprev;
         }
+        decay_el->forget_next = NULL;
+        decay_el->forget_pprev = NULL;
+        count--;
     }
 }
 
-inline void wma_forgetting_remove_from_p_queue(agent* thisAgent, wma_decay_element* decay_el)
+void wma_forget_wheel::advance(wma_d_cycle now)
 {
-    if (decay_el)
+    // nothing to walk past
+    if (count == 0)
+    {
+        current = (now + 1);
+        return;
+    }
+
+    for (; current <= now; current++)
     {
-        // try to find set for the element per cycle
-        wma_forget_p_queue::iterator pq_p = thisAgent->WM->wma_forget_pq->find(decay_el->forget_cycle);
-        if (pq_p != thisAgent->WM->wma_forget_pq->end())
+        // when a coarser slot's span comes up, spread it over the finer slots
+        if ((current & (SIZE - 1)) == 0)
         {
-            wma_decay_set::iterator d_p = pq_p->second->find(decay_el);
-            if (d_p != pq_p->second->end())
-            {
-                pq_p->second->erase(d_p);
+            int level = 1;
 
-                if (pq_p->second->empty())
-                {
-                    thisAgent->WM->wma_touched_sets->insert(pq_p->first);
-                }
+            while ((level < LEVELS) && (((current >> (BITS * level)) & (SIZE - 1)) == 0))
+            {
+                level++;
+            }
+            if (level == LEVELS)
+            {
+                refile(&overflow);
+                level--;
+            }
+            for (; level >= 1; level--)
+            {
+                refile(&(slots[ level ][ (current >> (BITS * level)) & (SIZE - 1) ]));
             }
         }
+
+        wma_decay_element** slot = &(slots[ 0 ][ current & (SIZE - 1) ]);
+        while (*slot)
+        {
+            wma_decay_element* decay_el = (*slot);
+            (*slot) = decay_el->forget_next;
+            link(&due, decay_el);
+        }
+    }
+}
+
+wma_decay_element* wma_forget_wheel::pop_due()
+{
+    wma_decay_element* decay_el = due;
+
+    if (decay_el)
+    {
+        remove(decay_el);
+    }
+    return decay_el;
+}
+
+inline void wma_forgetting_add_to_p_queue(agent* thisAgent, wma_decay_element* decay_el, wma_d_cycle new_cycle)
+{
+    if (decay_el)
+    {
+        thisAgent->WM->wma_forget_pq->schedule(decay_el, new_cycle);
+    }
+}
+
+inline void wma_forgetting_remove_from_p_queue(agent* thisAgent, wma_decay_element* decay_el)
+{
+    if (decay_el)
+    {
+        thisAgent->WM->wma_forget_pq->remove(decay_el);
     }
 }
 
 inline void wma_forgetting_move_in_p_queue(agent* thisAgent, wma_decay_element* decay_el, wma_d_cycle new_cycle)
 {
-    if (decay_el && (decay_el->forget_cycle != new_cycle))
+    if (decay_el && ((decay_el->forget_cycle != new_cycle) || !decay_el->forget_pprev))
+    {
+        thisAgent->WM->wma_forget_pq->schedule(decay_el, new_cycle);
+    }
+}
+
+// Finds how many cycles after current_cycle the activation of an element
+// first falls below the forgetting threshold.
+//
+// Since t^d decreases, the history references alone sum to at most
+// n * (t - newest)^d and at least n * (t - oldest)^d, so the crossing lies
+// within the span of the history from (thresh / n)^(1/d) cycles after the
+// oldest reference (the Petrov term can only push it later).  The search
+// starts from that bracket, gallops out of it if it has to, and bisects,
+// rather than doubling up from one cycle, which took twice the log of the
+// gap in evaluations.
+inline wma_d_cycle wma_forgetting_search_cycle(agent* thisAgent, wma_decay_element* decay_el, wma_d_cycle current_cycle)
+{
+    double my_thresh = thisAgent->WM->wma_thresh_exp;
+    wma_history_columns columns;
+
+    wma_history_to_columns(thisAgent, &(decay_el->touches), &columns);
+
+    // nothing to decay from
+    if (!columns.count)
+    {
+        return 1;
+    }
+
+    // bracket (as offsets from current_cycle)
+    wma_d_cycle low = 1;
+    wma_d_cycle high = 1;
+    if (columns.total_references > 0.0)
+    {
+        double reach = pow(my_thresh / columns.total_references, 1.0 / thisAgent->WM->wma_params->decay_rate->get_value());
+        double oldest = (static_cast<double>(columns.cycles[ columns.count - 1 ]) + reach) - static_cast<double>(current_cycle);
+        double newest = (static_cast<double>(columns.cycles[ 0 ]) + reach) - static_cast<double>(current_cycle);
+
+        // keep clear of overflow on absurd thresholds
+        if (oldest > 1.0)
+        {
+            low = static_cast<wma_d_cycle>((oldest < WMA_SEARCH_LIMIT) ? oldest : WMA_SEARCH_LIMIT);
+        }
+        if (newest > 1.0)
+        {
+            high = static_cast<wma_d_cycle>(ceil((newest < WMA_SEARCH_LIMIT) ? newest : WMA_SEARCH_LIMIT));
+        }
+        if (high < low)
+        {
+            high = low;
+        }
+    }
+
+    // above is the largest offset known to be at or above the threshold
+    // (0 for none) and below the smallest known to be under it
+    wma_d_cycle above = 0;
+    wma_d_cycle below = 0;
+    wma_d_cycle step;
+
+    if (wma_sum_columns(thisAgent, &columns, current_cycle + low) < my_thresh)
     {
-        wma_forgetting_remove_from_p_queue(thisAgent, decay_el);
-        wma_forgetting_add_to_p_queue(thisAgent, decay_el, new_cycle);
+        below = low;
+        for (step = 1; ; step *= 2)
+        {
+            if (below <= step)
+            {
+                break;
+            }
+            if (wma_sum_columns(thisAgent, &columns, current_cycle + (below - step)) >= my_thresh)
+            {
+                above = (below - step);
+                break;
+            }
+            below -= step;
+        }
+    }
+    else if ((high > low) && (wma_sum_columns(thisAgent, &columns, current_cycle + high) < my_thresh))
+    {
+        above = low;
+        below = high;
     }
+    else
+    {
+        above = high;
+        for (step = 1; ; step *= 2)
+        {
+            if (wma_sum_columns(thisAgent, &columns, current_cycle + (above + step)) < my_thresh)
+            {
+                below = (above + step);
+                break;
+            }
+            above += step;
+        }
+    }
+
+    while ((below - above) > 1)
+    {
+        wma_d_cycle mid = (above + ((below - above) / 2));
+
+        if (wma_sum_columns(thisAgent, &columns, current_cycle + mid) < my_thresh)
+        {
+            below = mid;
+        }
+        else
+        {
+            above = mid;
+        }
+    }
+
+    return below;
 }
 
 inline wma_d_cycle wma_forgetting_estimate_cycle(agent* thisAgent, wma_decay_element* decay_el, bool fresh_reference)
@@ -877,64 +1127,7 @@ inline wma_d_cycle wma_forgetting_estimate_cycle(agent* thisAgent, wma_decay_ele
 
     if (return_val == static_cast<wma_d_cycle>(thisAgent->WM->wma_d_cycle_count))
     {
-        double my_thresh = thisAgent->WM->wma_thresh_exp;
-
-        // binary parameter search
-        {
-            wma_d_cycle to_add = 1;
-            double act = wma_calculate_decay_activation(thisAgent, decay_el, (return_val + to_add), false);
-
-            if (act >= my_thresh)
-            {
-                while (act >= my_thresh)
-                {
-                    to_add *= 2;
-                    act = wma_calculate_decay_activation(thisAgent, decay_el, (return_val + to_add), false);
-                }
-
-                //
-
-                wma_d_cycle upper_bound = to_add;
-                wma_d_cycle lower_bound, mid;
-                if (to_add < 4)
-                {
-                    lower_bound = upper_bound;
-                }
-                else
-                {
-                    lower_bound = (to_add / 2);
-                }
-
-                while (lower_bound != upper_bound)
-                {
-                    mid = ((lower_bound + upper_bound) / 2);
-                    act = wma_calculate_decay_activation(thisAgent, decay_el, (return_val + mid), false);
-
-                    if (act < my_thresh)
-                    {
-                        upper_bound = mid;
-
-                        if (upper_bound - lower_bound <= 1)
-                        {
-                            lower_bound = mid;
-                        }
-                    }
-                    else
-                    {
-                        lower_bound = mid;
-
-                        if (upper_bound - lower_bound <= 1)
-                        {
-                            lower_bound = upper_bound;
-                        }
-                    }
-                }
-
-                to_add = upper_bound;
-            }
-
-            return_val += to_add;
-        }
+        return_val += wma_forgetting_search_cycle(thisAgent, decay_el, return_val);
     }
 
     return return_val;
@@ -977,96 +1170,73 @@ inline bool wma_forgetting_update_p_queue(agent* thisAgent)
     slot* s;
     wme* w;
 
+    // brings anything due up to this cycle into view
+    thisAgent->WM->wma_forget_pq->advance(thisAgent->WM->wma_d_cycle_count);
+
     if (!thisAgent->WM->wma_forget_pq->empty())
     {
-        wma_forget_p_queue::iterator pq_p = thisAgent->WM->wma_forget_pq->begin();
+        wma_forget_wheel* pq = thisAgent->WM->wma_forget_pq;
+        wma_decay_element* decay_el;
         wma_d_cycle current_cycle = thisAgent->WM->wma_d_cycle_count;
         double decay_thresh = thisAgent->WM->wma_thresh_exp;
         bool forget_only_lti = (thisAgent->WM->wma_params->forget_wme->get_value() == wma_param_container::lti);
 
-        if (pq_p->first == current_cycle)
+        while ((decay_el = pq->pop_due()))
         {
-            wma_decay_set::iterator d_p = pq_p->second->begin();
-            wma_decay_set::iterator current_p;
-
-            while (d_p != pq_p->second->end())
+            if (wma_calculate_decay_activation(thisAgent, decay_el, current_cycle, false) < decay_thresh)
             {
-                current_p = d_p++;
+                decay_el->forget_cycle = WMA_FORGOTTEN_CYCLE;
 
-                if (wma_calculate_decay_activation(thisAgent, (*current_p), current_cycle, false) < decay_thresh)
+                if (!forget_only_lti || (decay_el->this_wme->id->id->LTI_ID != NIL))
                 {
-                    (*current_p)->forget_cycle = WMA_FORGOTTEN_CYCLE;
+                    do_forget = true;
 
-                    if (!forget_only_lti || ((*current_p)->this_wme->id->id->LTI_ID != NIL))
+                    // implements all-or-nothing check for lti mode
+                    if (forget_only_lti)
                     {
-                        do_forget = true;
-
-                        // implements all-or-nothing check for lti mode
-                        if (forget_only_lti)
+                        for (s = decay_el->this_wme->id->id->slots; (s && do_forget); s = s->next)
                         {
-                            for (s = (*current_p)->this_wme->id->id->slots; (s && do_forget); s = s->next)
+                            for (w = s->wmes; (w && do_forget); w = w->next)
                             {
-                                for (w = s->wmes; (w && do_forget); w = w->next)
+                                if (w->preference->o_supported && (!wme_wma_decay_el(w) || (w->cold->wma_decay_el->forget_cycle != WMA_FORGOTTEN_CYCLE)))
                                 {
-                                    if (w->preference->o_supported && (!w->wma_decay_el || (w->wma_decay_el->forget_cycle != WMA_FORGOTTEN_CYCLE)))
-                                    {
-                                        do_forget = false;
-                                    }
+                                    do_forget = false;
                                 }
                             }
                         }
+                    }
 
-                        if (do_forget)
+                    if (do_forget)
+                    {
+                        if (forget_only_lti)
                         {
-                            if (forget_only_lti)
+                            // implements all-or-nothing forget for lti mode
+                            for (s = decay_el->this_wme->id->id->slots; (s && do_forget); s = s->next)
                             {
-                                // implements all-or-nothing forget for lti mode
-                                for (s = (*current_p)->this_wme->id->id->slots; (s && do_forget); s = s->next)
+                                for (w = s->wmes; (w && do_forget); w = w->next)
                                 {
-                                    for (w = s->wmes; (w && do_forget); w = w->next)
+                                    if (wma_forgetting_forget_wme(thisAgent, w))
                                     {
-                                        if (wma_forgetting_forget_wme(thisAgent, w))
-                                        {
-                                            return_val = true;
-                                        }
+                                        return_val = true;
                                     }
                                 }
                             }
-                            else
+                        }
+                        else
+                        {
+                            if (wma_forgetting_forget_wme(thisAgent, decay_el->this_wme))
                             {
-                                if (wma_forgetting_forget_wme(thisAgent, (*current_p)->this_wme))
-                                {
-                                    return_val = true;
-                                }
+                                return_val = true;
                             }
                         }
                     }
                 }
-                else
-                {
-                    wma_forgetting_move_in_p_queue(thisAgent, (*current_p), wma_forgetting_estimate_cycle(thisAgent, (*current_p), false));
-                }
             }
-
-            // clean up decay set
-            thisAgent->WM->wma_touched_sets->insert(pq_p->first);
-            pq_p->second->clear();
-        }
-
-        // clean up touched sets
-        for (wma_decay_cycle_set::iterator touched_it = thisAgent->WM->wma_touched_sets->begin(); touched_it != thisAgent->WM->wma_touched_sets->end(); touched_it++)
-        {
-            pq_p = thisAgent->WM->wma_forget_pq->find(*touched_it);
-
-            if ((pq_p != thisAgent->WM->wma_forget_pq->end()) && (pq_p->second->empty()))
+            else
             {
-                pq_p->second->~wma_decay_set();
-                thisAgent->memoryManager->free_with_pool(MP_wma_decay_set, pq_p->second);
-
-                thisAgent->WM->wma_forget_pq->erase(pq_p);
+                pq->schedule(decay_el, wma_forgetting_estimate_cycle(thisAgent, decay_el, false));
             }
         }
-        thisAgent->WM->wma_touched_sets->clear();
     }
 
     return return_val;
@@ -1081,15 +1251,15 @@ inline bool wma_forgetting_naive_sweep(agent* thisAgent)
 
     for (wme* w = thisAgent->all_wmes_in_rete; w; w = w->rete_next)
     {
-        if (w->wma_decay_el && (!forget_only_lti || (w->id->id->LTI_ID != NIL)))
+        if (wme_wma_decay_el(w) && (!forget_only_lti || (w->id->id->LTI_ID != NIL)))
         {
             // to be forgotten, wme must...
             // - have been accessed (can't imagine why not, but just in case)
             // - not have been accessed this cycle (i.e. no decay)
             // - have activation less than threshold
-            if ((w->wma_decay_el->touches.total_references > 0) &&
-                    (w->wma_decay_el->touches.access_history[ wma_history_prev(w->wma_decay_el->touches.next_p) ].d_cycle < current_cycle) &&
-                    (wma_calculate_decay_activation(thisAgent, w->wma_decay_el, current_cycle, false) < decay_thresh))
+            if ((w->cold->wma_decay_el->touches.total_references > 0) &&
+                    (w->cold->wma_decay_el->touches.access_history[ wma_history_prev(w->cold->wma_decay_el->touches.next_p) ].d_cycle < current_cycle) &&
+                    (wma_calculate_decay_activation(thisAgent, w->cold->wma_decay_el, current_cycle, false) < decay_thresh))
             {
                 if (wma_forgetting_forget_wme(thisAgent, w))
                 {
@@ -1182,7 +1352,7 @@ inline void wma_update_decay_histories(agent* thisAgent)
     // add to history for changed elements
     for (wme_p = thisAgent->WM->wma_touched_elements->begin(); wme_p != thisAgent->WM->wma_touched_elements->end(); wme_p++)
     {
-        temp_el = (*wme_p)->wma_decay_el;
+        temp_el = (*wme_p)->cold->wma_decay_el;
 
         // update number of references in the current history
         // (has to come before history overwrite)
@@ -1266,9 +1436,9 @@ double wma_get_wme_activation(agent* thisAgent, wme* w, bool log_result)
 {
     double return_val = static_cast<double>((log_result) ? (WMA_ACTIVATION_NONE) : (WMA_TIME_SUM_NONE));
 
-    if (w->wma_decay_el)
+    if (wme_wma_decay_el(w))
     {
-        return_val = wma_calculate_decay_activation(thisAgent, w->wma_decay_el, thisAgent->WM->wma_d_cycle_count, log_result);
+        return_val = wma_calculate_decay_activation(thisAgent, w->cold->wma_decay_el, thisAgent->WM->wma_d_cycle_count, log_result);
     }
 
     return return_val;
@@ -1297,9 +1467,9 @@ inline void _wma_ref_to_str(wma_cycle_reference& ref, wma_d_cycle current_cycle,
 
 void wma_get_wme_history(agent* thisAgent, wme* w, std::string& buffer)
 {
-    if (w->wma_decay_el)
+    if (wme_wma_decay_el(w))
     {
-        wma_history* history = &(w->wma_decay_el->touches);
+        wma_history* history = &(w->cold->wma_decay_el->touches);
         unsigned int p = history->next_p;
         unsigned int counter = history->history_ct;
         wma_d_cycle current_cycle = thisAgent->WM->wma_d_cycle_count;
@@ -1348,7 +1518,7 @@ void wma_get_wme_history(agent* thisAgent, wme* w, std::string& buffer)
             buffer.append("considering WME for decay @ d");
 
             std::string temp;
-            to_string(w->wma_decay_el->forget_cycle, temp);
+            to_string(w->cold->wma_decay_el->forget_cycle, temp);
             buffer.append(temp);
         }
     }
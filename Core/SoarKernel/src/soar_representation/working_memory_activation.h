@@ -52,6 +52,12 @@
  */
 #define WMA_FORGOTTEN_CYCLE 0
 
+/**
+ * Furthest ahead (in cycles) that a forgetting search will
+ * start looking
+ */
+#define WMA_SEARCH_LIMIT 1.0e15
+
 //////////////////////////////////////////////////////////
 // WMA Parameters
 //////////////////////////////////////////////////////////
@@ -171,6 +177,23 @@ typedef struct wma_history_struct
     wma_d_cycle first_reference;
 } wma_history;
 
+// a decay history copied out of its ring buffer into columns, newest
+// reference first, so that its activation can be worked out at many
+// cycles with one straight loop each
+typedef struct wma_history_columns_struct
+{
+    wma_d_cycle cycles[ WMA_DECAY_HISTORY ];
+    double references[ WMA_DECAY_HISTORY ];
+    unsigned int count;
+    double total_references;
+
+    // Petrov approximation of the references older than the history
+    // (older_references is zero when it is off)
+    double older_references;
+    wma_d_cycle first_reference;
+    double d_inv;
+} wma_history_columns;
+
 // attached to o-supported WMEs to keep track of its activation.
 typedef struct wma_decay_element_struct
 {
@@ -199,8 +222,60 @@ typedef struct wma_decay_element_struct
     // we need to forget this wme
     wma_d_cycle forget_cycle;
 
+    // links in the forgetting wheel's list for forget_cycle
+    // (forget_pprev is NULL when not in the wheel)
+    struct wma_decay_element_struct* forget_next;
+    struct wma_decay_element_struct** forget_pprev;
+
 } wma_decay_element;
 
+/**
+ * Decay elements waiting to be checked for forgetting, filed by
+ * forget_cycle in a hierarchical timing wheel: 256 one-cycle slots,
+ * then 256 slots of 256 cycles and 256 slots of 65536 cycles, and
+ * an overflow list beyond that.  As the wheel advances, each coarse
+ * slot is refiled into the finer ones when its span comes up, so
+ * scheduling, moving and removing an element are all constant time.
+ */
+class wma_forget_wheel
+{
+    public:
+        wma_forget_wheel() { reset(); }
+
+        // takes every element out of the wheel
+        void clear();
+
+        bool empty() { return (count == 0); }
+
+        // files an element under cycle (moving it if already filed)
+        void schedule(wma_decay_element* decay_el, wma_d_cycle cycle);
+
+        // takes an element out of the wheel, if it is in it
+        void remove(wma_decay_element* decay_el);
+
+        // makes every element filed at or before now due
+        void advance(wma_d_cycle now);
+
+        // takes the next due element out of the wheel, or returns NULL
+        wma_decay_element* pop_due();
+
+    private:
+        static const int BITS = 8;
+        static const int SIZE = (1 << BITS);
+        static const int LEVELS = 3;
+
+        wma_decay_element*  slots[ LEVELS ][ SIZE ];
+        wma_decay_element*  overflow;
+        wma_decay_element*  due;
+        wma_d_cycle         current;    // next cycle to be made due
+        uint64_t            count;
+
+        void reset();
+        void link(wma_decay_element** head, wma_decay_element* decay_el);
+        void file(wma_decay_element* decay_el);
+        void refile(wma_decay_element** head);
+};
+
 enum wma_go_action { wma_histories, wma_forgetting };
 
 //////////////////////////////////////////////////////////
@@ -0,0 +1,140 @@
+/*
+ * InputChurnTest.cpp
+ *
+ * Input-link churn micro-benchmark.  Run with "PerformanceTests input-churn
+ * [<numtrials>] [<num_decisions>]".
+ *
+ * The client keeps a set of objects on the input link, each with a few
+ * constant attributes and a shared link to its neighbour.  Every decision
+ * it removes and re-creates a quarter of the objects and updates an
+ * attribute on the rest, so almost all of the time goes to the SML input
+ * path: converting client ids and timetags to kernel ones and back.
+ */
+
+#include "PerformanceTests.h"
+
+#include "sml_Client.h"
+
+#include <chrono>
+
+using namespace std;
+using namespace sml;
+
+#define INPUT_CHURN_OBJECTS 500
+#define INPUT_CHURN_DEFAULT_DCS 2000
+
+struct ChurnObject
+{
+    Identifier*         id;
+    IntElement*         counter;
+    Identifier*         link;
+};
+
+static void CreateChurnObject(Agent* agent, Identifier* pInputLink, vector<ChurnObject>& objects, size_t i)
+{
+    ChurnObject& obj = objects[i];
+    obj.id = agent->CreateIdWME(pInputLink, "object");
+    agent->CreateIntWME(obj.id, "index", static_cast<long long>(i));
+    agent->CreateStringWME(obj.id, "color", (i % 2) ? "red" : "blue");
+    agent->CreateFloatWME(obj.id, "size", static_cast<double>(i) * 0.5);
+    obj.counter = agent->CreateIntWME(obj.id, "counter", 0);
+    obj.link = NULL;
+}
+
+static void LinkChurnObject(Agent* agent, vector<ChurnObject>& objects, size_t i)
+{
+    // Shared ids exercise the identifier reference counts
+    ChurnObject& obj = objects[i];
+    obj.link = agent->CreateSharedIdWME(obj.id, "next", objects[(i + 1) % objects.size()].id);
+}
+
+static void DestroyChurnObject(Agent* agent, vector<ChurnObject>& objects, size_t i)
+{
+    // Links into this object are owned by its neighbour, so drop them first
+    size_t prev = (i + objects.size() - 1) % objects.size();
+    if (objects[prev].link)
+    {
+        agent->DestroyWME(objects[prev].link);
+        objects[prev].link = NULL;
+    }
+    agent->DestroyWME(objects[i].id);
+    objects[i].id = NULL;
+    objects[i].link = NULL;
+}
+
+void Run_InputChurnTest(int numTrials, int numDecisions, StatsTracker* pSt)
+{
+    if (numDecisions <= 0)
+    {
+        numDecisions = INPUT_CHURN_DEFAULT_DCS;
+    }
+
+    for (int trial = 0; trial < numTrials; trial++)
+    {
+        Kernel* kernel = Kernel::CreateKernelInNewThread();
+        Agent* agent = kernel->CreateAgent("Soar1");
+        cout << (trial + 1) << " ";
+        cout.flush();
+
+        agent->ExecuteCommandLine("watch 0");
+        agent->ExecuteCommandLine("output enable off");
+        agent->SetOutputLinkChangeTracking(false);
+        kernel->SetAutoCommit(false);
+
+        Identifier* pInputLink = agent->GetInputLink();
+        vector<ChurnObject> objects(INPUT_CHURN_OBJECTS);
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            CreateChurnObject(agent, pInputLink, objects, i);
+        }
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            LinkChurnObject(agent, objects, i);
+        }
+        agent->Commit();
+        agent->RunSelf(1);
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        for (int dc = 0; dc < numDecisions; dc++)
+        {
+            // Replace every fourth object, starting at a different place each decision
+            vector<size_t> replaced;
+            for (size_t i = dc % 4; i < objects.size(); i += 4)
+            {
+                DestroyChurnObject(agent, objects, i);
+                replaced.push_back(i);
+            }
+            for (size_t r = 0; r < replaced.size(); r++)
+            {
+                CreateChurnObject(agent, pInputLink, objects, replaced[r]);
+            }
+            for (size_t i = 0; i < objects.size(); i++)
+            {
+                if (!objects[i].link)
+                {
+                    LinkChurnObject(agent, objects, i);
+                }
+                agent->Update(objects[i].counter, static_cast<long long>(dc));
+            }
+
+            agent->Commit();
+            agent->RunSelf(1);
+        }
+
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        pSt->kerneltimes.push_back(elapsed.count());
+        pSt->realtimes.push_back(elapsed.count());
+        pSt->totaltimes.push_back(elapsed.count());
+        pSt->decisionrates.push_back(elapsed.count() > 0.0 ? numDecisions / elapsed.count() : 0.0);
+
+        kernel->Shutdown();
+        delete kernel;
+
+        cout << "✅  ";
+        cout.flush();
+    }
+
+    cout << endl;
+    cout.flush();
+}
@@ -54,6 +54,10 @@ void Run_PerformanceTest(int numTrials, int numDecisions, StatsTracker* pSt, con
                 agent->ExecuteCommandLineXML("stats", &response);
                 pSt->kerneltimes.push_back(response.GetArgFloat(sml_Names::kParamStatsKernelCPUTime, 0.0));
                 pSt->totaltimes.push_back(response.GetArgFloat(sml_Names::kParamStatsTotalCPUTime, 0.0));
+
+                double kernelTime = pSt->kerneltimes.back();
+                double decisions = static_cast<double>(response.GetArgInt(sml_Names::kParamStatsCycleCountDecision, 0));
+                pSt->decisionrates.push_back(kernelTime > 0.0 ? decisions / kernelTime : 0.0);
             }
         }
         kernel->Shutdown();
@@ -119,6 +123,14 @@ int main(int argc, char* argv[])
     if (numInits > 0) cout << ", " << numInits << " extra init-soar/runs\n"; else cout << endl;
     cout.flush();
 
+    if (!strcmp(agentname, "input-churn"))
+    {
+        StatsTracker l_testStats;
+        Run_InputChurnTest(numTrials, numDCs, &l_testStats);
+        l_testStats.PrintResults(agentname);
+        return 0;
+    }
+
     {
         StatsTracker l_testStats;
         vector<string> commands, init_commands;
@@ -33,6 +33,7 @@ class StatsTracker
         std::vector<double> realtimes;
         std::vector<double> kerneltimes;
         std::vector<double> totaltimes;
+        std::vector<double> decisionrates;
 
         double GetAverage(std::vector<double> numbers)
         {
@@ -96,6 +97,7 @@ class StatsTracker
 //#endif
             //PrintResultsHelper(std::cout, "OS Real", 12, GetAverage(realtimes), GetLow(realtimes), GetHigh(realtimes));
             PrintResultsHelper(std::cout, testName, 40, GetAverage(kerneltimes), GetLow(kerneltimes), GetHigh(kerneltimes), true);
+            PrintResultsHelper(std::cout, "  decisions/sec", 40, GetAverage(decisionrates), GetLow(decisionrates), GetHigh(decisionrates), true);
             std::cout << "---------------------------------------------------------------------------------\n";
             //PrintResultsHelper(std::cout, "Soar Total", 12, GetAverage(totaltimes), GetLow(totaltimes), GetHigh(totaltimes));
 
@@ -137,4 +139,7 @@ class StatsTracker
         }
 };
 
+// Input-link churn micro-benchmark (InputChurnTest.cpp), run with the agent name "input-churn"
+void Run_InputChurnTest(int numTrials, int numDecisions, StatsTracker* pSt);
+
 #endif /* PERFORMANCETESTS_PERFORMANCETESTS_H_ */
@@ -300,3 +300,77 @@ void ElementXMLTest::testEquals()
 	assertTrue_msg(soarxml::ElementXML::GetLastParseErrorDescription(), element != 0);
 	delete element;
 }
+
+void ElementXMLTest::testBinaryFormat()
+{
+	soarxml::ElementXML* pXML1 = createXML1();
+	soarxml::ElementXML* pXML2 = createXML2();
+	soarxml::ElementXML* pXML3 = createXML3();
+	soarxml::ElementXML* pXML4 = createXML4();
+	soarxml::ElementXML* pXML5 = createXML5();
+	soarxml::ElementXML* pXML6 = createXML1();
+	
+	pXML3->SetUseCData(true);
+	pXML3->SetCharacterData(data2.c_str());
+	
+	pXML4->AddChild(pXML1) ;
+	pXML4->AddChild(pXML2) ;
+	pXML4->AddChild(pXML3) ;
+	pXML4->AddChild(pXML5) ;
+	pXML2->AddChild(pXML6) ;
+	
+	int length = 0 ;
+	char* pBuffer = pXML4->GenerateBinaryBuffer(&length) ;
+	
+	assertTrue(soarxml::ElementXML::IsBinaryBuffer(pBuffer, length)) ;
+	assertFalse(soarxml::ElementXML::IsBinaryBuffer("<sml></sml>", 11)) ;
+	
+	// The binary form should describe exactly the same document as the XML form
+	soarxml::ElementXML* pParsedXML = soarxml::ElementXML::ParseBinaryBuffer(pBuffer, length) ;
+	assertTrue_msg(soarxml::ElementXML::GetLastParseErrorDescription(), pParsedXML != NULL) ;
+	
+	char* pOriginalStr = pXML4->GenerateXMLString(true) ;
+	char* pParsedStr = pParsedXML->GenerateXMLString(true) ;
+	assertTrue(std::string(pOriginalStr) == std::string(pParsedStr)) ;
+	soarxml::ElementXML::DeleteString(pOriginalStr) ;
+	soarxml::ElementXML::DeleteString(pParsedStr) ;
+	
+	assertTrue(pParsedXML->GetNumberChildren() == 4) ;
+	
+	soarxml::ElementXML child0(NULL) ;
+	assertTrue(pParsedXML->GetChild(&child0, 0));
+	assertTrue(std::string(child0.GetTagName()) == tag1) ;
+	assertTrue(std::string(child0.GetComment()) == comment1) ;
+	assertTrue(std::string(child0.GetAttribute(att12.c_str())) == val12) ;
+	
+	soarxml::ElementXML child1(NULL) ;
+	assertTrue(pParsedXML->GetChild(&child1, 1));
+	assertTrue(child1.GetNumberChildren() == 1) ;
+	soarxml::ElementXML grandchild(NULL) ;
+	assertTrue(child1.GetChild(&grandchild, 0));
+	assertTrue(std::string(grandchild.GetTagName()) == tag1) ;
+	assertTrue(std::string(grandchild.GetAttribute(att11.c_str())) == val11) ;
+	
+	soarxml::ElementXML child2(NULL) ;
+	assertTrue(pParsedXML->GetChild(&child2, 2));
+	assertTrue(child2.GetUseCData()) ;
+	assertTrue(std::string(child2.GetCharacterData()) == data2) ;
+	
+	soarxml::ElementXML child3(NULL) ;
+	assertTrue(pParsedXML->GetChild(&child3, 3));
+	assertTrue(child3.IsCharacterDataBinary()) ;
+	assertTrue(child3.GetCharacterDataLength() == BUFFER_LENGTH) ;
+	assertTrue(verifyBuffer(child3.GetCharacterData())) ;
+	
+	// A buffer that has been cut short should be rejected rather than read past its end
+	for (int i = 0 ; i < length ; i++)
+	{
+		soarxml::ElementXML* pTruncated = soarxml::ElementXML::ParseBinaryBuffer(pBuffer, i) ;
+		assertTrue(pTruncated == NULL) ;
+	}
+	
+	soarxml::ElementXML::DeleteString(pBuffer) ;
+	
+	delete pXML4 ;
+	delete pParsedXML ;
+}
@@ -41,6 +41,9 @@ public:
 	TEST(testEquals, -1);
 	void testEquals();
 	
+	TEST(testBinaryFormat, -1);
+	void testBinaryFormat();
+	
 private:
 	soarxml::ElementXML* createXML1();
 	soarxml::ElementXML* createXML2();
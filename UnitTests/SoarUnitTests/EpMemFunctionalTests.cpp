@@ -172,6 +172,91 @@ void EpMemFunctionalTests::testReadCSoarDB()
 }
 
 
+void EpMemFunctionalTests::testGroupCommit()
+{
+	std::string db("epmem-group-commit-test.sqlite");
+	remove(db.c_str());
+	remove((db + "-wal").c_str());
+	remove((db + "-shm").c_str());
+	
+	agent->ExecuteCommandLine(std::string("epmem --set path \"" + db + "\"").c_str());
+	agent->ExecuteCommandLine("epmem --set database file");
+	agent->ExecuteCommandLine("epmem --set commit-episodes 5");
+	agent->ExecuteCommandLine("epmem --set trigger dc");
+	agent->ExecuteCommandLine("epmem --set learning on");
+	agent->ExecuteCommandLine("epmem --init");
+	agent->RunSelf(12);
+	// wait for the writer, so the episodes since the last commit really are
+	// sitting in the open transaction when the second agent looks
+	agent->ExecuteCommandLine("epmem --print 12");
+	
+	// A second agent opening the same file sees the committed groups but
+	// not the episodes since the last commit
+	sml::Agent* reader = kernel->CreateAgent("reader");
+	reader->ExecuteCommandLine(std::string("epmem --set path \"" + db + "\"").c_str());
+	reader->ExecuteCommandLine("epmem --set database file");
+	reader->ExecuteCommandLine("epmem --set append on");
+	reader->ExecuteCommandLine("epmem --set commit-episodes 5");
+	reader->ExecuteCommandLine("epmem --init");
+	std::string committed = reader->ExecuteCommandLine("epmem --print 10");
+	std::string uncommitted = reader->ExecuteCommandLine("epmem --print 11");
+	kernel->DestroyAgent(reader);
+	
+	agent->ExecuteCommandLine("epmem --set database memory");
+	agent->ExecuteCommandLine("epmem --init");
+	remove(db.c_str());
+	remove((db + "-wal").c_str());
+	remove((db + "-shm").c_str());
+	
+	assertTrue_msg("Committed episode missing: " + committed, committed.find("Episode 10") != std::string::npos);
+	assertTrue_msg("Uncommitted episode visible: " + uncommitted, uncommitted.find("Episode 11") == std::string::npos);
+}
+
+void EpMemFunctionalTests::testSnapshot()
+{
+	std::string snapshot("epmem-snapshot-test.epmem");
+	remove(snapshot.c_str());
+	
+	agent->ExecuteCommandLine("epmem --set trigger dc");
+	agent->ExecuteCommandLine("epmem --set learning on");
+	agent->RunSelf(12);
+	std::string original = agent->ExecuteCommandLine("epmem --print 10");
+	std::string exportResult = agent->ExecuteCommandLine(("epmem --export " + snapshot).c_str());
+	
+	// a fresh in-memory database is empty until the snapshot is imported
+	agent->ExecuteCommandLine("epmem --init");
+	std::string cleared = agent->ExecuteCommandLine("epmem --print 10");
+	std::string importResult = agent->ExecuteCommandLine(("epmem --import " + snapshot).c_str());
+	std::string imported = agent->ExecuteCommandLine("epmem --print 10");
+	
+	// storage carries on from the last imported episode
+	agent->RunSelf(2);
+	std::string next = agent->ExecuteCommandLine("epmem --print 13");
+	
+	std::string badImport = agent->ExecuteCommandLine(("epmem --import " + SoarHelper::GetResource("epmem-csoar-db.sqlite")).c_str());
+	// a snapshot that decodes but can't be inserted (it repeats an episode id)
+	std::string duplicateImport = agent->ExecuteCommandLine(("epmem --import " + SoarHelper::GetResource("epmem-duplicate-episode.epmem")).c_str());
+	std::string kept = agent->ExecuteCommandLine("epmem --print 13");
+	remove(snapshot.c_str());
+	
+	assertTrue_msg("Episode not stored: " + original, original.find("Episode 10") != std::string::npos);
+	assertTrue_msg("Export failed: " + exportResult, exportResult.find("exported") != std::string::npos);
+	assertTrue_msg("Episode survived init: " + cleared, cleared.find("Episode 10") == std::string::npos);
+	assertTrue_msg("Import failed: " + importResult, importResult.find("imported") != std::string::npos);
+	assertTrue_msg("Imported episode differs: " + imported, imported == original);
+	assertTrue_msg("No episode stored after import: " + next, next.find("Episode 13") != std::string::npos);
+	assertTrue_msg("Imported a database file: " + badImport, badImport.find("imported") == std::string::npos);
+	assertTrue_msg("Imported duplicate episodes: " + duplicateImport, duplicateImport.find("imported") == std::string::npos);
+	assertTrue_msg("Failed import lost the store: " + kept, kept == next);
+}
+
+void EpMemFunctionalTests::testIntervalIndexOff()
+{
+	// queries walk intervals from the database instead of the in-memory index
+	agent->ExecuteCommandLine("epmem --set interval-index off");
+	runTest("testBeforeAfterProhibitEpMem", 12);
+}
+
 void EpMemFunctionalTests::testMultiAgent()
 {
 	std::vector<sml::Agent*> agents;
@@ -223,6 +308,13 @@ void EpMemFunctionalTests::testHamiltonian()
 	runTest("hamiltonian", 2);
 }
 
+void EpMemFunctionalTests::testQueryThreads()
+{
+	// candidates are graph matched on four threads while the walk carries on
+	agent->ExecuteCommandLine("epmem --set query-threads 4");
+	runTest("hamiltonian", 2);
+}
+
 void EpMemFunctionalTests::testSVS()
 {
 	runTest("svs", 2);
@@ -40,8 +40,10 @@ public:
 	TEST(testEpmemUnit_12, -1)
 	TEST(testEpmemUnit_13, -1)
 	TEST(testEpMemYRemoval, -1)
+	TEST(testGroupCommit, -1)
 	TEST(testHamilton, -1)
 	TEST(testHamiltonian, -1)
+	TEST(testIntervalIndexOff, -1)
 	TEST(testKB, -1)
 	TEST(testMaxDoublePrecision_Irrational, -1)
 	TEST(testMaxDoublePrecisionEpMem, -1)
@@ -49,9 +51,11 @@ public:
 	TEST(testNegativeEpisode, -1)
 	TEST(testNonExistingEpisode, -1)
 	TEST(testOddEven, -1)
+	TEST(testQueryThreads, -1)
 	TEST(testReadCSoarDB, -1)
 	TEST(testSimpleFloatEpMem, -1)
 	TEST(testSingleStoreRetrieve, -1)
+	TEST(testSnapshot, -1)
 	TEST(testSVS, -1)
 	TEST(testSVSHard, -1)
 	TEST(testWMActivation_Balance0, -1)
@@ -86,8 +90,10 @@ public:
 	void testEpmemUnit_14();
     void testEpMemSmemFactorizationCombinationTest();
 	void testEpMemYRemoval();
+	void testGroupCommit();
 	void testHamilton();
 	void testHamiltonian();
+	void testIntervalIndexOff();
 	void testKB();
 	void testMaxDoublePrecision_Irrational();
 	void testMaxDoublePrecisionEpMem();
@@ -95,9 +101,11 @@ public:
 	void testNegativeEpisode();
 	void testNonExistingEpisode();
 	void testOddEven();
+	void testQueryThreads();
 	void testReadCSoarDB();
 	void testSimpleFloatEpMem();
 	void testSingleStoreRetrieve();
+	void testSnapshot();
 	void testSVS();
 	void testSVSHard();
 	void testWMActivation_Balance0();
@@ -9,6 +9,7 @@
 #include "IOTests.hpp"
 
 #include "SoarHelper.hpp"
+#include "symbol_manager.h"
 
 void IOTests::testInputLeak()
 {
@@ -249,3 +250,174 @@ void IOTests::testOutputLeak1()
 	
 	setUp();
 }
+
+void IOTests::testInputUniqueConstants()
+{
+	agent->ExecuteCommandLine("soar stop-phase input") ;
+	assertTrue_msg("soar stop-phase input", agent->GetLastCommandLineResult());
+	
+	agent->ExecuteCommandLine("watch 0") ;
+	
+	sml::Identifier* pInputLink = agent->GetInputLink();
+	Symbol_Manager* symbolManager = internal_agent->symbolManager;
+	
+	// Each round adds enough new constants to make the symbol tables grow
+	// several times, then removes them all again so that they shrink.
+	const int kRounds = 4;
+	const int kConstants = 5000;
+	
+	for (int round = 0; round < kRounds; ++round)
+	{
+		std::vector< sml::WMElement* > wmes;
+		
+		for (int count = 0; count < kConstants; ++count)
+		{
+			int64_t value = (static_cast<int64_t>(round) * kConstants) + count;
+			std::stringstream name;
+			name << "unique-" << value;
+			
+			sml::Identifier* pItem = pInputLink->CreateIdWME("item");
+			wmes.push_back(pItem);
+			pItem->CreateStringWME("name", name.str().c_str());
+			pItem->CreateIntWME("int", value);
+			pItem->CreateFloatWME("float", value + 0.5);
+		}
+		assertTrue(agent->Commit());
+		kernel->RunAllAgents(1);
+		
+		for (int count = 0; count < kConstants; ++count)
+		{
+			int64_t value = (static_cast<int64_t>(round) * kConstants) + count;
+			std::stringstream name;
+			name << "unique-" << value;
+			
+			assertTrue(symbolManager->find_str_constant(name.str().c_str()) != NULL);
+			assertTrue(symbolManager->find_int_constant(value) != NULL);
+			assertTrue(symbolManager->find_float_constant(value + 0.5) != NULL);
+		}
+		
+		for (std::vector< sml::WMElement* >::iterator iter = wmes.begin(); iter != wmes.end(); ++iter)
+		{
+			(*iter)->DestroyWME();
+		}
+		assertTrue(agent->Commit());
+		kernel->RunAllAgents(1);
+		
+		for (int count = 0; count < kConstants; ++count)
+		{
+			int64_t value = (static_cast<int64_t>(round) * kConstants) + count;
+			std::stringstream name;
+			name << "unique-" << value;
+			
+			assertTrue(symbolManager->find_str_constant(name.str().c_str()) == NULL);
+			assertTrue(symbolManager->find_float_constant(value + 0.5) == NULL);
+		}
+	}
+	SoarHelper::init_check_to_find_refcount_leaks(agent);
+}
+
+void IOTests::testInputBatch()
+{
+	sml::InputBatch batch;
+	batch.AddIdWME("I2", "item", "i7", -1);
+	batch.AddStringWME("i7", "name", "first item", -2);
+	batch.AddIntWME("i7", "count", -1234567890123LL, -3);
+	batch.AddDoubleWME("i7", "size", 2.5, -4);
+	batch.AddStringWME("i7", "empty", "", -5);
+	batch.RemoveWME(-2);
+	
+	std::string buffer;
+	batch.Serialize(&buffer);
+	
+	sml::InputBatch copy;
+	assertTrue(copy.Deserialize(buffer.data(), buffer.size()));
+	assertTrue(copy.GetSize() == batch.GetSize());
+	
+	for (size_t i = 0; i < batch.GetSize(); ++i)
+	{
+		assertTrue(copy.GetOp(i) == batch.GetOp(i));
+		assertTrue(copy.GetTimeTag(i) == batch.GetTimeTag(i));
+		if (batch.GetOp(i) == sml::InputBatch::kRemove)
+		{
+			continue;
+		}
+		assertTrue(std::string(copy.GetId(i)) == batch.GetId(i));
+		assertTrue(std::string(copy.GetAttribute(i)) == batch.GetAttribute(i));
+	}
+	assertTrue(std::string(copy.GetStringValue(0)) == "i7");
+	assertTrue(std::string(copy.GetStringValue(1)) == "first item");
+	assertTrue(copy.GetIntValue(2) == -1234567890123LL);
+	assertTrue(copy.GetDoubleValue(3) == 2.5);
+	assertTrue(std::string(copy.GetStringValue(4)).empty());
+	assertTrue(copy.GetOp(5) == sml::InputBatch::kRemove);
+	
+	// A truncated buffer must be rejected, not read past its end
+	for (size_t length = 0; length < buffer.size(); ++length)
+	{
+		sml::InputBatch truncated;
+		assertFalse(truncated.Deserialize(buffer.data(), length));
+		assertTrue(truncated.IsEmpty());
+	}
+	
+	// The same changes sent through Commit() reach working memory
+	agent->ExecuteCommandLine("watch 0");
+	sml::Identifier* pItem = agent->GetInputLink()->CreateIdWME("item");
+	pItem->CreateStringWME("name", "first item");
+	pItem->CreateIntWME("count", -1234567890123LL);
+	pItem->CreateFloatWME("size", 2.5);
+	pItem->CreateSharedIdWME("self", pItem);
+	assertTrue(agent->Commit());
+	kernel->RunAllAgents(1);
+	
+	std::string result = agent->ExecuteCommandLine("print --depth 2 --internal I2");
+	assertTrue_msg(result, result.find("^name |first item|") != std::string::npos);
+	assertTrue_msg(result, result.find("^count -1234567890123") != std::string::npos);
+	assertTrue_msg(result, result.find("^size 2.5") != std::string::npos);
+	assertTrue_msg(result, result.find("^self I") != std::string::npos);
+	
+	pItem->DestroyWME();
+	assertTrue(agent->Commit());
+	kernel->RunAllAgents(1);
+	SoarHelper::init_check_to_find_refcount_leaks(agent);
+}
+
+void IOTests::testInputBatchFallback()
+{
+	// An unoptimized kernel, so that input goes through Commit() rather than straight into the agent
+	sml::Kernel* kernel2 = sml::Kernel::CreateKernelInCurrentThread(false, sml::Kernel::kUseAnyPort);
+	assertTrue_msg(kernel2->GetLastErrorDescription(), !kernel2->HadError());
+	
+	// This kernel reads batches, so batches are used until they are turned off,
+	// after which changes go over as the <wme> tags an older kernel expects
+	assertTrue(kernel2->IsUsingInputBatches());
+	kernel2->SetAllowInputBatches(false);
+	assertFalse(kernel2->IsUsingInputBatches());
+	
+	sml::Agent* agent2 = kernel2->CreateAgent("soar2");
+	assertTrue(agent2 != NULL);
+	kernel2->SetAutoCommit(false);
+	agent2->ExecuteCommandLine("watch 0");
+	
+	sml::Identifier* pItem = agent2->GetInputLink()->CreateIdWME("item");
+	pItem->CreateStringWME("name", "first item");
+	pItem->CreateIntWME("count", -1234567890123LL);
+	pItem->CreateFloatWME("size", 2.5);
+	pItem->CreateSharedIdWME("self", pItem);
+	assertTrue(agent2->Commit());
+	agent2->RunSelf(1);
+	
+	std::string result = agent2->ExecuteCommandLine("print --depth 2 --internal I2");
+	assertTrue_msg(result, result.find("^name |first item|") != std::string::npos);
+	assertTrue_msg(result, result.find("^count -1234567890123") != std::string::npos);
+	assertTrue_msg(result, result.find("^size 2.5") != std::string::npos);
+	assertTrue_msg(result, result.find("^self I") != std::string::npos);
+	
+	pItem->DestroyWME();
+	assertTrue(agent2->Commit());
+	agent2->RunSelf(1);
+	result = agent2->ExecuteCommandLine("print --depth 2 --internal I2");
+	assertTrue_msg(result, result.find("^item") == std::string::npos);
+	
+	kernel2->Shutdown();
+	delete kernel2;
+}
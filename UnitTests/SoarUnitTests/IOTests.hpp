@@ -20,6 +20,7 @@
 #include "sml_Utils.h"
 #include "thread_Event.h"
 #include "sml_Names.h"
+#include "sml_InputBatch.h"
 
 #include "FunctionalTestHarness.hpp"
 
@@ -42,6 +43,15 @@ public:
 	
 	TEST(testOutputLeak1, -1);
 	void testOutputLeak1(); // output input wme created but not destroyed
+	
+	TEST(testInputUniqueConstants, -1);
+	void testInputUniqueConstants(); // stream many unique constants through the symbol tables
+	
+	TEST(testInputBatch, -1);
+	void testInputBatch(); // serialize a columnar batch of input changes and read it back
+	
+	TEST(testInputBatchFallback, -1);
+	void testInputBatchFallback(); // commit one <wme> tag per change when batches are off
 };
 
 #endif /* IOTests_cpp */
@@ -330,6 +330,129 @@ void MiscTests::testSource()
 	SoarHelper::init_check_to_find_refcount_leaks(agent);
 }
 
+void MiscTests::testReteNetRoundTrip()
+{
+	std::string file("rete-net-round-trip.soarx");
+	
+	agent->ExecuteCommandLine("sp {scale (state <s> ^superstate nil) --> (<s> ^scaled (* 0.1234567 10000000))}");
+	agent->ExecuteCommandLine("sp {other (state <s> ^superstate nil) --> (<s> ^other yes)}");
+	std::string saveResult = agent->ExecuteCommandLine(("save rete-network --save " + file).c_str());
+	assertTrue_msg("Save failed: " + saveResult, agent->GetLastCommandLineResult());
+	
+	// float constants come back exactly, not rounded to six places
+	std::string loadResult = agent->ExecuteCommandLine(("load rete-network --load " + file).c_str());
+	assertTrue_msg("Load failed: " + loadResult, agent->GetLastCommandLineResult());
+	agent->ExecuteCommandLine("run 1");
+	std::string loaded = agent->ExecuteCommandLine("print s1");
+	
+	// adding keeps working memory and replaces rules of the same name
+	agent->ExecuteCommandLine("excise other");
+	agent->ExecuteCommandLine("sp {extra (state <s> ^superstate nil) --> (<s> ^extra yes)}");
+	std::string addResult = agent->ExecuteCommandLine(("load rete-network --load " + file + " --add").c_str());
+	bool added = agent->GetLastCommandLineResult();
+	agent->ExecuteCommandLine("run 1");
+	std::string merged = agent->ExecuteCommandLine("print s1");
+	std::string rules = agent->ExecuteCommandLine("print");
+	
+	remove(file.c_str());
+	
+	assertTrue_msg("Wrong value after load: " + loaded, loaded.find("^scaled 1234567.0") != std::string::npos);
+	assertTrue_msg("Add failed: " + addResult, added);
+	assertTrue_msg("Working memory lost: " + merged, (merged.find("^extra yes") != std::string::npos) && (merged.find("^io") != std::string::npos));
+	assertTrue_msg("Rule not added: " + merged, merged.find("^other yes") != std::string::npos);
+	assertTrue_msg("Wrong rules after add: " + rules, (rules.find("scale") != std::string::npos) && (rules.find("extra") != std::string::npos));
+	SoarHelper::init_check_to_find_refcount_leaks(agent);
+}
+
+void MiscTests::testRLWeightsRoundTrip()
+{
+	std::string file("rl-weights-round-trip.rlw");
+	
+	agent->ExecuteCommandLine("sp {rl*left (state <s> ^superstate nil ^operator <o> +) (<o> ^name left) --> (<s> ^operator <o> = 2.5)}");
+	agent->ExecuteCommandLine("sp {rl*right (state <s> ^superstate nil ^operator <o> +) (<o> ^name right) --> (<s> ^operator <o> = -0.125)}");
+	std::string saveResult = agent->ExecuteCommandLine(("rl --save-weights " + file).c_str());
+	assertTrue_msg("Save failed: " + saveResult, agent->GetLastCommandLineResult());
+	
+	// the rules come back unlearned, and one of them is gone
+	agent->ExecuteCommandLine("excise rl*left");
+	agent->ExecuteCommandLine("excise rl*right");
+	agent->ExecuteCommandLine("sp {rl*left (state <s> ^superstate nil ^operator <o> +) (<o> ^name left) --> (<s> ^operator <o> = 0.0)}");
+	std::string loadResult = agent->ExecuteCommandLine(("rl --load-weights " + file).c_str());
+	bool loaded = agent->GetLastCommandLineResult();
+	std::string rule = agent->ExecuteCommandLine("print rl*left");
+	
+	// anything else is refused
+	std::string badResult = agent->ExecuteCommandLine(("rl --load-weights " + file + ".missing").c_str());
+	bool bad = agent->GetLastCommandLineResult();
+	
+	remove(file.c_str());
+	
+	assertTrue_msg("Load failed: " + loadResult, loaded);
+	assertTrue_msg("Wrong counts: " + loadResult, (loadResult.find("Loaded weights of 1 RL rules") != std::string::npos) && (loadResult.find("1 not found") != std::string::npos));
+	assertTrue_msg("Wrong value after load: " + rule, rule.find("= 2.5") != std::string::npos);
+	assertTrue_msg("Loaded a missing file: " + badResult, !bad);
+}
+
+void MiscTests::testRLWeightsTemplateOrder()
+{
+	std::string file("rl-weights-template-order.rlw");
+	const char* rules[] =
+	{
+		"sp {propose*init (state <s> ^superstate nil -^count) --> (<s> ^operator <o> + >) (<o> ^name init)}",
+		"sp {apply*init (state <s> ^operator.name init) --> (<s> ^count 0)}",
+		"sp {propose*a (state <s> ^superstate nil ^count <c> ^allow a) --> (<s> ^operator <o> +) (<o> ^name a ^count <c>)}",
+		"sp {propose*b (state <s> ^superstate nil ^count <c> ^allow b) --> (<s> ^operator <o> +) (<o> ^name b ^count <c>)}",
+		"sp {apply (state <s> ^operator <o> ^count <c>) (<o> ^count <c>) --> (<s> ^count <c> - (+ <c> 1))}",
+		"sp {reward (state <s> ^reward-link <r> ^operator.name a) --> (<r> ^reward.value 1)}",
+		"sp {tmpl :template (state <s> ^superstate nil ^operator <o> +) (<o> ^name <n>) --> (<s> ^operator <o> = 0)}"
+	};
+	
+	// the trained agent makes its instance for operator a before the one for b...
+	agent->ExecuteCommandLine("watch 0");
+	agent->ExecuteCommandLine("rl --set learning on");
+	for (const char* rule : rules)
+	{
+		agent->ExecuteCommandLine(rule);
+	}
+	agent->ExecuteCommandLine("sp {allow*a (state <s> ^superstate nil) --> (<s> ^allow a)}");
+	agent->RunSelf(4);
+	agent->ExecuteCommandLine("sp {allow*b (state <s> ^superstate nil) --> (<s> ^allow b)}");
+	agent->RunSelf(4);
+	std::string trainedA = agent->ExecuteCommandLine("print rl*tmpl*2");
+	std::string trainedB = agent->ExecuteCommandLine("print rl*tmpl*3");
+	std::string saveResult = agent->ExecuteCommandLine(("rl --save-weights " + file).c_str());
+	
+	// ...and the fresh one makes them the other way round, so the names are swapped
+	sml::Agent* fresh = kernel->CreateAgent("fresh");
+	fresh->ExecuteCommandLine("watch 0");
+	for (const char* rule : rules)
+	{
+		fresh->ExecuteCommandLine(rule);
+	}
+	fresh->ExecuteCommandLine("sp {allow*b (state <s> ^superstate nil) --> (<s> ^allow b)}");
+	fresh->RunSelf(4);
+	fresh->ExecuteCommandLine("sp {allow*a (state <s> ^superstate nil) --> (<s> ^allow a)}");
+	fresh->RunSelf(4);
+	std::string loadResult = fresh->ExecuteCommandLine(("rl --load-weights " + file).c_str());
+	std::string loadedA = fresh->ExecuteCommandLine("print rl*tmpl*3");
+	std::string loadedB = fresh->ExecuteCommandLine("print rl*tmpl*2");
+	kernel->DestroyAgent(fresh);
+	
+	remove(file.c_str());
+	
+	assertTrue_msg("Not an instance for a: " + trainedA, trainedA.find("^name a") != std::string::npos);
+	assertTrue_msg("Instance for a learned nothing: " + trainedA, trainedA.find("= 0)") == std::string::npos);
+	assertTrue_msg("Save failed: " + saveResult, saveResult.find("Saved") != std::string::npos);
+	assertTrue_msg("Wrong counts: " + loadResult, (loadResult.find("Loaded weights of 3 RL rules") != std::string::npos) && (loadResult.find("not found") == std::string::npos));
+	
+	// the value written into a rule that was never updated prints differently, so compare numbers
+	auto value = [](const std::string& rule) { return atof(rule.substr(rule.rfind("= ") + 2).c_str()); };
+	assertTrue_msg("Wrong rule for a: " + loadedA, loadedA.find("^name a") != std::string::npos);
+	assertTrue_msg("Wrong value for a: " + loadedA, value(loadedA) == value(trainedA));
+	assertTrue_msg("Wrong rule for b: " + loadedB, loadedB.find("^name b") != std::string::npos);
+	assertTrue_msg("Wrong value for b: " + loadedB, value(loadedB) == value(trainedB));
+}
+
 void MiscTests::testSoarRand()
 {
 	int halftrials = 50000000;
@@ -43,6 +43,15 @@ public:
 	TEST(testSource, -1)
 	void testSource();
 	
+	TEST(testReteNetRoundTrip, -1)
+	void testReteNetRoundTrip();
+	
+	TEST(testRLWeightsRoundTrip, -1)
+	void testRLWeightsRoundTrip();
+	
+	TEST(testRLWeightsTemplateOrder, -1)
+	void testRLWeightsTemplateOrder();
+	
 	TEST(testSoarRand, -1)
 	void testSoarRand();
 	TEST(testPreferenceDeallocation, -1)
@@ -15,6 +15,8 @@ const int MultiAgentTest::MAX_AGENTS = 100;
 void MultiAgentTest::setUp()
 {
 	updateEventHandler = user_data_struct(std::bind(&MultiAgentTest::MyUpdateEventHandler, this));
+	agentMemoryPools = false;
+	parallelThreads = 1;
 }
 
 void MultiAgentTest::tearDown(bool caught)
@@ -158,11 +160,77 @@ void MultiAgentTest::testMaxAgents()
 	doTest();
 }
 
+void MultiAgentTest::testTenAgentsOwnMemoryPools()
+{
+	numberAgents = 10;
+	agentMemoryPools = true;
+	doTest();
+}
+
+void MultiAgentTest::testTenAgentsInParallel()
+{
+	numberAgents = 10;
+	agentMemoryPools = true;
+	parallelThreads = 4;
+	doTest();
+}
+
+void MultiAgentTest::testParallelRandomStreams()
+{
+	// Agents that step in parallel each draw from their own generator, so
+	// agents given the same seed roll the same numbers however they interleave
+	pKernel = sml::Kernel::CreateKernelInCurrentThread(true, sml::Kernel::kUseAnyPort);
+	no_agent_assertTrue_msg(pKernel->GetLastErrorDescription(), !pKernel->HadError());
+	no_agent_assertTrue(pKernel->SetAgentMemoryPools(true));
+	no_agent_assertTrue(pKernel->SetParallelRunThreads(4));
+	
+	const int kAgents = 4;
+	std::vector< sml::Agent* > agents;
+	for (int agentCounter = 0 ; agentCounter < kAgents ; ++agentCounter)
+	{
+		std::stringstream name;
+		name << "roller" << 1 + agentCounter;
+		
+		sml::Agent* agent = pKernel->CreateAgent(name.str().c_str()) ;
+		no_agent_assertTrue(agent != NULL);
+		agents.push_back(agent);
+		
+		agent->ExecuteCommandLine("sp {propose*init (state <s> ^superstate nil -^count) --> (<s> ^operator <o> +) (<o> ^name init)}");
+		agent->ExecuteCommandLine("sp {apply*init (state <s> ^operator <o>) (<o> ^name init) --> (<s> ^count 0)}");
+		agent->ExecuteCommandLine("sp {propose*roll (state <s> ^superstate nil ^count {<c> < 20}) --> (<s> ^operator <o> +) (<o> ^name roll)}");
+		agent->ExecuteCommandLine("sp {apply*roll (state <s> ^operator <o> ^count <c>) (<o> ^name roll) --> (<s> ^count <c> - ^count (+ <c> 1) ^roll (rand-int 1000000))}");
+		agent->ExecuteCommandLine("srand 42");
+	}
+	
+	pKernel->RunAllAgents(25) ;
+	
+	std::string expected = agents[0]->ExecuteCommandLine("print --depth 1 s1");
+	no_agent_assertTrue_msg(expected, expected.find("^roll") != std::string::npos);
+	for (int agentCounter = 1 ; agentCounter < kAgents ; ++agentCounter)
+	{
+		std::string rolls = agents[agentCounter]->ExecuteCommandLine("print --depth 1 s1");
+		no_agent_assertTrue_msg(rolls, rolls == expected);
+	}
+	
+	pKernel->Shutdown() ;
+	delete pKernel ;
+}
+
 void MultiAgentTest::doTest()
 {
 	pKernel = sml::Kernel::CreateKernelInCurrentThread(true, sml::Kernel::kUseAnyPort);
 	no_agent_assertTrue_msg(pKernel->GetLastErrorDescription(), !pKernel->HadError());
 	
+	if (agentMemoryPools)
+	{
+		no_agent_assertTrue(pKernel->SetAgentMemoryPools(true));
+	}
+	
+	if (parallelThreads > 1)
+	{
+		no_agent_assertTrue(pKernel->SetParallelRunThreads(parallelThreads));
+	}
+	
 	// We'll require commits, just so we're testing that path
 	pKernel->SetAutoCommit(false) ;
 	
@@ -245,6 +313,24 @@ void MultiAgentTest::doTest()
 	
 	reportAgentStatus(pKernel, numberAgents, trace) ;
 	
+	if (agentMemoryPools)
+	{
+		// Each agent should report its own pools rather than the kernel's
+		sml::Agent* agent = agents[0];
+		std::string stats = agent->ExecuteCommandLine("stats --memory");
+		assertTrue_msg(stats, stats.find("owned by this agent") != std::string::npos);
+		no_agent_assertTrue(pKernel->SetAgentMemoryPools(false));
+	}
+	
+	if (parallelThreads > 1)
+	{
+		// The agents are identical and synchronize every round, so they should all be at the same point
+		for (int agentCounter = 1 ; agentCounter < numberAgents ; ++agentCounter)
+		{
+			no_agent_assertTrue(agents[agentCounter]->GetDecisionCycleCounter() == agents[0]->GetDecisionCycleCounter());
+		}
+	}
+	
 	for (std::vector< std::stringstream* >::iterator iter = trace.begin(); iter != trace.end(); ++iter)
 	{
 		delete *iter;
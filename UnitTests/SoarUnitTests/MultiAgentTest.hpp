@@ -41,6 +41,15 @@ public:
 	TEST(testMaxAgents, -1)
 	void testMaxAgents();
 	
+	TEST(testTenAgentsOwnMemoryPools, -1)
+	void testTenAgentsOwnMemoryPools();
+	
+	TEST(testTenAgentsInParallel, -1)
+	void testTenAgentsInParallel();
+	
+	TEST(testParallelRandomStreams, -1)
+	void testParallelRandomStreams();
+	
 private:
 	struct user_data_struct
 	{
@@ -64,6 +73,8 @@ private:
 	
 	static const int MAX_AGENTS;
 	int numberAgents;
+	bool agentMemoryPools;
+	int parallelThreads;
 	sml::Kernel* pKernel;
 };
 
@@ -16,6 +16,8 @@
 #include "sml_Client.h"
 #include "sml_Names.h"
 
+#include <fstream>
+
 void SMemFunctionalTests::setUp()
 {
     FunctionalTestHarness::setUp();
@@ -75,6 +77,20 @@ void SMemFunctionalTests::testMaxMultivalued()
 	runTest("testMaxMultivalued", 1);
 }
 
+void SMemFunctionalTests::testMaxFiltered()
+{
+	SoarHelper::setStopPhase(agent, SoarHelper::StopPhase::OUTPUT);
+	runTest("testMaxFiltered", 1);
+}
+
+void SMemFunctionalTests::testMaxFilteredNativeStoreOff()
+{
+	// max is found by testing every candidate instead of walking values in order
+	agent->ExecuteCommandLine("smem --set native-store off");
+	SoarHelper::setStopPhase(agent, SoarHelper::StopPhase::OUTPUT);
+	runTest("testMaxFiltered", 1);
+}
+
 void SMemFunctionalTests::testMin()
 {
 	SoarHelper::setStopPhase(agent, SoarHelper::StopPhase::OUTPUT);
@@ -154,6 +170,13 @@ void SMemFunctionalTests::testNegQuery()
 	runTest("testNegQuery", 248);
 }
 
+void SMemFunctionalTests::testNativeStoreOff()
+{
+	// queries walk candidates from the database instead of the in-memory store
+	agent->ExecuteCommandLine("smem --set native-store off");
+	runTest("testNegQuery", 248);
+}
+
 void SMemFunctionalTests::testNegStringFloat()
 {
 	runTest("testNegStringFloat", 5);
@@ -335,6 +358,31 @@ void SMemFunctionalTests::testSpreadingActivation_AlphabetAgentAllOn()
     assertTrue_msg(msg.append("testSpreadingActivation_AlphabetAgentAllOn functional test did not halt. DC = ").append(dc_count).c_str(), halted);
 }
 
+void SMemFunctionalTests::testSpreadingActivation_StoreToCachedSource()
+{
+	runTestSetup("testSpreadingActivation_StoreToCachedSource");
+	std::string result, expected;
+
+	// @1 is a source and spreads to its only child, @2
+	agent->RunSelf(20);
+	result = agent->ExecuteCommandLine("print @2 -d 1");
+	expected = "(@2 ^kind leaf ^name a [+8.766])\n";
+	assertTrue_msg(std::string("Activation value ") + expected + std::string(" != " + result), result == expected);
+	result = agent->ExecuteCommandLine("print @3 -d 1");
+	expected = "(@3 ^kind leaf ^name b [-0.693])\n";
+	assertTrue_msg(std::string("Activation value ") + expected + std::string(" != " + result), result == expected);
+
+	// @3 is stored as a second child of @1, so it is spread to as well
+	agent->RunSelf(20);
+	assertTrue_msg("testSpreadingActivation_StoreToCachedSource functional test did not halt", halted);
+	result = agent->ExecuteCommandLine("print @1 -d 1");
+	expected = "(@1 ^child @2 @3 ^name src [-0.511])\n";
+	assertTrue_msg(std::string("Activation value ") + expected + std::string(" != " + result), result == expected);
+	result = agent->ExecuteCommandLine("print @3 -d 1");
+	expected = "(@3 ^kind leaf ^name b [+8.215])\n";
+	assertTrue_msg(std::string("Activation value ") + expected + std::string(" != " + result), result == expected);
+}
+
 void SMemFunctionalTests::testDbBackupAndLoadTests()
 {
 	runTestSetup("testFactorization");
@@ -392,6 +440,54 @@ void SMemFunctionalTests::testDbBackupAndLoadTests()
 	remove((pwd + "/backup.sqlite").c_str());
 }
 
+void SMemFunctionalTests::testBulkImport()
+{
+	std::string triples("smem-import-test.csv");
+	std::string bad("smem-import-bad.csv");
+	std::string clauses("smem-import-test.soar");
+	{
+		std::ofstream file(triples.c_str());
+		file << "# id,attribute,value[,edge weight]\n"
+		     << "<cat>,name,cat\n<cat>,legs,4\n<cat>,isa,<mammal>\n<cat>,isa,<mammal>\n"
+		     << "<dog>,name,dog\n<dog>,legs,4\n<dog>,isa,<mammal>,0.5\n"
+		     << "<mammal>,name,mammal\n<mammal>,code,|42|\n";
+	}
+	{
+		std::ofstream file(bad.c_str());
+		file << "<cow>,name,cow\n<cow>,legs\n";
+	}
+	{
+		std::ofstream file(clauses.c_str());
+		file << "(<bird> ^name bird ^legs 2)\n(@2 ^habitat land ^member <bird>)\n";
+	}
+	
+	agent->ExecuteCommandLine("smem --enable");
+	std::string importResult = agent->ExecuteCommandLine(("smem --import " + triples).c_str());
+	std::string imported = agent->ExecuteCommandLine("print @");
+	
+	// nothing is stored from a file with a bad line
+	std::string badResult = agent->ExecuteCommandLine(("smem --import " + bad).c_str());
+	std::string afterBad = agent->ExecuteCommandLine("print @");
+	
+	std::string query = agent->ExecuteCommandLine("smem --query {(<x> ^legs 4 ^isa @2)} 2");
+	std::string clauseResult = agent->ExecuteCommandLine(("smem --import " + clauses).c_str());
+	std::string mammal = agent->ExecuteCommandLine("print @2");
+	std::string bird = agent->ExecuteCommandLine("print @4");
+	
+	remove(triples.c_str());
+	remove(bad.c_str());
+	remove(clauses.c_str());
+	
+	assertTrue_msg("Import failed: " + importResult, importResult.find("Imported 8 augmentations and 3 new LTIs") != std::string::npos);
+	assertTrue_msg("Wrong knowledge imported: " + imported, imported == "(@1 ^isa @2 ^legs 4 ^name cat [+0.000])\n(@2 ^code |42| ^name mammal [+0.000])\n(@3 ^isa @2 ^legs 4 ^name dog [+0.000])\n");
+	assertTrue_msg("Bad file imported: " + badResult, badResult.find("Imported") == std::string::npos);
+	assertTrue_msg("Bad file changed memory: " + afterBad, afterBad == imported);
+	assertTrue_msg("Query missed imported knowledge: " + query, (query.find("@1") != std::string::npos) && (query.find("@3") != std::string::npos));
+	assertTrue_msg("Clause import failed: " + clauseResult, clauseResult.find("Imported 4 augmentations and 1 new LTIs") != std::string::npos);
+	assertTrue_msg("Clauses not appended: " + mammal, (mammal.find("^habitat land") != std::string::npos) && (mammal.find("^member @4") != std::string::npos) && (mammal.find("^name mammal") != std::string::npos));
+	assertTrue_msg("Clause LTI not stored: " + bird, bird.find("^name bird") != std::string::npos);
+}
+
 void SMemFunctionalTests::testReadCSoarDB()
 {
 	agent->InitSoar();
@@ -46,6 +46,12 @@ public:
 	TEST(testMaxMultivalued, -1)
 	void testMaxMultivalued();
 	
+	TEST(testMaxFiltered, -1)
+	void testMaxFiltered();
+
+	TEST(testMaxFilteredNativeStoreOff, -1)
+	void testMaxFilteredNativeStoreOff();
+
 	TEST(testMin, -1)
 	void testMin();
 	
@@ -87,6 +93,9 @@ public:
 	
 	TEST(testNegQuery, -1)
 	void testNegQuery();
+
+	TEST(testNativeStoreOff, -1)
+	void testNativeStoreOff();
 	
 	TEST(testNegStringFloat, -1)
 	void testNegStringFloat();
@@ -124,12 +133,18 @@ public:
 	TEST(testSpreadingActivation_AlphabetAgentAllOn, -1)
     void testSpreadingActivation_AlphabetAgentAllOn();
 
+	TEST(testSpreadingActivation_StoreToCachedSource, -1)
+	void testSpreadingActivation_StoreToCachedSource();
+
 	TEST(testDbBackupAndLoadTests, -1)
 	void testDbBackupAndLoadTests();
 	
 	TEST(testReadCSoarDB, -1)
 	void testReadCSoarDB();
 
+	TEST(testBulkImport, -1)
+	void testBulkImport();
+
 	TEST(testMultiAgent, -1)
 	void testMultiAgent();
 };